@@ -34,8 +34,9 @@ template<typename MatrixType, int UpLo> struct LDLT_Traits;
   * is lower triangular with a unit diagonal and D is a diagonal matrix.
   *
   * The decomposition uses pivoting to ensure stability, so that L will have
-  * zeros in the bottom right rank(A) - n submatrix. Avoiding the square root
-  * on D also stabilizes the computation.
+  * zeros in the bottom right rank(A) - n submatrix. At each step, the pivot is the
+  * largest diagonal coefficient of the remaining Schur complement. Avoiding the square root
+  * on D also stabilizes the computation. Large matrices are decomposed by blocks of columns.
   *
   * Remember that Cholesky decompositions are not rank-revealing. Also, do not use a Cholesky
   * decomposition to determine whether a system of equations has a solution.
@@ -245,27 +246,23 @@ template<int UpLo> struct ldlt_inplace;
 
 template<> struct ldlt_inplace<Lower>
 {
+  // Computes the columns k0 to kend-1 of the decomposition, assuming that the contribution of the previous
+  // columns has already been applied to the trailing part mat(k0:,k0:). The diagonal of the trailing part is
+  // kept up to date, so that the pivots are chosen on the diagonal of the Schur complement.
+  // Returns false if the decomposition finished early because the matrix is not full rank.
   template<typename MatrixType, typename TranspositionType, typename Workspace>
-  static bool unblocked(MatrixType& mat, TranspositionType& transpositions, Workspace& temp, int* sign=0)
+  static bool factorize_columns(MatrixType& mat, TranspositionType& transpositions, Workspace& temp,
+                                typename MatrixType::Index k0, typename MatrixType::Index kend,
+                                typename MatrixType::RealScalar& cutoff, int* sign)
   {
     using std::abs;
     typedef typename MatrixType::Scalar Scalar;
     typedef typename MatrixType::RealScalar RealScalar;
     typedef typename MatrixType::Index Index;
-    eigen_assert(mat.rows()==mat.cols());
     const Index size = mat.rows();
+    RealScalar biggest_in_corner;
 
-    if (size <= 1)
-    {
-      transpositions.setIdentity();
-      if(sign)
-        *sign = numext::real(mat.coeff(0,0))>0 ? 1:-1;
-      return true;
-    }
-
-    RealScalar cutoff(0), biggest_in_corner;
-
-    for (Index k = 0; k < size; ++k)
+    for (Index k = k0; k < kend; ++k)
     {
       // Find largest diagonal element
       Index index_of_biggest_in_corner;
@@ -285,7 +282,7 @@ template<> struct ldlt_inplace<Lower>
       {
         for(Index i = k; i < size; i++) transpositions.coeffRef(i) = i;
         if(sign) *sign = 0;
-        break;
+        return false;
       }
 
       transpositions.coeffRef(k) = index_of_biggest_in_corner;
@@ -293,43 +290,49 @@ template<> struct ldlt_inplace<Lower>
       {
         // apply the transposition while taking care to consider only
         // the lower triangular part
-        Index s = size-index_of_biggest_in_corner-1; // trailing size after the biggest element
-        mat.row(k).head(k).swap(mat.row(index_of_biggest_in_corner).head(k));
-        mat.col(k).tail(s).swap(mat.col(index_of_biggest_in_corner).tail(s));
-        std::swap(mat.coeffRef(k,k),mat.coeffRef(index_of_biggest_in_corner,index_of_biggest_in_corner));
-        for(int i=k+1;i<index_of_biggest_in_corner;++i)
+        Index p = index_of_biggest_in_corner;
+        Index s = size-p-1; // trailing size after the biggest element
+        mat.row(k).head(k).swap(mat.row(p).head(k));
+        mat.col(k).tail(s).swap(mat.col(p).tail(s));
+        std::swap(mat.coeffRef(k,k),mat.coeffRef(p,p));
+        for(Index i=k+1;i<p;++i)
         {
           Scalar tmp = mat.coeffRef(i,k);
-          mat.coeffRef(i,k) = numext::conj(mat.coeffRef(index_of_biggest_in_corner,i));
-          mat.coeffRef(index_of_biggest_in_corner,i) = numext::conj(tmp);
+          mat.coeffRef(i,k) = numext::conj(mat.coeffRef(p,i));
+          mat.coeffRef(p,i) = numext::conj(tmp);
         }
         if(NumTraits<Scalar>::IsComplex)
-          mat.coeffRef(index_of_biggest_in_corner,k) = numext::conj(mat.coeff(index_of_biggest_in_corner,k));
+          mat.coeffRef(p,k) = numext::conj(mat.coeff(p,k));
       }
 
-      // partition the matrix:
+      // partition the matrix, the columns on the left of k0 being already applied:
       //       A00 |  -  |  -
       // lu  = A10 | A11 |  -
       //       A20 | A21 | A22
       Index rs = size - k - 1;
+      Index i = k - k0;
       Block<MatrixType,Dynamic,1> A21(mat,k+1,k,rs,1);
-      Block<MatrixType,1,Dynamic> A10(mat,k,0,1,k);
-      Block<MatrixType,Dynamic,Dynamic> A20(mat,k+1,0,rs,k);
+      Block<MatrixType,1,Dynamic> A10(mat,k,k0,1,i);
+      Block<MatrixType,Dynamic,Dynamic> A20(mat,k+1,k0,rs,i);
 
-      if(k>0)
+      if(i>0 && rs>0)
       {
-        temp.head(k) = mat.diagonal().head(k).asDiagonal() * A10.adjoint();
-        mat.coeffRef(k,k) -= (A10 * temp.head(k)).value();
-        if(rs>0)
-          A21.noalias() -= A20 * temp.head(k);
+        temp.head(i) = mat.diagonal().segment(k0,i).asDiagonal() * A10.adjoint();
+        A21.noalias() -= A20 * temp.head(i);
       }
+      RealScalar dk = numext::real(mat.coeff(k,k));
       if((rs>0) && (abs(mat.coeffRef(k,k)) > cutoff))
+      {
         A21 /= mat.coeffRef(k,k);
-      
+        // update the diagonal of the Schur complement
+        for(Index j = 0; j < rs; ++j)
+          mat.coeffRef(k+1+j,k+1+j) -= dk * numext::abs2(A21.coeff(j));
+      }
+
       if(sign)
       {
         // LDLT is not guaranteed to work for indefinite matrices, but let's try to get the sign right
-        int newSign = numext::real(mat.diagonal().coeff(index_of_biggest_in_corner)) > 0;
+        int newSign = dk > 0;
         if(k == 0)
           *sign = newSign;
         else if(*sign != newSign)
@@ -340,6 +343,69 @@ template<> struct ldlt_inplace<Lower>
     return true;
   }
 
+  template<typename MatrixType, typename TranspositionType, typename Workspace>
+  static bool unblocked(MatrixType& mat, TranspositionType& transpositions, Workspace& temp, int* sign=0)
+  {
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef typename MatrixType::Index Index;
+    eigen_assert(mat.rows()==mat.cols());
+    const Index size = mat.rows();
+
+    if (size <= 1)
+    {
+      transpositions.setIdentity();
+      if(sign)
+        *sign = numext::real(mat.coeff(0,0))>0 ? 1:-1;
+      return true;
+    }
+
+    RealScalar cutoff(0);
+    factorize_columns(mat, transpositions, temp, 0, size, cutoff, sign);
+    return true;
+  }
+
+  // Same as unblocked(), but the columns are computed by panels whose contribution to the
+  // trailing part of the matrix is applied as a rank-k update.
+  template<typename MatrixType, typename TranspositionType, typename Workspace>
+  static bool blocked(MatrixType& mat, TranspositionType& transpositions, Workspace& temp, int* sign=0)
+  {
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef typename MatrixType::Index Index;
+    eigen_assert(mat.rows()==mat.cols());
+    const Index size = mat.rows();
+    if(size<32)
+      return unblocked(mat, transpositions, temp, sign);
+
+    Index blockSize = size/8;
+    blockSize = (blockSize/16)*16;
+    blockSize = (std::min)((std::max)(blockSize,Index(8)), Index(128));
+
+    RealScalar cutoff(0);
+    Matrix<Scalar,Dynamic,Dynamic> W;
+    Matrix<Scalar,Dynamic,1> diag;
+    for (Index k = 0; k < size; k += blockSize)
+    {
+      Index bs = (std::min)(blockSize, size-k);
+      if(!factorize_columns(mat, transpositions, temp, k, k+bs, cutoff, sign))
+        break;
+
+      // A22 -= L21 D1 L21^*, the diagonal of A22 being already up to date
+      Index rs = size - k - bs;
+      if(rs>0)
+      {
+        Block<MatrixType,Dynamic,Dynamic> L21(mat,k+bs,k,rs,bs);
+        Block<MatrixType,Dynamic,Dynamic> A22(mat,k+bs,k+bs,rs,rs);
+        diag = A22.diagonal();
+        W.noalias() = L21 * mat.diagonal().segment(k,bs).asDiagonal();
+        A22.template triangularView<Lower>() -= W * L21.adjoint();
+        A22.diagonal() = diag;
+      }
+    }
+
+    return true;
+  }
+
   // Reference for the algorithm: Davis and Hager, "Multiple Rank
   // Modifications of a Sparse Cholesky Factorization" (Algorithm 1)
   // Trivial rearrangements of their computations (Timothy E. Holy)
@@ -405,6 +471,13 @@ template<> struct ldlt_inplace<Upper>
     return ldlt_inplace<Lower>::unblocked(matt, transpositions, temp, sign);
   }
 
+  template<typename MatrixType, typename TranspositionType, typename Workspace>
+  static EIGEN_STRONG_INLINE bool blocked(MatrixType& mat, TranspositionType& transpositions, Workspace& temp, int* sign=0)
+  {
+    Transpose<MatrixType> matt(mat);
+    return ldlt_inplace<Lower>::blocked(matt, transpositions, temp, sign);
+  }
+
   template<typename MatrixType, typename TranspositionType, typename Workspace, typename WType>
   static EIGEN_STRONG_INLINE bool update(MatrixType& mat, TranspositionType& transpositions, Workspace& tmp, WType& w, const typename MatrixType::RealScalar& sigma=1)
   {
@@ -445,7 +518,7 @@ LDLT<MatrixType,_UpLo>& LDLT<MatrixType,_UpLo>::compute(const MatrixType& a)
   m_isInitialized = false;
   m_temporary.resize(size);
 
-  internal::ldlt_inplace<UpLo>::unblocked(m_matrix, m_transpositions, m_temporary, &m_sign);
+  internal::ldlt_inplace<UpLo>::blocked(m_matrix, m_transpositions, m_temporary, &m_sign);
 
   m_isInitialized = true;
   return *this;
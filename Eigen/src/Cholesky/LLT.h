@@ -301,6 +301,10 @@ template<typename Scalar> struct llt_inplace<Scalar, Lower>
     blockSize = (blockSize/16)*16;
     blockSize = (std::min)((std::max)(blockSize,Index(8)), Index(128));
 
+    Index threads = parallel_level3_threads(double(size)*double(size)*double(size)/6, size);
+    if(threads>1)
+      return blocked_lookahead(m, blockSize, threads);
+
     for (Index k=0; k<size; k+=blockSize)
     {
       // partition the matrix:
@@ -321,6 +325,89 @@ template<typename Scalar> struct llt_inplace<Scalar, Lower>
     return -1;
   }
 
+  /** \internal The tasks of a step of blocked_lookahead(). Given the factorized panel \a k of width \a bs, the task 0
+    * updates the next \a nbs columns and factorizes them as the next panel, while the other tasks update \a slices
+    * vertical strips of the lower triangular part of the remaining columns. */
+  template<typename MatrixType> struct LookAheadJob
+  {
+    typedef typename MatrixType::Index Index;
+
+    LookAheadJob(MatrixType& m, Index k, Index bs, Index nbs, Index slices, Index* panel_ret)
+      : m_mat(m), m_k(k), m_bs(bs), m_nbs(nbs), m_slices(slices), m_panel_ret(panel_ret)
+    {}
+
+    void operator()(int i) const
+    {
+      const Index size = m_mat.rows();
+      const Index next = m_k + m_bs;
+      Index start, length;
+      if(i==0)
+      {
+        start = next;
+        length = m_nbs;
+      }
+      else
+      {
+        Index rest = size - next - m_nbs;
+        start = parallel_triangular_chunk(rest, m_slices, Index(i-1), true);
+        length = parallel_triangular_chunk(rest, m_slices, Index(i), true) - start;
+        start += next + m_nbs;
+      }
+      if(length==0)
+        return;
+
+      Index rs = size - start - length;
+      Block<MatrixType,Dynamic,Dynamic> L1(m_mat,start,       m_k,  length,m_bs);
+      Block<MatrixType,Dynamic,Dynamic> L2(m_mat,start+length,m_k,  rs,    m_bs);
+      Block<MatrixType,Dynamic,Dynamic> A11(m_mat,start,       start,length,length);
+      Block<MatrixType,Dynamic,Dynamic> A21(m_mat,start+length,start,rs,    length);
+
+      A11.template selfadjointView<Lower>().rankUpdate(L1,-1);
+      if(rs>0) A21.noalias() -= L2 * L1.adjoint();
+
+      if(i==0)
+      {
+        Index ret = unblocked(A11);
+        *m_panel_ret = ret;
+        if(ret<0 && rs>0) A11.adjoint().template triangularView<Upper>().template solveInPlace<OnTheRight>(A21);
+      }
+    }
+
+    MatrixType& m_mat;
+    Index m_k, m_bs, m_nbs, m_slices;
+    Index* m_panel_ret;
+  };
+
+  /** \internal performs the same factorization as blocked() using up to \a threads threads, with a look-ahead
+    * of one panel: the panel k+1 is factorized while the trailing matrix is still being updated by the panel k,
+    * so that the factorization of the panels is not on the critical path. */
+  template<typename MatrixType>
+  static typename MatrixType::Index blocked_lookahead(MatrixType& m, typename MatrixType::Index blockSize, typename MatrixType::Index threads)
+  {
+    typedef typename MatrixType::Index Index;
+    Index size = m.rows();
+
+    Index bs = (std::min)(blockSize, size);
+    Block<MatrixType,Dynamic,Dynamic> A11(m,0, 0,bs,     bs);
+    Block<MatrixType,Dynamic,Dynamic> A21(m,bs,0,size-bs,bs);
+    Index ret;
+    if((ret=unblocked(A11))>=0) return ret;
+    if(size>bs) A11.adjoint().template triangularView<Upper>().template solveInPlace<OnTheRight>(A21);
+
+    for(Index k=0; k+blockSize<size; k+=blockSize)
+    {
+      Index next = k + blockSize;
+      Index nbs = (std::min)(blockSize, size-next);
+      Index rest = size - next - nbs;
+      Index slices = rest>0 ? (std::max)(Index(1), (std::min)(threads-1, rest/32)) : 0;
+
+      Index panel_ret = -1;
+      parallel_for(LookAheadJob<MatrixType>(m, k, blockSize, nbs, slices, &panel_ret), int(1+slices));
+      if(panel_ret>=0) return next+panel_ret;
+    }
+    return -1;
+  }
+
   template<typename MatrixType, typename VectorType>
   static typename MatrixType::Index rankUpdate(MatrixType& mat, const VectorType& vec, const RealScalar& sigma)
   {
@@ -70,7 +70,12 @@ public:
                                         : int(DefaultTraversal),
     Vectorized = int(Traversal) == InnerVectorizedTraversal
               || int(Traversal) == LinearVectorizedTraversal
-              || int(Traversal) == SliceVectorizedTraversal
+              || int(Traversal) == SliceVectorizedTraversal,
+    /* With masked loads and stores, the unaligned head and the remainder of the linear and slice
+       vectorized traversals are assigned with a single partial packet rather than coefficient-wise. */
+    MaskedTails = bool(Vectorized)
+               && bool(packet_traits<typename Derived::Scalar>::HasMaskedLoadStore)
+               && (int(Derived::Flags) & int(OtherDerived::Flags) & PartialPacketAccessBit)
   };
 
 private:
@@ -115,6 +120,7 @@ public:
     EIGEN_DEBUG_VAR(MayLinearVectorize)
     EIGEN_DEBUG_VAR(MaySliceVectorize)
     EIGEN_DEBUG_VAR(Traversal)
+    EIGEN_DEBUG_VAR(MaskedTails)
     EIGEN_DEBUG_VAR(UnrollingLimit)
     EIGEN_DEBUG_VAR(MayUnrollCompletely)
     EIGEN_DEBUG_VAR(MayUnrollInner)
@@ -386,6 +392,45 @@ struct unaligned_assign_impl<false>
   }
 };
 
+/* Assigns the less than a packet coefficients in [start,end) of a linear or a slice vectorized traversal,
+   either one by one, or with a single partial packet if the architecture has masked loads and stores. */
+template <bool Masked = false>
+struct tail_assign_impl
+{
+  template <typename Derived, typename OtherDerived>
+  static EIGEN_STRONG_INLINE void run(const Derived& src, OtherDerived& dst, typename Derived::Index start, typename Derived::Index end)
+  {
+    unaligned_assign_impl<>::run(src,dst,start,end);
+  }
+
+  template <typename Derived, typename OtherDerived>
+  static EIGEN_STRONG_INLINE void runByOuterInner(const Derived& src, OtherDerived& dst, typename Derived::Index outer,
+                                                  typename Derived::Index start, typename Derived::Index end)
+  {
+    for(typename Derived::Index inner = start; inner<end; ++inner)
+      dst.copyCoeffByOuterInner(outer, inner, src);
+  }
+};
+
+template <>
+struct tail_assign_impl<true>
+{
+  template <typename Derived, typename OtherDerived>
+  static EIGEN_STRONG_INLINE void run(const Derived& src, OtherDerived& dst, typename Derived::Index start, typename Derived::Index end)
+  {
+    if(end>start)
+      dst.template copyPartialPacket<Derived, Unaligned>(start, end-start, src);
+  }
+
+  template <typename Derived, typename OtherDerived>
+  static EIGEN_STRONG_INLINE void runByOuterInner(const Derived& src, OtherDerived& dst, typename Derived::Index outer,
+                                                  typename Derived::Index start, typename Derived::Index end)
+  {
+    if(end>start)
+      dst.template copyPartialPacketByOuterInner<Derived, Unaligned>(outer, start, end-start, src);
+  }
+};
+
 template<typename Derived1, typename Derived2, int Version>
 struct assign_impl<Derived1, Derived2, LinearVectorizedTraversal, NoUnrolling, Version>
 {
@@ -403,14 +448,17 @@ struct assign_impl<Derived1, Derived2, LinearVectorizedTraversal, NoUnrolling, V
                              : internal::first_aligned(&dst.coeffRef(0), size);
     const Index alignedEnd = alignedStart + ((size-alignedStart)/packetSize)*packetSize;
 
-    unaligned_assign_impl<assign_traits<Derived1,Derived2>::DstIsAligned!=0>::run(src,dst,0,alignedStart);
+    if(assign_traits<Derived1,Derived2>::MaskedTails)
+      tail_assign_impl<assign_traits<Derived1,Derived2>::MaskedTails!=0>::run(src,dst,0,alignedStart);
+    else
+      unaligned_assign_impl<assign_traits<Derived1,Derived2>::DstIsAligned!=0>::run(src,dst,0,alignedStart);
 
     for(Index index = alignedStart; index < alignedEnd; index += packetSize)
     {
       dst.template copyPacket<Derived2, dstAlignment, srcAlignment>(index, src);
     }
 
-    unaligned_assign_impl<>::run(src,dst,alignedEnd,size);
+    tail_assign_impl<assign_traits<Derived1,Derived2>::MaskedTails!=0>::run(src,dst,alignedEnd,size);
   }
 };
 
@@ -425,7 +473,10 @@ struct assign_impl<Derived1, Derived2, LinearVectorizedTraversal, CompleteUnroll
            alignedSize = (size/packetSize)*packetSize };
 
     assign_innervec_CompleteUnrolling<Derived1, Derived2, 0, alignedSize>::run(dst, src);
-    assign_DefaultTraversal_CompleteUnrolling<Derived1, Derived2, alignedSize, size>::run(dst, src);
+    if(assign_traits<Derived1,Derived2>::MaskedTails)
+      tail_assign_impl<assign_traits<Derived1,Derived2>::MaskedTails!=0>::run(src, dst, alignedSize, size);
+    else
+      assign_DefaultTraversal_CompleteUnrolling<Derived1, Derived2, alignedSize, size>::run(dst, src);
   }
 };
 
@@ -457,16 +508,14 @@ struct assign_impl<Derived1, Derived2, SliceVectorizedTraversal, NoUnrolling, Ve
     {
       const Index alignedEnd = alignedStart + ((innerSize-alignedStart) & ~packetAlignedMask);
       // do the non-vectorizable part of the assignment
-      for(Index inner = 0; inner<alignedStart ; ++inner)
-        dst.copyCoeffByOuterInner(outer, inner, src);
+      tail_assign_impl<assign_traits<Derived1,Derived2>::MaskedTails!=0>::runByOuterInner(src, dst, outer, 0, alignedStart);
 
       // do the vectorizable part of the assignment
       for(Index inner = alignedStart; inner<alignedEnd; inner+=packetSize)
         dst.template copyPacketByOuterInner<Derived2, dstAlignment, Unaligned>(outer, inner, src);
 
       // do the non-vectorizable part of the assignment
-      for(Index inner = alignedEnd; inner<innerSize ; ++inner)
-        dst.copyCoeffByOuterInner(outer, inner, src);
+      tail_assign_impl<assign_traits<Derived1,Derived2>::MaskedTails!=0>::runByOuterInner(src, dst, outer, alignedEnd, innerSize);
 
       alignedStart = std::min<Index>((alignedStart+alignedStep)%packetSize, innerSize);
     }
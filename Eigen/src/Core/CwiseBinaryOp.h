@@ -75,6 +75,7 @@ struct traits<CwiseBinaryOp<BinaryOp, Lhs, Rhs> >
         HereditaryBits
       | (int(LhsFlags) & int(RhsFlags) &
            ( AlignedBit
+           | PartialPacketAccessBit
            | (StorageOrdersAgree ? LinearAccessBit : 0)
            | (functor_traits<BinaryOp>::PacketAccess && StorageOrdersAgree && SameType ? PacketAccessBit : 0)
            )
@@ -36,7 +36,7 @@ struct traits<CwiseNullaryOp<NullaryOp, PlainObjectType> > : traits<PlainObjectT
 {
   enum {
     Flags = (traits<PlainObjectType>::Flags
-      & (  HereditaryBits
+      & (  HereditaryBits | PartialPacketAccessBit
          | (functor_has_linear_access<NullaryOp>::ret ? LinearAccessBit : 0)
          | (functor_traits<NullaryOp>::PacketAccess ? PacketAccessBit : 0)))
       | (functor_traits<NullaryOp>::IsRepeatable ? 0 : EvalBeforeNestingBit),
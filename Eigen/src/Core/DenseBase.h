@@ -84,6 +84,8 @@ template<typename Derived> class DenseBase
     using Base::copyCoeffByOuterInner;
     using Base::copyPacket;
     using Base::copyPacketByOuterInner;
+    using Base::copyPartialPacket;
+    using Base::copyPartialPacketByOuterInner;
     using Base::operator();
     using Base::operator[];
     using Base::x;
@@ -252,6 +252,8 @@ class DenseCoeffsBase<Derived,ReadOnlyAccessors> : public EigenBase<Derived>
     void copyCoeffByOuterInner();
     void copyPacket();
     void copyPacketByOuterInner();
+    void copyPartialPacket();
+    void copyPartialPacketByOuterInner();
     void stride();
     void innerStride();
     void outerStride();
@@ -547,6 +549,40 @@ class DenseCoeffsBase<Derived, WriteAccessors> : public DenseCoeffsBase<Derived,
       // derived() is important here: copyCoeff() may be reimplemented in Derived!
       derived().template copyPacket< OtherDerived, StoreMode, LoadMode>(row, col, other);
     }
+
+    /** \internal Copies the \a count first coefficients of the packet at position (row,col) of other into *this,
+      * where \a count is smaller than the packet size. Both expressions must have the #PartialPacketAccessBit flag,
+      * and *this must have direct access.
+      *
+      * Like copyPacket(), this method is overridden in SwapWrapper and SelfCwiseBinaryOp.
+      */
+    template<typename OtherDerived, int LoadMode>
+    EIGEN_STRONG_INLINE void copyPartialPacket(Index row, Index col, Index count, const DenseBase<OtherDerived>& other)
+    {
+      eigen_internal_assert(row >= 0 && row < rows()
+                        && col >= 0 && col < cols());
+      internal::pstoreu_partial(&derived().coeffRef(row, col),
+        other.derived().template packet<LoadMode | PartialPacketLoad>(row, col), count);
+    }
+
+    /** \internal Copies the \a count first coefficients of the packet at the given index of other into *this,
+      * see copyPartialPacket(Index,Index,Index,const DenseBase<OtherDerived>&) */
+    template<typename OtherDerived, int LoadMode>
+    EIGEN_STRONG_INLINE void copyPartialPacket(Index index, Index count, const DenseBase<OtherDerived>& other)
+    {
+      eigen_internal_assert(index >= 0 && index < size());
+      internal::pstoreu_partial(&derived().coeffRef(index),
+        other.derived().template packet<LoadMode | PartialPacketLoad>(index), count);
+    }
+
+    /** \internal */
+    template<typename OtherDerived, int LoadMode>
+    EIGEN_STRONG_INLINE void copyPartialPacketByOuterInner(Index outer, Index inner, Index count, const DenseBase<OtherDerived>& other)
+    {
+      const Index row = rowIndexByOuterInner(outer,inner);
+      const Index col = colIndexByOuterInner(outer,inner);
+      derived().template copyPartialPacket<OtherDerived, LoadMode>(row, col, count, other);
+    }
 #endif
 
 };
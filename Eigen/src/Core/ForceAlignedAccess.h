@@ -69,7 +69,7 @@ template<typename ExpressionType> class ForceAlignedAccess
     template<int LoadMode>
     inline const PacketScalar packet(Index row, Index col) const
     {
-      return m_expression.template packet<Aligned>(row, col);
+      return m_expression.template packet<Aligned | (LoadMode & PartialPacketLoad)>(row, col);
     }
 
     template<int LoadMode>
@@ -81,7 +81,7 @@ template<typename ExpressionType> class ForceAlignedAccess
     template<int LoadMode>
     inline const PacketScalar packet(Index index) const
     {
-      return m_expression.template packet<Aligned>(index);
+      return m_expression.template packet<Aligned | (LoadMode & PartialPacketLoad)>(index);
     }
 
     template<int LoadMode>
@@ -172,10 +172,33 @@ struct functor_traits<scalar_hypot_op<Scalar> > {
 template<typename Scalar, typename OtherScalar> struct scalar_binary_pow_op {
   EIGEN_EMPTY_STRUCT_CTOR(scalar_binary_pow_op)
   inline Scalar operator() (const Scalar& a, const OtherScalar& b) const { return numext::pow(a, b); }
+  template<typename Packet>
+  inline const Packet packetOp(const Packet& a, const Packet& b) const
+  { return internal::ppow(a,b); }
 };
 template<typename Scalar, typename OtherScalar>
 struct functor_traits<scalar_binary_pow_op<Scalar,OtherScalar> > {
-  enum { Cost = 5 * NumTraits<Scalar>::MulCost, PacketAccess = false };
+  enum { Cost = 5 * NumTraits<Scalar>::MulCost, PacketAccess = is_same<Scalar,OtherScalar>::value && packet_traits<Scalar>::HasPow };
+};
+
+/** \internal
+  * \brief Template functor to compute the arc tangent of the quotient of two scalars
+  *
+  * \sa class CwiseBinaryOp, atan2()
+  */
+template<typename Scalar> struct scalar_atan2_op {
+  EIGEN_EMPTY_STRUCT_CTOR(scalar_atan2_op)
+  inline Scalar operator() (const Scalar& y, const Scalar& x) const { using std::atan2; return atan2(y, x); }
+  template<typename Packet>
+  inline const Packet packetOp(const Packet& y, const Packet& x) const
+  { return internal::patan2(y,x); }
+};
+template<typename Scalar>
+struct functor_traits<scalar_atan2_op<Scalar> > {
+  enum {
+    Cost = 6 * NumTraits<Scalar>::MulCost,
+    PacketAccess = packet_traits<Scalar>::HasATan && packet_traits<Scalar>::HasDiv
+  };
 };
 
 // other binary functors:
@@ -792,6 +815,85 @@ struct functor_traits<scalar_asin_op<Scalar> >
   };
 };
 
+/** \internal
+  * \brief Template functor to compute the arc tangent of a scalar
+  * \sa class CwiseUnaryOp, ArrayBase::atan()
+  */
+template<typename Scalar> struct scalar_atan_op {
+  EIGEN_EMPTY_STRUCT_CTOR(scalar_atan_op)
+  inline const Scalar operator() (const Scalar& a) const { using std::atan; return atan(a); }
+  typedef typename packet_traits<Scalar>::type Packet;
+  inline Packet packetOp(const Packet& a) const { return internal::patan(a); }
+};
+template<typename Scalar>
+struct functor_traits<scalar_atan_op<Scalar> >
+{
+  enum {
+    Cost = 5 * NumTraits<Scalar>::MulCost,
+    PacketAccess = packet_traits<Scalar>::HasATan
+  };
+};
+
+/** \internal
+  * \brief Template functor to compute the hyperbolic tangent of a scalar
+  * \sa class CwiseUnaryOp, ArrayBase::tanh()
+  */
+template<typename Scalar> struct scalar_tanh_op {
+  EIGEN_EMPTY_STRUCT_CTOR(scalar_tanh_op)
+  inline const Scalar operator() (const Scalar& a) const { using std::tanh; return tanh(a); }
+  typedef typename packet_traits<Scalar>::type Packet;
+  inline Packet packetOp(const Packet& a) const { return internal::ptanh(a); }
+};
+template<typename Scalar>
+struct functor_traits<scalar_tanh_op<Scalar> >
+{
+  enum {
+    Cost = 6 * NumTraits<Scalar>::MulCost,
+    PacketAccess = packet_traits<Scalar>::HasTanh
+  };
+};
+
+/** \internal
+  * \brief Template functor to compute the logistic function 1/(1+exp(-x)) of a scalar
+  * \sa class CwiseUnaryOp, ArrayBase::logistic()
+  */
+template<typename Scalar> struct scalar_logistic_op {
+  EIGEN_EMPTY_STRUCT_CTOR(scalar_logistic_op)
+  inline const Scalar operator() (const Scalar& a) const { using std::exp; return Scalar(1) / (Scalar(1) + exp(-a)); }
+  typedef typename packet_traits<Scalar>::type Packet;
+  inline Packet packetOp(const Packet& a) const { return internal::plogistic(a); }
+};
+template<typename Scalar>
+struct functor_traits<scalar_logistic_op<Scalar> >
+{
+  enum {
+    Cost = 6 * NumTraits<Scalar>::MulCost,
+    PacketAccess = packet_traits<Scalar>::HasLogistic
+  };
+};
+
+/** \internal
+  * \brief Template functor to compute the error function of a scalar
+  *
+  * The scalar path uses the same approximation as the packet one, since erf() is not part of C++98.
+  *
+  * \sa class CwiseUnaryOp, ArrayBase::erf()
+  */
+template<typename Scalar> struct scalar_erf_op {
+  EIGEN_EMPTY_STRUCT_CTOR(scalar_erf_op)
+  inline const Scalar operator() (const Scalar& a) const { return internal::perf(a); }
+  typedef typename packet_traits<Scalar>::type Packet;
+  inline Packet packetOp(const Packet& a) const { return internal::perf(a); }
+};
+template<typename Scalar>
+struct functor_traits<scalar_erf_op<Scalar> >
+{
+  enum {
+    Cost = 10 * NumTraits<Scalar>::MulCost,
+    PacketAccess = packet_traits<Scalar>::HasErf
+  };
+};
+
 /** \internal
   * \brief Template functor to raise a scalar to a power
   * \sa class CwiseUnaryOp, Cwise::pow
@@ -802,11 +904,40 @@ struct scalar_pow_op {
   inline scalar_pow_op(const scalar_pow_op& other) : m_exponent(other.m_exponent) { }
   inline scalar_pow_op(const Scalar& exponent) : m_exponent(exponent) {}
   inline Scalar operator() (const Scalar& a) const { return numext::pow(a, m_exponent); }
+  typedef typename packet_traits<Scalar>::type Packet;
+  inline Packet packetOp(const Packet& a) const
+  {
+    using std::abs;
+    // the vectorized pow trades some accuracy for speed (see EIGEN_FAST_MATH), and so does the evaluation
+    // of the small integer exponents by repeated squaring, whose rounding errors grow with the exponent
+    if(packet_traits<Scalar>::HasPow)
+    {
+      if(abs(m_exponent) <= Scalar(64) && m_exponent == Scalar(int(m_exponent)))
+      {
+        Packet res = pset1<Packet>(Scalar(1)), x = a;
+        for(int n = int(abs(m_exponent)); n; n >>= 1)
+        {
+          if(n & 1) res = pmul(res, x);
+          if(n > 1) x = pmul(x, x);
+        }
+        return m_exponent < Scalar(0) ? pdiv(pset1<Packet>(Scalar(1)), res) : res;
+      }
+      return internal::ppow(a, pset1<Packet>(m_exponent));
+    }
+    // otherwise, the exponent is applied coefficient per coefficient, as in operator()
+    EIGEN_ALIGN_DEFAULT Scalar values[unpacket_traits<Packet>::size];
+    pstore(values, a);
+    for(int i = 0; i < unpacket_traits<Packet>::size; ++i)
+      values[i] = numext::pow(values[i], m_exponent);
+    return pload<Packet>(values);
+  }
   const Scalar m_exponent;
 };
 template<typename Scalar>
 struct functor_traits<scalar_pow_op<Scalar> >
-{ enum { Cost = 5 * NumTraits<Scalar>::MulCost, PacketAccess = false }; };
+{ enum { Cost = 5 * NumTraits<Scalar>::MulCost,
+         PacketAccess = !NumTraits<Scalar>::IsComplex && !NumTraits<Scalar>::IsInteger
+                     && packet_traits<Scalar>::HasMul && packet_traits<Scalar>::HasDiv }; };
 
 /** \internal
   * \brief Template functor to compute the quotient between a scalar and array entries.
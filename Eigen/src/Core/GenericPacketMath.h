@@ -52,6 +52,7 @@ struct default_packet_traits
     HasMax    = 1,
     HasConj   = 1,
     HasSetLinear = 1,
+    HasMaskedLoadStore = 0,
 
     HasDiv    = 0,
     HasSqrt   = 0,
@@ -64,7 +65,10 @@ struct default_packet_traits
     HasTan    = 0,
     HasASin   = 0,
     HasACos   = 0,
-    HasATan   = 0
+    HasATan   = 0,
+    HasTanh   = 0,
+    HasLogistic = 0,
+    HasErf    = 0
   };
 };
 
@@ -148,6 +152,23 @@ pxor(const Packet& a, const Packet& b) { return a ^ b; }
 template<typename Packet> inline Packet
 pandnot(const Packet& a, const Packet& b) { return a & (!b); }
 
+/** \internal \returns a mask which is set for the coefficients where \a a < \a b.
+  * The masks returned by the pcmp_* functions are only meant to be consumed by pselect(). */
+template<typename Packet> inline Packet
+pcmp_lt(const Packet& a, const Packet& b) { return a<b ? Packet(1) : Packet(0); }
+
+/** \internal \returns a mask which is set for the coefficients where \a a <= \a b, see pcmp_lt() */
+template<typename Packet> inline Packet
+pcmp_le(const Packet& a, const Packet& b) { return a<=b ? Packet(1) : Packet(0); }
+
+/** \internal \returns a mask which is set for the coefficients where \a a == \a b, see pcmp_lt() */
+template<typename Packet> inline Packet
+pcmp_eq(const Packet& a, const Packet& b) { return a==b ? Packet(1) : Packet(0); }
+
+/** \internal \returns the coefficients of \a a where \a mask is set, and those of \a b elsewhere */
+template<typename Packet> inline Packet
+pselect(const Packet& mask, const Packet& a, const Packet& b) { return mask!=Packet(0) ? a : b; }
+
 /** \internal \returns a packet version of \a *from, from must be 16 bytes aligned */
 template<typename Packet> inline Packet
 pload(const typename unpacket_traits<Packet>::type* from) { return *from; }
@@ -238,18 +259,6 @@ Packet psin(const Packet& a) { using std::sin; return sin(a); }
 template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
 Packet pcos(const Packet& a) { using std::cos; return cos(a); }
 
-/** \internal \returns the tan of \a a (coeff-wise) */
-template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
-Packet ptan(const Packet& a) { using std::tan; return tan(a); }
-
-/** \internal \returns the arc sine of \a a (coeff-wise) */
-template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
-Packet pasin(const Packet& a) { using std::asin; return asin(a); }
-
-/** \internal \returns the arc cosine of \a a (coeff-wise) */
-template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
-Packet pacos(const Packet& a) { using std::acos; return acos(a); }
-
 /** \internal \returns the exp of \a a (coeff-wise) */
 template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
 Packet pexp(const Packet& a) { using std::exp; return exp(a); }
@@ -292,6 +301,42 @@ inline Packet ploadt(const typename unpacket_traits<Packet>::type* from)
     return ploadu<Packet>(from);
 }
 
+/** \internal \returns a packet made of the \a n first coefficients of \a from completed by zeros.
+  * At most \a n coefficients are read, and \a n can be larger than the packet size.
+  * Architectures with masked loads (see packet_traits::HasMaskedLoadStore) specialize this function. */
+template<typename Packet> inline Packet
+ploadu_partial(const typename unpacket_traits<Packet>::type* from, DenseIndex n)
+{
+  typedef typename unpacket_traits<Packet>::type Scalar;
+  Scalar tmp[unpacket_traits<Packet>::size];
+  for(DenseIndex i=0; i<unpacket_traits<Packet>::size; ++i)
+    tmp[i] = i<n ? from[i] : Scalar(0);
+  return ploadu<Packet>(tmp);
+}
+
+/** \internal copy the \a n first coefficients of the packet \a from to \a *to, with \a n smaller
+  * than the packet size */
+template<typename Scalar, typename Packet> inline void
+pstoreu_partial(Scalar* to, const Packet& from, DenseIndex n)
+{
+  Scalar tmp[unpacket_traits<Packet>::size];
+  pstoreu(tmp, from);
+  for(DenseIndex i=0; i<n; ++i)
+    to[i] = tmp[i];
+}
+
+/** \internal \returns a packet version of \a *from, where \a available is the number of coefficients
+  * which can be read from \a from. This number is only used if LoadMode has the #PartialPacketLoad bit,
+  * see ploadu_partial(). */
+template<typename Packet, int LoadMode>
+inline Packet ploadt(const typename unpacket_traits<Packet>::type* from, DenseIndex available)
+{
+  if(LoadMode & PartialPacketLoad)
+    return ploadu_partial<Packet>(from, available);
+  else
+    return ploadt<Packet, LoadMode>(from);
+}
+
 /** \internal copy the packet \a from to \a *to.
   * If StoreMode equals #Aligned, \a to must be 16 bytes aligned */
 template<typename Scalar, typename Packet, int LoadMode>
@@ -332,6 +377,372 @@ inline void palign(PacketType& first, const PacketType& second)
   palign_impl<Offset,PacketType>::run(first,second);
 }
 
+/***************************************************************************
+* Special math functions built on top of the other packet functions
+***************************************************************************/
+
+/* The following special functions have no counterpart in the architecture specific code:
+ * they are written in terms of the basic packet arithmetic, pexp/plog, and the pcmp_*
+ * and pselect masking functions, so that they are vectorized as soon as an architecture
+ * provides those (see the HasTanh, HasLogistic, HasErf, HasTan, HasASin, HasACos, HasATan
+ * and HasPow flags).
+ * The approximations come from the cephes library, with specializations for float
+ * packets where a lower degree suffices. All branches are evaluated and the result
+ * is selected coefficient-wise.
+ */
+
+/** \internal \returns \a result, with the NaN coefficients of the argument \a a put back: the clamping of the
+  * arguments, explicit or in pexp, would otherwise return a finite value for them */
+template<typename Packet> EIGEN_STRONG_INLINE Packet ppropagate_nan(const Packet& a, const Packet& result)
+{
+  return pselect(pcmp_eq(a,a), result, a);
+}
+
+template<typename Packet, typename Scalar = typename unpacket_traits<Packet>::type>
+struct ptanh_impl
+{
+  // tanh(x) = x + x^3 P(x^2)/Q(x^2) for |x| < 0.625, and 1 - 2/(exp(2|x|)+1) otherwise
+  static Packet run(const Packet& x)
+  {
+    const Packet one = pset1<Packet>(Scalar(1));
+    const Packet ax = pabs(x);
+    const Packet z = pmul(x,x);
+
+    Packet p = pset1<Packet>(Scalar(-9.64399179425052238628E-1));
+    p = pmadd(p, z, pset1<Packet>(Scalar(-9.92877231001918586564E1)));
+    p = pmadd(p, z, pset1<Packet>(Scalar(-1.61468768441708447952E3)));
+    Packet q = padd(z, pset1<Packet>(Scalar(1.12811678491632931402E2)));
+    q = pmadd(q, z, pset1<Packet>(Scalar(2.23548839060100448583E3)));
+    q = pmadd(q, z, pset1<Packet>(Scalar(4.84406305325125486048E3)));
+    Packet small = pmadd(pmul(x,z), pdiv(p,q), x);
+
+    Packet large = psub(one, pdiv(pset1<Packet>(Scalar(2)), padd(pexp(padd(ax,ax)), one)));
+    large = pselect(pcmp_lt(x, pset1<Packet>(Scalar(0))), pnegate(large), large);
+    return pselect(pcmp_lt(ax, pset1<Packet>(Scalar(0.625))), small, large);
+  }
+};
+
+template<typename Packet>
+struct ptanh_impl<Packet,float>
+{
+  static Packet run(const Packet& x)
+  {
+    const Packet one = pset1<Packet>(1.f);
+    const Packet ax = pabs(x);
+    const Packet z = pmul(x,x);
+
+    Packet p = pset1<Packet>(-5.70498872745E-3f);
+    p = pmadd(p, z, pset1<Packet>( 2.06390887954E-2f));
+    p = pmadd(p, z, pset1<Packet>(-5.37397155531E-2f));
+    p = pmadd(p, z, pset1<Packet>( 1.33314422036E-1f));
+    p = pmadd(p, z, pset1<Packet>(-3.33332819422E-1f));
+    Packet small = pmadd(pmul(x,z), p, x);
+
+    Packet large = psub(one, pdiv(pset1<Packet>(2.f), padd(pexp(padd(ax,ax)), one)));
+    large = pselect(pcmp_lt(x, pset1<Packet>(0.f)), pnegate(large), large);
+    return pselect(pcmp_lt(ax, pset1<Packet>(0.625f)), small, large);
+  }
+};
+
+/** \internal \returns the hyperbolic tangent of \a a (coeff-wise) */
+template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
+Packet ptanh(const Packet& a) { return ppropagate_nan(a, ptanh_impl<Packet>::run(a)); }
+
+/** \internal \returns the logistic function 1/(1+exp(-a)) of \a a (coeff-wise) */
+template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
+Packet plogistic(const Packet& a)
+{
+  typedef typename unpacket_traits<Packet>::type Scalar;
+  const Packet one = pset1<Packet>(Scalar(1));
+  return ppropagate_nan(a, pdiv(one, padd(one, pexp(pnegate(a)))));
+}
+
+template<typename Packet, typename Scalar = typename unpacket_traits<Packet>::type>
+struct perf_impl
+{
+  // erf(x) = x T(x^2)/U(x^2) for |x| < 1, and 1 - exp(-x^2) P(|x|)/Q(|x|) otherwise.
+  // erfc(x) is below the double precision epsilon for x > 6, so that |x| is clamped there.
+  static Packet run(const Packet& x)
+  {
+    const Packet one = pset1<Packet>(Scalar(1));
+    const Packet ax = pmin(pabs(x), pset1<Packet>(Scalar(6)));
+    const Packet z = pmul(x,x);
+
+    Packet t = pset1<Packet>(Scalar(9.60497373987051638749E0));
+    t = pmadd(t, z, pset1<Packet>(Scalar(9.00260197203842689217E1)));
+    t = pmadd(t, z, pset1<Packet>(Scalar(2.23200534594684319226E3)));
+    t = pmadd(t, z, pset1<Packet>(Scalar(7.00332514112805075473E3)));
+    t = pmadd(t, z, pset1<Packet>(Scalar(5.55923013010394962768E4)));
+    Packet u = padd(z, pset1<Packet>(Scalar(3.35617141647503099647E1)));
+    u = pmadd(u, z, pset1<Packet>(Scalar(5.21357949780152679795E2)));
+    u = pmadd(u, z, pset1<Packet>(Scalar(4.59432382970980127987E3)));
+    u = pmadd(u, z, pset1<Packet>(Scalar(2.26290000613890934246E4)));
+    u = pmadd(u, z, pset1<Packet>(Scalar(4.92673942608635921086E4)));
+    Packet small = pdiv(pmul(x,t), u);
+
+    Packet p = pset1<Packet>(Scalar(2.46196981473530512524E-10));
+    p = pmadd(p, ax, pset1<Packet>(Scalar(5.64189564831068821977E-1)));
+    p = pmadd(p, ax, pset1<Packet>(Scalar(7.46321056442269912687E0)));
+    p = pmadd(p, ax, pset1<Packet>(Scalar(4.86371970985681366614E1)));
+    p = pmadd(p, ax, pset1<Packet>(Scalar(1.96520832956077098242E2)));
+    p = pmadd(p, ax, pset1<Packet>(Scalar(5.26445194995477358631E2)));
+    p = pmadd(p, ax, pset1<Packet>(Scalar(9.34528527171957607540E2)));
+    p = pmadd(p, ax, pset1<Packet>(Scalar(1.02755188689515710272E3)));
+    p = pmadd(p, ax, pset1<Packet>(Scalar(5.57535335369399327526E2)));
+    Packet q = padd(ax, pset1<Packet>(Scalar(1.32281951154744992508E1)));
+    q = pmadd(q, ax, pset1<Packet>(Scalar(8.67072140885989742329E1)));
+    q = pmadd(q, ax, pset1<Packet>(Scalar(3.54937778887819891062E2)));
+    q = pmadd(q, ax, pset1<Packet>(Scalar(9.75708501743205489753E2)));
+    q = pmadd(q, ax, pset1<Packet>(Scalar(1.82390916687909736289E3)));
+    q = pmadd(q, ax, pset1<Packet>(Scalar(2.24633760818710981792E3)));
+    q = pmadd(q, ax, pset1<Packet>(Scalar(1.65666309194161350182E3)));
+    q = pmadd(q, ax, pset1<Packet>(Scalar(5.57535340817727675546E2)));
+    Packet large = psub(one, pmul(pexp(pnegate(pmul(ax,ax))), pdiv(p,q)));
+    large = pselect(pcmp_lt(x, pset1<Packet>(Scalar(0))), pnegate(large), large);
+
+    return pselect(pcmp_lt(pabs(x), one), small, large);
+  }
+};
+
+template<typename Packet>
+struct perf_impl<Packet,float>
+{
+  // single rational approximation on [-4,4], erf(x) rounds to +-1 outside
+  static Packet run(const Packet& a)
+  {
+    const Packet x = pmax(pmin(a, pset1<Packet>(4.f)), pset1<Packet>(-4.f));
+    const Packet z = pmul(x,x);
+
+    Packet p = pset1<Packet>(-2.72614225801306e-10f);
+    p = pmadd(p, z, pset1<Packet>( 2.77068142495902e-08f));
+    p = pmadd(p, z, pset1<Packet>(-2.10102402082508e-06f));
+    p = pmadd(p, z, pset1<Packet>(-5.69250639462346e-05f));
+    p = pmadd(p, z, pset1<Packet>(-7.34990630326855e-04f));
+    p = pmadd(p, z, pset1<Packet>(-2.95459980854025e-03f));
+    p = pmadd(p, z, pset1<Packet>(-1.60960333262415e-02f));
+    p = pmul(x, p);
+
+    Packet q = pset1<Packet>(-1.45660718464996e-05f);
+    q = pmadd(q, z, pset1<Packet>(-2.13374055278905e-04f));
+    q = pmadd(q, z, pset1<Packet>(-1.68282697438203e-03f));
+    q = pmadd(q, z, pset1<Packet>(-7.37332916720468e-03f));
+    q = pmadd(q, z, pset1<Packet>(-1.42647390514189e-02f));
+    return pdiv(p, q);
+  }
+};
+
+/** \internal \returns the error function of \a a (coeff-wise) */
+template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
+Packet perf(const Packet& a) { return ppropagate_nan(a, perf_impl<Packet>::run(a)); }
+
+template<typename Packet, typename Scalar = typename unpacket_traits<Packet>::type>
+struct patan_impl
+{
+  // the argument is reduced to |x| <= 0.66 using atan(x) = Pi/2 - atan(1/x) for |x| > tan(3Pi/8),
+  // and atan(x) = Pi/4 + atan((x-1)/(x+1)) in between, then atan(x) = x + x^3 P(x^2)/Q(x^2)
+  static Packet run(const Packet& x)
+  {
+    const Packet one = pset1<Packet>(Scalar(1));
+    const Packet zero = pset1<Packet>(Scalar(0));
+    const Packet ax = pabs(x);
+    const Packet big = pcmp_lt(pset1<Packet>(Scalar(2.41421356237309504880)), ax);
+    const Packet mid = pcmp_lt(pset1<Packet>(Scalar(0.66)), ax);
+
+    Packet xr = pselect(big, pnegate(pdiv(one, ax)), pselect(mid, pdiv(psub(ax,one), padd(ax,one)), ax));
+    Packet y0 = pselect(big, pset1<Packet>(Scalar(1.57079632679489661923)), pselect(mid, pset1<Packet>(Scalar(0.78539816339744830962)), zero));
+    Packet morebits = pselect(big, pset1<Packet>(Scalar(6.123233995736765886130E-17)), pselect(mid, pset1<Packet>(Scalar(3.061616997868382943065E-17)), zero));
+
+    const Packet z = pmul(xr,xr);
+    Packet p = pset1<Packet>(Scalar(-8.750608600031904122785E-1));
+    p = pmadd(p, z, pset1<Packet>(Scalar(-1.615753718733365076637E1)));
+    p = pmadd(p, z, pset1<Packet>(Scalar(-7.500855792314704667340E1)));
+    p = pmadd(p, z, pset1<Packet>(Scalar(-1.228866684490136173410E2)));
+    p = pmadd(p, z, pset1<Packet>(Scalar(-6.485021904942025371773E1)));
+    Packet q = padd(z, pset1<Packet>(Scalar(2.485846490142306297962E1)));
+    q = pmadd(q, z, pset1<Packet>(Scalar(1.650270098316988542046E2)));
+    q = pmadd(q, z, pset1<Packet>(Scalar(4.328810604912902668951E2)));
+    q = pmadd(q, z, pset1<Packet>(Scalar(4.853903996359136964868E2)));
+    q = pmadd(q, z, pset1<Packet>(Scalar(1.945506571482613964425E2)));
+
+    Packet y = padd(pmadd(pmul(xr,z), pdiv(p,q), xr), morebits);
+    y = padd(y0, y);
+    return pselect(pcmp_lt(x, zero), pnegate(y), y);
+  }
+};
+
+template<typename Packet>
+struct patan_impl<Packet,float>
+{
+  static Packet run(const Packet& x)
+  {
+    const Packet one = pset1<Packet>(1.f);
+    const Packet zero = pset1<Packet>(0.f);
+    const Packet ax = pabs(x);
+    const Packet big = pcmp_lt(pset1<Packet>(2.414213562373095f), ax);
+    const Packet mid = pcmp_lt(pset1<Packet>(0.4142135623730950f), ax);
+
+    Packet xr = pselect(big, pnegate(pdiv(one, ax)), pselect(mid, pdiv(psub(ax,one), padd(ax,one)), ax));
+    Packet y0 = pselect(big, pset1<Packet>(1.5707963267948966192f), pselect(mid, pset1<Packet>(0.7853981633974483096f), zero));
+
+    const Packet z = pmul(xr,xr);
+    Packet p = pset1<Packet>(8.05374449538e-2f);
+    p = pmadd(p, z, pset1<Packet>(-1.38776856032E-1f));
+    p = pmadd(p, z, pset1<Packet>( 1.99777106478E-1f));
+    p = pmadd(p, z, pset1<Packet>(-3.33329491539E-1f));
+
+    Packet y = padd(y0, pmadd(pmul(xr,z), p, xr));
+    return pselect(pcmp_lt(x, zero), pnegate(y), y);
+  }
+};
+
+/** \internal \returns the tan of \a a (coeff-wise), which is as accurate as psin() and pcos() */
+template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
+Packet ptan(const Packet& a) { return pdiv(psin(a), pcos(a)); }
+
+template<typename Packet, typename Scalar = typename unpacket_traits<Packet>::type>
+struct pasin_impl
+{
+  // asin(x) = x + x^3 P(x^2)/Q(x^2) for |x| <= 0.625, and Pi/2 - sqrt(2z) (1 + z R(z)/S(z)) with z = 1-|x| otherwise
+  static Packet run(const Packet& x)
+  {
+    const Packet one = pset1<Packet>(Scalar(1));
+    const Packet pio4 = pset1<Packet>(Scalar(7.85398163397448309616E-1));
+    const Packet ax = pabs(x);
+
+    Packet zz = pmul(x,x);
+    Packet p = pset1<Packet>(Scalar(4.253011369004428248960E-3));
+    p = pmadd(p, zz, pset1<Packet>(Scalar(-6.019598008014123785661E-1)));
+    p = pmadd(p, zz, pset1<Packet>(Scalar(5.444622390564711410273E0)));
+    p = pmadd(p, zz, pset1<Packet>(Scalar(-1.626247967210700244449E1)));
+    p = pmadd(p, zz, pset1<Packet>(Scalar(1.956261983317594739197E1)));
+    p = pmadd(p, zz, pset1<Packet>(Scalar(-8.198089802484824371615E0)));
+    Packet q = padd(zz, pset1<Packet>(Scalar(-1.474091372988853791896E1)));
+    q = pmadd(q, zz, pset1<Packet>(Scalar(7.049610280856842141659E1)));
+    q = pmadd(q, zz, pset1<Packet>(Scalar(-1.471791292232726029859E2)));
+    q = pmadd(q, zz, pset1<Packet>(Scalar(1.395105614657485689735E2)));
+    q = pmadd(q, zz, pset1<Packet>(Scalar(-4.918853881490881290097E1)));
+    Packet small = pmadd(pmul(x,zz), pdiv(p,q), x);
+
+    zz = psub(one, ax);
+    Packet r = pset1<Packet>(Scalar(2.967721961301243206100E-3));
+    r = pmadd(r, zz, pset1<Packet>(Scalar(-5.634242780008963776856E-1)));
+    r = pmadd(r, zz, pset1<Packet>(Scalar(6.968710824104713396794E0)));
+    r = pmadd(r, zz, pset1<Packet>(Scalar(-2.556901049652824852289E1)));
+    r = pmadd(r, zz, pset1<Packet>(Scalar(2.853665548261061424989E1)));
+    Packet t = padd(zz, pset1<Packet>(Scalar(-2.194779531642920639778E1)));
+    t = pmadd(t, zz, pset1<Packet>(Scalar(1.470656354026814941758E2)));
+    t = pmadd(t, zz, pset1<Packet>(Scalar(-3.838770957603691357202E2)));
+    t = pmadd(t, zz, pset1<Packet>(Scalar(3.424398657913078477438E2)));
+    p = pmul(zz, pdiv(r,t));
+    zz = psqrt(padd(zz,zz));
+    // (Pi/4 - sqrt(2z)) - (sqrt(2z) z R(z)/S(z) - morebits) + Pi/4
+    Packet large = psub(psub(pio4, zz), psub(pmul(zz,p), pset1<Packet>(Scalar(6.123233995736765886130E-17))));
+    large = padd(large, pio4);
+    large = pselect(pcmp_lt(x, pset1<Packet>(Scalar(0))), pnegate(large), large);
+
+    return pselect(pcmp_lt(pset1<Packet>(Scalar(0.625)), ax), large, small);
+  }
+};
+
+template<typename Packet>
+struct pasin_impl<Packet,float>
+{
+  // asin(x) = x + x^3 P(x^2) for |x| <= 0.5, and Pi/2 - 2 asin(sqrt((1-|x|)/2)) otherwise
+  static Packet run(const Packet& x)
+  {
+    const Packet half = pset1<Packet>(0.5f);
+    const Packet ax = pabs(x);
+    const Packet big = pcmp_lt(half, ax);
+
+    const Packet z = pselect(big, pmul(half, psub(pset1<Packet>(1.f), ax)), pmul(ax,ax));
+    const Packet xr = pselect(big, psqrt(z), ax);
+    Packet p = pset1<Packet>(4.2163199048E-2f);
+    p = pmadd(p, z, pset1<Packet>(2.4181311049E-2f));
+    p = pmadd(p, z, pset1<Packet>(4.5470025998E-2f));
+    p = pmadd(p, z, pset1<Packet>(7.4953002686E-2f));
+    p = pmadd(p, z, pset1<Packet>(1.6666752422E-1f));
+    Packet y = pmadd(pmul(p,z), xr, xr);
+    y = pselect(big, psub(pset1<Packet>(1.5707963267948966192f), padd(y,y)), y);
+    return pselect(pcmp_lt(x, pset1<Packet>(0.f)), pnegate(y), y);
+  }
+};
+
+/** \internal \returns NaN for the coefficients of \a a out of [-1,1], and \a result elsewhere */
+template<typename Packet> EIGEN_STRONG_INLINE Packet pasin_domain(const Packet& a, const Packet& result)
+{
+  typedef typename unpacket_traits<Packet>::type Scalar;
+  return pselect(pcmp_lt(pset1<Packet>(Scalar(1)), pabs(a)), pset1<Packet>(std::numeric_limits<Scalar>::quiet_NaN()), result);
+}
+
+/** \internal \returns the arc sine of \a a (coeff-wise) */
+template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
+Packet pasin(const Packet& a) { return pasin_domain(a, pasin_impl<Packet>::run(a)); }
+
+/** \internal \returns the arc cosine of \a a (coeff-wise) */
+template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
+Packet pacos(const Packet& a)
+{
+  // acos(x) = Pi/2 - asin(x) for |x| <= 0.5, and 2 asin(sqrt((1-|x|)/2)), or Pi minus it for x < 0, otherwise
+  typedef typename unpacket_traits<Packet>::type Scalar;
+  const Packet half = pset1<Packet>(Scalar(0.5));
+  const Packet small = pcmp_le(pabs(a), half);
+  const Packet w = pasin_impl<Packet>::run(pselect(small, a, psqrt(pmul(half, psub(pset1<Packet>(Scalar(1)), pabs(a))))));
+  Packet large = padd(w,w);
+  large = pselect(pcmp_lt(a, pset1<Packet>(Scalar(0))), psub(pset1<Packet>(Scalar(3.14159265358979323846)), large), large);
+  return pasin_domain(a, pselect(small, psub(pset1<Packet>(Scalar(1.57079632679489661923)), w), large));
+}
+
+/** \internal \returns the arc tangent of \a a (coeff-wise) */
+template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
+Packet patan(const Packet& a) { return patan_impl<Packet>::run(a); }
+
+/** \internal \returns the arc tangent of \a y / \a x using the signs of both arguments to
+  * determine the quadrant (coeff-wise). As for std::atan2, the result is in [-Pi,Pi]. */
+template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
+Packet patan2(const Packet& y, const Packet& x)
+{
+  typedef typename unpacket_traits<Packet>::type Scalar;
+  const Packet zero = pset1<Packet>(Scalar(0));
+  const Packet pi = pset1<Packet>(Scalar(3.14159265358979323846));
+  const Packet pio2 = pset1<Packet>(Scalar(1.57079632679489661923));
+  const Packet y_neg = pcmp_lt(y, zero);
+
+  Packet r = patan(pdiv(y, x));
+  r = pselect(pcmp_lt(x, zero), padd(r, pselect(y_neg, pnegate(pi), pi)), r);
+  Packet on_axis = pselect(y_neg, pnegate(pio2), pselect(pcmp_eq(y, zero), zero, pio2));
+  return pselect(pcmp_eq(x, zero), on_axis, r);
+}
+
+/** \internal \returns \a x raised to the power \a y (coeff-wise), computed as exp(y*log(|x|)).
+  * Negative values of \a x give NaN, unless \a y is an integer in which case the sign is
+  * restored for odd exponents. The relative error grows like |y*log(x)| times the epsilon. */
+template<typename Packet> EIGEN_DECLARE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
+Packet ppow(const Packet& x, const Packet& y)
+{
+  typedef typename unpacket_traits<Packet>::type Scalar;
+  const Packet zero = pset1<Packet>(Scalar(0));
+  const Packet one = pset1<Packet>(Scalar(1));
+  const Packet half = pset1<Packet>(Scalar(0.5));
+  // adding and subtracting 2^(digits-1) rounds the numbers below it to an integer
+  const Packet magic = pset1<Packet>(Scalar(Scalar(1) / NumTraits<Scalar>::epsilon()));
+
+  Packet r = pexp(pmul(y, plog(pabs(x))));
+
+  const Packet ay = pabs(y);
+  const Packet exact = pcmp_lt(ay, magic);
+  const Packet ay_round = psub(padd(ay, magic), magic);
+  const Packet y_half = pmul(ay_round, half);
+  const Packet all_set = pcmp_eq(ay, ay);
+  const Packet is_int = pselect(exact, pcmp_eq(ay_round, ay), all_set);
+  const Packet is_even = pselect(exact, pcmp_eq(psub(padd(y_half, magic), magic), y_half), all_set);
+  const Packet neg_r = pselect(is_int, pselect(is_even, r, pnegate(r)), pset1<Packet>(std::numeric_limits<Scalar>::quiet_NaN()));
+  r = pselect(pcmp_lt(x, zero), neg_r, r);
+
+  const Packet at_zero = pselect(pcmp_lt(y, zero), pset1<Packet>(std::numeric_limits<Scalar>::infinity()), zero);
+  r = pselect(pcmp_eq(x, zero), at_zero, r);
+  return pselect(pcmp_eq(y, zero), one, r);
+}
+
 /***************************************************************************
 * Fast complex products (GCC generates a function call which is very slow)
 ***************************************************************************/
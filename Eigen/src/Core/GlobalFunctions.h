@@ -45,6 +45,10 @@ namespace Eigen
   EIGEN_ARRAY_DECLARE_GLOBAL_UNARY(asin,scalar_asin_op)
   EIGEN_ARRAY_DECLARE_GLOBAL_UNARY(acos,scalar_acos_op)
   EIGEN_ARRAY_DECLARE_GLOBAL_UNARY(tan,scalar_tan_op)
+  EIGEN_ARRAY_DECLARE_GLOBAL_UNARY(atan,scalar_atan_op)
+  EIGEN_ARRAY_DECLARE_GLOBAL_UNARY(tanh,scalar_tanh_op)
+  EIGEN_ARRAY_DECLARE_GLOBAL_UNARY(logistic,scalar_logistic_op)
+  EIGEN_ARRAY_DECLARE_GLOBAL_UNARY(erf,scalar_erf_op)
   EIGEN_ARRAY_DECLARE_GLOBAL_UNARY(exp,scalar_exp_op)
   EIGEN_ARRAY_DECLARE_GLOBAL_UNARY(log,scalar_log_op)
   EIGEN_ARRAY_DECLARE_GLOBAL_UNARY(abs,scalar_abs_op)
@@ -66,6 +70,19 @@ namespace Eigen
     );
   }
   
+  /**
+  * \brief Component-wise arc tangent of \a y / \a x, using the signs of both arguments to determine the quadrant.
+  **/
+  template<typename DerivedY, typename DerivedX>
+  inline const Eigen::CwiseBinaryOp<Eigen::internal::scalar_atan2_op<typename DerivedY::Scalar>, const DerivedY, const DerivedX>
+  atan2(const Eigen::ArrayBase<DerivedY>& y, const Eigen::ArrayBase<DerivedX>& x)
+  {
+    return Eigen::CwiseBinaryOp<Eigen::internal::scalar_atan2_op<typename DerivedY::Scalar>, const DerivedY, const DerivedX>(
+      y.derived(),
+      x.derived()
+    );
+  }
+
   /**
   * \brief Component-wise division of a scalar by array elements.
   **/
@@ -383,6 +383,7 @@ template<typename Derived> class MatrixBase
 /////////// SVD module ///////////
 
     JacobiSVD<PlainObject> jacobiSvd(unsigned int computationOptions = 0) const;
+    BDCSVD<PlainObject> bdcSvd(unsigned int computationOptions = 0) const;
 
     #ifdef EIGEN2_SUPPORT
     SVD<PlainObject> svd() const;
@@ -0,0 +1,324 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_PACKEDMATRIX_H
+#define EIGEN_PACKEDMATRIX_H
+
+namespace Eigen {
+
+/** \class PackedMatrix
+  * \ingroup Core_Module
+  *
+  * \brief A matrix stored in the packed format of the matrix product kernel
+  *
+  * \param MatrixType the type of the matrix being packed
+  *
+  * A matrix product copies the blocks of its left hand side into the panel format of the product kernel
+  * every time it is evaluated. When the same matrix multiplies a stream of different right hand sides,
+  * this class performs this packing once, and only the right hand sides are packed by the later products:
+  * \code
+  * PackedMatrix<MatrixXf> W = pack(A);
+  * for(...)
+  *   y.noalias() = W * x_block;
+  * \endcode
+  * The products support noalias(), +=, -=, scalar factors, and transposed or conjugated right hand sides,
+  * which must have the same scalar type. Column-major results are written directly, the other ones go
+  * through a temporary.
+  *
+  * The packed format depends on the cache sizes (see setCpuCacheSizes()) at the time the matrix is packed.
+  *
+  * \sa pack()
+  */
+
+namespace internal {
+template<typename _MatrixType>
+struct traits<PackedMatrix<_MatrixType> >
+{
+  typedef MatrixXpr XprKind;
+  typedef typename _MatrixType::Scalar Scalar;
+  typedef typename _MatrixType::Index Index;
+  typedef Dense StorageKind;
+  enum {
+    RowsAtCompileTime = _MatrixType::RowsAtCompileTime,
+    ColsAtCompileTime = _MatrixType::ColsAtCompileTime,
+    MaxRowsAtCompileTime = _MatrixType::MaxRowsAtCompileTime,
+    MaxColsAtCompileTime = _MatrixType::MaxColsAtCompileTime,
+    Flags = 0,
+    CoeffReadCost = 0
+  };
+};
+
+/** \internal \returns the number of coefficients reserved for a packed \a rows x \a depth block, such that the
+  * next block remains aligned */
+template<typename Scalar, typename Index> inline Index packed_block_size(Index depth, Index rows)
+{
+  const Index align = (std::max)(Index(1), Index(EIGEN_ALIGN_BYTES/sizeof(Scalar)));
+  return (depth*rows + align - 1) / align * align;
+}
+
+/* The blocking algorithm of general_matrix_matrix_product, minus the packing of the lhs:
+ * the kc x mc blocks of the lhs are stored one after the other in \a blockA, in the order they are used. */
+template<typename Scalar, typename Index, int RhsStorageOrder, bool ConjugateRhs>
+struct packed_matrix_product
+{
+  static void run(Index rows, Index cols, Index depth,
+                  const Scalar* blockA, Index kc, Index mc,
+                  const Scalar* _rhs, Index rhsStride,
+                  Scalar* res, Index resStride,
+                  Scalar alpha)
+  {
+    const_blas_data_mapper<Scalar, Index, RhsStorageOrder> rhs(_rhs,rhsStride);
+
+    typedef gebp_traits<Scalar,Scalar> Traits;
+
+    gemm_pack_rhs<Scalar, Index, Traits::nr, RhsStorageOrder> pack_rhs;
+    gebp_kernel<Scalar, Scalar, Index, Traits::mr, Traits::nr, false, ConjugateRhs> gebp;
+
+    std::size_t sizeB = kc*cols;
+    std::size_t sizeW = kc*Traits::WorkSpaceFactor;
+    ei_declare_aligned_stack_constructed_variable(Scalar, blockB, sizeB, 0);
+    ei_declare_aligned_stack_constructed_variable(Scalar, blockW, sizeW, 0);
+
+    for(Index k2=0; k2<depth; k2+=kc)
+    {
+      const Index actual_kc = (std::min)(k2+kc,depth)-k2;
+
+      pack_rhs(blockB, &rhs(k2,0), rhsStride, actual_kc, cols);
+
+      for(Index i2=0; i2<rows; i2+=mc)
+      {
+        const Index actual_mc = (std::min)(i2+mc,rows)-i2;
+        gebp(res+i2, resStride, blockA, blockB, actual_mc, actual_kc, cols, alpha, -1, -1, 0, 0, blockW);
+        blockA += packed_block_size<Scalar>(actual_kc, actual_mc);
+      }
+    }
+  }
+};
+
+template<typename Lhs, typename Rhs>
+struct traits<PackedProduct<Lhs,Rhs> >
+ : traits<ProductBase<PackedProduct<Lhs,Rhs>, Lhs, Rhs> >
+{};
+
+} // end namespace internal
+
+template<typename _MatrixType> class PackedMatrix
+  : public EigenBase<PackedMatrix<_MatrixType> >
+{
+  public:
+
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::Index Index;
+    typedef const PackedMatrix& Nested;
+    typedef PackedMatrix PlainObject;
+
+    enum {
+      RowsAtCompileTime = MatrixType::RowsAtCompileTime,
+      ColsAtCompileTime = MatrixType::ColsAtCompileTime,
+      MaxRowsAtCompileTime = MatrixType::MaxRowsAtCompileTime,
+      MaxColsAtCompileTime = MatrixType::MaxColsAtCompileTime,
+      IsVectorAtCompileTime = 0,
+      Flags = 0
+    };
+
+    /** Default constructor, the matrix must be packed with compute() before it is used. */
+    PackedMatrix() : m_rows(0), m_cols(0), m_kc(0), m_mc(0) {}
+
+    /** Packs the matrix \a matrix, see compute() */
+    template<typename InputType>
+    explicit PackedMatrix(const MatrixBase<InputType>& matrix) { compute(matrix); }
+
+    /** Packs the matrix \a matrix, which may be scaled, conjugated or transposed. */
+    template<typename InputType>
+    PackedMatrix& compute(const MatrixBase<InputType>& matrix)
+    {
+      EIGEN_STATIC_ASSERT((internal::is_same<Scalar,typename InputType::Scalar>::value),
+        YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+
+      typedef internal::blas_traits<InputType> BlasTraits;
+      typedef typename BlasTraits::DirectLinearAccessType ActualInputType;
+      typedef typename internal::remove_all<ActualInputType>::type _ActualInputType;
+      // the packing expects a unit inner stride, which is not the case of all the vectors
+      typedef typename internal::conditional<int(internal::inner_stride_at_compile_time<_ActualInputType>::ret)==1,
+        ActualInputType, typename _ActualInputType::PlainObject>::type UnitStrideInputType;
+      typedef typename internal::remove_all<UnitStrideInputType>::type _UnitStrideInputType;
+      typedef internal::gebp_traits<Scalar,Scalar> Traits;
+      enum { StorageOrder = (_UnitStrideInputType::Flags&RowMajorBit) ? RowMajor : ColMajor };
+
+      typename internal::add_const_on_value_type<UnitStrideInputType>::type mat
+        = BlasTraits::extract(matrix.derived());
+      const Scalar scale = BlasTraits::extractScalarFactor(matrix.derived());
+
+      m_rows = mat.rows();
+      m_cols = mat.cols();
+      m_kc = m_cols;
+      m_mc = m_rows;
+      Index nc = 0;
+      internal::computeProductBlockingSizes<Scalar,Scalar>(m_kc, m_mc, nc);
+      m_mc = (std::max)(m_mc, Index(1));
+
+      Index size = 0;
+      for(Index k2=0; k2<m_cols; k2+=m_kc)
+        for(Index i2=0; i2<m_rows; i2+=m_mc)
+          size += internal::packed_block_size<Scalar>((std::min)(k2+m_kc,m_cols)-k2, (std::min)(i2+m_mc,m_rows)-i2);
+      m_packed.resize(size);
+      if(size==0)
+        return *this;
+
+      internal::const_blas_data_mapper<Scalar, Index, StorageOrder> lhs(&mat.coeffRef(0,0), mat.outerStride());
+      internal::gemm_pack_lhs<Scalar, Index, Traits::mr, Traits::LhsProgress, StorageOrder,
+                              bool(BlasTraits::NeedToConjugate)> pack_lhs;
+
+      Scalar* blockA = m_packed.data();
+      for(Index k2=0; k2<m_cols; k2+=m_kc)
+      {
+        const Index actual_kc = (std::min)(k2+m_kc,m_cols)-k2;
+        for(Index i2=0; i2<m_rows; i2+=m_mc)
+        {
+          const Index actual_mc = (std::min)(i2+m_mc,m_rows)-i2;
+          pack_lhs(blockA, &lhs(i2,k2), mat.outerStride(), actual_kc, actual_mc);
+          if(scale!=Scalar(1))
+            Map<Matrix<Scalar,Dynamic,1> >(blockA, actual_kc*actual_mc) *= scale;
+          blockA += internal::packed_block_size<Scalar>(actual_kc, actual_mc);
+        }
+      }
+      return *this;
+    }
+
+    inline Index rows() const { return m_rows; }
+    inline Index cols() const { return m_cols; }
+
+    /** \internal \returns the packed blocks */
+    const Scalar* data() const { return m_packed.data(); }
+    /** \internal \returns the depth of the packed blocks */
+    Index blockDepth() const { return m_kc; }
+    /** \internal \returns the number of rows of the packed blocks */
+    Index blockRows() const { return m_mc; }
+
+    /** \returns an expression of the product of the packed matrix by \a rhs */
+    template<typename OtherDerived>
+    const PackedProduct<PackedMatrix,OtherDerived> operator*(const MatrixBase<OtherDerived>& rhs) const
+    {
+      return PackedProduct<PackedMatrix,OtherDerived>(*this, rhs.derived());
+    }
+
+  protected:
+    Matrix<Scalar,Dynamic,1> m_packed;
+    Index m_rows;
+    Index m_cols;
+    Index m_kc;
+    Index m_mc;
+};
+
+/** \returns the matrix \a matrix packed for repeated products
+  *
+  * \sa class PackedMatrix */
+template<typename Derived>
+PackedMatrix<typename Derived::PlainObject> pack(const MatrixBase<Derived>& matrix)
+{
+  return PackedMatrix<typename Derived::PlainObject>(matrix);
+}
+
+template<typename Lhs, typename Rhs>
+class PackedProduct
+  : public ProductBase<PackedProduct<Lhs,Rhs>, Lhs, Rhs>
+{
+  public:
+    EIGEN_PRODUCT_PUBLIC_INTERFACE(PackedProduct)
+
+    PackedProduct(const Lhs& lhs, const Rhs& rhs) : Base(lhs,rhs)
+    {
+      EIGEN_STATIC_ASSERT((internal::is_same<typename Lhs::Scalar,typename Rhs::Scalar>::value),
+        YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+    }
+
+    // The columns of the result only depend on the respective columns of the rhs, so that they are computed by slices
+    // in parallel, each slice packing its own part of the rhs.
+    template<typename ProductImpl, typename RhsType> struct SliceJob
+    {
+      SliceJob(const Lhs& lhs, const RhsType& rhs, Scalar* res, Index resStride, const Scalar& alpha, Index jobs)
+        : m_lhs(lhs), m_rhs(rhs), m_res(res), m_resStride(resStride), m_alpha(alpha), m_jobs(jobs)
+      {}
+
+      void operator()(int i) const
+      {
+        Index start, length;
+        internal::parallel_chunk(m_rhs.cols(), m_jobs, Index(4), Index(i), start, length);
+        ProductImpl::run(m_lhs.rows(), length, m_lhs.cols(),
+                         m_lhs.data(), m_lhs.blockDepth(), m_lhs.blockRows(),
+                         &m_rhs.coeffRef(0,start), m_rhs.outerStride(),
+                         m_res+start*m_resStride, m_resStride,
+                         m_alpha);
+      }
+
+      const Lhs& m_lhs;
+      const RhsType& m_rhs;
+      Scalar* m_res;
+      Index m_resStride;
+      Scalar m_alpha;
+      Index m_jobs;
+    };
+
+    template<typename Dest> void scaleAndAddTo(Dest& dst, const Scalar& alpha) const
+    {
+      eigen_assert(dst.rows()==m_lhs.rows() && dst.cols()==m_rhs.cols());
+      enum {
+        DirectDest = (int(Dest::Flags)&DirectAccessBit) && !(int(Dest::Flags)&RowMajorBit)
+                  && int(internal::inner_stride_at_compile_time<Dest>::ret)==1
+      };
+      scaleAndAddTo(dst, alpha, typename internal::conditional<bool(DirectDest),internal::true_type,internal::false_type>::type());
+    }
+
+  protected:
+
+    template<typename Dest> void scaleAndAddTo(Dest& dst, const Scalar& alpha, internal::false_type) const
+    {
+      Matrix<Scalar,Dynamic,Dynamic,ColMajor> res = Matrix<Scalar,Dynamic,Dynamic,ColMajor>::Zero(dst.rows(), dst.cols());
+      scaleAndAddTo(res, alpha, internal::true_type());
+      dst += res;
+    }
+
+    template<typename Dest> void scaleAndAddTo(Dest& dst, const Scalar& alpha, internal::true_type) const
+    {
+      // the rhs is packed as a matrix with unit inner stride, which is not the case of all the vectors
+      typedef typename internal::conditional<int(internal::inner_stride_at_compile_time<_ActualRhsType>::ret)==1,
+        ActualRhsType, typename _ActualRhsType::PlainObject>::type UnitStrideRhsType;
+      typedef typename internal::remove_all<UnitStrideRhsType>::type _UnitStrideRhsType;
+      typename internal::add_const_on_value_type<UnitStrideRhsType>::type rhs = RhsBlasTraits::extract(m_rhs);
+
+      if(m_lhs.rows()==0 || m_lhs.cols()==0 || rhs.cols()==0)
+        return;
+
+      Scalar actualAlpha = alpha * RhsBlasTraits::extractScalarFactor(m_rhs);
+
+      typedef internal::packed_matrix_product<Scalar, Index,
+        (_UnitStrideRhsType::Flags&RowMajorBit) ? RowMajor : ColMajor, bool(RhsBlasTraits::NeedToConjugate)> ProductImpl;
+
+      Index threads = internal::parallel_level3_threads(double(m_lhs.rows())*double(m_lhs.cols())*double(rhs.cols()),
+                                                        rhs.cols());
+      if(threads>1)
+      {
+        internal::parallel_for(SliceJob<ProductImpl,_UnitStrideRhsType>(m_lhs, rhs, &dst.coeffRef(0,0), dst.outerStride(), actualAlpha, threads),
+                               int(threads));
+        return;
+      }
+
+      ProductImpl::run(m_lhs.rows(), rhs.cols(), m_lhs.cols(),
+                       m_lhs.data(), m_lhs.blockDepth(), m_lhs.blockRows(),
+                       &rhs.coeffRef(0,0), rhs.outerStride(),
+                       &dst.coeffRef(0,0), dst.outerStride(),
+                       actualAlpha);
+    }
+
+  private:
+    PackedProduct& operator=(const PackedProduct&);
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_PACKEDMATRIX_H
@@ -178,14 +178,15 @@ class PlainObjectBase : public internal::dense_xpr_base<Derived>::type
       return internal::ploadt<PacketScalar, LoadMode>
                (m_storage.data() + (Flags & RowMajorBit
                                    ? colId + rowId * m_storage.cols()
-                                   : rowId + colId * m_storage.rows()));
+                                   : rowId + colId * m_storage.rows()),
+                Flags & RowMajorBit ? m_storage.cols() - colId : m_storage.rows() - rowId);
     }
 
     /** \internal */
     template<int LoadMode>
     EIGEN_STRONG_INLINE PacketScalar packet(Index index) const
     {
-      return internal::ploadt<PacketScalar, LoadMode>(m_storage.data() + index);
+      return internal::ploadt<PacketScalar, LoadMode>(m_storage.data() + index, this->size() - index);
     }
 
     /** \internal */
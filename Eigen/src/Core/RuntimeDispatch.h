@@ -0,0 +1,280 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_RUNTIME_DISPATCH_H
+#define EIGEN_RUNTIME_DISPATCH_H
+
+namespace Eigen {
+
+namespace internal {
+
+/**********************************************************************
+* This file forwards the general and triangular matrix products, the
+* triangular solvers and the vectorized math functions on float and
+* double to the kernels compiled for the best instruction set of the
+* running CPU, see EIGEN_RUNTIME_DISPATCH. This is implemented via
+* partial specialization of the respective run(..) methods. When no
+* kernel has been registered, the builtin implementations are used.
+**********************************************************************/
+
+/** \internal \returns the highest SimdLevel the runtime dispatch is allowed to select */
+inline int& runtime_dispatch_max_level()
+{
+  static int level = SimdLevelAVX512;
+  return level;
+}
+
+/** \internal \returns the registered kernels of the highest instruction set supported by the CPU,
+  * or a null pointer if there is none */
+inline const eigen_runtime_dispatch::table* runtime_dispatch_table()
+{
+  static const int cpu_level = querySimdLevel();
+  for(int level = (std::min)(cpu_level, runtime_dispatch_max_level()); level>=0; --level)
+    if(eigen_runtime_dispatch::registered_table(level))
+      return eigen_runtime_dispatch::registered_table(level);
+  return 0;
+}
+
+template<typename Scalar> const eigen_runtime_dispatch::kernels<Scalar>* runtime_dispatch_kernels();
+
+template<> inline const eigen_runtime_dispatch::kernels<float>* runtime_dispatch_kernels<float>()
+{
+  const eigen_runtime_dispatch::table* table = runtime_dispatch_table();
+  return table ? &table->single_precision : 0;
+}
+
+template<> inline const eigen_runtime_dispatch::kernels<double>* runtime_dispatch_kernels<double>()
+{
+  const eigen_runtime_dispatch::table* table = runtime_dispatch_table();
+  return table ? &table->double_precision : 0;
+}
+
+// gemm specialization: the dispatched kernels pack their own operands, so in a parallel product
+// each thread simply computes its own slice of the result and the shared blocking is ignored.
+
+#define EIGEN_RUNTIME_DISPATCH_GEMM(SCALAR) \
+template<typename Index, int LhsStorageOrder, bool ConjugateLhs, int RhsStorageOrder, bool ConjugateRhs> \
+struct general_matrix_matrix_product<Index,SCALAR,LhsStorageOrder,ConjugateLhs,SCALAR,RhsStorageOrder,ConjugateRhs,ColMajor,Specialized> \
+{ \
+static void run(Index rows, Index cols, Index depth, \
+  const SCALAR* lhs, Index lhsStride, \
+  const SCALAR* rhs, Index rhsStride, \
+  SCALAR* res, Index resStride, \
+  SCALAR alpha, \
+  level3_blocking<SCALAR,SCALAR>& blocking, \
+  GemmParallelInfo<Index>* info = 0, Index tid = 0, Index threads = 1) \
+{ \
+  const eigen_runtime_dispatch::kernels<SCALAR>* kernels = runtime_dispatch_kernels<SCALAR>(); \
+  if(kernels==0) \
+    general_matrix_matrix_product<Index,SCALAR,LhsStorageOrder,ConjugateLhs,SCALAR,RhsStorageOrder,ConjugateRhs,ColMajor,BuiltIn>::run( \
+      rows, cols, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha, blocking, info, tid, threads); \
+  else \
+    kernels->gemm(LhsStorageOrder, RhsStorageOrder, rows, cols, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha); \
+} \
+};
+
+// gemv specialization
+
+#define EIGEN_RUNTIME_DISPATCH_GEMV(SCALAR,STORAGEORDER) \
+template<typename Index, bool ConjugateLhs, bool ConjugateRhs> \
+struct general_matrix_vector_product<Index,SCALAR,STORAGEORDER,ConjugateLhs,SCALAR,ConjugateRhs,Specialized> \
+{ \
+static void run( \
+  Index rows, Index cols, \
+  const SCALAR* lhs, Index lhsStride, \
+  const SCALAR* rhs, Index rhsIncr, \
+  SCALAR* res, Index resIncr, SCALAR alpha) \
+{ \
+  const eigen_runtime_dispatch::kernels<SCALAR>* kernels = runtime_dispatch_kernels<SCALAR>(); \
+  if(kernels==0) \
+    general_matrix_vector_product<Index,SCALAR,STORAGEORDER,ConjugateLhs,SCALAR,ConjugateRhs,BuiltIn>::run( \
+      rows, cols, lhs, lhsStride, rhs, rhsIncr, res, resIncr, alpha); \
+  else \
+    kernels->gemv(STORAGEORDER, rows, cols, lhs, lhsStride, rhs, rhsIncr, res, resIncr, alpha); \
+} \
+};
+
+// trmm specialization
+
+#define EIGEN_RUNTIME_DISPATCH_TRMM(SCALAR,LHSISTRIANGULAR) \
+template<typename Index, int Mode, int LhsStorageOrder, bool ConjugateLhs, int RhsStorageOrder, bool ConjugateRhs> \
+struct product_triangular_matrix_matrix<SCALAR,Index,Mode,LHSISTRIANGULAR, \
+                                        LhsStorageOrder,ConjugateLhs,RhsStorageOrder,ConjugateRhs,ColMajor,Specialized> \
+{ \
+static void run( \
+  Index rows, Index cols, Index depth, \
+  const SCALAR* lhs, Index lhsStride, \
+  const SCALAR* rhs, Index rhsStride, \
+  SCALAR* res, Index resStride, \
+  const SCALAR& alpha, level3_blocking<SCALAR,SCALAR>& blocking) \
+{ \
+  const eigen_runtime_dispatch::kernels<SCALAR>* kernels = runtime_dispatch_kernels<SCALAR>(); \
+  if(kernels==0) \
+    product_triangular_matrix_matrix<SCALAR,Index,Mode,LHSISTRIANGULAR, \
+                                     LhsStorageOrder,ConjugateLhs,RhsStorageOrder,ConjugateRhs,ColMajor,BuiltIn>::run( \
+      rows, cols, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha, blocking); \
+  else \
+    kernels->trmm(Mode, LHSISTRIANGULAR, LhsStorageOrder, RhsStorageOrder, rows, cols, depth, \
+                  lhs, lhsStride, rhs, rhsStride, res, resStride, alpha); \
+} \
+};
+
+// trsm specialization
+
+#define EIGEN_RUNTIME_DISPATCH_TRSM(SCALAR,SIDE) \
+template<typename Index, int Mode, bool Conjugate, int TriStorageOrder> \
+struct triangular_solve_matrix<SCALAR,Index,SIDE,Mode,Conjugate,TriStorageOrder,ColMajor,Specialized> \
+{ \
+static void run( \
+  Index size, Index otherSize, \
+  const SCALAR* tri, Index triStride, \
+  SCALAR* other, Index otherStride, \
+  level3_blocking<SCALAR,SCALAR>& blocking) \
+{ \
+  const eigen_runtime_dispatch::kernels<SCALAR>* kernels = runtime_dispatch_kernels<SCALAR>(); \
+  if(kernels==0) \
+    triangular_solve_matrix<SCALAR,Index,SIDE,Mode,Conjugate,TriStorageOrder,ColMajor,BuiltIn>::run( \
+      size, otherSize, tri, triStride, other, otherStride, blocking); \
+  else \
+    kernels->trsm(SIDE, Mode, TriStorageOrder, size, otherSize, tri, triStride, other, otherStride); \
+} \
+};
+
+#define EIGEN_RUNTIME_DISPATCH_PRODUCTS(SCALAR) \
+  EIGEN_RUNTIME_DISPATCH_GEMM(SCALAR) \
+  EIGEN_RUNTIME_DISPATCH_GEMV(SCALAR,ColMajor) \
+  EIGEN_RUNTIME_DISPATCH_GEMV(SCALAR,RowMajor) \
+  EIGEN_RUNTIME_DISPATCH_TRMM(SCALAR,true) \
+  EIGEN_RUNTIME_DISPATCH_TRMM(SCALAR,false) \
+  EIGEN_RUNTIME_DISPATCH_TRSM(SCALAR,OnTheLeft) \
+  EIGEN_RUNTIME_DISPATCH_TRSM(SCALAR,OnTheRight)
+
+EIGEN_RUNTIME_DISPATCH_PRODUCTS(float)
+EIGEN_RUNTIME_DISPATCH_PRODUCTS(double)
+
+// vectorized math functions, this follows the VML support of Assign_MKL.h
+
+#ifndef EIGEN_RUNTIME_DISPATCH_MATH_THRESHOLD
+#define EIGEN_RUNTIME_DISPATCH_MATH_THRESHOLD 32
+#endif
+
+template<typename Op> struct runtime_dispatch_math_op
+{ enum { Value = -1 }; };
+
+#define EIGEN_RUNTIME_DISPATCH_MATH_OP(EIGENOP, OP) \
+  template<> struct runtime_dispatch_math_op< scalar_##EIGENOP##_op<float> >  { enum { Value = eigen_runtime_dispatch::OP }; }; \
+  template<> struct runtime_dispatch_math_op< scalar_##EIGENOP##_op<double> > { enum { Value = eigen_runtime_dispatch::OP }; };
+
+EIGEN_RUNTIME_DISPATCH_MATH_OP(exp,      Exp)
+EIGEN_RUNTIME_DISPATCH_MATH_OP(log,      Log)
+EIGEN_RUNTIME_DISPATCH_MATH_OP(sin,      Sin)
+EIGEN_RUNTIME_DISPATCH_MATH_OP(cos,      Cos)
+EIGEN_RUNTIME_DISPATCH_MATH_OP(sqrt,     Sqrt)
+EIGEN_RUNTIME_DISPATCH_MATH_OP(tanh,     Tanh)
+EIGEN_RUNTIME_DISPATCH_MATH_OP(logistic, Logistic)
+EIGEN_RUNTIME_DISPATCH_MATH_OP(erf,      Erf)
+EIGEN_RUNTIME_DISPATCH_MATH_OP(atan,     Atan)
+
+template<typename Dst, typename Src, typename UnaryOp>
+class runtime_dispatch_assign_traits
+{
+  private:
+    enum {
+      DstHasDirectAccess = Dst::Flags & DirectAccessBit,
+      SrcHasDirectAccess = Src::Flags & DirectAccessBit,
+
+      StorageOrdersAgree = (int(Dst::IsRowMajor) == int(Src::IsRowMajor)),
+      InnerMaxSize  = int(Dst::IsVectorAtCompileTime) ? int(Dst::MaxSizeAtCompileTime)
+                    : int(Dst::Flags)&RowMajorBit ? int(Dst::MaxColsAtCompileTime)
+                    : int(Dst::MaxRowsAtCompileTime),
+      MaxSizeAtCompileTime = Dst::SizeAtCompileTime,
+
+      MightDispatch = runtime_dispatch_math_op<UnaryOp>::Value>=0 && StorageOrdersAgree && DstHasDirectAccess && SrcHasDirectAccess
+                   && Src::InnerStrideAtCompileTime==1 && Dst::InnerStrideAtCompileTime==1,
+      MightLinearize = MightDispatch && (int(Dst::Flags) & int(Src::Flags) & LinearAccessBit),
+      DispatchSize = MightLinearize ? MaxSizeAtCompileTime : InnerMaxSize,
+      LargeEnough = DispatchSize==Dynamic || DispatchSize>=EIGEN_RUNTIME_DISPATCH_MATH_THRESHOLD,
+      MayDispatch = MightDispatch && LargeEnough,
+      MayLinearize = MayDispatch && MightLinearize
+    };
+  public:
+    enum {
+      Traversal = MayLinearize ? LinearVectorizedTraversal
+                : MayDispatch ? InnerVectorizedTraversal
+                : DefaultTraversal
+    };
+};
+
+template<typename Derived1, typename Derived2, typename UnaryOp, int Traversal, int Unrolling,
+         int DispatchTraversal = runtime_dispatch_assign_traits<Derived1, Derived2, UnaryOp>::Traversal >
+struct runtime_dispatch_assign_impl
+  : assign_impl<Derived1, Eigen::CwiseUnaryOp<UnaryOp, Derived2>,Traversal,Unrolling,BuiltIn>
+{
+};
+
+template<typename Derived1, typename Derived2, typename UnaryOp, int Traversal, int Unrolling>
+struct runtime_dispatch_assign_impl<Derived1, Derived2, UnaryOp, Traversal, Unrolling, InnerVectorizedTraversal>
+{
+  typedef typename Derived1::Scalar Scalar;
+  typedef typename Derived1::Index Index;
+  static inline void run(Derived1& dst, const CwiseUnaryOp<UnaryOp, Derived2>& src)
+  {
+    const eigen_runtime_dispatch::kernels<Scalar>* kernels = runtime_dispatch_kernels<Scalar>();
+    if(kernels==0)
+    {
+      assign_impl<Derived1,Eigen::CwiseUnaryOp<UnaryOp, Derived2>,Traversal,Unrolling,BuiltIn>::run(dst,src);
+      return;
+    }
+    const Index innerSize = dst.innerSize();
+    const Index outerSize = dst.outerSize();
+    for(Index outer = 0; outer < outerSize; ++outer) {
+      const Scalar *src_ptr = src.nestedExpression().data() + outer * src.nestedExpression().outerStride();
+      Scalar *dst_ptr = dst.data() + outer * dst.outerStride();
+      kernels->math(runtime_dispatch_math_op<UnaryOp>::Value, innerSize, src_ptr, dst_ptr);
+    }
+  }
+};
+
+template<typename Derived1, typename Derived2, typename UnaryOp, int Traversal, int Unrolling>
+struct runtime_dispatch_assign_impl<Derived1, Derived2, UnaryOp, Traversal, Unrolling, LinearVectorizedTraversal>
+{
+  typedef typename Derived1::Scalar Scalar;
+  static inline void run(Derived1& dst, const CwiseUnaryOp<UnaryOp, Derived2>& src)
+  {
+    const eigen_runtime_dispatch::kernels<Scalar>* kernels = runtime_dispatch_kernels<Scalar>();
+    if(kernels==0)
+      assign_impl<Derived1,Eigen::CwiseUnaryOp<UnaryOp, Derived2>,Traversal,Unrolling,BuiltIn>::run(dst,src);
+    else
+      kernels->math(runtime_dispatch_math_op<UnaryOp>::Value, dst.size(), src.nestedExpression().data(), dst.data());
+  }
+};
+
+#define EIGEN_RUNTIME_DISPATCH_SPECIALIZE_ASSIGN(TRAVERSAL,UNROLLING) \
+  template<typename Derived1, typename Derived2, typename UnaryOp> \
+  struct assign_impl<Derived1, Eigen::CwiseUnaryOp<UnaryOp, Derived2>, TRAVERSAL, UNROLLING, Specialized>  {  \
+    static inline void run(Derived1 &dst, const Eigen::CwiseUnaryOp<UnaryOp, Derived2> &src) { \
+      runtime_dispatch_assign_impl<Derived1,Derived2,UnaryOp,TRAVERSAL,UNROLLING>::run(dst, src); \
+    } \
+  };
+
+EIGEN_RUNTIME_DISPATCH_SPECIALIZE_ASSIGN(DefaultTraversal,NoUnrolling)
+EIGEN_RUNTIME_DISPATCH_SPECIALIZE_ASSIGN(DefaultTraversal,CompleteUnrolling)
+EIGEN_RUNTIME_DISPATCH_SPECIALIZE_ASSIGN(DefaultTraversal,InnerUnrolling)
+EIGEN_RUNTIME_DISPATCH_SPECIALIZE_ASSIGN(LinearTraversal,NoUnrolling)
+EIGEN_RUNTIME_DISPATCH_SPECIALIZE_ASSIGN(LinearTraversal,CompleteUnrolling)
+EIGEN_RUNTIME_DISPATCH_SPECIALIZE_ASSIGN(InnerVectorizedTraversal,NoUnrolling)
+EIGEN_RUNTIME_DISPATCH_SPECIALIZE_ASSIGN(InnerVectorizedTraversal,CompleteUnrolling)
+EIGEN_RUNTIME_DISPATCH_SPECIALIZE_ASSIGN(InnerVectorizedTraversal,InnerUnrolling)
+EIGEN_RUNTIME_DISPATCH_SPECIALIZE_ASSIGN(LinearVectorizedTraversal,CompleteUnrolling)
+EIGEN_RUNTIME_DISPATCH_SPECIALIZE_ASSIGN(LinearVectorizedTraversal,NoUnrolling)
+EIGEN_RUNTIME_DISPATCH_SPECIALIZE_ASSIGN(SliceVectorizedTraversal,NoUnrolling)
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_RUNTIME_DISPATCH_H
@@ -0,0 +1,217 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_RUNTIME_DISPATCH_KERNELS_H
+#define EIGEN_RUNTIME_DISPATCH_KERNELS_H
+
+/**********************************************************************
+* This file defines the kernels called by the translation units compiled
+* with EIGEN_RUNTIME_DISPATCH, for the instruction set this translation
+* unit is compiled for, and registers them at startup. It is included
+* by Eigen/Core when EIGEN_RUNTIME_DISPATCH_KERNELS is defined.
+**********************************************************************/
+
+#if defined EIGEN_VECTORIZE_AVX512
+  #define EIGEN_RUNTIME_DISPATCH_LEVEL SimdLevelAVX512
+  #define EIGEN_RUNTIME_DISPATCH_REGISTER register_kernels_avx512
+#elif defined(EIGEN_VECTORIZE_AVX2) && defined(EIGEN_VECTORIZE_FMA)
+  #define EIGEN_RUNTIME_DISPATCH_LEVEL SimdLevelAVX2
+  #define EIGEN_RUNTIME_DISPATCH_REGISTER register_kernels_avx2
+#elif defined EIGEN_VECTORIZE_AVX
+  #define EIGEN_RUNTIME_DISPATCH_LEVEL SimdLevelAVX
+  #define EIGEN_RUNTIME_DISPATCH_REGISTER register_kernels_avx
+#elif defined EIGEN_VECTORIZE_SSE4_2
+  #define EIGEN_RUNTIME_DISPATCH_LEVEL SimdLevelSSE4_2
+  #define EIGEN_RUNTIME_DISPATCH_REGISTER register_kernels_sse4_2
+#else
+  #define EIGEN_RUNTIME_DISPATCH_LEVEL SimdLevelSSE2
+  #define EIGEN_RUNTIME_DISPATCH_REGISTER register_kernels_sse2
+#endif
+
+namespace Eigen {
+
+namespace internal {
+
+template<typename Scalar> struct runtime_dispatch_kernels_impl
+{
+  typedef eigen_runtime_dispatch::index Index;
+
+  template<int LhsStorageOrder, int RhsStorageOrder>
+  static void gemm_run(Index rows, Index cols, Index depth,
+                       const Scalar* lhs, Index lhsStride, const Scalar* rhs, Index rhsStride,
+                       Scalar* res, Index resStride, Scalar alpha)
+  {
+    gemm_blocking_space<ColMajor,Scalar,Scalar,Dynamic,Dynamic,Dynamic> blocking(rows, cols, depth);
+    general_matrix_matrix_product<Index,Scalar,LhsStorageOrder,false,Scalar,RhsStorageOrder,false,ColMajor>
+      ::run(rows, cols, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha, blocking);
+  }
+
+  static void gemm(int lhsStorageOrder, int rhsStorageOrder, Index rows, Index cols, Index depth,
+                   const Scalar* lhs, Index lhsStride, const Scalar* rhs, Index rhsStride,
+                   Scalar* res, Index resStride, Scalar alpha)
+  {
+    if(lhsStorageOrder==ColMajor)
+      (rhsStorageOrder==ColMajor ? &gemm_run<ColMajor,ColMajor> : &gemm_run<ColMajor,RowMajor>)
+        (rows, cols, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha);
+    else
+      (rhsStorageOrder==ColMajor ? &gemm_run<RowMajor,ColMajor> : &gemm_run<RowMajor,RowMajor>)
+        (rows, cols, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha);
+  }
+
+  static void gemv(int lhsStorageOrder, Index rows, Index cols, const Scalar* lhs, Index lhsStride,
+                   const Scalar* rhs, Index rhsIncr, Scalar* res, Index resIncr, Scalar alpha)
+  {
+    if(lhsStorageOrder==ColMajor)
+      general_matrix_vector_product<Index,Scalar,ColMajor,false,Scalar,false>
+        ::run(rows, cols, lhs, lhsStride, rhs, rhsIncr, res, resIncr, alpha);
+    else
+      general_matrix_vector_product<Index,Scalar,RowMajor,false,Scalar,false>
+        ::run(rows, cols, lhs, lhsStride, rhs, rhsIncr, res, resIncr, alpha);
+  }
+
+  typedef void (*trmm_func)(Index, Index, Index, const Scalar*, Index, const Scalar*, Index, Scalar*, Index, Scalar);
+
+  template<int Mode, bool LhsIsTriangular, int LhsStorageOrder, int RhsStorageOrder>
+  static void trmm_run(Index rows, Index cols, Index depth,
+                       const Scalar* lhs, Index lhsStride, const Scalar* rhs, Index rhsStride,
+                       Scalar* res, Index resStride, Scalar alpha)
+  {
+    gemm_blocking_space<ColMajor,Scalar,Scalar,Dynamic,Dynamic,Dynamic,4> blocking(rows, cols, depth);
+    product_triangular_matrix_matrix<Scalar,Index,Mode,LhsIsTriangular,LhsStorageOrder,false,RhsStorageOrder,false,ColMajor>
+      ::run(rows, cols, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha, blocking);
+  }
+
+  template<int Mode, bool LhsIsTriangular>
+  static trmm_func trmm_select(int lhsStorageOrder, int rhsStorageOrder)
+  {
+    if(lhsStorageOrder==ColMajor)
+      return rhsStorageOrder==ColMajor ? &trmm_run<Mode,LhsIsTriangular,ColMajor,ColMajor>
+                                       : &trmm_run<Mode,LhsIsTriangular,ColMajor,RowMajor>;
+    else
+      return rhsStorageOrder==ColMajor ? &trmm_run<Mode,LhsIsTriangular,RowMajor,ColMajor>
+                                       : &trmm_run<Mode,LhsIsTriangular,RowMajor,RowMajor>;
+  }
+
+  template<int Mode>
+  static trmm_func trmm_select(bool lhsIsTriangular, int lhsStorageOrder, int rhsStorageOrder)
+  {
+    return lhsIsTriangular ? trmm_select<Mode,true>(lhsStorageOrder, rhsStorageOrder)
+                           : trmm_select<Mode,false>(lhsStorageOrder, rhsStorageOrder);
+  }
+
+  static void trmm(int mode, bool lhsIsTriangular, int lhsStorageOrder, int rhsStorageOrder, Index rows, Index cols,
+                   Index depth, const Scalar* lhs, Index lhsStride, const Scalar* rhs, Index rhsStride,
+                   Scalar* res, Index resStride, Scalar alpha)
+  {
+    trmm_func func = 0;
+    switch(mode)
+    {
+      case Lower:         func = trmm_select<Lower>(lhsIsTriangular, lhsStorageOrder, rhsStorageOrder); break;
+      case Upper:         func = trmm_select<Upper>(lhsIsTriangular, lhsStorageOrder, rhsStorageOrder); break;
+      case UnitLower:     func = trmm_select<UnitLower>(lhsIsTriangular, lhsStorageOrder, rhsStorageOrder); break;
+      case UnitUpper:     func = trmm_select<UnitUpper>(lhsIsTriangular, lhsStorageOrder, rhsStorageOrder); break;
+      case StrictlyLower: func = trmm_select<StrictlyLower>(lhsIsTriangular, lhsStorageOrder, rhsStorageOrder); break;
+      case StrictlyUpper: func = trmm_select<StrictlyUpper>(lhsIsTriangular, lhsStorageOrder, rhsStorageOrder); break;
+    }
+    eigen_assert(func!=0 && "unsupported triangular mode");
+    func(rows, cols, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha);
+  }
+
+  typedef void (*trsm_func)(Index, Index, const Scalar*, Index, Scalar*, Index);
+
+  template<int Side, int Mode, int TriStorageOrder>
+  static void trsm_run(Index size, Index otherSize, const Scalar* tri, Index triStride, Scalar* other, Index otherStride)
+  {
+    gemm_blocking_space<ColMajor,Scalar,Scalar,Dynamic,Dynamic,Dynamic,4>
+      blocking(Side==OnTheLeft ? size : otherSize, Side==OnTheLeft ? otherSize : size, size);
+    triangular_solve_matrix<Scalar,Index,Side,Mode,false,TriStorageOrder,ColMajor>
+      ::run(size, otherSize, tri, triStride, other, otherStride, blocking);
+  }
+
+  template<int Mode>
+  static trsm_func trsm_select(int side, int triStorageOrder)
+  {
+    if(side==OnTheLeft)
+      return triStorageOrder==ColMajor ? &trsm_run<OnTheLeft,Mode,ColMajor> : &trsm_run<OnTheLeft,Mode,RowMajor>;
+    else
+      return triStorageOrder==ColMajor ? &trsm_run<OnTheRight,Mode,ColMajor> : &trsm_run<OnTheRight,Mode,RowMajor>;
+  }
+
+  static void trsm(int side, int mode, int triStorageOrder, Index size, Index otherSize,
+                   const Scalar* tri, Index triStride, Scalar* other, Index otherStride)
+  {
+    trsm_func func = 0;
+    switch(mode)
+    {
+      case Lower:     func = trsm_select<Lower>(side, triStorageOrder); break;
+      case Upper:     func = trsm_select<Upper>(side, triStorageOrder); break;
+      case UnitLower: func = trsm_select<UnitLower>(side, triStorageOrder); break;
+      case UnitUpper: func = trsm_select<UnitUpper>(side, triStorageOrder); break;
+    }
+    eigen_assert(func!=0 && "unsupported triangular mode");
+    func(size, otherSize, tri, triStride, other, otherStride);
+  }
+
+  static void math(int op, Index size, const Scalar* src, Scalar* dst)
+  {
+    typedef Array<Scalar,Dynamic,1> ArrayType;
+    Map<const ArrayType> x(src, size);
+    Map<ArrayType> y(dst, size);
+    switch(op)
+    {
+      case eigen_runtime_dispatch::Exp:      y = x.exp(); break;
+      case eigen_runtime_dispatch::Log:      y = x.log(); break;
+      case eigen_runtime_dispatch::Sin:      y = x.sin(); break;
+      case eigen_runtime_dispatch::Cos:      y = x.cos(); break;
+      case eigen_runtime_dispatch::Sqrt:     y = x.sqrt(); break;
+      case eigen_runtime_dispatch::Tanh:     y = x.tanh(); break;
+      case eigen_runtime_dispatch::Logistic: y = x.logistic(); break;
+      case eigen_runtime_dispatch::Erf:      y = x.erf(); break;
+      case eigen_runtime_dispatch::Atan:     y = x.atan(); break;
+      default: eigen_assert(false && "unsupported math function");
+    }
+  }
+};
+
+#define EIGEN_RUNTIME_DISPATCH_KERNELS_OF(SCALAR) \
+  { &runtime_dispatch_kernels_impl<SCALAR>::gemm, &runtime_dispatch_kernels_impl<SCALAR>::gemv, \
+    &runtime_dispatch_kernels_impl<SCALAR>::trmm, &runtime_dispatch_kernels_impl<SCALAR>::trsm, \
+    &runtime_dispatch_kernels_impl<SCALAR>::math }
+
+namespace {
+
+// constant initialized, so that it is ready before any dynamic initialization
+const eigen_runtime_dispatch::table runtime_dispatch_table = {
+  EIGEN_RUNTIME_DISPATCH_LEVEL,
+  EIGEN_RUNTIME_DISPATCH_KERNELS_OF(float),
+  EIGEN_RUNTIME_DISPATCH_KERNELS_OF(double)
+};
+
+// Registers the kernels at startup. This runs whatever the CPU, and therefore must not contain anything
+// else than the trivial registration.
+struct runtime_dispatch_registration
+{
+  runtime_dispatch_registration() { eigen_runtime_dispatch::EIGEN_RUNTIME_DISPATCH_REGISTER(); }
+} runtime_dispatch_registration_instance;
+
+} // end anonymous namespace
+
+#undef EIGEN_RUNTIME_DISPATCH_KERNELS_OF
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+void eigen_runtime_dispatch::EIGEN_RUNTIME_DISPATCH_REGISTER()
+{
+  registered_table(Eigen::internal::EIGEN_RUNTIME_DISPATCH_LEVEL) = &Eigen::internal::runtime_dispatch_table;
+}
+
+#undef EIGEN_RUNTIME_DISPATCH_LEVEL
+#undef EIGEN_RUNTIME_DISPATCH_REGISTER
+
+#endif // EIGEN_RUNTIME_DISPATCH_KERNELS_H
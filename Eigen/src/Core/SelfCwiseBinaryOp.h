@@ -122,6 +122,27 @@ template<typename BinaryOp, typename Lhs, typename Rhs> class SelfCwiseBinaryOp
         m_functor.packetOp(m_matrix.template packet<StoreMode>(index),_other.template packet<LoadMode>(index)) );
     }
 
+    template<typename OtherDerived, int LoadMode>
+    void copyPartialPacket(Index row, Index col, Index count, const DenseBase<OtherDerived>& other)
+    {
+      OtherDerived& _other = other.const_cast_derived();
+      eigen_internal_assert(row >= 0 && row < rows()
+                        && col >= 0 && col < cols());
+      internal::pstoreu_partial(&m_matrix.coeffRef(row, col),
+        m_functor.packetOp(m_matrix.template packet<PartialPacketLoad>(row, col),
+                           _other.template packet<LoadMode | PartialPacketLoad>(row, col)), count);
+    }
+
+    template<typename OtherDerived, int LoadMode>
+    void copyPartialPacket(Index index, Index count, const DenseBase<OtherDerived>& other)
+    {
+      OtherDerived& _other = other.const_cast_derived();
+      eigen_internal_assert(index >= 0 && index < m_matrix.size());
+      internal::pstoreu_partial(&m_matrix.coeffRef(index),
+        m_functor.packetOp(m_matrix.template packet<PartialPacketLoad>(index),
+                           _other.template packet<LoadMode | PartialPacketLoad>(index)), count);
+    }
+
     // reimplement lazyAssign to handle complex *= real
     // see CwiseBinaryOp ctor for details
     template<typename RhsDerived>
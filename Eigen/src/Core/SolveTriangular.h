@@ -19,7 +19,7 @@ namespace internal {
 template<typename LhsScalar, typename RhsScalar, typename Index, int Side, int Mode, bool Conjugate, int StorageOrder>
 struct triangular_solve_vector;
 
-template <typename Scalar, typename Index, int Side, int Mode, bool Conjugate, int TriStorageOrder, int OtherStorageOrder>
+template <typename Scalar, typename Index, int Side, int Mode, bool Conjugate, int TriStorageOrder, int OtherStorageOrder, int Version=Specialized>
 struct triangular_solve_matrix;
 
 // small helper struct extracting some traits on the underlying solver operation
@@ -86,6 +86,35 @@ struct triangular_solver_selector<Lhs,Rhs,Side,Mode,NoUnrolling,Dynamic>
   typedef blas_traits<Lhs> LhsProductTraits;
   typedef typename LhsProductTraits::DirectLinearAccessType ActualLhsType;
 
+  typedef internal::gemm_blocking_space<(Rhs::Flags&RowMajorBit) ? RowMajor : ColMajor,Scalar,Scalar,
+            Rhs::MaxRowsAtCompileTime, Rhs::MaxColsAtCompileTime, Lhs::MaxRowsAtCompileTime,4> BlockingType;
+
+  typedef triangular_solve_matrix<Scalar,Index,Side,Mode,LhsProductTraits::NeedToConjugate,(int(Lhs::Flags) & RowMajorBit) ? RowMajor : ColMajor,
+                                  (Rhs::Flags&RowMajorBit) ? RowMajor : ColMajor> SolverType;
+
+  // The right hand sides are independent of each other: the columns of rhs (or its rows if Side==OnTheRight)
+  // are split into slices which are solved in parallel.
+  struct SliceJob
+  {
+    SliceJob(const Scalar* tri, Index triStride, Rhs& rhs, Index size, Index othersize, Index jobs)
+      : m_tri(tri), m_triStride(triStride), m_rhs(rhs), m_size(size), m_othersize(othersize), m_jobs(jobs)
+    {}
+
+    void operator()(int i) const
+    {
+      Index start, length;
+      parallel_chunk(m_othersize, m_jobs, Index(Side==OnTheLeft ? 4 : 8), Index(i), start, length);
+      Scalar* other = Side==OnTheLeft ? &m_rhs.coeffRef(0,start) : &m_rhs.coeffRef(start,0);
+      BlockingType blocking(Side==OnTheLeft ? m_size : length, Side==OnTheLeft ? length : m_size, m_size);
+      SolverType::run(m_size, length, m_tri, m_triStride, other, m_rhs.outerStride(), blocking);
+    }
+
+    const Scalar* m_tri;
+    Index m_triStride;
+    Rhs& m_rhs;
+    Index m_size, m_othersize, m_jobs;
+  };
+
   static void run(const Lhs& lhs, Rhs& rhs)
   {
     typename internal::add_const_on_value_type<ActualLhsType>::type actualLhs = LhsProductTraits::extract(lhs);
@@ -93,14 +122,16 @@ struct triangular_solver_selector<Lhs,Rhs,Side,Mode,NoUnrolling,Dynamic>
     const Index size = lhs.rows();
     const Index othersize = Side==OnTheLeft? rhs.cols() : rhs.rows();
 
-    typedef internal::gemm_blocking_space<(Rhs::Flags&RowMajorBit) ? RowMajor : ColMajor,Scalar,Scalar,
-              Rhs::MaxRowsAtCompileTime, Rhs::MaxColsAtCompileTime, Lhs::MaxRowsAtCompileTime,4> BlockingType;
+    Index threads = parallel_level3_threads(double(size)*double(size)*double(othersize)/2, othersize);
+    if(threads>1)
+    {
+      parallel_for(SliceJob(&actualLhs.coeffRef(0,0), actualLhs.outerStride(), rhs, size, othersize, threads), int(threads));
+      return;
+    }
 
     BlockingType blocking(rhs.rows(), rhs.cols(), size);
 
-    triangular_solve_matrix<Scalar,Index,Side,Mode,LhsProductTraits::NeedToConjugate,(int(Lhs::Flags) & RowMajorBit) ? RowMajor : ColMajor,
-                               (Rhs::Flags&RowMajorBit) ? RowMajor : ColMajor>
-      ::run(size, othersize, &actualLhs.coeffRef(0,0), actualLhs.outerStride(), &rhs.coeffRef(0,0), rhs.outerStride(), blocking);
+    SolverType::run(size, othersize, &actualLhs.coeffRef(0,0), actualLhs.outerStride(), &rhs.coeffRef(0,0), rhs.outerStride(), blocking);
   }
 };
 
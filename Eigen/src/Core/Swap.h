@@ -115,6 +115,29 @@ template<typename ExpressionType> class SwapWrapper
       _other.template writePacket<LoadMode>(index, tmp);
     }
 
+    template<typename OtherDerived, int LoadMode>
+    void copyPartialPacket(Index rowId, Index colId, Index count, const DenseBase<OtherDerived>& other)
+    {
+      OtherDerived& _other = other.const_cast_derived();
+      eigen_internal_assert(rowId >= 0 && rowId < rows()
+                        && colId >= 0 && colId < cols());
+      Packet tmp = m_expression.template packet<PartialPacketLoad>(rowId, colId);
+      internal::pstoreu_partial(&m_expression.coeffRef(rowId, colId),
+        _other.template packet<LoadMode | PartialPacketLoad>(rowId, colId), count);
+      internal::pstoreu_partial(&_other.coeffRef(rowId, colId), tmp, count);
+    }
+
+    template<typename OtherDerived, int LoadMode>
+    void copyPartialPacket(Index index, Index count, const DenseBase<OtherDerived>& other)
+    {
+      OtherDerived& _other = other.const_cast_derived();
+      eigen_internal_assert(index >= 0 && index < m_expression.size());
+      Packet tmp = m_expression.template packet<PartialPacketLoad>(index);
+      internal::pstoreu_partial(&m_expression.coeffRef(index),
+        _other.template packet<LoadMode | PartialPacketLoad>(index), count);
+      internal::pstoreu_partial(&_other.coeffRef(index), tmp, count);
+    }
+
     ExpressionType& expression() const { return m_expression; }
 
   protected:
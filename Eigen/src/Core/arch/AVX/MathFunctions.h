@@ -0,0 +1,764 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2007 Julien Pommier
+// Copyright (C) 2009 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+/* The sin, cos, exp, and log functions of this file are the 256 bits versions of
+ * the ones of SSE/MathFunctions.h, which come from Julien Pommier's sse math library:
+ * http://gruntthepeon.free.fr/ssemath/
+ */
+
+#ifndef EIGEN_MATH_FUNCTIONS_AVX_H
+#define EIGEN_MATH_FUNCTIONS_AVX_H
+
+namespace Eigen {
+
+namespace internal {
+
+// AVX does not provide 256 bits integer arithmetic (this comes with AVX2),
+// so the following helpers fall back to two SSE instructions on the 128 bits halves.
+#ifdef EIGEN_VECTORIZE_AVX2
+template<int N> EIGEN_STRONG_INLINE Packet8i avx_slli_epi32(const Packet8i& a) { return _mm256_slli_epi32(a, N); }
+template<int N> EIGEN_STRONG_INLINE Packet8i avx_srli_epi32(const Packet8i& a) { return _mm256_srli_epi32(a, N); }
+EIGEN_STRONG_INLINE Packet8i avx_add_epi32(const Packet8i& a, const Packet8i& b) { return _mm256_add_epi32(a, b); }
+EIGEN_STRONG_INLINE Packet8i avx_sub_epi32(const Packet8i& a, const Packet8i& b) { return _mm256_sub_epi32(a, b); }
+EIGEN_STRONG_INLINE Packet8i avx_cmpeq_epi32(const Packet8i& a, const Packet8i& b) { return _mm256_cmpeq_epi32(a, b); }
+#else
+#define EIGEN_AVX_SPLIT_INT_OP(OP) \
+  Packet4i lo = OP(_mm256_castsi256_si128(a), _mm256_castsi256_si128(b)); \
+  Packet4i hi = OP(_mm256_extractf128_si256(a,1), _mm256_extractf128_si256(b,1)); \
+  return _mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1);
+template<int N> EIGEN_STRONG_INLINE Packet8i avx_slli_epi32(const Packet8i& a)
+{
+  Packet4i lo = _mm_slli_epi32(_mm256_castsi256_si128(a), N);
+  Packet4i hi = _mm_slli_epi32(_mm256_extractf128_si256(a,1), N);
+  return _mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+template<int N> EIGEN_STRONG_INLINE Packet8i avx_srli_epi32(const Packet8i& a)
+{
+  Packet4i lo = _mm_srli_epi32(_mm256_castsi256_si128(a), N);
+  Packet4i hi = _mm_srli_epi32(_mm256_extractf128_si256(a,1), N);
+  return _mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+EIGEN_STRONG_INLINE Packet8i avx_add_epi32(const Packet8i& a, const Packet8i& b) { EIGEN_AVX_SPLIT_INT_OP(_mm_add_epi32) }
+EIGEN_STRONG_INLINE Packet8i avx_sub_epi32(const Packet8i& a, const Packet8i& b) { EIGEN_AVX_SPLIT_INT_OP(_mm_sub_epi32) }
+EIGEN_STRONG_INLINE Packet8i avx_cmpeq_epi32(const Packet8i& a, const Packet8i& b) { EIGEN_AVX_SPLIT_INT_OP(_mm_cmpeq_epi32) }
+#undef EIGEN_AVX_SPLIT_INT_OP
+#endif
+// bitwise operations are available on floating point registers
+EIGEN_STRONG_INLINE Packet8i avx_and_si256(const Packet8i& a, const Packet8i& b)
+{ return _mm256_castps_si256(_mm256_and_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b))); }
+EIGEN_STRONG_INLINE Packet8i avx_andnot_si256(const Packet8i& a, const Packet8i& b)
+{ return _mm256_castps_si256(_mm256_andnot_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b))); }
+// Spreads four 32 bits integers over the four 64 bits lanes of a Packet4d,
+// taking the lower words from lo and the upper words from hi.
+EIGEN_STRONG_INLINE Packet4d avx_interleave_epi32_pd(const Packet4i& lo, const Packet4i& hi)
+{
+  return _mm256_castsi256_pd(_mm256_insertf128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi32(lo, hi)),
+                                                     _mm_unpackhi_epi32(lo, hi), 1));
+}
+
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet8f plog<Packet8f>(const Packet8f& _x)
+{
+  Packet8f x = _x;
+  _EIGEN_DECLARE_CONST_Packet8f(1 , 1.0f);
+  _EIGEN_DECLARE_CONST_Packet8f(half, 0.5f);
+  _EIGEN_DECLARE_CONST_Packet8i(0x7f, 0x7f);
+
+  _EIGEN_DECLARE_CONST_Packet8f_FROM_INT(inv_mant_mask, ~0x7f800000);
+
+  /* the smallest non denormalized float number */
+  _EIGEN_DECLARE_CONST_Packet8f_FROM_INT(min_norm_pos,  0x00800000);
+  _EIGEN_DECLARE_CONST_Packet8f_FROM_INT(minus_inf,     0xff800000);//-1.f/0.f);
+
+  /* natural logarithm computed for 8 simultaneous float
+    return NaN for x <= 0
+  */
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_SQRTHF, 0.707106781186547524f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_log_p0, 7.0376836292E-2f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_log_p1, - 1.1514610310E-1f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_log_p2, 1.1676998740E-1f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_log_p3, - 1.2420140846E-1f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_log_p4, + 1.4249322787E-1f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_log_p5, - 1.6668057665E-1f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_log_p6, + 2.0000714765E-1f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_log_p7, - 2.4999993993E-1f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_log_p8, + 3.3333331174E-1f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_log_q1, -2.12194440e-4f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_log_q2, 0.693359375f);
+
+  Packet8i emm0;
+
+  Packet8f invalid_mask = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_NGE_UQ); // not greater equal is true if x is NaN
+  Packet8f iszero_mask = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_EQ_OQ);
+
+  x = pmax(x, p8f_min_norm_pos);  /* cut off denormalized stuff */
+  emm0 = avx_srli_epi32<23>(_mm256_castps_si256(x));
+
+  /* keep only the fractional part */
+  x = _mm256_and_ps(x, p8f_inv_mant_mask);
+  x = _mm256_or_ps(x, p8f_half);
+
+  emm0 = avx_sub_epi32(emm0, p8i_0x7f);
+  Packet8f e = padd(_mm256_cvtepi32_ps(emm0), p8f_1);
+
+  /* part2:
+     if( x < SQRTHF ) {
+       e -= 1;
+       x = x + x - 1.0;
+     } else { x = x - 1.0; }
+  */
+  Packet8f mask = _mm256_cmp_ps(x, p8f_cephes_SQRTHF, _CMP_LT_OQ);
+  Packet8f tmp = _mm256_and_ps(x, mask);
+  x = psub(x, p8f_1);
+  e = psub(e, _mm256_and_ps(p8f_1, mask));
+  x = padd(x, tmp);
+
+  Packet8f x2 = pmul(x,x);
+  Packet8f x3 = pmul(x2,x);
+
+  Packet8f y, y1, y2;
+  y  = pmadd(p8f_cephes_log_p0, x, p8f_cephes_log_p1);
+  y1 = pmadd(p8f_cephes_log_p3, x, p8f_cephes_log_p4);
+  y2 = pmadd(p8f_cephes_log_p6, x, p8f_cephes_log_p7);
+  y  = pmadd(y , x, p8f_cephes_log_p2);
+  y1 = pmadd(y1, x, p8f_cephes_log_p5);
+  y2 = pmadd(y2, x, p8f_cephes_log_p8);
+  y = pmadd(y, x3, y1);
+  y = pmadd(y, x3, y2);
+  y = pmul(y, x3);
+
+  y1 = pmul(e, p8f_cephes_log_q1);
+  tmp = pmul(x2, p8f_half);
+  y = padd(y, y1);
+  x = psub(x, tmp);
+  y2 = pmul(e, p8f_cephes_log_q2);
+  x = padd(x, y);
+  x = padd(x, y2);
+  // negative arg will be NAN, 0 will be -INF
+  return _mm256_or_ps(_mm256_andnot_ps(iszero_mask, _mm256_or_ps(x, invalid_mask)),
+                      _mm256_and_ps(iszero_mask, p8f_minus_inf));
+}
+
+/* natural logarithm computed for 4 simultaneous doubles, see the SSE version for the details. */
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet4d plog<Packet4d>(const Packet4d& _x)
+{
+  Packet4d x = _x;
+  _EIGEN_DECLARE_CONST_Packet4d(1 , 1.0);
+  _EIGEN_DECLARE_CONST_Packet4d(half, 0.5);
+  _EIGEN_DECLARE_CONST_Packet4d(52, 52.0);
+  _EIGEN_DECLARE_CONST_Packet4d(2p52, 4503599627370496.0);
+  _EIGEN_DECLARE_CONST_Packet4d(min_norm_pos, (std::numeric_limits<double>::min)());
+  _EIGEN_DECLARE_CONST_Packet4d(inf, std::numeric_limits<double>::infinity());
+  _EIGEN_DECLARE_CONST_Packet4d(minus_inf, -std::numeric_limits<double>::infinity());
+  _EIGEN_DECLARE_CONST_Packet4i(1022, 1022);
+  const Packet4d p4d_inv_mant_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(~0x7ff0000000000000LL));
+
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_SQRTHF, 0.70710678118654752440);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_log_p0, 1.01875663804580931796E-4);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_log_p1, 4.97494994976747001425E-1);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_log_p2, 4.70579119878881725854E0);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_log_p3, 1.44989225341610930846E1);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_log_p4, 1.79368678507819816313E1);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_log_p5, 7.70838733755885391666E0);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_log_q0, 1.12873587189167450590E1);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_log_q1, 4.52279145837532221105E1);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_log_q2, 8.29875266912776603211E1);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_log_q3, 7.11544750618563894466E1);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_log_q4, 2.31251620126765340583E1);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_log_C1, -2.121944400546905827679E-4);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_log_C2, 0.693359375);
+
+  Packet4d invalid_mask = _mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_NGE_UQ); // not greater equal is true if x is NaN
+  Packet4d iszero_mask = _mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_EQ_OQ);
+  Packet4d isinf_mask = _mm256_cmp_pd(x, p4d_inf, _CMP_EQ_OQ);
+
+  /* scale the denormalized numbers by 2^52 */
+  Packet4d denorm_mask = _mm256_cmp_pd(x, p4d_min_norm_pos, _CMP_LT_OQ);
+  x = _mm256_blendv_pd(x, pmul(x, p4d_2p52), denorm_mask);
+
+  /* gather the upper 32 bits of the doubles, which hold the exponents */
+  __m128 lo = _mm256_castps256_ps128(_mm256_castpd_ps(x));
+  __m128 hi = _mm256_extractf128_ps(_mm256_castpd_ps(x), 1);
+  Packet4i emm0 = _mm_castps_si128(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3,1,3,1)));
+  emm0 = _mm_srli_epi32(emm0, 20);
+  emm0 = _mm_sub_epi32(emm0, p4i_1022);
+  Packet4d e = psub(_mm256_cvtepi32_pd(emm0), _mm256_and_pd(denorm_mask, p4d_52));
+
+  /* keep only the fractional part */
+  x = _mm256_and_pd(x, p4d_inv_mant_mask);
+  x = _mm256_or_pd(x, p4d_half);
+
+  /* if( x < SQRTHF ) { e -= 1; x = x + x - 1.0; } else { x = x - 1.0; } */
+  Packet4d mask = _mm256_cmp_pd(x, p4d_cephes_SQRTHF, _CMP_LT_OQ);
+  Packet4d tmp = _mm256_and_pd(x, mask);
+  x = psub(x, p4d_1);
+  e = psub(e, _mm256_and_pd(p4d_1, mask));
+  x = padd(x, tmp);
+
+  Packet4d x2 = pmul(x,x);
+
+  Packet4d px = p4d_cephes_log_p0;
+  px = pmadd(px, x, p4d_cephes_log_p1);
+  px = pmadd(px, x, p4d_cephes_log_p2);
+  px = pmadd(px, x, p4d_cephes_log_p3);
+  px = pmadd(px, x, p4d_cephes_log_p4);
+  px = pmadd(px, x, p4d_cephes_log_p5);
+
+  Packet4d qx = padd(x, p4d_cephes_log_q0);
+  qx = pmadd(qx, x, p4d_cephes_log_q1);
+  qx = pmadd(qx, x, p4d_cephes_log_q2);
+  qx = pmadd(qx, x, p4d_cephes_log_q3);
+  qx = pmadd(qx, x, p4d_cephes_log_q4);
+
+  Packet4d y = pmul(x, pdiv(pmul(x2, px), qx));
+  y = pmadd(e, p4d_cephes_log_C1, y);
+  y = psub(y, pmul(x2, p4d_half));
+  x = padd(x, y);
+  x = pmadd(e, p4d_cephes_log_C2, x);
+
+  // negative and NaN args will be NAN, 0 will be -INF, +INF stays +INF
+  x = _mm256_or_pd(x, invalid_mask);
+  x = _mm256_blendv_pd(x, p4d_minus_inf, iszero_mask);
+  return _mm256_blendv_pd(x, p4d_inf, isinf_mask);
+}
+
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet8f pexp<Packet8f>(const Packet8f& _x)
+{
+  Packet8f x = _x;
+  _EIGEN_DECLARE_CONST_Packet8f(1 , 1.0f);
+  _EIGEN_DECLARE_CONST_Packet8f(half, 0.5f);
+  _EIGEN_DECLARE_CONST_Packet8i(0x7f, 0x7f);
+
+  _EIGEN_DECLARE_CONST_Packet8f(exp_hi,  88.3762626647950f);
+  _EIGEN_DECLARE_CONST_Packet8f(exp_lo, -88.3762626647949f);
+
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_LOG2EF, 1.44269504088896341f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_exp_C1, 0.693359375f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_exp_C2, -2.12194440e-4f);
+
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_exp_p0, 1.9875691500E-4f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_exp_p1, 1.3981999507E-3f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_exp_p2, 8.3334519073E-3f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_exp_p3, 4.1665795894E-2f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_exp_p4, 1.6666665459E-1f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_exp_p5, 5.0000001201E-1f);
+
+  Packet8f tmp, fx;
+  Packet8i emm0;
+
+  // clamp x
+  x = pmax(pmin(x, p8f_exp_hi), p8f_exp_lo);
+
+  /* express exp(x) as exp(g + n*log(2)) */
+  fx = pmadd(x, p8f_cephes_LOG2EF, p8f_half);
+  fx = _mm256_floor_ps(fx);
+
+  tmp = pmul(fx, p8f_cephes_exp_C1);
+  Packet8f z = pmul(fx, p8f_cephes_exp_C2);
+  x = psub(x, tmp);
+  x = psub(x, z);
+
+  z = pmul(x,x);
+
+  Packet8f y = p8f_cephes_exp_p0;
+  y = pmadd(y, x, p8f_cephes_exp_p1);
+  y = pmadd(y, x, p8f_cephes_exp_p2);
+  y = pmadd(y, x, p8f_cephes_exp_p3);
+  y = pmadd(y, x, p8f_cephes_exp_p4);
+  y = pmadd(y, x, p8f_cephes_exp_p5);
+  y = pmadd(y, z, x);
+  y = padd(y, p8f_1);
+
+  // build 2^n
+  emm0 = _mm256_cvttps_epi32(fx);
+  emm0 = avx_add_epi32(emm0, p8i_0x7f);
+  emm0 = avx_slli_epi32<23>(emm0);
+  return pmul(y, _mm256_castsi256_ps(emm0));
+}
+
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet4d pexp<Packet4d>(const Packet4d& _x)
+{
+  Packet4d x = _x;
+
+  _EIGEN_DECLARE_CONST_Packet4d(1 , 1.0);
+  _EIGEN_DECLARE_CONST_Packet4d(2 , 2.0);
+  _EIGEN_DECLARE_CONST_Packet4d(half, 0.5);
+
+  _EIGEN_DECLARE_CONST_Packet4d(exp_hi,  709.437);
+  _EIGEN_DECLARE_CONST_Packet4d(exp_lo, -709.436139303);
+
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_LOG2EF, 1.4426950408889634073599);
+
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_exp_p0, 1.26177193074810590878e-4);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_exp_p1, 3.02994407707441961300e-2);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_exp_p2, 9.99999999999999999910e-1);
+
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_exp_q0, 3.00198505138664455042e-6);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_exp_q1, 2.52448340349684104192e-3);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_exp_q2, 2.27265548208155028766e-1);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_exp_q3, 2.00000000000000000009e0);
+
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_exp_C1, 0.693145751953125);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_exp_C2, 1.42860682030941723212e-6);
+  _EIGEN_DECLARE_CONST_Packet4i(1023, 1023);
+
+  Packet4d tmp, fx;
+  Packet4i emm0;
+
+  // clamp x
+  x = pmax(pmin(x, p4d_exp_hi), p4d_exp_lo);
+  /* express exp(x) as exp(g + n*log(2)) */
+  fx = pmadd(p4d_cephes_LOG2EF, x, p4d_half);
+  fx = _mm256_floor_pd(fx);
+
+  tmp = pmul(fx, p4d_cephes_exp_C1);
+  Packet4d z = pmul(fx, p4d_cephes_exp_C2);
+  x = psub(x, tmp);
+  x = psub(x, z);
+
+  Packet4d x2 = pmul(x,x);
+
+  Packet4d px = p4d_cephes_exp_p0;
+  px = pmadd(px, x2, p4d_cephes_exp_p1);
+  px = pmadd(px, x2, p4d_cephes_exp_p2);
+  px = pmul (px, x);
+
+  Packet4d qx = p4d_cephes_exp_q0;
+  qx = pmadd(qx, x2, p4d_cephes_exp_q1);
+  qx = pmadd(qx, x2, p4d_cephes_exp_q2);
+  qx = pmadd(qx, x2, p4d_cephes_exp_q3);
+
+  x = pdiv(px,psub(qx,px));
+  x = pmadd(p4d_2,x,p4d_1);
+
+  // build 2^n: the biased exponents are moved to the upper 32 bits of each double
+  emm0 = _mm256_cvttpd_epi32(fx);
+  emm0 = _mm_add_epi32(emm0, p4i_1023);
+  emm0 = _mm_slli_epi32(emm0, 20);
+  Packet4i lo = _mm_unpacklo_epi32(_mm_setzero_si128(), emm0);
+  Packet4i hi = _mm_unpackhi_epi32(_mm_setzero_si128(), emm0);
+  return pmul(x, _mm256_castsi256_pd(_mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1)));
+}
+
+/* evaluation of 8 sines at onces, see the SSE version for the details. */
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet8f psin<Packet8f>(const Packet8f& _x)
+{
+  Packet8f x = _x;
+  _EIGEN_DECLARE_CONST_Packet8f(1 , 1.0f);
+  _EIGEN_DECLARE_CONST_Packet8f(half, 0.5f);
+
+  _EIGEN_DECLARE_CONST_Packet8i(1, 1);
+  _EIGEN_DECLARE_CONST_Packet8i(not1, ~1);
+  _EIGEN_DECLARE_CONST_Packet8i(2, 2);
+  _EIGEN_DECLARE_CONST_Packet8i(4, 4);
+
+  _EIGEN_DECLARE_CONST_Packet8f_FROM_INT(sign_mask, 0x80000000);
+
+  _EIGEN_DECLARE_CONST_Packet8f(minus_cephes_DP1,-0.78515625f);
+  _EIGEN_DECLARE_CONST_Packet8f(minus_cephes_DP2, -2.4187564849853515625e-4f);
+  _EIGEN_DECLARE_CONST_Packet8f(minus_cephes_DP3, -3.77489497744594108e-8f);
+  _EIGEN_DECLARE_CONST_Packet8f(sincof_p0, -1.9515295891E-4f);
+  _EIGEN_DECLARE_CONST_Packet8f(sincof_p1,  8.3321608736E-3f);
+  _EIGEN_DECLARE_CONST_Packet8f(sincof_p2, -1.6666654611E-1f);
+  _EIGEN_DECLARE_CONST_Packet8f(coscof_p0,  2.443315711809948E-005f);
+  _EIGEN_DECLARE_CONST_Packet8f(coscof_p1, -1.388731625493765E-003f);
+  _EIGEN_DECLARE_CONST_Packet8f(coscof_p2,  4.166664568298827E-002f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_FOPI, 1.27323954473516f); // 4 / M_PI
+
+  Packet8f xmm1, xmm2, xmm3, sign_bit, y;
+
+  Packet8i emm0, emm2;
+  sign_bit = x;
+  /* take the absolute value */
+  x = pabs(x);
+
+  /* extract the sign bit (upper one) */
+  sign_bit = _mm256_and_ps(sign_bit, p8f_sign_mask);
+
+  /* scale by 4/Pi */
+  y = pmul(x, p8f_cephes_FOPI);
+
+  /* store the integer part of y in mm0 */
+  emm2 = _mm256_cvttps_epi32(y);
+  /* j=(j+1) & (~1) (see the cephes sources) */
+  emm2 = avx_add_epi32(emm2, p8i_1);
+  emm2 = avx_and_si256(emm2, p8i_not1);
+  y = _mm256_cvtepi32_ps(emm2);
+  /* get the swap sign flag */
+  emm0 = avx_and_si256(emm2, p8i_4);
+  emm0 = avx_slli_epi32<29>(emm0);
+  /* get the polynom selection mask
+     there is one polynom for 0 <= x <= Pi/4
+     and another one for Pi/4<x<=Pi/2
+
+     Both branches will be computed.
+  */
+  emm2 = avx_and_si256(emm2, p8i_2);
+  emm2 = avx_cmpeq_epi32(emm2, _mm256_setzero_si256());
+
+  Packet8f swap_sign_bit = _mm256_castsi256_ps(emm0);
+  Packet8f poly_mask = _mm256_castsi256_ps(emm2);
+  sign_bit = _mm256_xor_ps(sign_bit, swap_sign_bit);
+
+  /* The magic pass: "Extended precision modular arithmetic"
+     x = ((x - y * DP1) - y * DP2) - y * DP3; */
+  xmm1 = pmul(y, p8f_minus_cephes_DP1);
+  xmm2 = pmul(y, p8f_minus_cephes_DP2);
+  xmm3 = pmul(y, p8f_minus_cephes_DP3);
+  x = padd(x, xmm1);
+  x = padd(x, xmm2);
+  x = padd(x, xmm3);
+
+  /* Evaluate the first polynom  (0 <= x <= Pi/4) */
+  y = p8f_coscof_p0;
+  Packet8f z = pmul(x,x);
+
+  y = pmadd(y, z, p8f_coscof_p1);
+  y = pmadd(y, z, p8f_coscof_p2);
+  y = pmul(y, z);
+  y = pmul(y, z);
+  Packet8f tmp = pmul(z, p8f_half);
+  y = psub(y, tmp);
+  y = padd(y, p8f_1);
+
+  /* Evaluate the second polynom  (Pi/4 <= x <= 0) */
+
+  Packet8f y2 = p8f_sincof_p0;
+  y2 = pmadd(y2, z, p8f_sincof_p1);
+  y2 = pmadd(y2, z, p8f_sincof_p2);
+  y2 = pmul(y2, z);
+  y2 = pmul(y2, x);
+  y2 = padd(y2, x);
+
+  /* select the correct result from the two polynoms */
+  y = _mm256_blendv_ps(y, y2, poly_mask);
+  /* update the sign */
+  return _mm256_xor_ps(y, sign_bit);
+}
+
+/* almost the same as psin */
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet8f pcos<Packet8f>(const Packet8f& _x)
+{
+  Packet8f x = _x;
+  _EIGEN_DECLARE_CONST_Packet8f(1 , 1.0f);
+  _EIGEN_DECLARE_CONST_Packet8f(half, 0.5f);
+
+  _EIGEN_DECLARE_CONST_Packet8i(1, 1);
+  _EIGEN_DECLARE_CONST_Packet8i(not1, ~1);
+  _EIGEN_DECLARE_CONST_Packet8i(2, 2);
+  _EIGEN_DECLARE_CONST_Packet8i(4, 4);
+
+  _EIGEN_DECLARE_CONST_Packet8f(minus_cephes_DP1,-0.78515625f);
+  _EIGEN_DECLARE_CONST_Packet8f(minus_cephes_DP2, -2.4187564849853515625e-4f);
+  _EIGEN_DECLARE_CONST_Packet8f(minus_cephes_DP3, -3.77489497744594108e-8f);
+  _EIGEN_DECLARE_CONST_Packet8f(sincof_p0, -1.9515295891E-4f);
+  _EIGEN_DECLARE_CONST_Packet8f(sincof_p1,  8.3321608736E-3f);
+  _EIGEN_DECLARE_CONST_Packet8f(sincof_p2, -1.6666654611E-1f);
+  _EIGEN_DECLARE_CONST_Packet8f(coscof_p0,  2.443315711809948E-005f);
+  _EIGEN_DECLARE_CONST_Packet8f(coscof_p1, -1.388731625493765E-003f);
+  _EIGEN_DECLARE_CONST_Packet8f(coscof_p2,  4.166664568298827E-002f);
+  _EIGEN_DECLARE_CONST_Packet8f(cephes_FOPI, 1.27323954473516f); // 4 / M_PI
+
+  Packet8f xmm1, xmm2, xmm3, y;
+  Packet8i emm0, emm2;
+
+  x = pabs(x);
+
+  /* scale by 4/Pi */
+  y = pmul(x, p8f_cephes_FOPI);
+
+  /* get the integer part of y */
+  emm2 = _mm256_cvttps_epi32(y);
+  /* j=(j+1) & (~1) (see the cephes sources) */
+  emm2 = avx_add_epi32(emm2, p8i_1);
+  emm2 = avx_and_si256(emm2, p8i_not1);
+  y = _mm256_cvtepi32_ps(emm2);
+
+  emm2 = avx_sub_epi32(emm2, p8i_2);
+
+  /* get the swap sign flag */
+  emm0 = avx_andnot_si256(emm2, p8i_4);
+  emm0 = avx_slli_epi32<29>(emm0);
+  /* get the polynom selection mask */
+  emm2 = avx_and_si256(emm2, p8i_2);
+  emm2 = avx_cmpeq_epi32(emm2, _mm256_setzero_si256());
+
+  Packet8f sign_bit = _mm256_castsi256_ps(emm0);
+  Packet8f poly_mask = _mm256_castsi256_ps(emm2);
+
+  /* The magic pass: "Extended precision modular arithmetic"
+     x = ((x - y * DP1) - y * DP2) - y * DP3; */
+  xmm1 = pmul(y, p8f_minus_cephes_DP1);
+  xmm2 = pmul(y, p8f_minus_cephes_DP2);
+  xmm3 = pmul(y, p8f_minus_cephes_DP3);
+  x = padd(x, xmm1);
+  x = padd(x, xmm2);
+  x = padd(x, xmm3);
+
+  /* Evaluate the first polynom  (0 <= x <= Pi/4) */
+  y = p8f_coscof_p0;
+  Packet8f z = pmul(x,x);
+
+  y = pmadd(y,z,p8f_coscof_p1);
+  y = pmadd(y,z,p8f_coscof_p2);
+  y = pmul(y, z);
+  y = pmul(y, z);
+  Packet8f tmp = pmul(z, p8f_half);
+  y = psub(y, tmp);
+  y = padd(y, p8f_1);
+
+  /* Evaluate the second polynom  (Pi/4 <= x <= 0) */
+  Packet8f y2 = p8f_sincof_p0;
+  y2 = pmadd(y2, z, p8f_sincof_p1);
+  y2 = pmadd(y2, z, p8f_sincof_p2);
+  y2 = pmul(y2, z);
+  y2 = pmadd(y2, x, x);
+
+  /* select the correct result from the two polynoms */
+  y = _mm256_blendv_ps(y, y2, poly_mask);
+
+  /* update the sign */
+  return _mm256_xor_ps(y, sign_bit);
+}
+
+/* \internal returns \a y, where the coefficients for which the packet sine and cosine of \a x are not
+   accurate, that is |x| >= 2^30 and the infinite and NaN ones, are replaced by the scalar \a func of \a x */
+EIGEN_STRONG_INLINE Packet4d psincos_large_arguments(const Packet4d& x, const Packet4d& y, double (*func)(double))
+{
+  if(_mm256_movemask_pd(_mm256_cmp_pd(pabs(x), pset1<Packet4d>(1073741824.0), _CMP_NLT_UQ))==0)
+    return y;
+  EIGEN_ALIGN32 double xs[4], ys[4];
+  pstore(xs, x);
+  pstore(ys, y);
+  for(int i=0; i<4; ++i)
+    if(!(std::abs(xs[i]) < 1073741824.0))
+      ys[i] = func(xs[i]);
+  return pload<Packet4d>(ys);
+}
+
+/* evaluation of 4 double precision sines at once, see the SSE version for the details. */
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet4d psin<Packet4d>(const Packet4d& _x)
+{
+  Packet4d x = _x;
+  _EIGEN_DECLARE_CONST_Packet4d(1 , 1.0);
+  _EIGEN_DECLARE_CONST_Packet4d(half, 0.5);
+
+  _EIGEN_DECLARE_CONST_Packet4i(1, 1);
+  _EIGEN_DECLARE_CONST_Packet4i(not1, ~1);
+  _EIGEN_DECLARE_CONST_Packet4i(2, 2);
+  _EIGEN_DECLARE_CONST_Packet4i(4, 4);
+
+  const Packet4d p4d_sign_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x8000000000000000LL));
+
+  _EIGEN_DECLARE_CONST_Packet4d(minus_cephes_DP1, -7.85398125648498535156E-1);
+  _EIGEN_DECLARE_CONST_Packet4d(minus_cephes_DP2, -3.77489470793079817668E-8);
+  _EIGEN_DECLARE_CONST_Packet4d(minus_cephes_DP3, -2.69515142907905952645E-15);
+  _EIGEN_DECLARE_CONST_Packet4d(sincof_p0,  1.58962301576546568060E-10);
+  _EIGEN_DECLARE_CONST_Packet4d(sincof_p1, -2.50507477628578072866E-8);
+  _EIGEN_DECLARE_CONST_Packet4d(sincof_p2,  2.75573136213857245213E-6);
+  _EIGEN_DECLARE_CONST_Packet4d(sincof_p3, -1.98412698295895385996E-4);
+  _EIGEN_DECLARE_CONST_Packet4d(sincof_p4,  8.33333333332211858878E-3);
+  _EIGEN_DECLARE_CONST_Packet4d(sincof_p5, -1.66666666666666307295E-1);
+  _EIGEN_DECLARE_CONST_Packet4d(coscof_p0, -1.13585365213876817300E-11);
+  _EIGEN_DECLARE_CONST_Packet4d(coscof_p1,  2.08757008419747316778E-9);
+  _EIGEN_DECLARE_CONST_Packet4d(coscof_p2, -2.75573141792967388112E-7);
+  _EIGEN_DECLARE_CONST_Packet4d(coscof_p3,  2.48015872888517045348E-5);
+  _EIGEN_DECLARE_CONST_Packet4d(coscof_p4, -1.38888888888730564116E-3);
+  _EIGEN_DECLARE_CONST_Packet4d(coscof_p5,  4.16666666666665929218E-2);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_FOPI, 1.27323954473516268615); // 4 / M_PI
+
+  Packet4d sign_bit, y;
+  Packet4i emm0, emm2;
+
+  /* extract the sign bit and take the absolute value */
+  sign_bit = _mm256_and_pd(x, p4d_sign_mask);
+  x = pabs(x);
+
+  /* scale by 4/Pi */
+  y = pmul(x, p4d_cephes_FOPI);
+
+  /* store the integer part of y in the two lower words of emm2 */
+  emm2 = _mm256_cvttpd_epi32(y);
+  /* j=(j+1) & (~1) (see the cephes sources) */
+  emm2 = _mm_add_epi32(emm2, p4i_1);
+  emm2 = _mm_and_si128(emm2, p4i_not1);
+  y = _mm256_cvtepi32_pd(emm2);
+  /* get the swap sign flag and the polynom selection mask */
+  emm0 = _mm_and_si128(emm2, p4i_4);
+  emm0 = _mm_slli_epi32(emm0, 29);
+  emm2 = _mm_and_si128(emm2, p4i_2);
+  emm2 = _mm_cmpeq_epi32(emm2, _mm_setzero_si128());
+
+  Packet4d swap_sign_bit = avx_interleave_epi32_pd(_mm_setzero_si128(), emm0);
+  Packet4d poly_mask = avx_interleave_epi32_pd(emm2, emm2);
+  sign_bit = _mm256_xor_pd(sign_bit, swap_sign_bit);
+
+  /* Extended precision modular arithmetic: x = ((x - y * DP1) - y * DP2) - y * DP3; */
+  x = pmadd(y, p4d_minus_cephes_DP1, x);
+  x = pmadd(y, p4d_minus_cephes_DP2, x);
+  x = pmadd(y, p4d_minus_cephes_DP3, x);
+
+  /* Evaluate the first polynom  (0 <= x <= Pi/4) */
+  Packet4d z = pmul(x,x);
+  y = p4d_coscof_p0;
+  y = pmadd(y, z, p4d_coscof_p1);
+  y = pmadd(y, z, p4d_coscof_p2);
+  y = pmadd(y, z, p4d_coscof_p3);
+  y = pmadd(y, z, p4d_coscof_p4);
+  y = pmadd(y, z, p4d_coscof_p5);
+  y = pmul(y, z);
+  y = pmul(y, z);
+  y = psub(y, pmul(z, p4d_half));
+  y = padd(y, p4d_1);
+
+  /* Evaluate the second polynom  (Pi/4 <= x <= 0) */
+  Packet4d y2 = p4d_sincof_p0;
+  y2 = pmadd(y2, z, p4d_sincof_p1);
+  y2 = pmadd(y2, z, p4d_sincof_p2);
+  y2 = pmadd(y2, z, p4d_sincof_p3);
+  y2 = pmadd(y2, z, p4d_sincof_p4);
+  y2 = pmadd(y2, z, p4d_sincof_p5);
+  y2 = pmul(y2, z);
+  y2 = pmadd(y2, x, x);
+
+  /* select the correct result from the two polynoms */
+  y = _mm256_blendv_pd(y, y2, poly_mask);
+  /* update the sign */
+  return psincos_large_arguments(_x, _mm256_xor_pd(y, sign_bit), std::sin);
+}
+
+/* almost the same as psin */
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet4d pcos<Packet4d>(const Packet4d& _x)
+{
+  Packet4d x = _x;
+  _EIGEN_DECLARE_CONST_Packet4d(1 , 1.0);
+  _EIGEN_DECLARE_CONST_Packet4d(half, 0.5);
+
+  _EIGEN_DECLARE_CONST_Packet4i(1, 1);
+  _EIGEN_DECLARE_CONST_Packet4i(not1, ~1);
+  _EIGEN_DECLARE_CONST_Packet4i(2, 2);
+  _EIGEN_DECLARE_CONST_Packet4i(4, 4);
+
+  _EIGEN_DECLARE_CONST_Packet4d(minus_cephes_DP1, -7.85398125648498535156E-1);
+  _EIGEN_DECLARE_CONST_Packet4d(minus_cephes_DP2, -3.77489470793079817668E-8);
+  _EIGEN_DECLARE_CONST_Packet4d(minus_cephes_DP3, -2.69515142907905952645E-15);
+  _EIGEN_DECLARE_CONST_Packet4d(sincof_p0,  1.58962301576546568060E-10);
+  _EIGEN_DECLARE_CONST_Packet4d(sincof_p1, -2.50507477628578072866E-8);
+  _EIGEN_DECLARE_CONST_Packet4d(sincof_p2,  2.75573136213857245213E-6);
+  _EIGEN_DECLARE_CONST_Packet4d(sincof_p3, -1.98412698295895385996E-4);
+  _EIGEN_DECLARE_CONST_Packet4d(sincof_p4,  8.33333333332211858878E-3);
+  _EIGEN_DECLARE_CONST_Packet4d(sincof_p5, -1.66666666666666307295E-1);
+  _EIGEN_DECLARE_CONST_Packet4d(coscof_p0, -1.13585365213876817300E-11);
+  _EIGEN_DECLARE_CONST_Packet4d(coscof_p1,  2.08757008419747316778E-9);
+  _EIGEN_DECLARE_CONST_Packet4d(coscof_p2, -2.75573141792967388112E-7);
+  _EIGEN_DECLARE_CONST_Packet4d(coscof_p3,  2.48015872888517045348E-5);
+  _EIGEN_DECLARE_CONST_Packet4d(coscof_p4, -1.38888888888730564116E-3);
+  _EIGEN_DECLARE_CONST_Packet4d(coscof_p5,  4.16666666666665929218E-2);
+  _EIGEN_DECLARE_CONST_Packet4d(cephes_FOPI, 1.27323954473516268615); // 4 / M_PI
+
+  Packet4d y;
+  Packet4i emm0, emm2;
+
+  x = pabs(x);
+
+  /* scale by 4/Pi */
+  y = pmul(x, p4d_cephes_FOPI);
+
+  /* get the integer part of y */
+  emm2 = _mm256_cvttpd_epi32(y);
+  /* j=(j+1) & (~1) (see the cephes sources) */
+  emm2 = _mm_add_epi32(emm2, p4i_1);
+  emm2 = _mm_and_si128(emm2, p4i_not1);
+  y = _mm256_cvtepi32_pd(emm2);
+
+  emm2 = _mm_sub_epi32(emm2, p4i_2);
+
+  /* get the swap sign flag */
+  emm0 = _mm_andnot_si128(emm2, p4i_4);
+  emm0 = _mm_slli_epi32(emm0, 29);
+  /* get the polynom selection mask */
+  emm2 = _mm_and_si128(emm2, p4i_2);
+  emm2 = _mm_cmpeq_epi32(emm2, _mm_setzero_si128());
+
+  Packet4d sign_bit = avx_interleave_epi32_pd(_mm_setzero_si128(), emm0);
+  Packet4d poly_mask = avx_interleave_epi32_pd(emm2, emm2);
+
+  /* Extended precision modular arithmetic: x = ((x - y * DP1) - y * DP2) - y * DP3; */
+  x = pmadd(y, p4d_minus_cephes_DP1, x);
+  x = pmadd(y, p4d_minus_cephes_DP2, x);
+  x = pmadd(y, p4d_minus_cephes_DP3, x);
+
+  /* Evaluate the first polynom  (0 <= x <= Pi/4) */
+  Packet4d z = pmul(x,x);
+  y = p4d_coscof_p0;
+  y = pmadd(y, z, p4d_coscof_p1);
+  y = pmadd(y, z, p4d_coscof_p2);
+  y = pmadd(y, z, p4d_coscof_p3);
+  y = pmadd(y, z, p4d_coscof_p4);
+  y = pmadd(y, z, p4d_coscof_p5);
+  y = pmul(y, z);
+  y = pmul(y, z);
+  y = psub(y, pmul(z, p4d_half));
+  y = padd(y, p4d_1);
+
+  /* Evaluate the second polynom  (Pi/4 <= x <= 0) */
+  Packet4d y2 = p4d_sincof_p0;
+  y2 = pmadd(y2, z, p4d_sincof_p1);
+  y2 = pmadd(y2, z, p4d_sincof_p2);
+  y2 = pmadd(y2, z, p4d_sincof_p3);
+  y2 = pmadd(y2, z, p4d_sincof_p4);
+  y2 = pmadd(y2, z, p4d_sincof_p5);
+  y2 = pmul(y2, z);
+  y2 = pmadd(y2, x, x);
+
+  /* select the correct result from the two polynoms */
+  y = _mm256_blendv_pd(y, y2, poly_mask);
+
+  /* update the sign */
+  return psincos_large_arguments(_x, _mm256_xor_pd(y, sign_bit), std::cos);
+}
+
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet8f psqrt<Packet8f>(const Packet8f& _x)
+{
+#if EIGEN_FAST_MATH
+  // one Newton iteration on top of the hardware approximation of the inverse square root,
+  // see the SSE version
+  Packet8f half = pmul(_x, pset1<Packet8f>(.5f));
+
+  /* select only the inverse sqrt of non-zero inputs */
+  Packet8f non_zero_mask = _mm256_cmp_ps(_x, pset1<Packet8f>((std::numeric_limits<float>::min)()), _CMP_GE_OQ);
+  Packet8f x = _mm256_and_ps(non_zero_mask, _mm256_rsqrt_ps(_x));
+
+  x = pmul(x, psub(pset1<Packet8f>(1.5f), pmul(half, pmul(x,x))));
+  return pmul(_x,x);
+#else
+  return _mm256_sqrt_ps(_x);
+#endif
+}
+
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet4d psqrt<Packet4d>(const Packet4d& x)
+{
+  return _mm256_sqrt_pd(x);
+}
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_MATH_FUNCTIONS_AVX_H
@@ -0,0 +1,64 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_MATH_FUNCTIONS_AVX512_H
+#define EIGEN_MATH_FUNCTIONS_AVX512_H
+
+namespace Eigen {
+
+namespace internal {
+
+// The transcendental functions are evaluated on the two 256 bits halves of the packets
+// using the AVX implementations, see AVX/MathFunctions.h.
+
+#define EIGEN_AVX512_SPLIT_FUNCTION(FUNC,PACKET) \
+  template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED \
+  PACKET FUNC<PACKET>(const PACKET& x) \
+  { \
+    return avx512_combine(FUNC(avx512_lower_half(x)), FUNC(avx512_upper_half(x))); \
+  }
+
+EIGEN_AVX512_SPLIT_FUNCTION(plog, Packet16f)
+EIGEN_AVX512_SPLIT_FUNCTION(pexp, Packet16f)
+EIGEN_AVX512_SPLIT_FUNCTION(psin, Packet16f)
+EIGEN_AVX512_SPLIT_FUNCTION(pcos, Packet16f)
+EIGEN_AVX512_SPLIT_FUNCTION(plog, Packet8d)
+EIGEN_AVX512_SPLIT_FUNCTION(pexp, Packet8d)
+EIGEN_AVX512_SPLIT_FUNCTION(psin, Packet8d)
+EIGEN_AVX512_SPLIT_FUNCTION(pcos, Packet8d)
+
+#undef EIGEN_AVX512_SPLIT_FUNCTION
+
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet16f psqrt<Packet16f>(const Packet16f& _x)
+{
+#if EIGEN_FAST_MATH
+  // one Newton iteration on top of the 14 bits approximation of the inverse square root
+  Packet16f half = pmul(_x, pset1<Packet16f>(.5f));
+
+  /* select only the inverse sqrt of non-zero inputs */
+  __mmask16 non_zero_mask = _mm512_cmp_ps_mask(_x, pset1<Packet16f>((std::numeric_limits<float>::min)()), _CMP_GE_OQ);
+  Packet16f x = _mm512_maskz_mov_ps(non_zero_mask, _mm512_rsqrt14_ps(_x));
+
+  x = pmul(x, psub(pset1<Packet16f>(1.5f), pmul(half, pmul(x,x))));
+  return pmul(_x,x);
+#else
+  return _mm512_sqrt_ps(_x);
+#endif
+}
+
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet8d psqrt<Packet8d>(const Packet8d& x)
+{
+  return _mm512_sqrt_pd(x);
+}
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_MATH_FUNCTIONS_AVX512_H
@@ -0,0 +1,352 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2008-2009 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_PACKET_MATH_AVX512_H
+#define EIGEN_PACKET_MATH_AVX512_H
+
+namespace Eigen {
+
+namespace internal {
+
+// The AVX512 backend is included after the SSE and AVX ones: floats and doubles are vectorized
+// over 512 bits, their complex counterparts keep using the 256 bits AVX packets, and integers
+// the 128 bits SSE ones.
+
+typedef __m512  Packet16f;
+typedef __m512i Packet16i;
+typedef __m512d Packet8d;
+
+template<> struct is_arithmetic<__m512>  { enum { value = true }; };
+template<> struct is_arithmetic<__m512i> { enum { value = true }; };
+template<> struct is_arithmetic<__m512d> { enum { value = true }; };
+
+#define _EIGEN_DECLARE_CONST_Packet16f(NAME,X) \
+  const Packet16f p16f_##NAME = pset1<Packet16f>(X)
+
+#define _EIGEN_DECLARE_CONST_Packet8d(NAME,X) \
+  const Packet8d p8d_##NAME = pset1<Packet8d>(X)
+
+template<> struct packet_traits<float>  : default_packet_traits
+{
+  typedef Packet16f type;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size=16,
+    HasMaskedLoadStore = 1,
+
+    HasDiv  = 1,
+    HasSin  = EIGEN_FAST_MATH,
+    HasCos  = EIGEN_FAST_MATH,
+    HasTan  = EIGEN_FAST_MATH,
+    HasLog  = 1,
+    HasExp  = 1,
+    HasSqrt = 1,
+    HasPow  = EIGEN_FAST_MATH,
+    HasASin = 1,
+    HasACos = 1,
+    HasATan = 1,
+    HasTanh = 1,
+    HasLogistic = 1,
+    HasErf  = 1
+  };
+};
+template<> struct packet_traits<double> : default_packet_traits
+{
+  typedef Packet8d type;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size=8,
+    HasMaskedLoadStore = 1,
+
+    HasDiv  = 1,
+    HasSin  = EIGEN_FAST_MATH,
+    HasCos  = EIGEN_FAST_MATH,
+    HasTan  = EIGEN_FAST_MATH,
+    HasLog  = 1,
+    HasExp  = 1,
+    HasSqrt = 1,
+    HasPow  = EIGEN_FAST_MATH,
+    HasASin = 1,
+    HasACos = 1,
+    HasATan = 1,
+    HasTanh = 1,
+    HasLogistic = 1,
+    HasErf  = 1
+  };
+};
+
+template<> struct unpacket_traits<Packet16f> { typedef float  type; enum {size=16}; };
+template<> struct unpacket_traits<Packet8d>  { typedef double type; enum {size=8}; };
+
+// The bitwise operations on floating point registers require AVX512DQ,
+// so they are performed on integer registers.
+#define EIGEN_AVX512_BITWISE_OP(NAME,INSTR) \
+  template<> EIGEN_STRONG_INLINE Packet16f NAME<Packet16f>(const Packet16f& a, const Packet16f& b) \
+  { return _mm512_castsi512_ps(INSTR(_mm512_castps_si512(a),_mm512_castps_si512(b))); } \
+  template<> EIGEN_STRONG_INLINE Packet8d NAME<Packet8d>(const Packet8d& a, const Packet8d& b) \
+  { return _mm512_castsi512_pd(INSTR(_mm512_castpd_si512(a),_mm512_castpd_si512(b))); }
+
+EIGEN_AVX512_BITWISE_OP(pand,    _mm512_and_si512)
+EIGEN_AVX512_BITWISE_OP(por,     _mm512_or_si512)
+EIGEN_AVX512_BITWISE_OP(pxor,    _mm512_xor_si512)
+EIGEN_AVX512_BITWISE_OP(pandnot, _mm512_andnot_si512)
+
+#undef EIGEN_AVX512_BITWISE_OP
+
+// The comparisons return a bit mask, which is expanded to a full packet so that
+// the masks can be combined like on the other architectures.
+#define EIGEN_AVX512_CMP_OP(NAME,PRED) \
+  template<> EIGEN_STRONG_INLINE Packet16f NAME<Packet16f>(const Packet16f& a, const Packet16f& b) \
+  { return _mm512_castsi512_ps(_mm512_maskz_set1_epi32(_mm512_cmp_ps_mask(a,b,PRED), -1)); } \
+  template<> EIGEN_STRONG_INLINE Packet8d NAME<Packet8d>(const Packet8d& a, const Packet8d& b) \
+  { return _mm512_castsi512_pd(_mm512_maskz_set1_epi64(_mm512_cmp_pd_mask(a,b,PRED), -1)); }
+
+EIGEN_AVX512_CMP_OP(pcmp_lt, _CMP_LT_OQ)
+EIGEN_AVX512_CMP_OP(pcmp_le, _CMP_LE_OQ)
+EIGEN_AVX512_CMP_OP(pcmp_eq, _CMP_EQ_OQ)
+
+#undef EIGEN_AVX512_CMP_OP
+
+template<> EIGEN_STRONG_INLINE Packet16f pselect<Packet16f>(const Packet16f& mask, const Packet16f& a, const Packet16f& b)
+{
+  __m512i m = _mm512_castps_si512(mask);
+  return _mm512_mask_blend_ps(_mm512_test_epi32_mask(m,m), b, a);
+}
+template<> EIGEN_STRONG_INLINE Packet8d pselect<Packet8d>(const Packet8d& mask, const Packet8d& a, const Packet8d& b)
+{
+  __m512i m = _mm512_castpd_si512(mask);
+  return _mm512_mask_blend_pd(_mm512_test_epi64_mask(m,m), b, a);
+}
+
+template<> EIGEN_STRONG_INLINE Packet16f pset1<Packet16f>(const float&  from) { return _mm512_set1_ps(from); }
+template<> EIGEN_STRONG_INLINE Packet8d  pset1<Packet8d>(const double& from)  { return _mm512_set1_pd(from); }
+
+template<> EIGEN_STRONG_INLINE Packet16f plset<float>(const float& a)
+{
+  return _mm512_add_ps(pset1<Packet16f>(a), _mm512_set_ps(15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0));
+}
+template<> EIGEN_STRONG_INLINE Packet8d plset<double>(const double& a)
+{
+  return _mm512_add_pd(pset1<Packet8d>(a), _mm512_set_pd(7,6,5,4,3,2,1,0));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16f padd<Packet16f>(const Packet16f& a, const Packet16f& b) { return _mm512_add_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet8d  padd<Packet8d>(const Packet8d& a, const Packet8d& b)    { return _mm512_add_pd(a,b); }
+
+template<> EIGEN_STRONG_INLINE Packet16f psub<Packet16f>(const Packet16f& a, const Packet16f& b) { return _mm512_sub_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet8d  psub<Packet8d>(const Packet8d& a, const Packet8d& b)    { return _mm512_sub_pd(a,b); }
+
+template<> EIGEN_STRONG_INLINE Packet16f pnegate(const Packet16f& a)
+{
+  return pxor(a, _mm512_castsi512_ps(_mm512_set1_epi32(0x80000000)));
+}
+template<> EIGEN_STRONG_INLINE Packet8d pnegate(const Packet8d& a)
+{
+  return pxor(a, _mm512_castsi512_pd(_mm512_set1_epi64(0x8000000000000000ULL)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16f pconj(const Packet16f& a) { return a; }
+template<> EIGEN_STRONG_INLINE Packet8d  pconj(const Packet8d& a)  { return a; }
+
+template<> EIGEN_STRONG_INLINE Packet16f pmul<Packet16f>(const Packet16f& a, const Packet16f& b) { return _mm512_mul_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet8d  pmul<Packet8d>(const Packet8d& a, const Packet8d& b)    { return _mm512_mul_pd(a,b); }
+
+template<> EIGEN_STRONG_INLINE Packet16f pdiv<Packet16f>(const Packet16f& a, const Packet16f& b) { return _mm512_div_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet8d  pdiv<Packet8d>(const Packet8d& a, const Packet8d& b)    { return _mm512_div_pd(a,b); }
+
+// AVX512F always comes with fused multiply-add
+template<> EIGEN_STRONG_INLINE Packet16f pmadd(const Packet16f& a, const Packet16f& b, const Packet16f& c) { return _mm512_fmadd_ps(a,b,c); }
+template<> EIGEN_STRONG_INLINE Packet8d  pmadd(const Packet8d& a, const Packet8d& b, const Packet8d& c)    { return _mm512_fmadd_pd(a,b,c); }
+
+template<> EIGEN_STRONG_INLINE Packet16f pmin<Packet16f>(const Packet16f& a, const Packet16f& b) { return _mm512_min_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet8d  pmin<Packet8d>(const Packet8d& a, const Packet8d& b)    { return _mm512_min_pd(a,b); }
+
+template<> EIGEN_STRONG_INLINE Packet16f pmax<Packet16f>(const Packet16f& a, const Packet16f& b) { return _mm512_max_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet8d  pmax<Packet8d>(const Packet8d& a, const Packet8d& b)    { return _mm512_max_pd(a,b); }
+
+template<> EIGEN_STRONG_INLINE Packet16f pload<Packet16f>(const float*  from) { EIGEN_DEBUG_ALIGNED_LOAD return _mm512_load_ps(from); }
+template<> EIGEN_STRONG_INLINE Packet8d  pload<Packet8d>(const double*  from) { EIGEN_DEBUG_ALIGNED_LOAD return _mm512_load_pd(from); }
+
+template<> EIGEN_STRONG_INLINE Packet16f ploadu<Packet16f>(const float* from) { EIGEN_DEBUG_UNALIGNED_LOAD return _mm512_loadu_ps(from); }
+template<> EIGEN_STRONG_INLINE Packet8d  ploadu<Packet8d>(const double* from) { EIGEN_DEBUG_UNALIGNED_LOAD return _mm512_loadu_pd(from); }
+
+// Loads 8 floats from memory and returns the packet {a0, a0, a1, a1, ..., a7, a7}
+template<> EIGEN_STRONG_INLINE Packet16f ploaddup<Packet16f>(const float* from)
+{
+  return _mm512_permutexvar_ps(_mm512_set_epi32(7,7,6,6,5,5,4,4,3,3,2,2,1,1,0,0),
+                               _mm512_castps256_ps512(_mm256_loadu_ps(from)));
+}
+// Loads 4 doubles from memory and returns the packet {a0, a0, a1, a1, a2, a2, a3, a3}
+template<> EIGEN_STRONG_INLINE Packet8d ploaddup<Packet8d>(const double* from)
+{
+  return _mm512_permutexvar_pd(_mm512_set_epi64(3,3,2,2,1,1,0,0),
+                               _mm512_castpd256_pd512(_mm256_loadu_pd(from)));
+}
+
+template<> EIGEN_STRONG_INLINE void pstore<float>(float*   to, const Packet16f& from) { EIGEN_DEBUG_ALIGNED_STORE _mm512_store_ps(to, from); }
+template<> EIGEN_STRONG_INLINE void pstore<double>(double* to, const Packet8d& from)  { EIGEN_DEBUG_ALIGNED_STORE _mm512_store_pd(to, from); }
+
+template<> EIGEN_STRONG_INLINE void pstoreu<float>(float*   to, const Packet16f& from) { EIGEN_DEBUG_UNALIGNED_STORE _mm512_storeu_ps(to, from); }
+template<> EIGEN_STRONG_INLINE void pstoreu<double>(double* to, const Packet8d& from)  { EIGEN_DEBUG_UNALIGNED_STORE _mm512_storeu_pd(to, from); }
+
+// Masked loads and stores: the lanes which are not selected by the mask are neither read nor written,
+// so that the partial packets never touch memory past the end of the arrays.
+EIGEN_STRONG_INLINE __mmask16 avx512_first_lanes_mask16(DenseIndex n) { return n>=16 ? __mmask16(0xffff) : __mmask16((1u<<n)-1); }
+EIGEN_STRONG_INLINE __mmask8  avx512_first_lanes_mask8(DenseIndex n)  { return n>=8  ? __mmask8(0xff)    : __mmask8((1u<<n)-1); }
+
+template<> EIGEN_STRONG_INLINE Packet16f ploadu_partial<Packet16f>(const float* from, DenseIndex n)
+{
+  EIGEN_DEBUG_UNALIGNED_LOAD return _mm512_maskz_loadu_ps(avx512_first_lanes_mask16(n), from);
+}
+template<> EIGEN_STRONG_INLINE Packet8d ploadu_partial<Packet8d>(const double* from, DenseIndex n)
+{
+  EIGEN_DEBUG_UNALIGNED_LOAD return _mm512_maskz_loadu_pd(avx512_first_lanes_mask8(n), from);
+}
+
+template<> EIGEN_STRONG_INLINE void pstoreu_partial<float>(float* to, const Packet16f& from, DenseIndex n)
+{
+  EIGEN_DEBUG_UNALIGNED_STORE _mm512_mask_storeu_ps(to, avx512_first_lanes_mask16(n), from);
+}
+template<> EIGEN_STRONG_INLINE void pstoreu_partial<double>(double* to, const Packet8d& from, DenseIndex n)
+{
+  EIGEN_DEBUG_UNALIGNED_STORE _mm512_mask_storeu_pd(to, avx512_first_lanes_mask8(n), from);
+}
+
+template<> EIGEN_STRONG_INLINE void pstore1<Packet16f>(float* to, const float& a)
+{
+  pstore(to, pset1<Packet16f>(a));
+}
+template<> EIGEN_STRONG_INLINE void pstore1<Packet8d>(double* to, const double& a)
+{
+  pstore(to, pset1<Packet8d>(a));
+}
+
+template<> EIGEN_STRONG_INLINE float  pfirst<Packet16f>(const Packet16f& a) { return _mm_cvtss_f32(_mm512_castps512_ps128(a)); }
+template<> EIGEN_STRONG_INLINE double pfirst<Packet8d>(const Packet8d& a)   { return _mm_cvtsd_f64(_mm512_castpd512_pd128(a)); }
+
+template<> EIGEN_STRONG_INLINE Packet16f preverse(const Packet16f& a)
+{
+  return _mm512_permutexvar_ps(_mm512_set_epi32(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15), a);
+}
+template<> EIGEN_STRONG_INLINE Packet8d preverse(const Packet8d& a)
+{
+  return _mm512_permutexvar_pd(_mm512_set_epi64(0,1,2,3,4,5,6,7), a);
+}
+
+template<> EIGEN_STRONG_INLINE Packet16f pabs(const Packet16f& a)
+{
+  return pand(a, _mm512_castsi512_ps(_mm512_set1_epi32(0x7FFFFFFF)));
+}
+template<> EIGEN_STRONG_INLINE Packet8d pabs(const Packet8d& a)
+{
+  return pand(a, _mm512_castsi512_pd(_mm512_set1_epi64(0x7FFFFFFFFFFFFFFFLL)));
+}
+
+// The 256 bits halves of the packets. Only AVX512F instructions are used here,
+// the 32 bits flavors of the extractions require AVX512DQ.
+EIGEN_STRONG_INLINE Packet8f avx512_lower_half(const Packet16f& a) { return _mm512_castps512_ps256(a); }
+EIGEN_STRONG_INLINE Packet8f avx512_upper_half(const Packet16f& a) { return _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(a),1)); }
+EIGEN_STRONG_INLINE Packet4d avx512_lower_half(const Packet8d& a)  { return _mm512_castpd512_pd256(a); }
+EIGEN_STRONG_INLINE Packet4d avx512_upper_half(const Packet8d& a)  { return _mm512_extractf64x4_pd(a,1); }
+EIGEN_STRONG_INLINE Packet16f avx512_combine(const Packet8f& lo, const Packet8f& hi)
+{
+  return _mm512_castpd_ps(_mm512_insertf64x4(_mm512_castps_pd(_mm512_castps256_ps512(lo)), _mm256_castps_pd(hi), 1));
+}
+EIGEN_STRONG_INLINE Packet8d avx512_combine(const Packet4d& lo, const Packet4d& hi)
+{
+  return _mm512_insertf64x4(_mm512_castpd256_pd512(lo), hi, 1);
+}
+
+// preduxp: the 512 bits packets are first folded onto 256 bits ones, then the AVX implementation does the rest.
+template<> EIGEN_STRONG_INLINE Packet16f preduxp<Packet16f>(const Packet16f* vecs)
+{
+  Packet8f halves[16];
+  for(int i=0; i<16; ++i)
+    halves[i] = _mm256_add_ps(avx512_lower_half(vecs[i]), avx512_upper_half(vecs[i]));
+  return avx512_combine(preduxp(halves), preduxp(halves+8));
+}
+template<> EIGEN_STRONG_INLINE Packet8d preduxp<Packet8d>(const Packet8d* vecs)
+{
+  Packet4d halves[8];
+  for(int i=0; i<8; ++i)
+    halves[i] = _mm256_add_pd(avx512_lower_half(vecs[i]), avx512_upper_half(vecs[i]));
+  return avx512_combine(preduxp(halves), preduxp(halves+4));
+}
+
+// The horizontal reductions first fold the upper 256 bits onto the lower ones,
+// and then reuse the AVX implementations.
+
+// sum
+template<> EIGEN_STRONG_INLINE float predux<Packet16f>(const Packet16f& a)
+{
+  return predux(_mm256_add_ps(avx512_lower_half(a), avx512_upper_half(a)));
+}
+template<> EIGEN_STRONG_INLINE double predux<Packet8d>(const Packet8d& a)
+{
+  return predux(_mm256_add_pd(avx512_lower_half(a), avx512_upper_half(a)));
+}
+
+// mul
+template<> EIGEN_STRONG_INLINE float predux_mul<Packet16f>(const Packet16f& a)
+{
+  return predux_mul(_mm256_mul_ps(avx512_lower_half(a), avx512_upper_half(a)));
+}
+template<> EIGEN_STRONG_INLINE double predux_mul<Packet8d>(const Packet8d& a)
+{
+  return predux_mul(_mm256_mul_pd(avx512_lower_half(a), avx512_upper_half(a)));
+}
+
+// min
+template<> EIGEN_STRONG_INLINE float predux_min<Packet16f>(const Packet16f& a)
+{
+  return predux_min(_mm256_min_ps(avx512_lower_half(a), avx512_upper_half(a)));
+}
+template<> EIGEN_STRONG_INLINE double predux_min<Packet8d>(const Packet8d& a)
+{
+  return predux_min(_mm256_min_pd(avx512_lower_half(a), avx512_upper_half(a)));
+}
+
+// max
+template<> EIGEN_STRONG_INLINE float predux_max<Packet16f>(const Packet16f& a)
+{
+  return predux_max(_mm256_max_ps(avx512_lower_half(a), avx512_upper_half(a)));
+}
+template<> EIGEN_STRONG_INLINE double predux_max<Packet8d>(const Packet8d& a)
+{
+  return predux_max(_mm256_max_pd(avx512_lower_half(a), avx512_upper_half(a)));
+}
+
+// valignd/valignq shift the concatenation of two full 512 bits registers.
+template<int Offset>
+struct palign_impl<Offset,Packet16f>
+{
+  static EIGEN_STRONG_INLINE void run(Packet16f& first, const Packet16f& second)
+  {
+    if (Offset!=0)
+      first = _mm512_castsi512_ps(_mm512_alignr_epi32(_mm512_castps_si512(second), _mm512_castps_si512(first), Offset));
+  }
+};
+
+template<int Offset>
+struct palign_impl<Offset,Packet8d>
+{
+  static EIGEN_STRONG_INLINE void run(Packet8d& first, const Packet8d& second)
+  {
+    if (Offset!=0)
+      first = _mm512_castsi512_pd(_mm512_alignr_epi64(_mm512_castpd_si512(second), _mm512_castpd_si512(first), Offset));
+  }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_PACKET_MATH_AVX512_H
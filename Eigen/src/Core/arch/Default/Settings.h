@@ -38,6 +38,14 @@
 #define EIGEN_TUNE_TRIANGULAR_PANEL_WIDTH 8
 #endif
 
+/** Defines the size in bytes of the blocks of the matrix processed at once by the product of a matrix
+  * by several vectors, such that each block is read only once from the memory while it is multiplied by all
+  * the vectors. It should fit into the L2 cache. The default is 256KB.
+  */
+#ifndef EIGEN_TUNE_GEMV_BLOCK_SIZE
+#define EIGEN_TUNE_GEMV_BLOCK_SIZE (256*1024)
+#endif
+
 
 /** Defines the default number of registers available for that architecture.
   * Currently it must be 8 or 16. Other values will fail.
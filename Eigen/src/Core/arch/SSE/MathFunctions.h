@@ -103,6 +103,93 @@ Packet4f plog<Packet4f>(const Packet4f& _x)
                    _mm_and_ps(iszero_mask, p4f_minus_inf));
 }
 
+/* natural logarithm computed for 2 simultaneous doubles, this is the rewriting
+   of the cephes log function: log(1+x) = x - x^2/2 + x^3 P(x)/Q(x) on [sqrt(1/2)-1, sqrt(2)-1]
+   after extraction of the exponent.
+   Unlike the float version, denormalized numbers are scaled into the normalized range,
+   negative and NaN arguments give NaN, 0 gives -INF and +INF gives +INF.
+*/
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet2d plog<Packet2d>(const Packet2d& _x)
+{
+  Packet2d x = _x;
+  _EIGEN_DECLARE_CONST_Packet2d(1 , 1.0);
+  _EIGEN_DECLARE_CONST_Packet2d(half, 0.5);
+  _EIGEN_DECLARE_CONST_Packet2d(52, 52.0);
+  _EIGEN_DECLARE_CONST_Packet2d(2p52, 4503599627370496.0);
+  _EIGEN_DECLARE_CONST_Packet2d(min_norm_pos, (std::numeric_limits<double>::min)());
+  _EIGEN_DECLARE_CONST_Packet2d(inf, std::numeric_limits<double>::infinity());
+  _EIGEN_DECLARE_CONST_Packet2d(minus_inf, -std::numeric_limits<double>::infinity());
+  _EIGEN_DECLARE_CONST_Packet4i(1022, 1022);
+  static const Packet2d p2d_inv_mant_mask = _mm_castsi128_pd(_mm_setr_epi32(-1, ~0x7ff00000, -1, ~0x7ff00000));
+
+  _EIGEN_DECLARE_CONST_Packet2d(cephes_SQRTHF, 0.70710678118654752440);
+  _EIGEN_DECLARE_CONST_Packet2d(cephes_log_p0, 1.01875663804580931796E-4);
+  _EIGEN_DECLARE_CONST_Packet2d(cephes_log_p1, 4.97494994976747001425E-1);
+  _EIGEN_DECLARE_CONST_Packet2d(cephes_log_p2, 4.70579119878881725854E0);
+  _EIGEN_DECLARE_CONST_Packet2d(cephes_log_p3, 1.44989225341610930846E1);
+  _EIGEN_DECLARE_CONST_Packet2d(cephes_log_p4, 1.79368678507819816313E1);
+  _EIGEN_DECLARE_CONST_Packet2d(cephes_log_p5, 7.70838733755885391666E0);
+  _EIGEN_DECLARE_CONST_Packet2d(cephes_log_q0, 1.12873587189167450590E1);
+  _EIGEN_DECLARE_CONST_Packet2d(cephes_log_q1, 4.52279145837532221105E1);
+  _EIGEN_DECLARE_CONST_Packet2d(cephes_log_q2, 8.29875266912776603211E1);
+  _EIGEN_DECLARE_CONST_Packet2d(cephes_log_q3, 7.11544750618563894466E1);
+  _EIGEN_DECLARE_CONST_Packet2d(cephes_log_q4, 2.31251620126765340583E1);
+  _EIGEN_DECLARE_CONST_Packet2d(cephes_log_C1, -2.121944400546905827679E-4);
+  _EIGEN_DECLARE_CONST_Packet2d(cephes_log_C2, 0.693359375);
+
+  Packet2d invalid_mask = _mm_cmpnge_pd(x, _mm_setzero_pd());
+  Packet2d iszero_mask = _mm_cmpeq_pd(x, _mm_setzero_pd());
+  Packet2d isinf_mask = _mm_cmpeq_pd(x, p2d_inf);
+
+  /* scale the denormalized numbers by 2^52 */
+  Packet2d denorm_mask = _mm_cmplt_pd(x, p2d_min_norm_pos);
+  x = _mm_or_pd(_mm_andnot_pd(denorm_mask, x), _mm_and_pd(denorm_mask, pmul(x, p2d_2p52)));
+
+  /* the exponents are in the upper 32 bits of the doubles */
+  Packet4i emm0 = _mm_castps_si128(_mm_shuffle_ps(_mm_castpd_ps(x), _mm_castpd_ps(x), _MM_SHUFFLE(3,1,3,1)));
+  emm0 = _mm_srli_epi32(emm0, 20);
+  emm0 = _mm_sub_epi32(emm0, p4i_1022);
+  Packet2d e = psub(_mm_cvtepi32_pd(emm0), _mm_and_pd(denorm_mask, p2d_52));
+
+  /* keep only the fractional part */
+  x = _mm_and_pd(x, p2d_inv_mant_mask);
+  x = _mm_or_pd(x, p2d_half);
+
+  /* if( x < SQRTHF ) { e -= 1; x = x + x - 1.0; } else { x = x - 1.0; } */
+  Packet2d mask = _mm_cmplt_pd(x, p2d_cephes_SQRTHF);
+  Packet2d tmp = _mm_and_pd(x, mask);
+  x = psub(x, p2d_1);
+  e = psub(e, _mm_and_pd(p2d_1, mask));
+  x = padd(x, tmp);
+
+  Packet2d x2 = pmul(x,x);
+
+  Packet2d px = p2d_cephes_log_p0;
+  px = pmadd(px, x, p2d_cephes_log_p1);
+  px = pmadd(px, x, p2d_cephes_log_p2);
+  px = pmadd(px, x, p2d_cephes_log_p3);
+  px = pmadd(px, x, p2d_cephes_log_p4);
+  px = pmadd(px, x, p2d_cephes_log_p5);
+
+  Packet2d qx = padd(x, p2d_cephes_log_q0);
+  qx = pmadd(qx, x, p2d_cephes_log_q1);
+  qx = pmadd(qx, x, p2d_cephes_log_q2);
+  qx = pmadd(qx, x, p2d_cephes_log_q3);
+  qx = pmadd(qx, x, p2d_cephes_log_q4);
+
+  Packet2d y = pmul(x, pdiv(pmul(x2, px), qx));
+  y = pmadd(e, p2d_cephes_log_C1, y);
+  y = psub(y, pmul(x2, p2d_half));
+  x = padd(x, y);
+  x = pmadd(e, p2d_cephes_log_C2, x);
+
+  x = _mm_or_pd(x, invalid_mask);
+  Packet2d special_mask = _mm_or_pd(iszero_mask, isinf_mask);
+  return _mm_or_pd(_mm_andnot_pd(special_mask, x),
+                   _mm_or_pd(_mm_and_pd(iszero_mask, p2d_minus_inf), _mm_and_pd(isinf_mask, p2d_inf)));
+}
+
 template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
 Packet4f pexp<Packet4f>(const Packet4f& _x)
 {
@@ -442,6 +529,219 @@ Packet4f pcos<Packet4f>(const Packet4f& _x)
   return _mm_xor_ps(y, sign_bit);
 }
 
+/* \internal returns \a y, where the coefficients for which the packet sine and cosine of \a x are not
+   accurate, that is |x| >= 2^30 and the infinite and NaN ones, are replaced by the scalar \a func of \a x */
+EIGEN_STRONG_INLINE Packet2d psincos_large_arguments(const Packet2d& x, const Packet2d& y, double (*func)(double))
+{
+  if(_mm_movemask_pd(_mm_cmpnlt_pd(pabs(x), pset1<Packet2d>(1073741824.0)))==0)
+    return y;
+  EIGEN_ALIGN16 double xs[2], ys[2];
+  pstore(xs, x);
+  pstore(ys, y);
+  for(int i=0; i<2; ++i)
+    if(!(std::abs(xs[i]) < 1073741824.0))
+      ys[i] = func(xs[i]);
+  return pload<Packet2d>(ys);
+}
+
+/* evaluation of 2 double precision sines at once, this is the rewriting of the cephes sin
+   function, following the same structure as the float version above.
+   The reduction modulo Pi/4 uses a three terms Cody-Waite splitting of Pi/4, so that the
+   precision is within a couple of ULP as long as |x| < 2^30. Beyond, the quadrant index
+   overflows the 32 bits integers, and these arguments are passed to std::sin instead.
+*/
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet2d psin<Packet2d>(const Packet2d& _x)
+{
+  Packet2d x = _x;
+  _EIGEN_DECLARE_CONST_Packet2d(1 , 1.0);
+  _EIGEN_DECLARE_CONST_Packet2d(half, 0.5);
+
+  _EIGEN_DECLARE_CONST_Packet4i(1, 1);
+  _EIGEN_DECLARE_CONST_Packet4i(not1, ~1);
+  _EIGEN_DECLARE_CONST_Packet4i(2, 2);
+  _EIGEN_DECLARE_CONST_Packet4i(4, 4);
+
+  static const Packet2d p2d_sign_mask = _mm_castsi128_pd(_mm_setr_epi32(0, 0x80000000, 0, 0x80000000));
+
+  _EIGEN_DECLARE_CONST_Packet2d(minus_cephes_DP1, -7.85398125648498535156E-1);
+  _EIGEN_DECLARE_CONST_Packet2d(minus_cephes_DP2, -3.77489470793079817668E-8);
+  _EIGEN_DECLARE_CONST_Packet2d(minus_cephes_DP3, -2.69515142907905952645E-15);
+  _EIGEN_DECLARE_CONST_Packet2d(sincof_p0,  1.58962301576546568060E-10);
+  _EIGEN_DECLARE_CONST_Packet2d(sincof_p1, -2.50507477628578072866E-8);
+  _EIGEN_DECLARE_CONST_Packet2d(sincof_p2,  2.75573136213857245213E-6);
+  _EIGEN_DECLARE_CONST_Packet2d(sincof_p3, -1.98412698295895385996E-4);
+  _EIGEN_DECLARE_CONST_Packet2d(sincof_p4,  8.33333333332211858878E-3);
+  _EIGEN_DECLARE_CONST_Packet2d(sincof_p5, -1.66666666666666307295E-1);
+  _EIGEN_DECLARE_CONST_Packet2d(coscof_p0, -1.13585365213876817300E-11);
+  _EIGEN_DECLARE_CONST_Packet2d(coscof_p1,  2.08757008419747316778E-9);
+  _EIGEN_DECLARE_CONST_Packet2d(coscof_p2, -2.75573141792967388112E-7);
+  _EIGEN_DECLARE_CONST_Packet2d(coscof_p3,  2.48015872888517045348E-5);
+  _EIGEN_DECLARE_CONST_Packet2d(coscof_p4, -1.38888888888730564116E-3);
+  _EIGEN_DECLARE_CONST_Packet2d(coscof_p5,  4.16666666666665929218E-2);
+  _EIGEN_DECLARE_CONST_Packet2d(cephes_FOPI, 1.27323954473516268615); // 4 / M_PI
+
+  Packet2d sign_bit, y;
+  Packet4i emm0, emm2;
+
+  /* extract the sign bit and take the absolute value */
+  sign_bit = _mm_and_pd(x, p2d_sign_mask);
+  x = pabs(x);
+
+  /* scale by 4/Pi */
+  y = pmul(x, p2d_cephes_FOPI);
+
+  /* store the integer part of y in the two lower words of emm2 */
+  emm2 = _mm_cvttpd_epi32(y);
+  /* j=(j+1) & (~1) (see the cephes sources) */
+  emm2 = _mm_add_epi32(emm2, p4i_1);
+  emm2 = _mm_and_si128(emm2, p4i_not1);
+  y = _mm_cvtepi32_pd(emm2);
+  /* get the swap sign flag and the polynom selection mask, and spread them
+     over the upper, respectively both, words of the doubles */
+  emm0 = _mm_and_si128(emm2, p4i_4);
+  emm0 = _mm_slli_epi32(emm0, 29);
+  emm0 = _mm_unpacklo_epi32(_mm_setzero_si128(), emm0);
+  emm2 = _mm_and_si128(emm2, p4i_2);
+  emm2 = _mm_cmpeq_epi32(emm2, _mm_setzero_si128());
+  emm2 = _mm_unpacklo_epi32(emm2, emm2);
+
+  Packet2d swap_sign_bit = _mm_castsi128_pd(emm0);
+  Packet2d poly_mask = _mm_castsi128_pd(emm2);
+  sign_bit = _mm_xor_pd(sign_bit, swap_sign_bit);
+
+  /* Extended precision modular arithmetic: x = ((x - y * DP1) - y * DP2) - y * DP3; */
+  x = pmadd(y, p2d_minus_cephes_DP1, x);
+  x = pmadd(y, p2d_minus_cephes_DP2, x);
+  x = pmadd(y, p2d_minus_cephes_DP3, x);
+
+  /* Evaluate the first polynom  (0 <= x <= Pi/4) */
+  Packet2d z = pmul(x,x);
+  y = p2d_coscof_p0;
+  y = pmadd(y, z, p2d_coscof_p1);
+  y = pmadd(y, z, p2d_coscof_p2);
+  y = pmadd(y, z, p2d_coscof_p3);
+  y = pmadd(y, z, p2d_coscof_p4);
+  y = pmadd(y, z, p2d_coscof_p5);
+  y = pmul(y, z);
+  y = pmul(y, z);
+  y = psub(y, pmul(z, p2d_half));
+  y = padd(y, p2d_1);
+
+  /* Evaluate the second polynom  (Pi/4 <= x <= 0) */
+  Packet2d y2 = p2d_sincof_p0;
+  y2 = pmadd(y2, z, p2d_sincof_p1);
+  y2 = pmadd(y2, z, p2d_sincof_p2);
+  y2 = pmadd(y2, z, p2d_sincof_p3);
+  y2 = pmadd(y2, z, p2d_sincof_p4);
+  y2 = pmadd(y2, z, p2d_sincof_p5);
+  y2 = pmul(y2, z);
+  y2 = pmadd(y2, x, x);
+
+  /* select the correct result from the two polynoms */
+  y2 = _mm_and_pd(poly_mask, y2);
+  y = _mm_andnot_pd(poly_mask, y);
+  y = _mm_or_pd(y,y2);
+  /* update the sign */
+  return psincos_large_arguments(_x, _mm_xor_pd(y, sign_bit), std::sin);
+}
+
+/* almost the same as psin */
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet2d pcos<Packet2d>(const Packet2d& _x)
+{
+  Packet2d x = _x;
+  _EIGEN_DECLARE_CONST_Packet2d(1 , 1.0);
+  _EIGEN_DECLARE_CONST_Packet2d(half, 0.5);
+
+  _EIGEN_DECLARE_CONST_Packet4i(1, 1);
+  _EIGEN_DECLARE_CONST_Packet4i(not1, ~1);
+  _EIGEN_DECLARE_CONST_Packet4i(2, 2);
+  _EIGEN_DECLARE_CONST_Packet4i(4, 4);
+
+  _EIGEN_DECLARE_CONST_Packet2d(minus_cephes_DP1, -7.85398125648498535156E-1);
+  _EIGEN_DECLARE_CONST_Packet2d(minus_cephes_DP2, -3.77489470793079817668E-8);
+  _EIGEN_DECLARE_CONST_Packet2d(minus_cephes_DP3, -2.69515142907905952645E-15);
+  _EIGEN_DECLARE_CONST_Packet2d(sincof_p0,  1.58962301576546568060E-10);
+  _EIGEN_DECLARE_CONST_Packet2d(sincof_p1, -2.50507477628578072866E-8);
+  _EIGEN_DECLARE_CONST_Packet2d(sincof_p2,  2.75573136213857245213E-6);
+  _EIGEN_DECLARE_CONST_Packet2d(sincof_p3, -1.98412698295895385996E-4);
+  _EIGEN_DECLARE_CONST_Packet2d(sincof_p4,  8.33333333332211858878E-3);
+  _EIGEN_DECLARE_CONST_Packet2d(sincof_p5, -1.66666666666666307295E-1);
+  _EIGEN_DECLARE_CONST_Packet2d(coscof_p0, -1.13585365213876817300E-11);
+  _EIGEN_DECLARE_CONST_Packet2d(coscof_p1,  2.08757008419747316778E-9);
+  _EIGEN_DECLARE_CONST_Packet2d(coscof_p2, -2.75573141792967388112E-7);
+  _EIGEN_DECLARE_CONST_Packet2d(coscof_p3,  2.48015872888517045348E-5);
+  _EIGEN_DECLARE_CONST_Packet2d(coscof_p4, -1.38888888888730564116E-3);
+  _EIGEN_DECLARE_CONST_Packet2d(coscof_p5,  4.16666666666665929218E-2);
+  _EIGEN_DECLARE_CONST_Packet2d(cephes_FOPI, 1.27323954473516268615); // 4 / M_PI
+
+  Packet2d y;
+  Packet4i emm0, emm2;
+
+  x = pabs(x);
+
+  /* scale by 4/Pi */
+  y = pmul(x, p2d_cephes_FOPI);
+
+  /* get the integer part of y */
+  emm2 = _mm_cvttpd_epi32(y);
+  /* j=(j+1) & (~1) (see the cephes sources) */
+  emm2 = _mm_add_epi32(emm2, p4i_1);
+  emm2 = _mm_and_si128(emm2, p4i_not1);
+  y = _mm_cvtepi32_pd(emm2);
+
+  emm2 = _mm_sub_epi32(emm2, p4i_2);
+
+  /* get the swap sign flag */
+  emm0 = _mm_andnot_si128(emm2, p4i_4);
+  emm0 = _mm_slli_epi32(emm0, 29);
+  emm0 = _mm_unpacklo_epi32(_mm_setzero_si128(), emm0);
+  /* get the polynom selection mask */
+  emm2 = _mm_and_si128(emm2, p4i_2);
+  emm2 = _mm_cmpeq_epi32(emm2, _mm_setzero_si128());
+  emm2 = _mm_unpacklo_epi32(emm2, emm2);
+
+  Packet2d sign_bit = _mm_castsi128_pd(emm0);
+  Packet2d poly_mask = _mm_castsi128_pd(emm2);
+
+  /* Extended precision modular arithmetic: x = ((x - y * DP1) - y * DP2) - y * DP3; */
+  x = pmadd(y, p2d_minus_cephes_DP1, x);
+  x = pmadd(y, p2d_minus_cephes_DP2, x);
+  x = pmadd(y, p2d_minus_cephes_DP3, x);
+
+  /* Evaluate the first polynom  (0 <= x <= Pi/4) */
+  Packet2d z = pmul(x,x);
+  y = p2d_coscof_p0;
+  y = pmadd(y, z, p2d_coscof_p1);
+  y = pmadd(y, z, p2d_coscof_p2);
+  y = pmadd(y, z, p2d_coscof_p3);
+  y = pmadd(y, z, p2d_coscof_p4);
+  y = pmadd(y, z, p2d_coscof_p5);
+  y = pmul(y, z);
+  y = pmul(y, z);
+  y = psub(y, pmul(z, p2d_half));
+  y = padd(y, p2d_1);
+
+  /* Evaluate the second polynom  (Pi/4 <= x <= 0) */
+  Packet2d y2 = p2d_sincof_p0;
+  y2 = pmadd(y2, z, p2d_sincof_p1);
+  y2 = pmadd(y2, z, p2d_sincof_p2);
+  y2 = pmadd(y2, z, p2d_sincof_p3);
+  y2 = pmadd(y2, z, p2d_sincof_p4);
+  y2 = pmadd(y2, z, p2d_sincof_p5);
+  y2 = pmul(y2, z);
+  y2 = pmadd(y2, x, x);
+
+  /* select the correct result from the two polynoms */
+  y2 = _mm_and_pd(poly_mask, y2);
+  y  = _mm_andnot_pd(poly_mask, y);
+  y  = _mm_or_pd(y,y2);
+
+  /* update the sign */
+  return psincos_large_arguments(_x, _mm_xor_pd(y, sign_bit), std::cos);
+}
+
 // This is based on Quake3's fast inverse square root.
 // For detail see here: http://www.beyond3d.com/content/articles/8/
 template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
@@ -457,6 +757,14 @@ Packet4f psqrt<Packet4f>(const Packet4f& _x)
   return pmul(_x,x);
 }
 
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet2d psqrt<Packet2d>(const Packet2d& x)
+{
+  // the hardware square root is correctly rounded, and there is no double precision
+  // approximation of the inverse square root to start Newton iterations from
+  return _mm_sqrt_pd(x);
+}
+
 } // end namespace internal
 
 } // end namespace Eigen
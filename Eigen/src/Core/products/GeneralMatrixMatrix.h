@@ -20,8 +20,8 @@ template<typename _LhsScalar, typename _RhsScalar> class level3_blocking;
 template<
   typename Index,
   typename LhsScalar, int LhsStorageOrder, bool ConjugateLhs,
-  typename RhsScalar, int RhsStorageOrder, bool ConjugateRhs>
-struct general_matrix_matrix_product<Index,LhsScalar,LhsStorageOrder,ConjugateLhs,RhsScalar,RhsStorageOrder,ConjugateRhs,RowMajor>
+  typename RhsScalar, int RhsStorageOrder, bool ConjugateRhs, int Version>
+struct general_matrix_matrix_product<Index,LhsScalar,LhsStorageOrder,ConjugateLhs,RhsScalar,RhsStorageOrder,ConjugateRhs,RowMajor,Version>
 {
   typedef typename scalar_product_traits<LhsScalar, RhsScalar>::ReturnType ResScalar;
   static EIGEN_STRONG_INLINE void run(
@@ -31,14 +31,14 @@ struct general_matrix_matrix_product<Index,LhsScalar,LhsStorageOrder,ConjugateLh
     ResScalar* res, Index resStride,
     ResScalar alpha,
     level3_blocking<RhsScalar,LhsScalar>& blocking,
-    GemmParallelInfo<Index>* info = 0)
+    GemmParallelInfo<Index>* info = 0, Index tid = 0, Index threads = 1)
   {
     // transpose the product such that the result is column major
     general_matrix_matrix_product<Index,
       RhsScalar, RhsStorageOrder==RowMajor ? ColMajor : RowMajor, ConjugateRhs,
       LhsScalar, LhsStorageOrder==RowMajor ? ColMajor : RowMajor, ConjugateLhs,
-      ColMajor>
-    ::run(cols,rows,depth,rhs,rhsStride,lhs,lhsStride,res,resStride,alpha,blocking,info);
+      ColMajor,Version>
+    ::run(cols,rows,depth,rhs,rhsStride,lhs,lhsStride,res,resStride,alpha,blocking,info,tid,threads);
   }
 };
 
@@ -47,8 +47,8 @@ struct general_matrix_matrix_product<Index,LhsScalar,LhsStorageOrder,ConjugateLh
 template<
   typename Index,
   typename LhsScalar, int LhsStorageOrder, bool ConjugateLhs,
-  typename RhsScalar, int RhsStorageOrder, bool ConjugateRhs>
-struct general_matrix_matrix_product<Index,LhsScalar,LhsStorageOrder,ConjugateLhs,RhsScalar,RhsStorageOrder,ConjugateRhs,ColMajor>
+  typename RhsScalar, int RhsStorageOrder, bool ConjugateRhs, int Version>
+struct general_matrix_matrix_product<Index,LhsScalar,LhsStorageOrder,ConjugateLhs,RhsScalar,RhsStorageOrder,ConjugateRhs,ColMajor,Version>
 {
 
 typedef typename scalar_product_traits<LhsScalar, RhsScalar>::ReturnType ResScalar;
@@ -58,7 +58,7 @@ static void run(Index rows, Index cols, Index depth,
   ResScalar* res, Index resStride,
   ResScalar alpha,
   level3_blocking<LhsScalar,RhsScalar>& blocking,
-  GemmParallelInfo<Index>* info = 0)
+  GemmParallelInfo<Index>* info = 0, Index tid = 0, Index threads = 1)
 {
   const_blas_data_mapper<LhsScalar, Index, LhsStorageOrder> lhs(_lhs,lhsStride);
   const_blas_data_mapper<RhsScalar, Index, RhsStorageOrder> rhs(_rhs,rhsStride);
@@ -73,12 +73,10 @@ static void run(Index rows, Index cols, Index depth,
   gemm_pack_rhs<RhsScalar, Index, Traits::nr, RhsStorageOrder> pack_rhs;
   gebp_kernel<LhsScalar, RhsScalar, Index, Traits::mr, Traits::nr, ConjugateLhs, ConjugateRhs> gebp;
 
-#ifdef EIGEN_HAS_OPENMP
   if(info)
   {
     // this is the parallel version!
-    Index tid = omp_get_thread_num();
-    Index threads = omp_get_num_threads();
+    // We are the thread tid of a team of threads, see parallelize_gemm().
     
     std::size_t sizeA = kc*mc;
     std::size_t sizeW = kc*Traits::WorkSpaceFactor;
@@ -109,6 +107,7 @@ static void run(Index rows, Index cols, Index depth,
       pack_rhs(blockB+info[tid].rhs_start*actual_kc, &rhs(k,info[tid].rhs_start), rhsStride, actual_kc, info[tid].rhs_length);
 
       // Notify the other threads that the part B'_j is ready to go.
+      parallel_memory_barrier();
       info[tid].sync = k;
 
       // Computes C_i += A' * B' per B'_j
@@ -140,14 +139,11 @@ static void run(Index rows, Index cols, Index depth,
       // Release all the sub blocks B'_j of B' for the current thread,
       // i.e., we simply decrement the number of users by 1
       for(Index j=0; j<threads; ++j)
-        #pragma omp atomic
-        --(info[j].users);
+        parallel_atomic_decrement(&info[j].users);
     }
   }
   else
-#endif // EIGEN_HAS_OPENMP
   {
-    EIGEN_UNUSED_VARIABLE(info);
 
     // this is the sequential version!
     std::size_t sizeA = kc*mc;
@@ -205,7 +201,7 @@ struct gemm_functor
 {
   gemm_functor(const Lhs& lhs, const Rhs& rhs, Dest& dest, const Scalar& actualAlpha,
                   BlockingType& blocking)
-    : m_lhs(lhs), m_rhs(rhs), m_dest(dest), m_actualAlpha(actualAlpha), m_blocking(blocking)
+    : m_lhs(lhs), m_rhs(rhs), m_dest(dest), m_actualAlpha(actualAlpha), m_blocking(blocking), m_partials(0), m_depthSlices(1)
   {}
 
   void initParallelSession() const
@@ -213,7 +209,57 @@ struct gemm_functor
     m_blocking.allocateB();
   }
 
-  void operator() (Index row, Index rows, Index col=0, Index cols=-1, GemmParallelInfo<Index>* info=0) const
+  /** \returns the depth of the cache blocks of the sequential product */
+  Index blockingDepth() const { return m_blocking.kc(); }
+
+  /** Prepares the independent computation of blocks of the result by runBlock(), with \a depthSlices slices along the depth */
+  void initBlockSession(Index depthSlices) const
+  {
+    m_depthSlices = depthSlices;
+    if(depthSlices>1)
+    {
+      std::size_t size = std::size_t(m_dest.rows()) * std::size_t(m_dest.cols()) * std::size_t(depthSlices-1);
+      m_partials = aligned_new<Scalar>(size);
+      std::fill(m_partials, m_partials+size, Scalar(0));
+    }
+  }
+
+  /** Adds the product of the depth slice [\a depthStart, \a depthStart + \a depth) of the lhs rows [\a row, \a row + \a rows)
+    * by the rhs columns [\a col, \a col + \a cols) to the corresponding block of the result.
+    * Unlike operator(), this function uses its own blocking space, and can thus be called simultaneously from several threads
+    * on disjoint blocks. The slices \a slice > 0 are accumulated into temporary buffers which are summed by finishBlockSession(). */
+  void runBlock(Index row, Index rows, Index col, Index cols, Index slice, Index depthStart, Index depth) const
+  {
+    typename BlockingType::DynamicBlocking blocking(rows, cols, depth);
+
+    Scalar* res = (Scalar*)&(m_dest.coeffRef(row,col));
+    Index resStride = m_dest.outerStride();
+    if(slice>0)
+    {
+      resStride = Dest::IsRowMajor ? m_dest.cols() : m_dest.rows();
+      res = m_partials + (slice-1) * m_dest.rows() * m_dest.cols() + (Dest::IsRowMajor ? row*resStride + col : col*resStride + row);
+    }
+
+    Gemm::run(rows, cols, depth,
+              &m_lhs.coeffRef(row,depthStart), m_lhs.outerStride(),
+              &m_rhs.coeffRef(depthStart,col), m_rhs.outerStride(),
+              res, resStride,
+              m_actualAlpha, blocking, 0, 0, 1);
+  }
+
+  /** Sums the depth slices computed by runBlock() into the result */
+  void finishBlockSession() const
+  {
+    typedef Map<Matrix<Scalar,Dynamic,Dynamic,Dest::IsRowMajor ? RowMajor : ColMajor> > PartialMap;
+    for(Index slice=1; slice<m_depthSlices; ++slice)
+      m_dest += PartialMap(m_partials + (slice-1) * m_dest.rows() * m_dest.cols(), m_dest.rows(), m_dest.cols());
+    if(m_partials)
+      aligned_delete(m_partials, std::size_t(m_dest.rows()) * std::size_t(m_dest.cols()) * std::size_t(m_depthSlices-1));
+    m_partials = 0;
+    m_depthSlices = 1;
+  }
+
+  void operator() (Index row, Index rows, Index col=0, Index cols=-1, GemmParallelInfo<Index>* info=0, Index tid=0, Index threads=1) const
   {
     if(cols==-1)
       cols = m_rhs.cols();
@@ -222,7 +268,7 @@ struct gemm_functor
               /*(const Scalar*)*/&m_lhs.coeffRef(row,0), m_lhs.outerStride(),
               /*(const Scalar*)*/&m_rhs.coeffRef(0,col), m_rhs.outerStride(),
               (Scalar*)&(m_dest.coeffRef(row,col)), m_dest.outerStride(),
-              m_actualAlpha, m_blocking, info);
+              m_actualAlpha, m_blocking, info, tid, threads);
   }
 
   protected:
@@ -231,6 +277,8 @@ struct gemm_functor
     Dest& m_dest;
     Scalar m_actualAlpha;
     BlockingType& m_blocking;
+    mutable Scalar* m_partials;
+    mutable Index m_depthSlices;
 };
 
 template<int StorageOrder, typename LhsScalar, typename RhsScalar, int MaxRows, int MaxCols, int MaxDepth, int KcFactor=1,
@@ -286,12 +334,14 @@ class gemm_blocking_space<StorageOrder,_LhsScalar,_RhsScalar,MaxRows, MaxCols, M
       SizeW = MaxDepth * Traits::WorkSpaceFactor
     };
 
-    EIGEN_ALIGN16 LhsScalar m_staticA[SizeA];
-    EIGEN_ALIGN16 RhsScalar m_staticB[SizeB];
-    EIGEN_ALIGN16 RhsScalar m_staticW[SizeW];
+    EIGEN_ALIGN_DEFAULT LhsScalar m_staticA[SizeA];
+    EIGEN_ALIGN_DEFAULT RhsScalar m_staticB[SizeB];
+    EIGEN_ALIGN_DEFAULT RhsScalar m_staticW[SizeW];
 
   public:
 
+    typedef gemm_blocking_space<StorageOrder,_LhsScalar,_RhsScalar,Dynamic,Dynamic,Dynamic,KcFactor> DynamicBlocking;
+
     gemm_blocking_space(DenseIndex /*rows*/, DenseIndex /*cols*/, DenseIndex /*depth*/)
     {
       this->m_mc = ActualRows;
@@ -327,6 +377,8 @@ class gemm_blocking_space<StorageOrder,_LhsScalar,_RhsScalar,MaxRows, MaxCols, M
 
   public:
 
+    typedef gemm_blocking_space DynamicBlocking;
+
     gemm_blocking_space(DenseIndex rows, DenseIndex cols, DenseIndex depth)
     {
       this->m_mc = Transpose ? cols : rows;
@@ -372,6 +424,40 @@ class gemm_blocking_space<StorageOrder,_LhsScalar,_RhsScalar,MaxRows, MaxCols, M
     }
 };
 
+/* Computes dst += alpha * lhs * rhs with the batched matrix-vector kernel, and returns false when the storage
+ * orders do not allow it: the col-major (resp. row-major) kernel requires contiguous result (resp. rhs) vectors.
+ * Mixed scalar types are left to the matrix-matrix kernel.
+ */
+template<bool SameScalars, bool ConjugateLhs, bool ConjugateRhs>
+struct gemm_by_vectors
+{
+  template<typename Lhs, typename Rhs, typename Dest, typename Scalar>
+  static bool run(const Lhs&, const Rhs&, Dest&, const Scalar&) { return false; }
+};
+
+template<bool ConjugateLhs, bool ConjugateRhs>
+struct gemm_by_vectors<true,ConjugateLhs,ConjugateRhs>
+{
+  template<typename Lhs, typename Rhs, typename Dest, typename Scalar>
+  static bool run(const Lhs& lhs, const Rhs& rhs, Dest& dst, const Scalar& alpha)
+  {
+    enum {
+      LhsIsRowMajor = (Lhs::Flags&RowMajorBit)==RowMajorBit,
+      RhsIsRowMajor = (Rhs::Flags&RowMajorBit)==RowMajorBit,
+      DestIsRowMajor = (Dest::Flags&RowMajorBit)==RowMajorBit
+    };
+    if(LhsIsRowMajor ? RhsIsRowMajor : DestIsRowMajor)
+      return false;
+    general_matrix_vector_product_batch<typename Dest::Index, typename Lhs::Scalar, LhsIsRowMajor ? RowMajor : ColMajor,
+                                        ConjugateLhs, typename Rhs::Scalar, ConjugateRhs>::run(
+      lhs.rows(), lhs.cols(), &lhs.coeffRef(0,0), lhs.outerStride(),
+      &rhs.coeffRef(0,0), RhsIsRowMajor ? rhs.outerStride() : 1, RhsIsRowMajor ? 1 : rhs.outerStride(),
+      &dst.coeffRef(0,0), DestIsRowMajor ? dst.outerStride() : 1, DestIsRowMajor ? 1 : dst.outerStride(),
+      rhs.cols(), alpha);
+    return true;
+  }
+};
+
 } // end namespace internal
 
 template<typename Lhs, typename Rhs>
@@ -404,6 +490,13 @@ class GeneralProduct<Lhs, Rhs, GemmProduct>
       Scalar actualAlpha = alpha * LhsBlasTraits::extractScalarFactor(m_lhs)
                                  * RhsBlasTraits::extractScalarFactor(m_rhs);
 
+      // The product by a few vectors is bound by the memory bandwidth, and packing the lhs would read it twice
+      // => multiply each cache block of the lhs by all the vectors
+      if(rhs.cols()<=4 && dst.size()>0 && lhs.cols()>0
+         && internal::gemm_by_vectors<internal::is_same<LhsScalar,RhsScalar>::value,
+                                      bool(LhsBlasTraits::NeedToConjugate),bool(RhsBlasTraits::NeedToConjugate)>::run(lhs, rhs, dst, actualAlpha))
+        return;
+
       typedef internal::gemm_blocking_space<(Dest::Flags&RowMajorBit) ? RowMajor : ColMajor,LhsScalar,RhsScalar,
               Dest::MaxRowsAtCompileTime,Dest::MaxColsAtCompileTime,MaxDepthAtCompileTime> BlockingType;
 
@@ -418,7 +511,7 @@ class GeneralProduct<Lhs, Rhs, GemmProduct>
 
       BlockingType blocking(dst.rows(), dst.cols(), lhs.cols());
 
-      internal::parallelize_gemm<(Dest::MaxRowsAtCompileTime>32 || Dest::MaxRowsAtCompileTime==Dynamic)>(GemmFunctor(lhs, rhs, dst, actualAlpha, blocking), this->rows(), this->cols(), Dest::Flags&RowMajorBit);
+      internal::parallelize_gemm<(Dest::MaxRowsAtCompileTime>32 || Dest::MaxRowsAtCompileTime==Dynamic)>(GemmFunctor(lhs, rhs, dst, actualAlpha, blocking), this->rows(), this->cols(), lhs.cols(), Dest::Flags&RowMajorBit);
     }
 };
 
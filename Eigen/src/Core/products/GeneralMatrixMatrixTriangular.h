@@ -57,8 +57,64 @@ template <typename Index, typename LhsScalar, int LhsStorageOrder, bool Conjugat
 struct general_matrix_matrix_triangular_product<Index,LhsScalar,LhsStorageOrder,ConjugateLhs,RhsScalar,RhsStorageOrder,ConjugateRhs,ColMajor,UpLo,Version>
 {
   typedef typename scalar_product_traits<LhsScalar, RhsScalar>::ReturnType ResScalar;
-  static EIGEN_STRONG_INLINE void run(Index size, Index depth,const LhsScalar* _lhs, Index lhsStride,
-                                      const RhsScalar* _rhs, Index rhsStride, ResScalar* res, Index resStride, const ResScalar& alpha)
+
+  // The result is split into vertical strips enclosing the same area of the triangular part, and each strip is computed
+  // independently: the block overlapping the diagonal as a smaller triangular product, and the rest as a GEMM.
+  struct StripJob
+  {
+    StripJob(Index size, Index depth, const LhsScalar* lhs, Index lhsStride, const RhsScalar* rhs, Index rhsStride,
+             ResScalar* res, Index resStride, const ResScalar& alpha, Index jobs)
+      : m_size(size), m_depth(depth), m_lhs(lhs), m_lhsStride(lhsStride), m_rhs(rhs), m_rhsStride(rhsStride),
+        m_res(res), m_resStride(resStride), m_alpha(alpha), m_jobs(jobs)
+    {}
+
+    void operator()(int i) const
+    {
+      const_blas_data_mapper<LhsScalar, Index, LhsStorageOrder> lhs(m_lhs,m_lhsStride);
+      const_blas_data_mapper<RhsScalar, Index, RhsStorageOrder> rhs(m_rhs,m_rhsStride);
+
+      Index j0 = parallel_triangular_chunk(m_size, m_jobs, Index(i), UpLo==Lower);
+      Index j1 = parallel_triangular_chunk(m_size, m_jobs, Index(i+1), UpLo==Lower);
+      if(j1<=j0)
+        return;
+
+      runSequential(j1-j0, m_depth, &lhs(j0,0), m_lhsStride, &rhs(0,j0), m_rhsStride,
+                    m_res+m_resStride*j0+j0, m_resStride, m_alpha);
+
+      Index i0 = UpLo==Lower ? j1 : 0;
+      Index rows = UpLo==Lower ? m_size-j1 : j0;
+      if(rows>0)
+      {
+        gemm_blocking_space<ColMajor,LhsScalar,RhsScalar,Dynamic,Dynamic,Dynamic> blocking(rows, j1-j0, m_depth);
+        general_matrix_matrix_product<Index,LhsScalar,LhsStorageOrder,ConjugateLhs,RhsScalar,RhsStorageOrder,ConjugateRhs,ColMajor>
+          ::run(rows, j1-j0, m_depth, &lhs(i0,0), m_lhsStride, &rhs(0,j0), m_rhsStride,
+                m_res+m_resStride*j0+i0, m_resStride, m_alpha, blocking);
+      }
+    }
+
+    Index m_size, m_depth;
+    const LhsScalar* m_lhs;
+    Index m_lhsStride;
+    const RhsScalar* m_rhs;
+    Index m_rhsStride;
+    ResScalar* m_res;
+    Index m_resStride;
+    ResScalar m_alpha;
+    Index m_jobs;
+  };
+
+  static EIGEN_STRONG_INLINE void run(Index size, Index depth,const LhsScalar* lhs, Index lhsStride,
+                                      const RhsScalar* rhs, Index rhsStride, ResScalar* res, Index resStride, const ResScalar& alpha)
+  {
+    Index threads = parallel_level3_threads(double(size)*double(size)*double(depth)/2, size);
+    if(threads>1)
+      parallel_for(StripJob(size, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha, threads), int(threads));
+    else
+      runSequential(size, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha);
+  }
+
+  static void runSequential(Index size, Index depth,const LhsScalar* _lhs, Index lhsStride,
+                            const RhsScalar* _rhs, Index rhsStride, ResScalar* res, Index resStride, const ResScalar& alpha)
   {
     const_blas_data_mapper<LhsScalar, Index, LhsStorageOrder> lhs(_lhs,lhsStride);
     const_blas_data_mapper<RhsScalar, Index, RhsStorageOrder> rhs(_rhs,rhsStride);
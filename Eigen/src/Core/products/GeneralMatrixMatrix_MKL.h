@@ -59,7 +59,7 @@ static void run(Index rows, Index cols, Index depth, \
   EIGTYPE* res, Index resStride, \
   EIGTYPE alpha, \
   level3_blocking<EIGTYPE, EIGTYPE>& /*blocking*/, \
-  GemmParallelInfo<Index>* /*info = 0*/) \
+  GemmParallelInfo<Index>* /*info = 0*/, Index /*tid = 0*/, Index /*threads = 1*/) \
 { \
   using std::conj; \
 \
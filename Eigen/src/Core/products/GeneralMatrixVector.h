@@ -107,6 +107,10 @@ EIGEN_DONT_INLINE void general_matrix_vector_product<Index,LhsScalar,ColMajor,Co
                        : alignmentStep==(LhsPacketSize/2) ? EvenAligned
                        : FirstAligned;
 
+  // the FirstAligned path relies on palign<1..3>, i.e., it assumes packets of 4 coefficients
+  if(LhsPacketSize>4 && alignmentPattern==FirstAligned)
+    alignmentPattern = NoneAligned;
+
   // we cannot assume the first element is aligned because of sub-matrices
   const Index lhsAlignmentOffset = internal::first_aligned(lhs,size);
 
@@ -370,6 +374,10 @@ EIGEN_DONT_INLINE void general_matrix_vector_product<Index,LhsScalar,RowMajor,Co
                          : alignmentStep==(LhsPacketSize/2) ? EvenAligned
                          : FirstAligned;
 
+  // the FirstAligned path relies on palign<1..3>, i.e., it assumes packets of 4 coefficients
+  if(LhsPacketSize>4 && alignmentPattern==FirstAligned)
+    alignmentPattern = NoneAligned;
+
   // we cannot assume the first element is aligned because of sub-matrices
   const Index lhsAlignmentOffset = internal::first_aligned(lhs,depth);
 
@@ -566,6 +574,95 @@ EIGEN_DONT_INLINE void general_matrix_vector_product<Index,LhsScalar,RowMajor,Co
   #undef _EIGEN_ACCUMULATE_PACKETS
 }
 
+/* Matrix times several vectors: res_k += alpha * lhs * rhs_k for k in [0,count), where rhs_k and res_k are
+ * rhsStride and resStride apart.
+ * The rows of the result are split among threads, and each thread processes its part of the matrix by contiguous
+ * blocks of EIGEN_TUNE_GEMV_BLOCK_SIZE bytes which stay in the cache while they are multiplied by all the vectors,
+ * such that the matrix is read only once from the memory whatever the number of vectors.
+ */
+template<typename Index, typename LhsScalar, int LhsStorageOrder, bool ConjugateLhs, typename RhsScalar, bool ConjugateRhs>
+struct general_matrix_vector_product_batch
+{
+  typedef typename scalar_product_traits<LhsScalar, RhsScalar>::ReturnType ResScalar;
+  typedef general_matrix_vector_product<Index,LhsScalar,LhsStorageOrder,ConjugateLhs,RhsScalar,ConjugateRhs> Gemv;
+  // the type of the scale factor of the respective kernel
+  typedef typename conditional<LhsStorageOrder==RowMajor,ResScalar,RhsScalar>::type AlphaScalar;
+
+  struct SliceJob
+  {
+    SliceJob(Index rows, Index cols, const LhsScalar* lhs, Index lhsStride,
+             const RhsScalar* rhs, Index rhsIncr, Index rhsStride,
+             ResScalar* res, Index resIncr, Index resStride, Index count, AlphaScalar alpha, Index jobs)
+      : m_rows(rows), m_cols(cols), m_lhs(lhs), m_lhsStride(lhsStride), m_rhs(rhs), m_rhsIncr(rhsIncr), m_rhsStride(rhsStride),
+        m_res(res), m_resIncr(resIncr), m_resStride(resStride), m_count(count), m_alpha(alpha), m_jobs(jobs)
+    {}
+
+    void operator()(int i) const
+    {
+      Index start, length;
+      parallel_chunk(m_rows, m_jobs, Index(16), Index(i), start, length);
+      runSlice(start, length, m_cols, m_lhs, m_lhsStride, m_rhs, m_rhsIncr, m_rhsStride,
+               m_res, m_resIncr, m_resStride, m_count, m_alpha);
+    }
+
+    Index m_rows, m_cols;
+    const LhsScalar* m_lhs;
+    Index m_lhsStride;
+    const RhsScalar* m_rhs;
+    Index m_rhsIncr, m_rhsStride;
+    ResScalar* m_res;
+    Index m_resIncr, m_resStride, m_count;
+    AlphaScalar m_alpha;
+    Index m_jobs;
+  };
+
+  static void runSlice(Index start, Index length, Index cols, const LhsScalar* lhs, Index lhsStride,
+                       const RhsScalar* rhs, Index rhsIncr, Index rhsStride,
+                       ResScalar* res, Index resIncr, Index resStride, Index count, AlphaScalar alpha)
+  {
+    if(LhsStorageOrder==RowMajor)
+    {
+      // blocks of consecutive rows
+      const Index blockRows = count==1 ? length
+                            : (std::max)(Index(16), Index(EIGEN_TUNE_GEMV_BLOCK_SIZE) / (std::max)(Index(1),cols*Index(sizeof(LhsScalar))));
+      for(Index i=start; i<start+length; i+=blockRows)
+      {
+        const Index actualRows = (std::min)(i+blockRows,start+length)-i;
+        for(Index k=0; k<count; ++k)
+          Gemv::run(actualRows, cols, lhs + i*lhsStride, lhsStride, rhs + k*rhsStride, rhsIncr,
+                    res + i*resIncr + k*resStride, resIncr, alpha);
+      }
+    }
+    else
+    {
+      // blocks of consecutive columns
+      const Index blockCols = count==1 ? cols
+                            : (std::max)(Index(4), Index(EIGEN_TUNE_GEMV_BLOCK_SIZE) / (std::max)(Index(1),length*Index(sizeof(LhsScalar))));
+      for(Index j=0; j<cols; j+=blockCols)
+      {
+        const Index actualCols = (std::min)(j+blockCols,cols)-j;
+        for(Index k=0; k<count; ++k)
+          Gemv::run(length, actualCols, lhs + start + j*lhsStride, lhsStride, rhs + j*rhsIncr + k*rhsStride, rhsIncr,
+                    res + start*resIncr + k*resStride, resIncr, alpha);
+      }
+    }
+  }
+
+  static void run(Index rows, Index cols, const LhsScalar* lhs, Index lhsStride,
+                  const RhsScalar* rhs, Index rhsIncr, Index rhsStride,
+                  ResScalar* res, Index resIncr, Index resStride, Index count, AlphaScalar alpha)
+  {
+    Index threads = parallel_level2_threads(double(rows)*double(cols), rows);
+    if(threads>1)
+    {
+      parallel_for(SliceJob(rows, cols, lhs, lhsStride, rhs, rhsIncr, rhsStride, res, resIncr, resStride, count, alpha, threads),
+                   int(threads));
+      return;
+    }
+    runSlice(0, rows, cols, lhs, lhsStride, rhs, rhsIncr, rhsStride, res, resIncr, resStride, count, alpha);
+  }
+};
+
 } // end namespace internal
 
 } // end namespace Eigen
@@ -14,6 +14,41 @@ namespace Eigen {
 
 namespace internal {
 
+/** \internal */
+inline void manage_parallel_executor(Action action, ParallelExecutor** executor)
+{
+  static ParallelExecutor* m_executor = 0;
+
+  eigen_internal_assert(executor!=0);
+  if(action==SetAction)
+    m_executor = *executor;
+  else if(action==GetAction)
+    *executor = m_executor;
+  else
+    eigen_internal_assert(false);
+}
+
+#if defined(EIGEN_USE_THREADS) && !defined(EIGEN_HAS_OPENMP)
+/** \internal \returns the thread pool used when no executor has been registered */
+inline ThreadPool& default_thread_pool()
+{
+  static ThreadPool pool;
+  return pool;
+}
+#endif
+
+/** \internal \returns the executor which runs the parallel kernels, or 0 if they run on OpenMP or are sequential */
+inline ParallelExecutor* parallel_executor()
+{
+  ParallelExecutor* executor;
+  manage_parallel_executor(GetAction, &executor);
+  #if defined(EIGEN_USE_THREADS) && !defined(EIGEN_HAS_OPENMP)
+  if(executor==0)
+    executor = &default_thread_pool();
+  #endif
+  return executor;
+}
+
 /** \internal */
 inline void manage_multi_threading(Action action, int* v)
 {
@@ -27,13 +62,25 @@ inline void manage_multi_threading(Action action, int* v)
   else if(action==GetAction)
   {
     eigen_internal_assert(v!=0);
-    #ifdef EIGEN_HAS_OPENMP
+    ParallelExecutor* executor;
+    manage_parallel_executor(GetAction, &executor);
+    #if !defined(EIGEN_HAS_OPENMP) && !defined(EIGEN_USE_THREADS)
+    // without executor, the kernels are sequential whatever setNbThreads()
+    if(executor==0)
+      *v = 1;
+    else
+    #endif
     if(m_maxThreads>0)
       *v = m_maxThreads;
+    else if(executor)
+      *v = executor->numThreads();
     else
+    #if defined(EIGEN_HAS_OPENMP)
       *v = omp_get_max_threads();
+    #elif defined(EIGEN_USE_THREADS)
+      *v = ThreadPool::hardwareConcurrency();
     #else
-    *v = 1;
+      *v = 1;
     #endif
   }
   else
@@ -51,6 +98,9 @@ inline void initParallel()
   internal::manage_multi_threading(GetAction, &nbt);
   std::ptrdiff_t l1, l2;
   internal::manage_caching_sizes(GetAction, &l1, &l2);
+  #if defined(EIGEN_USE_THREADS) && !defined(EIGEN_HAS_OPENMP)
+  internal::default_thread_pool();
+  #endif
 }
 
 /** \returns the max number of threads reserved for Eigen
@@ -62,15 +112,90 @@ inline int nbThreads()
   return ret;
 }
 
-/** Sets the max number of threads reserved for Eigen
+/** Sets the max number of threads reserved for Eigen, or restores the default if \a v is 0
   * \sa nbThreads */
 inline void setNbThreads(int v)
 {
   internal::manage_multi_threading(SetAction, &v);
 }
 
+/** Makes the parallel kernels of Eigen run on \a executor, or restores the default behavior if \a executor is null.
+  *
+  * By default, the parallel kernels use OpenMP when it is enabled, otherwise the ThreadPool of Eigen
+  * if \c EIGEN_USE_THREADS is defined, and are sequential otherwise. The executor is not owned by Eigen,
+  * and must outlive its use. This function is not thread safe, and should be called once during the
+  * initialization of the application, like initParallel().
+  *
+  * \sa parallelExecutor(), ParallelExecutor, nbThreads() */
+inline void setParallelExecutor(ParallelExecutor* executor)
+{
+  internal::manage_parallel_executor(SetAction, &executor);
+}
+
+/** \returns the executor registered by setParallelExecutor(), or 0 if there is none
+  * \sa setParallelExecutor() */
+inline ParallelExecutor* parallelExecutor()
+{
+  ParallelExecutor* executor;
+  internal::manage_parallel_executor(GetAction, &executor);
+  return executor;
+}
+
 namespace internal {
 
+/** \internal \returns the number of threads the parallel kernels can use from the calling thread,
+  * that is nbThreads() if they can run on an executor or on OpenMP outside of a parallel region, and 1 otherwise */
+inline int parallel_max_threads()
+{
+  #ifdef EIGEN_HAS_OPENMP
+  if(parallel_executor()==0 && omp_get_num_threads()>1)
+    return 1;
+  #else
+  if(parallel_executor()==0)
+    return 1;
+  #endif
+  return nbThreads();
+}
+
+/** \internal The tasks run by parallel_for(): task \a id of \a count calls func(i) for all i in [0,jobs) such that i%count equals \a id */
+template<typename Functor> struct parallel_for_session
+{
+  parallel_for_session(const Functor& func, int jobs) : m_func(func), m_jobs(jobs) {}
+
+  static void run(void* data, int id, int count)
+  {
+    const parallel_for_session& session = *static_cast<const parallel_for_session*>(data);
+    for(int i=id; i<session.m_jobs; i+=count)
+      session.m_func(i);
+  }
+
+  const Functor& m_func;
+  int m_jobs;
+};
+
+/** \internal Calls \a func(i) for all i in [0,\a jobs) using up to \a jobs threads of the parallel executor, or of OpenMP.
+  * Unlike the tasks of a parallel GEMM, the jobs must be independent of each other, see parallel_max_threads(). */
+template<typename Functor> void parallel_for(const Functor& func, int jobs)
+{
+  parallel_for_session<Functor> session(func, jobs);
+  ParallelExecutor* executor = parallel_executor();
+  if(jobs>1 && executor)
+  {
+    executor->run(&parallel_for_session<Functor>::run, &session, jobs);
+  }
+  #ifdef EIGEN_HAS_OPENMP
+  else if(jobs>1)
+  {
+    #pragma omp parallel num_threads(jobs)
+    parallel_for_session<Functor>::run(&session, omp_get_thread_num(), omp_get_num_threads());
+  }
+  #endif
+  else
+  {
+    parallel_for_session<Functor>::run(&session, 0, 1);
+  }
+}
+
 template<typename Index> struct GemmParallelInfo
 {
   GemmParallelInfo() : sync(-1), users(0), rhs_start(0), rhs_length(0) {}
@@ -82,73 +207,315 @@ template<typename Index> struct GemmParallelInfo
   Index rhs_length;
 };
 
+/** \internal atomically decrements \a *v */
+inline void parallel_atomic_decrement(int volatile* v)
+{
+#if defined(__GNUC__)
+  __sync_fetch_and_sub(v, 1);
+#elif defined(_MSC_VER)
+  _InterlockedDecrement(reinterpret_cast<long volatile*>(v));
+#else
+  #ifdef EIGEN_HAS_OPENMP
+  #pragma omp atomic
+  #endif
+  --(*v);
+#endif
+}
+
+/** \internal makes the writes issued before this call visible to the other threads before the subsequent ones */
+inline void parallel_memory_barrier()
+{
+#if defined(__GNUC__)
+  __sync_synchronize();
+#elif defined(_MSC_VER)
+  _ReadWriteBarrier();
+#elif defined(EIGEN_HAS_OPENMP)
+  #pragma omp flush
+#endif
+}
+
+/** \internal The tasks of a parallel GEMM: task \a id of \a count computes the \a id-th horizontal
+  * (or vertical if transpose is true) slice of the result, see parallelize_gemm() */
+template<typename Functor, typename Index> struct gemm_parallel_session
+{
+  gemm_parallel_session(const Functor& func, GemmParallelInfo<Index>* info, Index rows, Index cols, bool transpose)
+    : m_func(func), m_info(info), m_rows(rows), m_cols(cols), m_transpose(transpose)
+  {}
+
+  void runTask(Index i, Index threads) const
+  {
+    Index blockCols = (m_cols / threads) & ~Index(0x3);
+    Index blockRows = (m_rows / threads) & ~Index(0x7);
+
+    Index r0 = i*blockRows;
+    Index actualBlockRows = (i+1==threads) ? m_rows-r0 : blockRows;
+
+    Index c0 = i*blockCols;
+    Index actualBlockCols = (i+1==threads) ? m_cols-c0 : blockCols;
+
+    m_info[i].rhs_start = c0;
+    m_info[i].rhs_length = actualBlockCols;
+
+    if(m_transpose)
+      m_func(0, m_cols, r0, actualBlockRows, m_info, i, threads);
+    else
+      m_func(r0, actualBlockRows, 0, m_cols, m_info, i, threads);
+  }
+
+  static void run(void* data, int id, int count)
+  {
+    static_cast<const gemm_parallel_session*>(data)->runTask(id, count);
+  }
+
+  const Functor& m_func;
+  GemmParallelInfo<Index>* m_info;
+  Index m_rows, m_cols;
+  bool m_transpose;
+};
+
+/** \internal splits [0,size) into \a count chunks multiple of \a granularity but the last one, and returns the \a i-th one */
+template<typename Index> void parallel_chunk(Index size, Index count, Index granularity, Index i, Index& start, Index& length)
+{
+  Index block = (size / count) & ~(granularity-1);
+  start = i*block;
+  length = (i+1==count) ? size-start : block;
+}
+
+/** \internal \returns the first column of the \a i-th of \a count vertical strips of a \a size x \a size lower (or upper)
+  * triangular matrix, such that the strips enclose the same area. The boundaries are multiples of 8 but the last one. */
+template<typename Index> Index parallel_triangular_chunk(Index size, Index count, Index i, bool lower)
+{
+  using std::sqrt;
+  if(i<=0 || i>=count)
+    return i<=0 ? 0 : size;
+  double n = double(size), area = double(i) / double(count) * n * n;
+  double j = lower ? n - sqrt(n*n - area) : sqrt(area);
+  return (std::min)(size, Index(j) & ~Index(0x7));
+}
+
+/** \internal The independent tasks of a parallel GEMM partitioned by compute_gemm_partition(): the result is split
+  * into a grid of pm x pn blocks, and the contribution of each block is further split into pk slices along the depth.
+  * Each of the pm*pn*pk jobs packs its own operands, so they do not need to run simultaneously, and a task runs all
+  * the jobs i such that i%count equals its \a id. */
+template<typename Functor, typename Index> struct gemm_grid_session
+{
+  gemm_grid_session(const Functor& func, Index rows, Index cols, Index depth, bool transpose, Index pm, Index pn, Index pk)
+    : m_func(func), m_rows(rows), m_cols(cols), m_depth(depth), m_transpose(transpose), m_pm(pm), m_pn(pn), m_pk(pk)
+  {}
+
+  void runJob(Index job) const
+  {
+    Index im = job % m_pm, in = (job / m_pm) % m_pn, ik = job / (m_pm*m_pn);
+    Index m0, m, n0, n, k0, k;
+    parallel_chunk(m_transpose ? m_cols : m_rows, m_pm, Index(8), im, m0, m);
+    parallel_chunk(m_transpose ? m_rows : m_cols, m_pn, Index(4), in, n0, n);
+    parallel_chunk(m_depth, m_pk, Index(8), ik, k0, k);
+    if(m_transpose)
+      m_func.runBlock(n0, n, m0, m, ik, k0, k);
+    else
+      m_func.runBlock(m0, m, n0, n, ik, k0, k);
+  }
+
+  static void run(void* data, int id, int count)
+  {
+    const gemm_grid_session& session = *static_cast<const gemm_grid_session*>(data);
+    for(Index job=id; job<session.m_pm*session.m_pn*session.m_pk; job+=count)
+      session.runJob(job);
+  }
+
+  const Functor& m_func;
+  Index m_rows, m_cols, m_depth;
+  bool m_transpose;
+  Index m_pm, m_pn, m_pk;
+};
+
+#ifndef EIGEN_GEMM_MIN_WORK_PER_THREAD
+/** \internal Number of multiply-adds below which it is not worth waking up one more thread for a matrix product */
+#define EIGEN_GEMM_MIN_WORK_PER_THREAD (1<<18)
+#endif
+
+/** \internal Describes how to split a matrix product, see compute_gemm_partition() */
+template<typename Index> struct gemm_partition
+{
+  Index pm, pn, pk;
+  Index threads() const { return pm*pn*pk; }
+};
+
+/** \internal Chooses how to distribute the column major product of a \a m x \a k and a \a k x \a n matrix
+  * on at most \a maxThreads threads.
+  *
+  * The number of threads is driven by the amount of work, such that each thread gets at least
+  * EIGEN_GEMM_MIN_WORK_PER_THREAD multiply-adds. These threads are then arranged as a \a pm x \a pn grid of blocks
+  * of the result, not thinner than the panels of the gebp kernel, and minimizing the amount of packing, i.e., the sum of
+  * the sizes of the lhs and rhs blocks copied by all the threads. When the result is too small to keep all the threads
+  * busy, the depth is split into \a pk slices of at least \a kc, the depth of the cache blocks, whose results are summed.
+  * A split along the rows only is favored since the threads can then share the packed rhs.
+  */
+template<typename Index>
+gemm_partition<Index> compute_gemm_partition(Index m, Index n, Index k, Index kc, Index maxThreads)
+{
+  gemm_partition<Index> p;
+  p.pm = p.pn = p.pk = 1;
+
+  double work = double(m) * double(n) * double(k);
+  Index threads = Index((std::min)(double(maxThreads), work / double(EIGEN_GEMM_MIN_WORK_PER_THREAD)));
+  if(threads<=1)
+    return p;
+
+  const Index maxPm = (std::max)(Index(1), m/32);
+  const Index maxPn = (std::max)(Index(1), n/16);
+  const Index maxPk = (std::max)(Index(1), k/(std::max)(kc,Index(32)));
+
+  double bestCost = 0;
+  for(Index pm=1; pm<=(std::min)(threads,maxPm); ++pm)
+  {
+    Index pn = (std::min)(maxPn, threads/pm);
+    double cost = double(m)*double(pn) + double(n)*double(pn==1 ? 1 : pm);
+    if(pm*pn>p.pm*p.pn || (pm*pn==p.pm*p.pn && cost<bestCost))
+    {
+      p.pm = pm;
+      p.pn = pn;
+      bestCost = cost;
+    }
+  }
+
+  if(p.pm*p.pn<threads)
+    p.pk = (std::min)(maxPk, threads/(p.pm*p.pn));
+
+  return p;
+}
+
+/** \internal \returns the number of threads worth using for a level-3 kernel other than a GEMM, like a triangular
+  * solve or a symmetric product, performing \a work multiply-adds and whose result can be split into \a size independent
+  * rows or columns. Each thread gets at least EIGEN_GEMM_MIN_WORK_PER_THREAD multiply-adds and a slice of 32 rows or
+  * columns, since the triangular or selfadjoint operand is packed by every thread. */
+template<typename Index> Index parallel_level3_threads(double work, Index size)
+{
+#if defined (EIGEN_USE_BLAS)
+  EIGEN_UNUSED_VARIABLE(work);
+  EIGEN_UNUSED_VARIABLE(size);
+  return 1;
+#else
+  Index threads = Index((std::min)(double(parallel_max_threads()), work / double(EIGEN_GEMM_MIN_WORK_PER_THREAD)));
+  return (std::max)(Index(1), (std::min)(threads, size/32));
+#endif
+}
+
+#ifndef EIGEN_GEMV_MIN_WORK_PER_THREAD
+/** \internal Number of matrix coefficients below which it is not worth waking up one more thread for a matrix-vector
+  * product. It is lower than for the level 3 kernels since these products are bound by the memory bandwidth. */
+#define EIGEN_GEMV_MIN_WORK_PER_THREAD (1<<16)
+#endif
+
+/** \internal \returns the number of threads worth using for a level-2 kernel reading \a work matrix coefficients,
+  * whose result can be split into \a size independent rows. Each thread gets at least EIGEN_GEMV_MIN_WORK_PER_THREAD
+  * coefficients and 16 rows. */
+template<typename Index> Index parallel_level2_threads(double work, Index size)
+{
+#if defined (EIGEN_USE_BLAS)
+  EIGEN_UNUSED_VARIABLE(work);
+  EIGEN_UNUSED_VARIABLE(size);
+  return 1;
+#else
+  Index threads = Index((std::min)(double(parallel_max_threads()), work / double(EIGEN_GEMV_MIN_WORK_PER_THREAD)));
+  return (std::max)(Index(1), (std::min)(threads, size/16));
+#endif
+}
+
 template<bool Condition, typename Functor, typename Index>
-void parallelize_gemm(const Functor& func, Index rows, Index cols, bool transpose)
+void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth, bool transpose)
 {
   // TODO when EIGEN_USE_BLAS is defined,
   // we should still enable OMP for other scalar types
-#if !(defined (EIGEN_HAS_OPENMP)) || defined (EIGEN_USE_BLAS)
+#if defined (EIGEN_USE_BLAS)
   // FIXME the transpose variable is only needed to properly split
   // the matrix product when multithreading is enabled. This is a temporary
   // fix to support row-major destination matrices. This whole
   // parallelizer mechanism has to be redisigned anyway.
   EIGEN_UNUSED_VARIABLE(transpose);
+  EIGEN_UNUSED_VARIABLE(depth);
   func(0,rows, 0,cols);
 #else
 
-  // Dynamically check whether we should enable or disable OpenMP.
+  // Dynamically check whether we should enable or disable multi-threading.
   // The conditions are:
   // - the max number of threads we can create is greater than 1
   // - we are not already in a parallel code
   // - the sizes are large enough
 
-  // 1- are we already in a parallel session?
-  // FIXME omp_get_num_threads()>1 only works for openmp, what if the user does not use openmp?
-  if((!Condition) || (omp_get_num_threads()>1))
+  if(!Condition)
     return func(0,rows, 0,cols);
 
-  Index size = transpose ? cols : rows;
+  // 1- are we already in a parallel session?
+  // With an executor, this is its job to hand out only the threads which are idle.
+  ParallelExecutor* executor = parallel_executor();
+  #ifdef EIGEN_HAS_OPENMP
+  if(executor==0 && omp_get_num_threads()>1)
+    return func(0,rows, 0,cols);
+  #endif
 
-  // 2- compute the maximal number of threads from the size of the product:
-  // FIXME this has to be fine tuned
-  Index max_threads = std::max<Index>(1,size / 32);
+  #ifndef EIGEN_HAS_OPENMP
+  if(executor==0)
+    return func(0,rows, 0,cols);
+  #endif
 
-  // 3 - compute the number of threads we are going to use
-  Index threads = std::min<Index>(nbThreads(), max_threads);
+  // 2- compute the number of threads and how to split the product from its dimensions
+  gemm_partition<Index> partition = compute_gemm_partition<Index>(transpose ? cols : rows, transpose ? rows : cols, depth,
+                                                                  func.blockingDepth(), nbThreads());
+  Index threads = partition.threads();
 
   if(threads==1)
     return func(0,rows, 0,cols);
 
   Eigen::initParallel();
-  func.initParallelSession();
 
-  if(transpose)
-    std::swap(rows,cols);
-
-  Index blockCols = (cols / threads) & ~Index(0x3);
-  Index blockRows = (rows / threads) & ~Index(0x7);
-  
-  GemmParallelInfo<Index>* info = new GemmParallelInfo<Index>[threads];
-
-  #pragma omp parallel for schedule(static,1) num_threads(threads)
-  for(Index i=0; i<threads; ++i)
+  if(partition.pn==1 && partition.pk==1)
   {
-    Index r0 = i*blockRows;
-    Index actualBlockRows = (i+1==threads) ? rows-r0 : blockRows;
+    // 3a- a split along the rows only: the threads share the packed rhs, see general_matrix_matrix_product
+    func.initParallelSession();
 
-    Index c0 = i*blockCols;
-    Index actualBlockCols = (i+1==threads) ? cols-c0 : blockCols;
+    if(transpose)
+      std::swap(rows,cols);
 
-    info[i].rhs_start = c0;
-    info[i].rhs_length = actualBlockCols;
+    GemmParallelInfo<Index>* info = new GemmParallelInfo<Index>[threads];
+    gemm_parallel_session<Functor,Index> session(func, info, rows, cols, transpose);
 
-    if(transpose)
-      func(0, cols, r0, actualBlockRows, info);
+    if(executor)
+    {
+      executor->run(&gemm_parallel_session<Functor,Index>::run, &session, int(threads));
+    }
+    #ifdef EIGEN_HAS_OPENMP
     else
-      func(r0, actualBlockRows, 0,cols, info);
+    {
+      // the number of threads actually started might be lower than requested
+      #pragma omp parallel num_threads(threads)
+      session.runTask(omp_get_thread_num(), omp_get_num_threads());
+    }
+    #endif
+
+    delete[] info;
   }
+  else
+  {
+    // 3b- a 2D grid, possibly with depth slices: the blocks are computed independently
+    func.initBlockSession(partition.pk);
+
+    gemm_grid_session<Functor,Index> session(func, rows, cols, depth, transpose, partition.pm, partition.pn, partition.pk);
+
+    if(executor)
+    {
+      executor->run(&gemm_grid_session<Functor,Index>::run, &session, int(threads));
+    }
+    #ifdef EIGEN_HAS_OPENMP
+    else
+    {
+      #pragma omp parallel num_threads(threads)
+      gemm_grid_session<Functor,Index>::run(&session, omp_get_thread_num(), omp_get_num_threads());
+    }
+    #endif
 
-  delete[] info;
+    func.finishBlockSession();
+  }
 #endif
 }
 
@@ -403,6 +403,44 @@ struct SelfadjointProductMatrix<Lhs,LhsMode,false,Rhs,RhsMode,false>
     RhsIsSelfAdjoint = (RhsMode&SelfAdjoint)==SelfAdjoint
   };
 
+  // The columns of the result (or its rows if the selfadjoint matrix is on the right) only depend on the
+  // respective columns of the rhs (or rows of the lhs), so that they are computed by slices in parallel.
+  template<typename ProductImpl, typename Dest> struct SliceJob
+  {
+    SliceJob(const _ActualLhsType& lhs, const _ActualRhsType& rhs, Dest& dst, const Scalar& alpha, Index jobs)
+      : m_lhs(lhs), m_rhs(rhs), m_dst(dst), m_alpha(alpha), m_jobs(jobs)
+    {}
+
+    void operator()(int i) const
+    {
+      Index start, length;
+      if(LhsIsSelfAdjoint)
+      {
+        internal::parallel_chunk(m_rhs.cols(), m_jobs, Index(4), Index(i), start, length);
+        ProductImpl::run(m_lhs.rows(), length,
+                         &m_lhs.coeffRef(0,0), m_lhs.outerStride(),
+                         &m_rhs.coeffRef(0,start), m_rhs.outerStride(),
+                         &m_dst.coeffRef(0,start), m_dst.outerStride(),
+                         m_alpha);
+      }
+      else
+      {
+        internal::parallel_chunk(m_lhs.rows(), m_jobs, Index(8), Index(i), start, length);
+        ProductImpl::run(length, m_rhs.cols(),
+                         &m_lhs.coeffRef(start,0), m_lhs.outerStride(),
+                         &m_rhs.coeffRef(0,0), m_rhs.outerStride(),
+                         &m_dst.coeffRef(start,0), m_dst.outerStride(),
+                         m_alpha);
+      }
+    }
+
+    const _ActualLhsType& m_lhs;
+    const _ActualRhsType& m_rhs;
+    Dest& m_dst;
+    Scalar m_alpha;
+    Index m_jobs;
+  };
+
   template<typename Dest> void scaleAndAddTo(Dest& dst, const Scalar& alpha) const
   {
     eigen_assert(dst.rows()==m_lhs.rows() && dst.cols()==m_rhs.cols());
@@ -413,15 +451,24 @@ struct SelfadjointProductMatrix<Lhs,LhsMode,false,Rhs,RhsMode,false>
     Scalar actualAlpha = alpha * LhsBlasTraits::extractScalarFactor(m_lhs)
                                * RhsBlasTraits::extractScalarFactor(m_rhs);
 
-    internal::product_selfadjoint_matrix<Scalar, Index,
+    typedef internal::product_selfadjoint_matrix<Scalar, Index,
       EIGEN_LOGICAL_XOR(LhsIsUpper,
                         internal::traits<Lhs>::Flags &RowMajorBit) ? RowMajor : ColMajor, LhsIsSelfAdjoint,
       NumTraits<Scalar>::IsComplex && EIGEN_LOGICAL_XOR(LhsIsUpper,bool(LhsBlasTraits::NeedToConjugate)),
       EIGEN_LOGICAL_XOR(RhsIsUpper,
                         internal::traits<Rhs>::Flags &RowMajorBit) ? RowMajor : ColMajor, RhsIsSelfAdjoint,
       NumTraits<Scalar>::IsComplex && EIGEN_LOGICAL_XOR(RhsIsUpper,bool(RhsBlasTraits::NeedToConjugate)),
-      internal::traits<Dest>::Flags&RowMajorBit  ? RowMajor : ColMajor>
-      ::run(
+      internal::traits<Dest>::Flags&RowMajorBit  ? RowMajor : ColMajor> ProductImpl;
+
+    Index threads = internal::parallel_level3_threads(double(lhs.rows())*double(lhs.cols())*double(rhs.cols()),
+                                                      LhsIsSelfAdjoint ? rhs.cols() : lhs.rows());
+    if(threads>1)
+    {
+      internal::parallel_for(SliceJob<ProductImpl,Dest>(lhs, rhs, dst, actualAlpha, threads), int(threads));
+      return;
+    }
+
+    ProductImpl::run(
         lhs.rows(), rhs.cols(),                 // sizes
         &lhs.coeffRef(0,0),    lhs.outerStride(),  // lhs info
         &rhs.coeffRef(0,0),    rhs.outerStride(),  // rhs info
@@ -388,6 +388,50 @@ struct TriangularProduct<Mode,LhsIsTriangular,Lhs,false,Rhs,false>
 
   TriangularProduct(const Lhs& lhs, const Rhs& rhs) : Base(lhs,rhs) {}
 
+  enum { IsLower = (Mode&Lower) == Lower };
+
+  // The columns of the result (or its rows if the triangular matrix is on the right) only depend on the
+  // respective columns of the rhs (or rows of the lhs), so that they are computed by slices in parallel.
+  template<typename ProductImpl, typename BlockingType, typename Dest> struct SliceJob
+  {
+    SliceJob(const _ActualLhsType& lhs, const _ActualRhsType& rhs, Dest& dst, Index rows, Index cols, Index depth,
+             const Scalar& alpha, Index jobs)
+      : m_lhs(lhs), m_rhs(rhs), m_dst(dst), m_rows(rows), m_cols(cols), m_depth(depth), m_alpha(alpha), m_jobs(jobs)
+    {}
+
+    void operator()(int i) const
+    {
+      Index start, length;
+      if(LhsIsTriangular)
+      {
+        internal::parallel_chunk(m_cols, m_jobs, Index(4), Index(i), start, length);
+        BlockingType blocking(m_rows, length, m_depth);
+        ProductImpl::run(m_rows, length, m_depth,
+                         &m_lhs.coeffRef(0,0), m_lhs.outerStride(),
+                         &m_rhs.coeffRef(0,start), m_rhs.outerStride(),
+                         &m_dst.coeffRef(0,start), m_dst.outerStride(),
+                         m_alpha, blocking);
+      }
+      else
+      {
+        internal::parallel_chunk(m_rows, m_jobs, Index(8), Index(i), start, length);
+        BlockingType blocking(length, m_cols, m_depth);
+        ProductImpl::run(length, m_cols, m_depth,
+                         &m_lhs.coeffRef(start,0), m_lhs.outerStride(),
+                         &m_rhs.coeffRef(0,0), m_rhs.outerStride(),
+                         &m_dst.coeffRef(start,0), m_dst.outerStride(),
+                         m_alpha, blocking);
+      }
+    }
+
+    const _ActualLhsType& m_lhs;
+    const _ActualRhsType& m_rhs;
+    Dest& m_dst;
+    Index m_rows, m_cols, m_depth;
+    Scalar m_alpha;
+    Index m_jobs;
+  };
+
   template<typename Dest> void scaleAndAddTo(Dest& dst, const Scalar& alpha) const
   {
     typename internal::add_const_on_value_type<ActualLhsType>::type lhs = LhsBlasTraits::extract(m_lhs);
@@ -399,20 +443,29 @@ struct TriangularProduct<Mode,LhsIsTriangular,Lhs,false,Rhs,false>
     typedef internal::gemm_blocking_space<(Dest::Flags&RowMajorBit) ? RowMajor : ColMajor,Scalar,Scalar,
               Lhs::MaxRowsAtCompileTime, Rhs::MaxColsAtCompileTime, Lhs::MaxColsAtCompileTime,4> BlockingType;
 
-    enum { IsLower = (Mode&Lower) == Lower };
+    typedef internal::product_triangular_matrix_matrix<Scalar, Index,
+      Mode, LhsIsTriangular,
+      (internal::traits<_ActualLhsType>::Flags&RowMajorBit) ? RowMajor : ColMajor, LhsBlasTraits::NeedToConjugate,
+      (internal::traits<_ActualRhsType>::Flags&RowMajorBit) ? RowMajor : ColMajor, RhsBlasTraits::NeedToConjugate,
+      (internal::traits<Dest          >::Flags&RowMajorBit) ? RowMajor : ColMajor> ProductImpl;
+
     Index stripedRows  = ((!LhsIsTriangular) || (IsLower))  ? lhs.rows() : (std::min)(lhs.rows(),lhs.cols());
     Index stripedCols  = ((LhsIsTriangular)  || (!IsLower)) ? rhs.cols() : (std::min)(rhs.cols(),rhs.rows());
     Index stripedDepth = LhsIsTriangular ? ((!IsLower) ? lhs.cols() : (std::min)(lhs.cols(),lhs.rows()))
                                          : ((IsLower)  ? rhs.rows() : (std::min)(rhs.rows(),rhs.cols()));
 
+    Index threads = internal::parallel_level3_threads(double(stripedRows)*double(stripedCols)*double(stripedDepth)/2,
+                                                      LhsIsTriangular ? stripedCols : stripedRows);
+    if(threads>1)
+    {
+      internal::parallel_for(SliceJob<ProductImpl,BlockingType,Dest>(lhs, rhs, dst, stripedRows, stripedCols, stripedDepth, actualAlpha, threads),
+                             int(threads));
+      return;
+    }
+
     BlockingType blocking(stripedRows, stripedCols, stripedDepth);
 
-    internal::product_triangular_matrix_matrix<Scalar, Index,
-      Mode, LhsIsTriangular,
-      (internal::traits<_ActualLhsType>::Flags&RowMajorBit) ? RowMajor : ColMajor, LhsBlasTraits::NeedToConjugate,
-      (internal::traits<_ActualRhsType>::Flags&RowMajorBit) ? RowMajor : ColMajor, RhsBlasTraits::NeedToConjugate,
-      (internal::traits<Dest          >::Flags&RowMajorBit) ? RowMajor : ColMajor>
-      ::run(
+    ProductImpl::run(
         stripedRows, stripedCols, stripedDepth,   // sizes
         &lhs.coeffRef(0,0),    lhs.outerStride(), // lhs info
         &rhs.coeffRef(0,0),    rhs.outerStride(), // rhs info
@@ -148,6 +148,14 @@ const unsigned int AlignedBit = 0x80;
 
 const unsigned int NestByRefBit = 0x100;
 
+/** \ingroup flags
+  *
+  * means the packet accessors accept the \c PartialPacketLoad load mode: in that mode, the expression
+  * does not read past the end of the underlying data, so that the last incomplete packet of a vector
+  * can be evaluated with masked loads rather than coefficient by coefficient.
+  * \sa PacketAccessBit */
+const unsigned int PartialPacketAccessBit = 0x400;
+
 // list of flags that are inherited by default
 const unsigned int HereditaryBits = RowMajorBit
                                   | EvalBeforeNestingBit
@@ -194,6 +202,11 @@ enum {
   Aligned=1 
 };
 
+/** \internal Bit which can be or-ed to the \p LoadMode of the packet accessors of expressions having the
+  * #PartialPacketAccessBit flag. Then the leaf expressions only read the coefficients which are within
+  * their bounds, and set the other ones of the packet to zero. */
+const int PartialPacketLoad = 0x2;
+
 /** \ingroup enums
  * Enum used by DenseBase::corner() in Eigen2 compatibility mode. */
 // FIXME after the corner() API change, this was not needed anymore, except by AlignedBox
@@ -348,6 +361,9 @@ enum DecompositionOptions {
   /** Used in GeneralizedSelfAdjointEigenSolver to indicate that it should
     * solve the generalized eigenproblem \f$ BAx = \lambda x \f$. */
   BAx_lx              = 0x400,
+  /** Used in SelfAdjointEigenSolver and GeneralizedSelfAdjointEigenSolver, together with #ComputeEigenvectors, to
+    * compute the eigenvectors of the tridiagonal matrix by divide and conquer instead of implicit QR steps. */
+  DivideAndConquer    = 0x800,
   /** \internal */
   GenEigMask = Ax_lBx | ABx_lx | BAx_lx
 };
@@ -406,7 +422,10 @@ namespace Architecture
     Generic = 0x0,
     SSE = 0x1,
     AltiVec = 0x2,
-#if defined EIGEN_VECTORIZE_SSE
+    AVX = 0x4,
+#if defined EIGEN_VECTORIZE_AVX
+    Target = AVX
+#elif defined EIGEN_VECTORIZE_SSE
     Target = SSE
 #elif defined EIGEN_VECTORIZE_ALTIVEC
     Target = AltiVec
@@ -264,14 +264,38 @@
   #error Please tell me what is the equivalent of __attribute__((aligned(n))) for your compiler
 #endif
 
+/* EIGEN_ALIGN_BYTES is the alignment, in bytes, required by the widest packet type.
+ * It is 16 bytes for SSE, AltiVec and NEON, 32 bytes when the compiler targets AVX, and 64 bytes for AVX512.
+ * Note that, unlike the 16 bytes alignment, this one depends on the target instruction set:
+ * code compiled with and without AVX must not exchange fixed size Eigen objects.
+ */
+#ifndef EIGEN_ALIGN_BYTES
+  #if defined(__AVX512F__) && !defined(EIGEN_DONT_VECTORIZE)
+    #define EIGEN_ALIGN_BYTES 64
+  #elif defined(__AVX__) && !defined(EIGEN_DONT_VECTORIZE)
+    #define EIGEN_ALIGN_BYTES 32
+  #else
+    #define EIGEN_ALIGN_BYTES 16
+  #endif
+#endif
+
 #define EIGEN_ALIGN16 EIGEN_ALIGN_TO_BOUNDARY(16)
+#define EIGEN_ALIGN32 EIGEN_ALIGN_TO_BOUNDARY(32)
+#define EIGEN_ALIGN64 EIGEN_ALIGN_TO_BOUNDARY(64)
+#define EIGEN_ALIGN_DEFAULT EIGEN_ALIGN_TO_BOUNDARY(EIGEN_ALIGN_BYTES)
 
 #if EIGEN_ALIGN_STATICALLY
 #define EIGEN_USER_ALIGN_TO_BOUNDARY(n) EIGEN_ALIGN_TO_BOUNDARY(n)
 #define EIGEN_USER_ALIGN16 EIGEN_ALIGN16
+#define EIGEN_USER_ALIGN32 EIGEN_ALIGN32
+#define EIGEN_USER_ALIGN64 EIGEN_ALIGN64
+#define EIGEN_USER_ALIGN_DEFAULT EIGEN_ALIGN_DEFAULT
 #else
 #define EIGEN_USER_ALIGN_TO_BOUNDARY(n)
 #define EIGEN_USER_ALIGN16
+#define EIGEN_USER_ALIGN32
+#define EIGEN_USER_ALIGN64
+#define EIGEN_USER_ALIGN_DEFAULT
 #endif
 
 #ifdef EIGEN_DONT_USE_RESTRICT_KEYWORD
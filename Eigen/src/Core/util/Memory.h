@@ -47,10 +47,12 @@
   #define EIGEN_FREEBSD_MALLOC_ALREADY_ALIGNED 0
 #endif
 
-#if defined(__APPLE__) \
+// Those system allocators only guarantee 16 bytes alignment, which is not enough for AVX.
+#if (defined(__APPLE__) \
  || defined(_WIN64) \
  || EIGEN_GLIBC_MALLOC_ALREADY_ALIGNED \
- || EIGEN_FREEBSD_MALLOC_ALREADY_ALIGNED
+ || EIGEN_FREEBSD_MALLOC_ALREADY_ALIGNED) \
+ && EIGEN_ALIGN_BYTES==16
   #define EIGEN_MALLOC_ALREADY_ALIGNED 1
 #else
   #define EIGEN_MALLOC_ALREADY_ALIGNED 0
@@ -91,14 +93,14 @@ inline void throw_std_bad_alloc()
 
 /* ----- Hand made implementations of aligned malloc/free and realloc ----- */
 
-/** \internal Like malloc, but the returned pointer is guaranteed to be 16-byte aligned.
-  * Fast, but wastes 16 additional bytes of memory. Does not throw any exception.
+/** \internal Like malloc, but the returned pointer is guaranteed to be EIGEN_ALIGN_BYTES-aligned.
+  * Fast, but wastes EIGEN_ALIGN_BYTES additional bytes of memory. Does not throw any exception.
   */
 inline void* handmade_aligned_malloc(std::size_t size)
 {
-  void *original = std::malloc(size+16);
+  void *original = std::malloc(size+EIGEN_ALIGN_BYTES);
   if (original == 0) return 0;
-  void *aligned = reinterpret_cast<void*>((reinterpret_cast<std::size_t>(original) & ~(std::size_t(15))) + 16);
+  void *aligned = reinterpret_cast<void*>((reinterpret_cast<std::size_t>(original) & ~(std::size_t(EIGEN_ALIGN_BYTES-1))) + EIGEN_ALIGN_BYTES);
   *(reinterpret_cast<void**>(aligned) - 1) = original;
   return aligned;
 }
@@ -119,9 +121,9 @@ inline void* handmade_aligned_realloc(void* ptr, std::size_t size, std::size_t =
   if (ptr == 0) return handmade_aligned_malloc(size);
   void *original = *(reinterpret_cast<void**>(ptr) - 1);
   std::ptrdiff_t previous_offset = static_cast<char *>(ptr)-static_cast<char *>(original);
-  original = std::realloc(original,size+16);
+  original = std::realloc(original,size+EIGEN_ALIGN_BYTES);
   if (original == 0) return 0;
-  void *aligned = reinterpret_cast<void*>((reinterpret_cast<std::size_t>(original) & ~(std::size_t(15))) + 16);
+  void *aligned = reinterpret_cast<void*>((reinterpret_cast<std::size_t>(original) & ~(std::size_t(EIGEN_ALIGN_BYTES-1))) + EIGEN_ALIGN_BYTES);
   void *previous_aligned = static_cast<char *>(original)+previous_offset;
   if(aligned!=previous_aligned)
     std::memmove(aligned, previous_aligned, size);
@@ -199,7 +201,7 @@ inline void check_that_malloc_is_allowed()
 {}
 #endif
 
-/** \internal Allocates \a size bytes. The returned pointer is guaranteed to have 16 bytes alignment.
+/** \internal Allocates \a size bytes. The returned pointer is guaranteed to have EIGEN_ALIGN_BYTES bytes alignment.
   * On allocation error, the returned pointer is null, and std::bad_alloc is thrown.
   */
 inline void* aligned_malloc(size_t size)
@@ -212,11 +214,11 @@ inline void* aligned_malloc(size_t size)
   #elif EIGEN_MALLOC_ALREADY_ALIGNED
     result = std::malloc(size);
   #elif EIGEN_HAS_POSIX_MEMALIGN
-    if(posix_memalign(&result, 16, size)) result = 0;
+    if(posix_memalign(&result, EIGEN_ALIGN_BYTES, size)) result = 0;
   #elif EIGEN_HAS_MM_MALLOC
-    result = _mm_malloc(size, 16);
+    result = _mm_malloc(size, EIGEN_ALIGN_BYTES);
 #elif defined(_MSC_VER) && (!defined(_WIN32_WCE))
-    result = _aligned_malloc(size, 16);
+    result = _aligned_malloc(size, EIGEN_ALIGN_BYTES);
   #else
     result = handmade_aligned_malloc(size);
   #endif
@@ -266,12 +268,12 @@ inline void* aligned_realloc(void *ptr, size_t new_size, size_t old_size)
   // implements _mm_malloc/_mm_free based on the corresponding _aligned_
   // functions. This may not always be the case and we just try to be safe.
   #if defined(_MSC_VER) && defined(_mm_free)
-    result = _aligned_realloc(ptr,new_size,16);
+    result = _aligned_realloc(ptr,new_size,EIGEN_ALIGN_BYTES);
   #else
     result = generic_aligned_realloc(ptr,new_size,old_size);
   #endif
 #elif defined(_MSC_VER)
-  result = _aligned_realloc(ptr,new_size,16);
+  result = _aligned_realloc(ptr,new_size,EIGEN_ALIGN_BYTES);
 #else
   result = handmade_aligned_realloc(ptr,new_size,old_size);
 #endif
@@ -286,7 +288,7 @@ inline void* aligned_realloc(void *ptr, size_t new_size, size_t old_size)
 *** Implementation of conditionally aligned functions                      ***
 *****************************************************************************/
 
-/** \internal Allocates \a size bytes. If Align is true, then the returned ptr is 16-byte-aligned.
+/** \internal Allocates \a size bytes. If Align is true, then the returned ptr is EIGEN_ALIGN_BYTES-aligned.
   * On allocation error, the returned pointer is null, and a std::bad_alloc is thrown.
   */
 template<bool Align> inline void* conditional_aligned_malloc(size_t size)
@@ -359,7 +361,7 @@ EIGEN_ALWAYS_INLINE void check_size_for_overflow(size_t size)
     throw_std_bad_alloc();
 }
 
-/** \internal Allocates \a size objects of type T. The returned pointer is guaranteed to have 16 bytes alignment.
+/** \internal Allocates \a size objects of type T. The returned pointer is guaranteed to have EIGEN_ALIGN_BYTES bytes alignment.
   * On allocation error, the returned pointer is undefined, but a std::bad_alloc is thrown.
   * The default constructor of T is called.
   */
@@ -571,8 +573,9 @@ template<typename T> class aligned_stack_memory_handler
   */
 #ifdef EIGEN_ALLOCA
 
-  #ifdef __arm__
-    #define EIGEN_ALIGNED_ALLOCA(SIZE) reinterpret_cast<void*>((reinterpret_cast<size_t>(EIGEN_ALLOCA(SIZE+16)) & ~(size_t(15))) + 16)
+  // alloca only guarantees 16 bytes alignment on x86, and less on ARM
+  #if defined(__arm__) || EIGEN_ALIGN_BYTES>16
+    #define EIGEN_ALIGNED_ALLOCA(SIZE) reinterpret_cast<void*>((reinterpret_cast<size_t>(EIGEN_ALLOCA(SIZE+EIGEN_ALIGN_BYTES)) & ~(size_t(EIGEN_ALIGN_BYTES-1))) + EIGEN_ALIGN_BYTES)
   #else
     #define EIGEN_ALIGNED_ALLOCA EIGEN_ALLOCA
   #endif
@@ -640,7 +643,7 @@ template<typename T> class aligned_stack_memory_handler
 
 #define EIGEN_MAKE_ALIGNED_OPERATOR_NEW EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF(true)
 #define EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF_VECTORIZABLE_FIXED_SIZE(Scalar,Size) \
-  EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF(bool(((Size)!=Eigen::Dynamic) && ((sizeof(Scalar)*(Size))%16==0)))
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF(bool(((Size)!=Eigen::Dynamic) && ((sizeof(Scalar)*(Size))%EIGEN_ALIGN_BYTES==0)))
 
 /****************************************************************************/
 
@@ -773,6 +776,17 @@ public:
 #  endif
 #endif
 
+// EIGEN_XGETBV(xcr0) reads the low word of the extended control register XCR0 telling which register states are
+// enabled by the OS. It must only be used when cpuid reports the OSXSAVE feature.
+#if defined(EIGEN_CPUID)
+#  if defined(__GNUC__)
+#    define EIGEN_XGETBV(xcr0) \
+       __asm__ __volatile__ (".byte 0x0f, 0x01, 0xd0" : "=a" (xcr0) : "c" (0) : "%edx");
+#  elif defined(_MSC_FULL_VER) && (_MSC_FULL_VER >= 160040219)
+#    define EIGEN_XGETBV(xcr0) xcr0 = int(_xgetbv(0));
+#  endif
+#endif
+
 namespace internal {
 
 #ifdef EIGEN_CPUID
@@ -967,6 +981,62 @@ inline int queryTopLevelCacheSize()
   return (std::max)(l2,l3);
 }
 
+//---------- SIMD instruction sets ----------
+
+/** \internal The x86 instruction set levels for which the runtime dispatched kernels can be compiled,
+  * each level implies all the previous ones. */
+enum SimdLevel {
+  SimdLevelSSE2 = 0,
+  SimdLevelSSE4_2 = 1,
+  SimdLevelAVX = 2,
+  SimdLevelAVX2 = 3,      // AVX2 and FMA
+  SimdLevelAVX512 = 4     // AVX512F
+};
+
+/** \internal
+ * \returns the highest SimdLevel supported by both the CPU and the OS we are running on */
+inline int querySimdLevel()
+{
+  #if defined(EIGEN_CPUID) && defined(EIGEN_XGETBV)
+  int abcd[4];
+  abcd[0] = abcd[1] = abcd[2] = abcd[3] = 0;
+  EIGEN_CPUID(abcd,0x0,0);
+  int max_std_funcs = abcd[0];
+  if(max_std_funcs<1)
+    return SimdLevelSSE2;
+
+  abcd[0] = abcd[1] = abcd[2] = abcd[3] = 0;
+  EIGEN_CPUID(abcd,0x1,0);
+  int features = abcd[2];
+  if((features & (1<<20))==0)                     // C[20] = SSE4.2
+    return SimdLevelSSE2;
+  if((features & (1<<27))==0 || (features & (1<<28))==0) // C[27] = OSXSAVE, C[28] = AVX
+    return SimdLevelSSE4_2;
+
+  // the OS must save the xmm and ymm registers
+  int xcr0 = 0;
+  EIGEN_XGETBV(xcr0);
+  if((xcr0 & 0x6)!=0x6)
+    return SimdLevelSSE4_2;
+
+  int extended_features = 0;
+  if(max_std_funcs>=7)
+  {
+    abcd[0] = abcd[1] = abcd[2] = abcd[3] = 0;
+    EIGEN_CPUID(abcd,0x7,0);
+    extended_features = abcd[1];
+  }
+  if((extended_features & (1<<5))==0 || (features & (1<<12))==0) // B[5] = AVX2, C[12] = FMA
+    return SimdLevelAVX;
+  // AVX512F additionally requires the opmask and zmm states
+  if((extended_features & (1<<16))==0 || (xcr0 & 0xe6)!=0xe6)   // B[16] = AVX512F
+    return SimdLevelAVX2;
+  return SimdLevelAVX512;
+  #else
+  return SimdLevelSSE2;
+  #endif
+}
+
 } // end namespace internal
 
 } // end namespace Eigen
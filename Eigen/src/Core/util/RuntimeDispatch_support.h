@@ -0,0 +1,83 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_RUNTIME_DISPATCH_SUPPORT_H
+#define EIGEN_RUNTIME_DISPATCH_SUPPORT_H
+
+#if (defined(EIGEN_RUNTIME_DISPATCH) || defined(EIGEN_RUNTIME_DISPATCH_KERNELS)) && defined(EIGEN_USE_MKL)
+  #error EIGEN_RUNTIME_DISPATCH and EIGEN_RUNTIME_DISPATCH_KERNELS cannot be combined with the MKL support
+#endif
+
+#ifdef EIGEN_RUNTIME_DISPATCH_KERNELS
+  // the translation units defining the kernels obviously do not forward to them
+  #undef EIGEN_RUNTIME_DISPATCH
+#endif
+
+#if defined(EIGEN_RUNTIME_DISPATCH) || defined(EIGEN_RUNTIME_DISPATCH_KERNELS)
+
+/** \internal
+  * This namespace is shared by the translation units compiled for the different instruction sets. Unlike
+  * namespace Eigen, it is not renamed in the kernel translation units (see EIGEN_RUNTIME_DISPATCH_KERNELS).
+  * Therefore everything declared here must be identical whatever the instruction set, and the inline functions
+  * must remain trivial: the linker keeps only one of their copies, which might come from any instruction set. */
+namespace eigen_runtime_dispatch {
+
+typedef std::ptrdiff_t index;
+
+/** \internal The coefficient-wise functions of the kernels::math entry */
+enum MathOp { Exp, Log, Sin, Cos, Sqrt, Tanh, Logistic, Erf, Atan };
+
+/** \internal The kernels compiled for one instruction set, all the matrices are column-major unless
+  * a storage order is given. */
+template<typename Scalar> struct kernels
+{
+  /** res += alpha * lhs * rhs, see general_matrix_matrix_product */
+  void (*gemm)(int lhsStorageOrder, int rhsStorageOrder, index rows, index cols, index depth,
+               const Scalar* lhs, index lhsStride, const Scalar* rhs, index rhsStride,
+               Scalar* res, index resStride, Scalar alpha);
+  /** res += alpha * lhs * rhs with a vector rhs, see general_matrix_vector_product */
+  void (*gemv)(int lhsStorageOrder, index rows, index cols, const Scalar* lhs, index lhsStride,
+               const Scalar* rhs, index rhsIncr, Scalar* res, index resIncr, Scalar alpha);
+  /** res += alpha * lhs * rhs where lhs or rhs is triangular, see product_triangular_matrix_matrix */
+  void (*trmm)(int mode, bool lhsIsTriangular, int lhsStorageOrder, int rhsStorageOrder, index rows, index cols,
+               index depth, const Scalar* lhs, index lhsStride, const Scalar* rhs, index rhsStride,
+               Scalar* res, index resStride, Scalar alpha);
+  /** other = tri^-1 * other or other * tri^-1, see triangular_solve_matrix */
+  void (*trsm)(int side, int mode, int triStorageOrder, index size, index otherSize,
+               const Scalar* tri, index triStride, Scalar* other, index otherStride);
+  /** dst[i] = op(src[i]) for i in [0,size) where op is a MathOp */
+  void (*math)(int op, index size, const Scalar* src, Scalar* dst);
+};
+
+struct table
+{
+  int level;
+  kernels<float> single_precision;
+  kernels<double> double_precision;
+};
+
+/** \internal \returns the slot of the table registered for the instruction set \a level, a SimdLevel */
+inline const table*& registered_table(int level)
+{
+  static const table* tables[5] = { 0, 0, 0, 0, 0 };
+  return tables[level];
+}
+
+/** \internal Register the kernels of the respective translation unit (see EIGEN_RUNTIME_DISPATCH_KERNELS).
+  * This is done automatically at startup, but calling them explicitly prevents the linker from discarding the
+  * kernels when they are taken from a static library. */
+void register_kernels_sse2();
+void register_kernels_sse4_2();
+void register_kernels_avx();
+void register_kernels_avx2();
+void register_kernels_avx512();
+
+} // end namespace eigen_runtime_dispatch
+
+#endif
+
+#endif // EIGEN_RUNTIME_DISPATCH_SUPPORT_H
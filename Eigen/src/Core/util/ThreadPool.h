@@ -0,0 +1,213 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_THREADPOOL_H
+#define EIGEN_THREADPOOL_H
+
+namespace Eigen {
+
+/** \class ParallelExecutor
+  * \ingroup Core_Module
+  *
+  * \brief Interface of the objects running the multi-threaded kernels of Eigen
+  *
+  * The parallel kernels of Eigen, such as the general matrix-matrix product, split their work
+  * into a small number of tasks which synchronize with each other. Therefore all the tasks
+  * of a kernel must run simultaneously, and an executor is free to choose their number
+  * according to the number of threads it can spare at the time of the call.
+  *
+  * Implement this interface to run these kernels on your own threads, and register it
+  * with setParallelExecutor(). When compiling with \c EIGEN_USE_THREADS, Eigen also provides
+  * a default implementation, ThreadPool.
+  *
+  * \sa ThreadPool, setParallelExecutor(), setNbThreads()
+  */
+class ParallelExecutor
+{
+  public:
+    /** Type of the tasks: the first argument is the opaque pointer given to run(),
+      * the second one is the index of the task, and the last one is the number of tasks. */
+    typedef void (*Task)(void* data, int id, int count);
+
+    virtual ~ParallelExecutor() {}
+
+    /** \returns the maximal number of tasks which can run simultaneously, the calling thread included */
+    virtual int numThreads() const = 0;
+
+    /** Calls \a task(\a data, i, n) for all i in [0,n) simultaneously, and returns once they are all completed.
+      * The number of tasks \a n must be chosen between 1 and \a maxTasks. Since the tasks might wait on each other,
+      * they must all be running at the same time, so \a n must not exceed the number of threads which are
+      * available at the time of the call. Typically, the calling thread runs one of the tasks. */
+    virtual void run(Task task, void* data, int maxTasks) = 0;
+};
+
+#ifdef EIGEN_USE_THREADS
+
+/** \class ThreadPool
+  * \ingroup Core_Module
+  *
+  * \brief A pool of persistent POSIX threads implementing ParallelExecutor
+  *
+  * The worker threads are started once by the constructor, and are then reused by all the parallel
+  * kernels until the pool is destroyed. Each call to run() is given the workers which are idle at that
+  * time, so that concurrent calls, including nested calls from within a task, share the pool without
+  * ever waiting on each other.
+  *
+  * This class is only available when \c EIGEN_USE_THREADS is defined. In that case, and if no other
+  * executor has been registered with setParallelExecutor(), Eigen uses a default pool with one thread
+  * per processor core (unless OpenMP is enabled, which then keeps precedence).
+  *
+  * \sa ParallelExecutor, setParallelExecutor()
+  */
+class ThreadPool : public ParallelExecutor
+{
+  public:
+
+    /** Creates a pool of \a threads threads, the calling thread included: \a threads-1 workers are started.
+      * The default is the number of processor cores. */
+    explicit ThreadPool(int threads = -1)
+      : m_stop(false)
+    {
+      if(threads<=0)
+        threads = hardwareConcurrency();
+      pthread_mutex_init(&m_mutex, 0);
+      pthread_cond_init(&m_done, 0);
+      m_workers.resize(threads-1);
+      for(std::size_t i=0; i<m_workers.size(); ++i)
+      {
+        Worker& w = m_workers[i];
+        w.pool = this;
+        w.task = 0;
+        w.data = 0;
+        w.id = 0;
+        w.count = 0;
+        w.pending = 0;
+        pthread_cond_init(&w.wakeup, 0);
+        pthread_create(&w.thread, 0, &ThreadPool::workerMain, &w);
+      }
+    }
+
+    /** Stops and joins all the workers. No call to run() must be in progress. */
+    ~ThreadPool()
+    {
+      pthread_mutex_lock(&m_mutex);
+      m_stop = true;
+      for(std::size_t i=0; i<m_workers.size(); ++i)
+        pthread_cond_signal(&m_workers[i].wakeup);
+      pthread_mutex_unlock(&m_mutex);
+      for(std::size_t i=0; i<m_workers.size(); ++i)
+      {
+        pthread_join(m_workers[i].thread, 0);
+        pthread_cond_destroy(&m_workers[i].wakeup);
+      }
+      pthread_cond_destroy(&m_done);
+      pthread_mutex_destroy(&m_mutex);
+    }
+
+    int numThreads() const { return int(m_workers.size())+1; }
+
+    void run(Task task, void* data, int maxTasks)
+    {
+      int pending = 0;
+      std::vector<Worker*> team;
+
+      // hire the idle workers, up to maxTasks-1 of them since the calling thread runs the first task
+      pthread_mutex_lock(&m_mutex);
+      for(std::size_t i=0; i<m_workers.size() && int(team.size())+1<maxTasks; ++i)
+        if(m_workers[i].task==0)
+        {
+          m_workers[i].task = task;
+          team.push_back(&m_workers[i]);
+        }
+      int count = int(team.size())+1;
+      pending = count-1;
+      for(int i=1; i<count; ++i)
+      {
+        Worker& w = *team[i-1];
+        w.data = data;
+        w.id = i;
+        w.count = count;
+        w.pending = &pending;
+        pthread_cond_signal(&w.wakeup);
+      }
+      pthread_mutex_unlock(&m_mutex);
+
+      task(data, 0, count);
+
+      pthread_mutex_lock(&m_mutex);
+      while(pending>0)
+        pthread_cond_wait(&m_done, &m_mutex);
+      pthread_mutex_unlock(&m_mutex);
+    }
+
+    /** \returns the number of processor cores, or 1 if it cannot be determined */
+    static int hardwareConcurrency()
+    {
+      long n = sysconf(_SC_NPROCESSORS_ONLN);
+      return n>0 ? int(n) : 1;
+    }
+
+  protected:
+
+    struct Worker
+    {
+      ThreadPool* pool;
+      pthread_t thread;
+      pthread_cond_t wakeup;
+      Task task;          // the task being run, or 0 if the worker is idle
+      void* data;
+      int id;
+      int count;
+      int* pending;       // number of tasks of the current run() which are not completed yet
+    };
+
+    static void* workerMain(void* arg)
+    {
+      Worker& w = *static_cast<Worker*>(arg);
+      ThreadPool& pool = *w.pool;
+      pthread_mutex_lock(&pool.m_mutex);
+      for(;;)
+      {
+        // a hired worker is woken up once its id, count and pending members are set
+        while(!pool.m_stop && (w.task==0 || w.pending==0))
+          pthread_cond_wait(&w.wakeup, &pool.m_mutex);
+        if(w.task==0 || w.pending==0)
+          break;
+        Task task = w.task;
+        void* data = w.data;
+        int id = w.id, count = w.count;
+        pthread_mutex_unlock(&pool.m_mutex);
+
+        task(data, id, count);
+
+        pthread_mutex_lock(&pool.m_mutex);
+        if(--(*w.pending)==0)
+          pthread_cond_broadcast(&pool.m_done);
+        w.task = 0;
+        w.pending = 0;
+      }
+      pthread_mutex_unlock(&pool.m_mutex);
+      return 0;
+    }
+
+    pthread_mutex_t m_mutex;
+    pthread_cond_t m_done;
+    std::vector<Worker> m_workers;
+    bool m_stop;
+
+  private:
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+};
+
+#endif // EIGEN_USE_THREADS
+
+} // end namespace Eigen
+
+#endif // EIGEN_THREADPOOL_H
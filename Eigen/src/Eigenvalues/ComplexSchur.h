@@ -354,7 +354,7 @@ struct complex_schur_reduce_to_hessenberg
   {
     _this.m_hess.compute(matrix);
     _this.m_matT = _this.m_hess.matrixH();
-    if(computeU)  _this.m_matU = _this.m_hess.matrixQ();
+    if(computeU)  internal::hessenberg_evaluate_q(_this.m_hess, _this.m_matU);
   }
 };
 
@@ -371,7 +371,8 @@ struct complex_schur_reduce_to_hessenberg<MatrixType, false>
     if(computeU)  
     {
       // This may cause an allocation which seems to be avoidable
-      MatrixType Q = _this.m_hess.matrixQ(); 
+      MatrixType Q;
+      internal::hessenberg_evaluate_q(_this.m_hess, Q);
       _this.m_matU = Q.template cast<ComplexScalar>();
     }
   }
@@ -84,7 +84,8 @@ class GeneralizedSelfAdjointEigenSolver : public SelfAdjointEigenSolver<_MatrixT
       *                   Only the lower triangular part of the matrix is referenced.
       * \param[in]  matB  Positive-definite matrix in matrix pencil.
       *                   Only the lower triangular part of the matrix is referenced.
-      * \param[in]  options A or-ed set of flags {#ComputeEigenvectors,#EigenvaluesOnly} | {#Ax_lBx,#ABx_lx,#BAx_lx}.
+      * \param[in]  options A or-ed set of flags {#ComputeEigenvectors,#EigenvaluesOnly} | {#Ax_lBx,#ABx_lx,#BAx_lx},
+      *                     plus #DivideAndConquer to compute the eigenvectors by divide and conquer.
       *                     Default is #ComputeEigenvectors|#Ax_lBx.
       *
       * This constructor calls compute(const MatrixType&, const MatrixType&, int)
@@ -117,7 +118,8 @@ class GeneralizedSelfAdjointEigenSolver : public SelfAdjointEigenSolver<_MatrixT
       *                   Only the lower triangular part of the matrix is referenced.
       * \param[in]  matB  Positive-definite matrix in matrix pencil.
       *                   Only the lower triangular part of the matrix is referenced.
-      * \param[in]  options A or-ed set of flags {#ComputeEigenvectors,#EigenvaluesOnly} | {#Ax_lBx,#ABx_lx,#BAx_lx}.
+      * \param[in]  options A or-ed set of flags {#ComputeEigenvectors,#EigenvaluesOnly} | {#Ax_lBx,#ABx_lx,#BAx_lx},
+      *                     plus #DivideAndConquer to compute the eigenvectors by divide and conquer.
       *                     Default is #ComputeEigenvectors|#Ax_lBx.
       *
       * \returns    Reference to \c *this
@@ -164,7 +166,7 @@ GeneralizedSelfAdjointEigenSolver<MatrixType>& GeneralizedSelfAdjointEigenSolver
 compute(const MatrixType& matA, const MatrixType& matB, int options)
 {
   eigen_assert(matA.cols()==matA.rows() && matB.rows()==matA.rows() && matB.cols()==matB.rows());
-  eigen_assert((options&~(EigVecMask|GenEigMask))==0
+  eigen_assert((options&~(EigVecMask|GenEigMask|DivideAndConquer))==0
           && (options&EigVecMask)!=EigVecMask
           && ((options&GenEigMask)==0 || (options&GenEigMask)==Ax_lBx
            || (options&GenEigMask)==ABx_lx || (options&GenEigMask)==BAx_lx)
@@ -175,6 +177,7 @@ compute(const MatrixType& matA, const MatrixType& matB, int options)
   // Compute the cholesky decomposition of matB = L L' = U'U
   LLT<MatrixType> cholB(matB);
 
+  int eigVecOptions = computeEigVecs ? (ComputeEigenvectors | (options&DivideAndConquer)) : EigenvaluesOnly;
   int type = (options&GenEigMask);
   if(type==0)
     type = Ax_lBx;
@@ -186,7 +189,7 @@ compute(const MatrixType& matA, const MatrixType& matB, int options)
     cholB.matrixL().template solveInPlace<OnTheLeft>(matC);
     cholB.matrixU().template solveInPlace<OnTheRight>(matC);
 
-    Base::compute(matC, computeEigVecs ? ComputeEigenvectors : EigenvaluesOnly );
+    Base::compute(matC, eigVecOptions);
 
     // transform back the eigen vectors: evecs = inv(U) * evecs
     if(computeEigVecs)
@@ -199,7 +202,7 @@ compute(const MatrixType& matA, const MatrixType& matB, int options)
     matC = matC * cholB.matrixL();
     matC = cholB.matrixU() * matC;
 
-    Base::compute(matC, computeEigVecs ? ComputeEigenvectors : EigenvaluesOnly);
+    Base::compute(matC, eigVecOptions);
 
     // transform back the eigen vectors: evecs = inv(U) * evecs
     if(computeEigVecs)
@@ -212,7 +215,7 @@ compute(const MatrixType& matA, const MatrixType& matB, int options)
     matC = matC * cholB.matrixL();
     matC = cholB.matrixU() * matC;
 
-    Base::compute(matC, computeEigVecs ? ComputeEigenvectors : EigenvaluesOnly);
+    Base::compute(matC, eigVecOptions);
 
     // transform back the eigen vectors: evecs = L * evecs
     if(computeEigVecs)
@@ -276,25 +276,74 @@ template<typename _MatrixType> class HessenbergDecomposition
     bool m_isInitialized;
 };
 
+namespace internal {
+
 /** \internal
-  * Performs a tridiagonal decomposition of \a matA in place.
-  *
-  * \param matA the input selfadjoint matrix
-  * \param hCoeffs returned Householder coefficients
-  *
-  * The result is written in the lower triangular part of \a matA.
-  *
-  * Implemented from Golub's "%Matrix Computations", algorithm 8.3.1.
-  *
-  * \sa packedMatrix()
+  * Reduces the \a bs columns of \a matA starting at \a k (as in LAPACK's xLAHR2). On return, the panel columns
+  * are reduced, and \a V, \a T and \a Y are such that the Householder reflectors of the panel read
+  * \f$ I - V T V^* \f$ and \f$ Y = A V T \f$, A being the matrix before the reduction of the panel. The rows of
+  * \a V start at \a k+1. Only the rows \a k+1 to \a n-1 of \a Y are computed.
   */
-template<typename MatrixType>
-void HessenbergDecomposition<MatrixType>::_compute(MatrixType& matA, CoeffVectorType& hCoeffs, VectorType& temp)
+template<typename MatrixType, typename CoeffVectorType, typename WorkMatrixType>
+void hessenberg_blocked_panel(MatrixType& matA, CoeffVectorType& hCoeffs, typename MatrixType::Index k,
+                              typename MatrixType::Index bs, WorkMatrixType& V, WorkMatrixType& T, WorkMatrixType& Y)
 {
-  eigen_assert(matA.rows()==matA.cols());
+  using numext::conj;
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
   Index n = matA.rows();
-  temp.resize(n);
-  for (Index i = 0; i<n-1; ++i)
+  Index rs = n-k-1;
+
+  V.setZero(rs, bs);
+  T.setZero(bs, bs);
+  Y.setZero(n, bs);
+  Matrix<Scalar,Dynamic,1> tmp(bs);
+  for(Index i = 0; i < bs; ++i)
+  {
+    Index j = k+i;
+    Index remainingSize = n-j-1;
+
+    // apply the previous transformations of the panel to the j-th column: b = (I - V T^* V^*) (b - Y V^* e_j)
+    if(i > 0)
+    {
+      typename MatrixType::ColXpr::SegmentReturnType b = matA.col(j).tail(rs);
+      b.noalias() -= Y.block(k+1,0,rs,i) * V.row(i-1).head(i).adjoint();
+      tmp.head(i).noalias() = V.leftCols(i).adjoint() * b;
+      tmp.head(i) = T.topLeftCorner(i,i).template triangularView<Upper>().adjoint() * tmp.head(i);
+      b.noalias() -= V.leftCols(i) * tmp.head(i);
+    }
+
+    RealScalar beta;
+    Scalar h;
+    matA.col(j).tail(remainingSize).makeHouseholderInPlace(h, beta);
+    V.col(i).tail(remainingSize) = matA.col(j).tail(remainingSize);
+    V.coeffRef(i,i) = Scalar(1);
+    matA.coeffRef(j+1,j) = beta;
+    hCoeffs.coeffRef(j) = h;
+
+    // y_i = conj(h) (A v_i - Y V^* v_i) and the i-th column of T
+    Scalar tau = conj(h);
+    tmp.head(i).noalias() = V.block(i,0,remainingSize,i).adjoint() * V.col(i).tail(remainingSize);
+    Y.col(i).segment(k+1,rs).noalias() = matA.block(k+1,j+1,rs,remainingSize) * V.col(i).tail(remainingSize);
+    Y.col(i).segment(k+1,rs).noalias() -= Y.block(k+1,0,rs,i) * tmp.head(i);
+    Y.col(i).segment(k+1,rs) *= tau;
+    T.col(i).head(i).noalias() = -tau * (T.topLeftCorner(i,i).template triangularView<Upper>() * tmp.head(i));
+    T.coeffRef(i,i) = tau;
+  }
+}
+
+/** \internal
+  * Reduces \a matA to Hessenberg form in place, starting at column \a k, one column at a time.
+  */
+template<typename MatrixType, typename CoeffVectorType, typename VectorType>
+void hessenberg_inplace_unblocked(MatrixType& matA, CoeffVectorType& hCoeffs, VectorType& temp, typename MatrixType::Index k = 0)
+{
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  Index n = matA.rows();
+  for (Index i = k; i<n-1; ++i)
   {
     // let's consider the vector v = i-th column starting at position i+1
     Index remainingSize = n-i-1;
@@ -317,8 +366,89 @@ void HessenbergDecomposition<MatrixType>::_compute(MatrixType& matA, CoeffVector
   }
 }
 
+/** \internal
+  * Same as hessenberg_inplace_unblocked(), but reduces the matrix by panels of \a maxBlockSize columns whose
+  * transformations are applied to the rest of the matrix with matrix-matrix products. The last columns are
+  * reduced by the unblocked algorithm.
+  */
+template<typename MatrixType, typename CoeffVectorType, typename VectorType>
+void hessenberg_inplace_blocked(MatrixType& matA, CoeffVectorType& hCoeffs, VectorType& temp, typename MatrixType::Index maxBlockSize = 32)
+{
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> WorkMatrixType;
+  Index n = matA.rows();
+
+  WorkMatrixType V, T, Y, tmp;
+  Index k = 0;
+  for(; n - k > 2*maxBlockSize; k += maxBlockSize)
+  {
+    Index bs = maxBlockSize;
+    Index rs = n-k-1;
+    hessenberg_blocked_panel(matA, hCoeffs, k, bs, V, T, Y);
+
+    // A = A (I - V T V^*) for the rows 0 to k, and the columns on the right of the panel
+    tmp.noalias() = matA.block(0,k+1,k+1,rs) * V;
+    Y.topRows(k+1).noalias() = tmp * T.template triangularView<Upper>();
+    matA.block(0,k+1,k+1,rs).noalias() -= Y.topRows(k+1) * V.adjoint();
+    Block<MatrixType,Dynamic,Dynamic> A2(matA, k+1, k+bs, rs, n-k-bs);
+    A2.noalias() -= Y.bottomRows(rs) * V.bottomRows(n-k-bs).adjoint();
+
+    // A = (I - V T^* V^*) A for the columns on the right of the panel
+    tmp.noalias() = V.adjoint() * A2;
+    tmp = T.template triangularView<Upper>().adjoint() * tmp;
+    A2.noalias() -= V * tmp;
+  }
+
+  hessenberg_inplace_unblocked(matA, hCoeffs, temp, k);
+}
+
+} // end namespace internal
+
+/** \internal
+  * Performs a Hessenberg decomposition of \a matA in place.
+  *
+  * \param matA the input matrix
+  * \param hCoeffs returned Householder coefficients
+  *
+  * Implemented from Golub's "%Matrix Computations", algorithm 7.4.2. Large matrices are reduced by panels
+  * of 32 columns, whose transformations are applied to the rest of the matrix with level 3 operations.
+  *
+  * \sa packedMatrix()
+  */
+template<typename MatrixType>
+void HessenbergDecomposition<MatrixType>::_compute(MatrixType& matA, CoeffVectorType& hCoeffs, VectorType& temp)
+{
+  eigen_assert(matA.rows()==matA.cols());
+  Index n = matA.rows();
+  temp.resize(n);
+  if(MaxSize==Dynamic || MaxSize>64)
+    internal::hessenberg_inplace_blocked(matA, hCoeffs, temp);
+  else
+    internal::hessenberg_inplace_unblocked(matA, hCoeffs, temp);
+}
+
 namespace internal {
 
+/** \internal
+  * Evaluates the matrix Q of the Hessenberg decomposition \a hess into \a dst. Large matrices are formed by
+  * blocks of Householder reflectors.
+  */
+template<typename MatrixType>
+void hessenberg_evaluate_q(const HessenbergDecomposition<MatrixType>& hess, MatrixType& dst)
+{
+  typedef typename MatrixType::Index Index;
+  Index n = hess.packedMatrix().rows();
+  if((MatrixType::MaxColsAtCompileTime==Dynamic || MatrixType::MaxColsAtCompileTime>64) && n>1)
+  {
+    dst.setIdentity(n, n);
+    apply_block_householder_sequence_on_the_left(dst, hess.packedMatrix(), hess.householderCoefficients().conjugate(),
+                                                 n-1, 1, true);
+  }
+  else
+    dst = hess.matrixQ();
+}
+
 /** \eigenvalues_module \ingroup Eigenvalues_Module
   *
   *
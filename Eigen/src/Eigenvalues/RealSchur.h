@@ -155,7 +155,10 @@ template<typename _MatrixType> class RealSchur
       * The Schur decomposition is computed by first reducing the matrix to
       * Hessenberg form using the class HessenbergDecomposition. The Hessenberg
       * matrix is then reduced to triangular form by performing Francis QR
-      * iterations with implicit double shift. The cost of computing the Schur
+      * iterations with implicit double shift. Large matrices are reduced by
+      * the small-bulge multishift QR algorithm with aggressive early
+      * deflation, which relies on matrix-matrix products, until the
+      * remaining active blocks are small enough. The cost of computing the Schur
       * decomposition depends on the number of iterations; as a rough guide, it
       * may be taken to be \f$25n^3\f$ flops if \a computeU is true and
       * \f$10n^3\f$ flops if \a computeU is false.
@@ -232,6 +235,11 @@ template<typename _MatrixType> class RealSchur
     Index m_maxIters;
 
     typedef Matrix<Scalar,3,1> Vector3s;
+    typedef Matrix<Scalar,Dynamic,Dynamic> WorkMatrixType;
+    typedef Matrix<Scalar,Dynamic,2> ShiftPairsType;
+
+    /** \internal Active windows of at least this size are reduced by the multishift QR algorithm. */
+    static const int m_multishiftMinSize = 75;
 
     Scalar computeNormOfT();
     Index findSmallSubdiagEntry(Index iu, const Scalar& norm);
@@ -239,6 +247,9 @@ template<typename _MatrixType> class RealSchur
     void computeShift(Index iu, Index iter, Scalar& exshift, Vector3s& shiftInfo);
     void initFrancisQRStep(Index il, Index iu, const Vector3s& shiftInfo, Index& im, Vector3s& firstHouseholderVector);
     void performFrancisQRStep(Index il, Index im, Index iu, bool computeU, const Vector3s& firstHouseholderVector, Scalar* workspace);
+    void performMultishiftQRStep(Index il, Index iu, Index iter, bool computeU);
+    Index aggressiveEarlyDeflation(Index il, Index iu, Index nw, bool computeU, ShiftPairsType& shifts);
+    void performMultishiftQRSweep(Index il, Index iu, const ShiftPairsType& shifts, bool computeU);
 };
 
 
@@ -254,7 +265,13 @@ RealSchur<MatrixType>& RealSchur<MatrixType>::compute(const MatrixType& matrix,
   m_hess.compute(matrix);
 
   // Step 2. Reduce to real Schur form  
-  computeFromHessenberg(m_hess.matrixH(), m_hess.matrixQ(), computeU);
+  if(computeU)
+  {
+    internal::hessenberg_evaluate_q(m_hess, m_matU);
+    computeFromHessenberg(m_hess.matrixH(), m_matU, computeU);
+  }
+  else
+    computeFromHessenberg(m_hess.matrixH(), m_hess.matrixQ(), computeU);
   
   return *this;
 }
@@ -282,7 +299,10 @@ RealSchur<MatrixType>& RealSchur<MatrixType>::computeFromHessenberg(const HessMa
   Scalar exshift(0);   // sum of exceptional shifts
   Scalar norm = computeNormOfT();
 
-  if(norm!=0)
+  // the iterations cannot converge if the matrix contains infinite or NaN entries
+  if(!(numext::isfinite)(norm))
+    totalIter = maxIters + 1;
+  else if(norm!=0)
   {
     while (iu >= 0)
     {
@@ -303,6 +323,13 @@ RealSchur<MatrixType>& RealSchur<MatrixType>::computeFromHessenberg(const HessMa
         iu -= 2;
         iter = 0;
       }
+      else if (iu - il + 1 >= m_multishiftMinSize) // No convergence yet, large active window
+      {
+        iter = iter + 1;
+        totalIter = totalIter + 1;
+        if (totalIter > maxIters) break;
+        performMultishiftQRStep(il, iu, iter, computeU);
+      }
       else // No convergence yet
       {
         // The firstHouseholderVector vector has to be initialized to something to get rid of a silly GCC warning (-O1 -Wall -DNDEBUG )
@@ -524,6 +551,279 @@ inline void RealSchur<MatrixType>::performFrancisQRStep(Index il, Index im, Inde
   }
 }
 
+/** \internal Perform an aggressive early deflation followed, if needed, by a multishift QR sweep on the rows il:iu.
+  *
+  * This is the small-bulge multishift QR algorithm of Braman, Byers and Mathias, as implemented in LAPACK's xLAQR0.
+  * The number of shifts and the size of the deflation window follow the choices of LAPACK.
+  */
+template<typename MatrixType>
+void RealSchur<MatrixType>::performMultishiftQRStep(Index il, Index iu, Index iter, bool computeU)
+{
+  using std::abs;
+  const Index nh = iu - il + 1;
+  Index ns;
+  if (nh < 150)       ns = 10;
+  else if (nh < 590)  ns = (std::max)(Index(10), Index(nh / Index(std::log(double(nh)) / std::log(2.0) + 0.5)));
+  else if (nh < 3000) ns = 64;
+  else if (nh < 6000) ns = 128;
+  else                ns = 256;
+  ns = (std::min)(ns - ns % 2, Index(nh / 6) * 2);
+  Index nw = (std::min)(nh <= 500 ? ns : 3 * ns / 2, (nh - 1) / 3);
+
+  ShiftPairsType shifts;
+  Index nd = aggressiveEarlyDeflation(il, iu, nw, computeU, shifts);
+
+  // skip the QR sweep if the deflation window was successful enough
+  if (nd > 0 && 100 * nd > 14 * nw)
+    return;
+  iu -= nd;
+
+  Index npairs = (std::min)(Index(shifts.rows()), ns / 2);
+  if (iter % 6 == 0 || npairs == 0)
+  {
+    // exceptional shifts
+    npairs = ns / 2;
+    shifts.resize(npairs, 2);
+    for (Index j = 0; j < npairs; ++j)
+    {
+      Index i = (std::max)(il + 2, iu - 2 * j);
+      Scalar s = abs(m_matT.coeff(i,i-1)) + abs(m_matT.coeff(i-1,i-2));
+      Scalar a = Scalar(0.75) * s + m_matT.coeff(i,i);
+      shifts.coeffRef(j,0) = Scalar(2) * a;
+      shifts.coeffRef(j,1) = a * a + Scalar(0.4375) * s * s;
+    }
+  }
+  performMultishiftQRSweep(il, iu, shifts.topRows(npairs), computeU);
+}
+
+/** \internal Aggressive early deflation on the trailing nw-by-nw window of the rows il:iu.
+  *
+  * The window is reduced to real Schur form, and the eigenvalues at its bottom whose corresponding component of
+  * the spike is negligible are deflated. The remaining part of the window is brought back to Hessenberg form.
+  * Unlike LAPACK's xLAQR3, the Schur form of the window is not reordered, so that the deflation stops at the
+  * first eigenvalue which cannot be deflated. The undeflated eigenvalues are returned in \a shifts, by pairs
+  * stored as their sum and product, starting from the bottom of the window. Returns the number of deflated
+  * eigenvalues.
+  */
+template<typename MatrixType>
+typename MatrixType::Index RealSchur<MatrixType>::aggressiveEarlyDeflation(Index il, Index iu, Index nw, bool computeU, ShiftPairsType& shifts)
+{
+  using std::abs;
+  using std::sqrt;
+  const Index size = m_matT.cols();
+  const Index kwtop = iu - nw + 1;
+  const Scalar spikeScale = kwtop > il ? m_matT.coeff(kwtop, kwtop-1) : Scalar(0);
+  const Scalar eps = NumTraits<Scalar>::epsilon();
+  const Scalar smlnum = (std::numeric_limits<Scalar>::min)() * (Scalar(size) / eps);
+  Scalar* workspace = &m_workspaceVector.coeffRef(0);
+
+  RealSchur<WorkMatrixType> windowSchur(nw);
+  windowSchur.computeFromHessenberg(m_matT.block(kwtop, kwtop, nw, nw), WorkMatrixType::Identity(nw, nw), true);
+  if (windowSchur.info() != Success)
+  {
+    shifts.resize(0, 2);
+    return 0;
+  }
+  WorkMatrixType S = windowSchur.matrixT();
+  WorkMatrixType Z = windowSchur.matrixU();
+  Matrix<Scalar,Dynamic,1> spike = spikeScale * Z.row(0).transpose();
+
+  // deflation check from the bottom of the window
+  Index nu = nw;
+  while (nu > 0)
+  {
+    if (nu > 1 && S.coeff(nu-1, nu-2) != Scalar(0))
+    {
+      Scalar foo = abs(S.coeff(nu-1,nu-1)) + sqrt(abs(S.coeff(nu-1,nu-2))) * sqrt(abs(S.coeff(nu-2,nu-1)));
+      if (foo == Scalar(0))
+        foo = abs(spikeScale);
+      if (!((std::max)(abs(spike.coeff(nu-1)), abs(spike.coeff(nu-2))) <= (std::max)(smlnum, eps * foo)))
+        break;
+      spike.coeffRef(nu-1) = spike.coeffRef(nu-2) = Scalar(0);
+      nu -= 2;
+    }
+    else
+    {
+      Scalar foo = abs(S.coeff(nu-1,nu-1));
+      if (foo == Scalar(0))
+        foo = abs(spikeScale);
+      if (!(abs(spike.coeff(nu-1)) <= (std::max)(smlnum, eps * foo)))
+        break;
+      spike.coeffRef(nu-1) = Scalar(0);
+      nu -= 1;
+    }
+  }
+  const Index nd = nw - nu;
+
+  // collect the undeflated eigenvalues as pairs of shifts
+  shifts.resize(nu / 2 + 1, 2);
+  Index npairs = 0;
+  bool pendingReal = false;
+  Scalar realShift(0);
+  for (Index i = nu - 1; i >= 0; --i)
+  {
+    if (i > 0 && S.coeff(i, i-1) != Scalar(0))
+    {
+      shifts.coeffRef(npairs,0) = S.coeff(i-1,i-1) + S.coeff(i,i);
+      shifts.coeffRef(npairs,1) = S.coeff(i-1,i-1) * S.coeff(i,i) - S.coeff(i-1,i) * S.coeff(i,i-1);
+      ++npairs;
+      --i;
+    }
+    else if (pendingReal)
+    {
+      shifts.coeffRef(npairs,0) = realShift + S.coeff(i,i);
+      shifts.coeffRef(npairs,1) = realShift * S.coeff(i,i);
+      ++npairs;
+      pendingReal = false;
+    }
+    else
+    {
+      realShift = S.coeff(i,i);
+      pendingReal = true;
+    }
+  }
+  shifts.conservativeResize(npairs, 2);
+
+  if (nd == 0)
+    return 0;
+
+  // write back the window and the spike, and reduce the undeflated part to Hessenberg form
+  Block<MatrixType,Dynamic,Dynamic> window(m_matT, kwtop, kwtop, nw, nw);
+  window = S;
+  if (kwtop > il)
+    m_matT.col(kwtop-1).segment(kwtop, nw) = spike;
+  if (nu > 1 && spikeScale != Scalar(0))
+  {
+    Scalar tau, beta;
+    Matrix<Scalar,Dynamic,1> ess(nu-1);
+    spike.head(nu).makeHouseholder(ess, tau, beta);
+    m_matT.coeffRef(kwtop, kwtop-1) = beta;
+    m_matT.col(kwtop-1).segment(kwtop+1, nu-1).setZero();
+    window.topRows(nu).applyHouseholderOnTheLeft(ess, tau, workspace);
+    window.topLeftCorner(nu, nu).applyHouseholderOnTheRight(ess, tau, workspace);
+    Z.leftCols(nu).applyHouseholderOnTheRight(ess, tau, workspace);
+
+    HessenbergDecomposition<WorkMatrixType> hess(window.topLeftCorner(nu, nu));
+    WorkMatrixType Q = hess.matrixQ();
+    window.topLeftCorner(nu, nu) = hess.matrixH();
+    window.topRightCorner(nu, nw - nu) = Q.transpose() * window.topRightCorner(nu, nw - nu);
+    Z.leftCols(nu) = Z.leftCols(nu) * Q;
+  }
+
+  // apply the orthogonal transformation of the window to the rest of the matrix
+  if (iu + 1 < size)
+    m_matT.block(kwtop, iu + 1, nw, size - iu - 1) = Z.transpose() * m_matT.block(kwtop, iu + 1, nw, size - iu - 1);
+  if (kwtop > 0)
+    m_matT.block(0, kwtop, kwtop, nw) = m_matT.block(0, kwtop, kwtop, nw) * Z;
+  if (computeU)
+    m_matU.middleCols(kwtop, nw) = m_matU.middleCols(kwtop, nw) * Z;
+
+  return nd;
+}
+
+/** \internal Perform a multishift QR sweep on the rows il:iu with the given pairs of shifts.
+  *
+  * The bulges of the pairs of shifts form a tightly packed chain of 3x3 bulges which are chased down together.
+  * The transformations are first applied to a window enclosing the chain and accumulated, and then applied to the
+  * rest of the matrix with matrix-matrix products.
+  */
+template<typename MatrixType>
+void RealSchur<MatrixType>::performMultishiftQRSweep(Index il, Index iu, const ShiftPairsType& shifts, bool computeU)
+{
+  using std::abs;
+  const Index size = m_matT.cols();
+  const Index npairs = shifts.rows();
+  Scalar* workspace = &m_workspaceVector.coeffRef(0);
+
+  // at step t, the bulge j is chased from the column p = il-1+t-3j (p = il-1 introduces the bulge)
+  const Index lastStep = iu - il - 1 + 3 * (npairs - 1);
+  const Index nstep = 3 * npairs;
+  WorkMatrixType U, tmp;
+  for (Index t0 = 0; t0 <= lastStep; t0 += nstep)
+  {
+    const Index t1 = (std::min)(t0 + nstep - 1, lastStep);
+    const Index w0 = (std::max)(il, il + t0 - 3 * (npairs - 1));
+    const Index w1 = (std::min)(iu, (std::min)(iu - 2, il - 1 + t1) + 4);
+    const Index nwin = w1 - w0 + 1;
+    U.setIdentity(nwin, nwin);
+
+    for (Index t = t0; t <= t1; ++t)
+    {
+      for (Index j = 0; j < npairs; ++j)
+      {
+        const Index p = il - 1 + t - 3 * j;
+        if (p > iu - 2)
+          continue;
+        if (p < il - 1)
+          break;
+
+        Scalar tau, beta;
+        if (p < iu - 2)
+        {
+          Vector3s v;
+          if (p == il - 1)
+          {
+            // first column of (H - s1 I)(H - s2 I), scaled to avoid overflows
+            Scalar scale = abs(m_matT.coeff(il,il)) + abs(m_matT.coeff(il+1,il)) + abs(m_matT.coeff(il,il+1))
+                         + abs(m_matT.coeff(il+1,il+1)) + abs(m_matT.coeff(il+2,il+1)) + abs(shifts.coeff(j,0));
+            if (scale == Scalar(0))
+              continue;
+            Scalar h00 = m_matT.coeff(il,il) / scale, h10 = m_matT.coeff(il+1,il) / scale;
+            Scalar h01 = m_matT.coeff(il,il+1) / scale, h11 = m_matT.coeff(il+1,il+1) / scale;
+            Scalar h21 = m_matT.coeff(il+2,il+1) / scale;
+            Scalar tr = shifts.coeff(j,0) / scale, det = (shifts.coeff(j,1) / scale) / scale;
+            v.coeffRef(0) = h00 * (h00 - tr) + h01 * h10 + det;
+            v.coeffRef(1) = h10 * (h00 + h11 - tr);
+            v.coeffRef(2) = h10 * h21;
+          }
+          else
+            v = m_matT.template block<3,1>(p+1, p);
+
+          Matrix<Scalar, 2, 1> ess;
+          v.makeHouseholder(ess, tau, beta);
+          if (p >= il)
+          {
+            m_matT.coeffRef(p+1, p) = beta;
+            m_matT.coeffRef(p+2, p) = Scalar(0);
+            m_matT.coeffRef(p+3, p) = Scalar(0);
+          }
+          m_matT.block(p+1, p+1, 3, w1-p).applyHouseholderOnTheLeft(ess, tau, workspace);
+          m_matT.block(w0, p+1, (std::min)(p+4, iu) - w0 + 1, 3).applyHouseholderOnTheRight(ess, tau, workspace);
+          U.block(0, p+1-w0, nwin, 3).applyHouseholderOnTheRight(ess, tau, workspace);
+        }
+        else
+        {
+          Matrix<Scalar, 2, 1> v = m_matT.template block<2,1>(iu-1, iu-2);
+          Matrix<Scalar, 1, 1> ess;
+          v.makeHouseholder(ess, tau, beta);
+          m_matT.coeffRef(iu-1, iu-2) = beta;
+          m_matT.coeffRef(iu, iu-2) = Scalar(0);
+          m_matT.block(iu-1, iu-1, 2, w1-iu+2).applyHouseholderOnTheLeft(ess, tau, workspace);
+          m_matT.block(w0, iu-1, iu-w0+1, 2).applyHouseholderOnTheRight(ess, tau, workspace);
+          U.block(0, iu-1-w0, nwin, 2).applyHouseholderOnTheRight(ess, tau, workspace);
+        }
+      }
+    }
+
+    // apply the accumulated transformations outside of the window
+    if (w1 + 1 < size)
+    {
+      tmp.noalias() = U.transpose() * m_matT.block(w0, w1+1, nwin, size-w1-1);
+      m_matT.block(w0, w1+1, nwin, size-w1-1) = tmp;
+    }
+    if (w0 > 0)
+    {
+      tmp.noalias() = m_matT.block(0, w0, w0, nwin) * U;
+      m_matT.block(0, w0, w0, nwin) = tmp;
+    }
+    if (computeU)
+    {
+      tmp.noalias() = m_matU.block(0, w0, size, nwin) * U;
+      m_matU.block(0, w0, size, nwin) = tmp;
+    }
+  }
+}
+
 } // end namespace Eigen
 
 #endif // EIGEN_REAL_SCHUR_H
@@ -139,11 +139,12 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
       *
       * \param[in]  matrix  Selfadjoint matrix whose eigendecomposition is to
       *    be computed. Only the lower triangular part of the matrix is referenced.
-      * \param[in]  options Can be #ComputeEigenvectors (default) or #EigenvaluesOnly.
+      * \param[in]  options Can be #ComputeEigenvectors (default) or #EigenvaluesOnly,
+      *    and #ComputeEigenvectors can be combined with #DivideAndConquer.
       *
       * This constructor calls compute(const MatrixType&, int) to compute the
       * eigenvalues of the matrix \p matrix. The eigenvectors are computed if
-      * \p options equals #ComputeEigenvectors.
+      * \p options contains #ComputeEigenvectors.
       *
       * Example: \include SelfAdjointEigenSolver_SelfAdjointEigenSolver_MatrixType.cpp
       * Output: \verbinclude SelfAdjointEigenSolver_SelfAdjointEigenSolver_MatrixType.out
@@ -163,11 +164,12 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
       *
       * \param[in]  matrix  Selfadjoint matrix whose eigendecomposition is to
       *    be computed. Only the lower triangular part of the matrix is referenced.
-      * \param[in]  options Can be #ComputeEigenvectors (default) or #EigenvaluesOnly.
+      * \param[in]  options Can be #ComputeEigenvectors (default) or #EigenvaluesOnly,
+      *    and #ComputeEigenvectors can be combined with #DivideAndConquer.
       * \returns    Reference to \c *this
       *
       * This function computes the eigenvalues of \p matrix.  The eigenvalues()
-      * function can be used to retrieve them.  If \p options equals #ComputeEigenvectors,
+      * function can be used to retrieve them.  If \p options contains #ComputeEigenvectors,
       * then the eigenvectors are also computed and can be retrieved by
       * calling eigenvectors().
       *
@@ -180,6 +182,15 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
       * The cost of the computation is about \f$ 9n^3 \f$ if the eigenvectors
       * are required and \f$ 4n^3/3 \f$ if they are not required.
       *
+      * If \p options also contains #DivideAndConquer, the eigenvectors of the
+      * tridiagonal matrix are instead computed by Cuppen's divide and conquer
+      * algorithm, with the deflation and the eigenvector computation of Gu and
+      * Eisenstat: the tridiagonal matrix is split in two halves, whose
+      * eigendecompositions are computed recursively and merged by solving a
+      * secular equation. Most of the work is then done by matrix products, and
+      * deflation often makes it much cheaper than \f$ 9n^3 \f$. This is
+      * recommended for large matrices.
+      *
       * This method reuses the memory in the SelfAdjointEigenSolver object that
       * was allocated when the object was constructed, if the size of the
       * matrix does not change.
@@ -378,6 +389,107 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
 namespace internal {
 template<int StorageOrder,typename RealScalar, typename Scalar, typename Index>
 static void tridiagonal_qr_step(RealScalar* diag, RealScalar* subdiag, Index start, Index end, Scalar* matrixQ, Index n);
+
+/** \internal
+  * Diagonalizes the tridiagonal matrix \a diag, \a subdiag by implicit QR steps, the rotations being applied
+  * to the columns of the n x n matrix \a matrixQ if it is not null. On return, \a diag holds the eigenvalues,
+  * in no particular order.
+  */
+template<int StorageOrder, typename RealVectorType, typename SubDiagType, typename Scalar>
+ComputationInfo tridiagonal_qr_iterations(RealVectorType& diag, SubDiagType& subdiag, typename RealVectorType::Index maxIterations, Scalar* matrixQ)
+{
+  using std::abs;
+  typedef typename RealVectorType::Index Index;
+  Index n = diag.size();
+  Index end = n-1;
+  Index start = 0;
+  Index iter = 0; // total number of iterations
+
+  while (end>0)
+  {
+    for (Index i = start; i<end; ++i)
+      if (internal::isMuchSmallerThan(abs(subdiag[i]),(abs(diag[i])+abs(diag[i+1]))))
+        subdiag[i] = 0;
+
+    // find the largest unreduced block
+    while (end>0 && subdiag[end-1]==0)
+    {
+      end--;
+    }
+    if (end<=0)
+      break;
+
+    // if we spent too many iterations, we give up
+    iter++;
+    if(iter > maxIterations) break;
+
+    start = end - 1;
+    while (start>0 && subdiag[start-1]!=0)
+      start--;
+
+    internal::tridiagonal_qr_step<StorageOrder>(diag.data(), subdiag.data(), start, end, matrixQ, n);
+  }
+
+  return iter <= maxIterations ? Success : NoConvergence;
+}
+
+/** \internal Blocks of the divide and conquer algorithm smaller than this are diagonalized by QR steps */
+enum { tridiagonal_divide_and_conquer_switch_size = 25 };
+
+template<typename RealVectorType, typename RealMatrixType>
+void tridiagonal_rank_one_eigenproblem(const RealVectorType& d, RealVectorType z, typename RealVectorType::Scalar rho,
+                                       RealVectorType& lambda, RealMatrixType& U);
+
+/** \internal
+  * Computes the eigendecomposition \f$ T = Z \Lambda Z^T \f$ of the block of \a n rows and columns of the
+  * tridiagonal matrix \a diag, \a subdiag starting at \a first, by Cuppen's divide and conquer algorithm.
+  * The diagonal block is overwritten by the eigenvalues, which are not sorted. The blocks smaller than
+  * tridiagonal_divide_and_conquer_switch_size are diagonalized by QR steps, which may fail to converge.
+  */
+template<typename RealVectorType, typename SubDiagType, typename RealMatrixType>
+ComputationInfo tridiagonal_divide_and_conquer(RealVectorType& diag, SubDiagType& subdiag, typename RealVectorType::Index first,
+                                               typename RealVectorType::Index n, RealMatrixType& Z, int maxIterations)
+{
+  typedef typename RealVectorType::Index Index;
+  typedef typename RealVectorType::Scalar RealScalar;
+  typedef Matrix<RealScalar,Dynamic,1> VectorType;
+
+  if(n <= tridiagonal_divide_and_conquer_switch_size)
+  {
+    VectorType d = diag.segment(first, n);
+    VectorType e = subdiag.segment(first, n-1);
+    Z.setIdentity(n, n);
+    ComputationInfo info = tridiagonal_qr_iterations<ColMajor>(d, e, maxIterations * n, Z.data());
+    diag.segment(first, n) = d;
+    return info;
+  }
+
+  // T = diag(T1, T2) + beta v v^T with v = e_{k-1} + e_k, T1 and T2 being the two halves of T
+  // whose last and first diagonal coefficients are decreased by beta
+  Index k = n/2;
+  RealScalar beta = subdiag.coeff(first+k-1);
+  diag.coeffRef(first+k-1) -= beta;
+  diag.coeffRef(first+k) -= beta;
+  RealMatrixType Z1, Z2;
+  if(tridiagonal_divide_and_conquer(diag, subdiag, first, k, Z1, maxIterations) != Success
+    || tridiagonal_divide_and_conquer(diag, subdiag, first+k, n-k, Z2, maxIterations) != Success)
+    return NoConvergence;
+
+  // T = diag(Z1, Z2) (D + beta z z^T) diag(Z1, Z2)^T with z = diag(Z1, Z2)^T v
+  VectorType d = diag.segment(first, n);
+  VectorType z(n);
+  z.head(k) = Z1.row(k-1).transpose();
+  z.tail(n-k) = Z2.row(0).transpose();
+  VectorType lambda;
+  RealMatrixType U;
+  tridiagonal_rank_one_eigenproblem(d, z, beta, lambda, U);
+
+  diag.segment(first, n) = lambda;
+  Z.resize(n, n);
+  Z.topRows(k).noalias() = Z1 * U.topRows(k);
+  Z.bottomRows(n-k).noalias() = Z2 * U.bottomRows(n-k);
+  return Success;
+}
 }
 
 template<typename MatrixType>
@@ -386,7 +498,7 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
 {
   using std::abs;
   eigen_assert(matrix.cols() == matrix.rows());
-  eigen_assert((options&~(EigVecMask|GenEigMask))==0
+  eigen_assert((options&~(EigVecMask|GenEigMask|DivideAndConquer))==0
           && (options&EigVecMask)!=EigVecMask
           && "invalid option parameter");
   bool computeEigenvectors = (options&ComputeEigenvectors)==ComputeEigenvectors;
@@ -414,41 +526,34 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
   if(scale==RealScalar(0)) scale = RealScalar(1);
   mat.template triangularView<Lower>() /= scale;
   m_subdiag.resize(n-1);
-  internal::tridiagonalization_inplace(mat, diag, m_subdiag, computeEigenvectors);
-  
-  Index end = n-1;
-  Index start = 0;
-  Index iter = 0; // total number of iterations
 
-  while (end>0)
+  if(computeEigenvectors && (options&DivideAndConquer) && n > internal::tridiagonal_divide_and_conquer_switch_size)
   {
-    for (Index i = start; i<end; ++i)
-      if (internal::isMuchSmallerThan(abs(m_subdiag[i]),(abs(diag[i])+abs(diag[i+1]))))
-        m_subdiag[i] = 0;
-
-    // find the largest unreduced block
-    while (end>0 && m_subdiag[end-1]==0)
-    {
-      end--;
-    }
-    if (end<=0)
-      break;
-
-    // if we spent too many iterations, we give up
-    iter++;
-    if(iter > m_maxIterations * n) break;
-
-    start = end - 1;
-    while (start>0 && m_subdiag[start-1]!=0)
-      start--;
-
-    internal::tridiagonal_qr_step<MatrixType::Flags&RowMajorBit ? RowMajor : ColMajor>(diag.data(), m_subdiag.data(), start, end, computeEigenvectors ? m_eivec.data() : (Scalar*)0, n);
+    // dynamic-size copies, so that the small fixed sizes, which never take this path, do not instantiate it
+    typedef Matrix<Scalar,Dynamic,Dynamic> PackedType;
+    typedef Matrix<RealScalar,Dynamic,Dynamic> RealMatrixType;
+    typedef Matrix<RealScalar,Dynamic,1> RealDiagonalType;
+    PackedType packed = mat;
+    Matrix<Scalar,Dynamic,1> hCoeffs(n-1);
+    internal::tridiagonalization_inplace(packed, hCoeffs);
+    RealDiagonalType d = packed.diagonal().real();
+    RealDiagonalType e = packed.template diagonal<-1>().real();
+
+    RealMatrixType eivecT;
+    m_info = internal::tridiagonal_divide_and_conquer(d, e, 0, n, eivecT, m_maxIterations);
+
+    // the eigenvectors are those of the tridiagonal matrix, transformed by the Householder reflectors
+    PackedType eivec = eivecT.template cast<Scalar>();
+    internal::apply_block_householder_sequence_on_the_left(eivec, packed, hCoeffs.conjugate(), n-1, 1);
+    mat = eivec;
+    diag = d;
   }
-
-  if (iter <= m_maxIterations * n)
-    m_info = Success;
   else
-    m_info = NoConvergence;
+  {
+    internal::tridiagonalization_inplace(mat, diag, m_subdiag, computeEigenvectors);
+    m_info = internal::tridiagonal_qr_iterations<MatrixType::Flags&RowMajorBit ? RowMajor : ColMajor>
+               (diag, m_subdiag, m_maxIterations * n, computeEigenvectors ? m_eivec.data() : (Scalar*)0);
+  }
 
   // Sort eigenvalues and corresponding vectors.
   // TODO make the sort optional ?
@@ -544,7 +649,7 @@ template<typename SolverType> struct direct_selfadjoint_eigenvalues<SolverType,3
   {
     using std::sqrt;
     eigen_assert(mat.cols() == 3 && mat.cols() == mat.rows());
-    eigen_assert((options&~(EigVecMask|GenEigMask))==0
+    eigen_assert((options&~(EigVecMask|GenEigMask|DivideAndConquer))==0
             && (options&EigVecMask)!=EigVecMask
             && "invalid option parameter");
     bool computeEigenvectors = (options&ComputeEigenvectors)==ComputeEigenvectors;
@@ -679,7 +784,7 @@ template<typename SolverType> struct direct_selfadjoint_eigenvalues<SolverType,2
   {
     using std::sqrt;
     eigen_assert(mat.cols() == 2 && mat.cols() == mat.rows());
-    eigen_assert((options&~(EigVecMask|GenEigMask))==0
+    eigen_assert((options&~(EigVecMask|GenEigMask|DivideAndConquer))==0
             && (options&EigVecMask)!=EigVecMask
             && "invalid option parameter");
     bool computeEigenvectors = (options&ComputeEigenvectors)==ComputeEigenvectors;
@@ -795,6 +900,167 @@ static void tridiagonal_qr_step(RealScalar* diag, RealScalar* subdiag, Index sta
   }
 }
 
+/** \internal A plane rotation of the deflation of tridiagonal_rank_one_eigenproblem(), applied to the rows \a i and \a j */
+template<typename Index, typename RealScalar>
+struct tridiagonal_deflation_rotation
+{
+  Index i, j;
+  RealScalar c, s;
+};
+
+/** \internal
+  * Computes the eigendecomposition \f$ D + \rho z z^T = U \Lambda U^T \f$, D being the diagonal matrix \a d.
+  *
+  * The components of z which are negligible, and the components of z corresponding to close coefficients of \a d,
+  * are first deflated by plane rotations. The remaining eigenvalues are the roots of the secular equation
+  * \f$ 1 + \rho \sum_i z_i^2 / (d_i - \lambda) = 0 \f$, which are computed by bisection relatively to the closest
+  * pole. Following Gu and Eisenstat, the eigenvectors are computed from the vector \f$ \hat z \f$ for which the
+  * computed eigenvalues are exact, which makes them numerically orthogonal.
+  */
+template<typename RealVectorType, typename RealMatrixType>
+void tridiagonal_rank_one_eigenproblem(const RealVectorType& d0, RealVectorType z, typename RealVectorType::Scalar rho,
+                                       RealVectorType& lambda, RealMatrixType& U)
+{
+  using std::abs;
+  using std::sqrt;
+  typedef typename RealVectorType::Index Index;
+  typedef typename RealVectorType::Scalar RealScalar;
+  Index n = d0.size();
+
+  RealVectorType d = d0;
+  RealScalar zNorm = z.norm();
+  z /= zNorm;
+  rho *= zNorm * zNorm;
+  // the eigenvalues of D + rho z z^T are the opposite of those of -D - rho z z^T
+  bool flip = rho < RealScalar(0);
+  if(flip)
+  {
+    d = -d;
+    rho = -rho;
+  }
+  lambda = d;
+  U.setIdentity(n, n);
+
+  std::vector<std::pair<RealScalar,Index> > sorted(n);
+  for(Index i = 0; i < n; ++i)
+    sorted[i] = std::make_pair(d.coeff(i), i);
+  std::sort(sorted.begin(), sorted.end());
+
+  // deflation
+  const RealScalar tol = RealScalar(8) * NumTraits<RealScalar>::epsilon() * (std::max)(d.cwiseAbs().maxCoeff(), rho);
+  std::vector<Index> kept; // the indices of the remaining problem, by increasing d
+  std::vector<tridiagonal_deflation_rotation<Index,RealScalar> > rotations;
+  for(Index p = 0; p < n; ++p)
+  {
+    Index i = sorted[p].second;
+    if(rho * abs(z.coeff(i)) <= tol)
+    {
+      z.coeffRef(i) = RealScalar(0);
+      continue;
+    }
+    if(!kept.empty() && d.coeff(i) - d.coeff(kept.back()) <= tol)
+    {
+      // rotate the basis vectors of the close eigenvalues such that one of them is orthogonal to z
+      Index j = kept.back();
+      RealScalar r = numext::hypot(z.coeff(i), z.coeff(j));
+      tridiagonal_deflation_rotation<Index,RealScalar> rot;
+      rot.i = j;
+      rot.j = i;
+      rot.c = z.coeff(i) / r;
+      rot.s = z.coeff(j) / r;
+      rotations.push_back(rot);
+      z.coeffRef(j) = RealScalar(0);
+      z.coeffRef(i) = r;
+      kept.back() = i;
+      continue;
+    }
+    kept.push_back(i);
+  }
+
+  Index m = Index(kept.size());
+  if(m > 0)
+  {
+    RealVectorType dk(m), zk(m);
+    for(Index j = 0; j < m; ++j)
+    {
+      dk.coeffRef(j) = d.coeff(kept[j]);
+      zk.coeffRef(j) = z.coeff(kept[j]);
+    }
+
+    // the j-th root is dk(origin(j)) + tau(j), origin(j) being the closest pole
+    std::vector<Index> origin(m);
+    RealVectorType tau(m);
+    for(Index j = 0; j < m; ++j)
+    {
+      Index o = j;
+      RealScalar lo = 0, hi;
+      if(j < m-1)
+      {
+        RealScalar mid = (dk.coeff(j+1) - dk.coeff(j)) / RealScalar(2);
+        RealScalar f = RealScalar(1) + rho * (zk.array().square() / ((dk.array() - dk.coeff(j)) - mid)).sum();
+        if(f >= RealScalar(0))
+          hi = mid;
+        else
+        {
+          o = j+1;
+          lo = -mid;
+          hi = 0;
+        }
+      }
+      else
+        hi = rho * zk.squaredNorm();
+
+      // the secular function is increasing between two poles
+      RealVectorType shifted = dk.array() - dk.coeff(o);
+      for(int iter = 0; iter < 400; ++iter)
+      {
+        RealScalar t = (lo + hi) / RealScalar(2);
+        if(t == lo || t == hi)
+          break;
+        RealScalar f = RealScalar(1) + rho * (zk.array().square() / (shifted.array() - t)).sum();
+        if(f > RealScalar(0)) hi = t;
+        else                  lo = t;
+      }
+      origin[j] = o;
+      tau.coeffRef(j) = (lo + hi) / RealScalar(2);
+    }
+
+    // Loewner's formula for the vector zhat
+    RealVectorType zhat(m);
+    for(Index i = 0; i < m; ++i)
+    {
+      RealScalar prod = (dk.coeff(origin[m-1]) - dk.coeff(i) + tau.coeff(m-1)) / rho;
+      for(Index j = 0; j < i; ++j)
+        prod *= (dk.coeff(origin[j]) - dk.coeff(i) + tau.coeff(j)) / (dk.coeff(j) - dk.coeff(i));
+      for(Index j = i; j < m-1; ++j)
+        prod *= (dk.coeff(origin[j]) - dk.coeff(i) + tau.coeff(j)) / (dk.coeff(j+1) - dk.coeff(i));
+      RealScalar a = sqrt(abs(prod));
+      zhat.coeffRef(i) = zk.coeff(i) < RealScalar(0) ? -a : a;
+    }
+
+    RealVectorType u(m);
+    for(Index j = 0; j < m; ++j)
+    {
+      u = zhat.array() / ((dk.array() - dk.coeff(origin[j])) - tau.coeff(j));
+      u.normalize();
+      U.col(kept[j]).setZero();
+      for(Index i = 0; i < m; ++i)
+        U.coeffRef(kept[i], kept[j]) = u.coeff(i);
+      lambda.coeffRef(kept[j]) = dk.coeff(origin[j]) + tau.coeff(j);
+    }
+  }
+
+  // undo the rotations of the deflation
+  for(Index r = Index(rotations.size())-1; r >= 0; --r)
+  {
+    const tridiagonal_deflation_rotation<Index,RealScalar>& rot = rotations[r];
+    U.applyOnTheLeft(rot.i, rot.j, JacobiRotation<RealScalar>(rot.c, rot.s));
+  }
+
+  if(flip)
+    lambda = -lambda;
+}
+
 } // end namespace internal
 
 } // end namespace Eigen
@@ -320,40 +320,19 @@ Tridiagonalization<MatrixType>::subDiagonal() const
 namespace internal {
 
 /** \internal
-  * Performs a tridiagonal decomposition of the selfadjoint matrix \a matA in-place.
-  *
-  * \param[in,out] matA On input the selfadjoint matrix. Only the \b lower triangular part is referenced.
-  *                     On output, the strict upper part is left unchanged, and the lower triangular part
-  *                     represents the T and Q matrices in packed format has detailed below.
-  * \param[out]    hCoeffs returned Householder coefficients (see below)
-  *
-  * On output, the tridiagonal selfadjoint matrix T is stored in the diagonal
-  * and lower sub-diagonal of the matrix \a matA.
-  * The unitary matrix Q is represented in a compact way as a product of
-  * Householder reflectors \f$ H_i \f$ such that:
-  *       \f$ Q = H_{N-1} \ldots H_1 H_0 \f$.
-  * The Householder reflectors are defined as
-  *       \f$ H_i = (I - h_i v_i v_i^T) \f$
-  * where \f$ h_i = hCoeffs[i]\f$ is the \f$ i \f$th Householder coefficient and
-  * \f$ v_i \f$ is the Householder vector defined by
-  *       \f$ v_i = [ 0, \ldots, 0, 1, matA(i+2,i), \ldots, matA(N-1,i) ]^T \f$.
-  *
-  * Implemented from Golub's "Matrix Computations", algorithm 8.3.1.
-  *
-  * \sa Tridiagonalization::packedMatrix()
+  * Unblocked version of tridiagonalization_inplace(MatrixType&, CoeffVectorType&), which reduces the columns starting
+  * at \a start. The previous columns must have been reduced, and their transformations applied to the rest of the matrix.
   */
 template<typename MatrixType, typename CoeffVectorType>
-void tridiagonalization_inplace(MatrixType& matA, CoeffVectorType& hCoeffs)
+void tridiagonalization_inplace_unblocked(MatrixType& matA, CoeffVectorType& hCoeffs, typename MatrixType::Index start = 0)
 {
   using numext::conj;
   typedef typename MatrixType::Index Index;
   typedef typename MatrixType::Scalar Scalar;
   typedef typename MatrixType::RealScalar RealScalar;
   Index n = matA.rows();
-  eigen_assert(n==matA.cols());
-  eigen_assert(n==hCoeffs.size()+1 || n==1);
   
-  for (Index i = 0; i<n-1; ++i)
+  for (Index i = start; i<n-1; ++i)
   {
     Index remainingSize = n-i-1;
     RealScalar beta;
@@ -377,6 +356,126 @@ void tridiagonalization_inplace(MatrixType& matA, CoeffVectorType& hCoeffs)
   }
 }
 
+/** \internal
+  * Reduces the \a bs columns of \a matA starting at \a k, and computes the matrix \a W such that the trailing
+  * part of the matrix is updated by \f$ A_{22} -= V W^* + W V^* \f$, V being the Householder vectors of the panel
+  * (as in LAPACK's xLATRD). The rows of \a W are those of the matrix starting at \a k. On return, the first
+  * coefficient of the Householder vectors is set to one, and the sub-diagonal of the panel is stored in \a betas.
+  */
+template<typename MatrixType, typename CoeffVectorType, typename WorkMatrixType, typename BetaVectorType>
+void tridiagonalization_blocked_panel(MatrixType& matA, CoeffVectorType& hCoeffs, typename MatrixType::Index k,
+                                      typename MatrixType::Index bs, WorkMatrixType& W, BetaVectorType& betas)
+{
+  using numext::conj;
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  Index n = matA.rows();
+
+  W.setZero(n-k, bs);
+  Matrix<Scalar,Dynamic,1> tmp(bs);
+  for(Index i = 0; i < bs; ++i)
+  {
+    Index j = k+i;
+    Index remainingSize = n-j-1;
+
+    // update the j-th column by the previous transformations of the panel
+    matA.col(j).tail(n-j).noalias() -= matA.block(j,k,n-j,i) * W.row(j-k).head(i).adjoint();
+    matA.col(j).tail(n-j).noalias() -= W.block(j-k,0,n-j,i) * matA.row(j).segment(k,i).adjoint();
+    matA.coeffRef(j,j) = numext::real(matA.coeff(j,j));
+
+    RealScalar beta;
+    Scalar h;
+    matA.col(j).tail(remainingSize).makeHouseholderInPlace(h, beta);
+    matA.coeffRef(j+1,j) = Scalar(1);
+    hCoeffs.coeffRef(j) = h;
+    betas.coeffRef(i) = beta;
+
+    // w_i = conj(h) (A - V W^* - W V^*) v_i, corrected such that the rank-2 update is A -= v_i w_i^* + w_i v_i^*
+    typename MatrixType::ColXpr::SegmentReturnType v = matA.col(j).tail(remainingSize);
+    typename WorkMatrixType::ColXpr::SegmentReturnType w = W.col(i).tail(remainingSize);
+    w.noalias() = matA.bottomRightCorner(remainingSize,remainingSize).template selfadjointView<Lower>() * v;
+    tmp.head(i).noalias() = W.block(j+1-k,0,remainingSize,i).adjoint() * v;
+    w.noalias() -= matA.block(j+1,k,remainingSize,i) * tmp.head(i);
+    tmp.head(i).noalias() = matA.block(j+1,k,remainingSize,i).adjoint() * v;
+    w.noalias() -= W.block(j+1-k,0,remainingSize,i) * tmp.head(i);
+    w *= conj(h);
+    w += (conj(h)*Scalar(-0.5)*(w.dot(v))) * v;
+  }
+}
+
+/** \internal
+  * Same as tridiagonalization_inplace_unblocked(), but reduces the matrix by panels of \a maxBlockSize columns whose
+  * transformations are applied to the trailing part of the matrix as a rank-2k update. The last columns are
+  * reduced by the unblocked algorithm.
+  */
+template<typename MatrixType, typename CoeffVectorType>
+void tridiagonalization_inplace_blocked(MatrixType& matA, CoeffVectorType& hCoeffs, typename MatrixType::Index maxBlockSize = 32)
+{
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  Index n = matA.rows();
+
+  Matrix<Scalar,Dynamic,Dynamic> W;
+  Matrix<RealScalar,Dynamic,1> betas(maxBlockSize);
+  Index k = 0;
+  for(; n - k > 2*maxBlockSize; k += maxBlockSize)
+  {
+    Index bs = maxBlockSize;
+    tridiagonalization_blocked_panel(matA, hCoeffs, k, bs, W, betas);
+
+    // update the trailing part
+    Index rs = n-k-bs;
+    Block<MatrixType,Dynamic,Dynamic> A22(matA, k+bs, k+bs, rs, rs);
+    A22.template triangularView<Lower>() -= matA.block(k+bs,k,rs,bs) * W.bottomRows(rs).adjoint();
+    A22.template triangularView<Lower>() -= W.bottomRows(rs) * matA.block(k+bs,k,rs,bs).adjoint();
+
+    for(Index i = 0; i < bs; ++i)
+      matA.coeffRef(k+i+1,k+i) = betas.coeff(i);
+  }
+
+  tridiagonalization_inplace_unblocked(matA, hCoeffs, k);
+}
+
+/** \internal
+  * Performs a tridiagonal decomposition of the selfadjoint matrix \a matA in-place.
+  *
+  * \param[in,out] matA On input the selfadjoint matrix. Only the \b lower triangular part is referenced.
+  *                     On output, the strict upper part is left unchanged, and the lower triangular part
+  *                     represents the T and Q matrices in packed format has detailed below.
+  * \param[out]    hCoeffs returned Householder coefficients (see below)
+  *
+  * On output, the tridiagonal selfadjoint matrix T is stored in the diagonal
+  * and lower sub-diagonal of the matrix \a matA.
+  * The unitary matrix Q is represented in a compact way as a product of
+  * Householder reflectors \f$ H_i \f$ such that:
+  *       \f$ Q = H_{N-1} \ldots H_1 H_0 \f$.
+  * The Householder reflectors are defined as
+  *       \f$ H_i = (I - h_i v_i v_i^T) \f$
+  * where \f$ h_i = hCoeffs[i]\f$ is the \f$ i \f$th Householder coefficient and
+  * \f$ v_i \f$ is the Householder vector defined by
+  *       \f$ v_i = [ 0, \ldots, 0, 1, matA(i+2,i), \ldots, matA(N-1,i) ]^T \f$.
+  *
+  * Implemented from Golub's "Matrix Computations", algorithm 8.3.1. Large matrices are reduced by panels of
+  * 32 columns, whose transformations are applied to the rest of the matrix with level 3 operations.
+  *
+  * \sa Tridiagonalization::packedMatrix()
+  */
+template<typename MatrixType, typename CoeffVectorType>
+void tridiagonalization_inplace(MatrixType& matA, CoeffVectorType& hCoeffs)
+{
+  typedef typename MatrixType::Index Index;
+  Index n = matA.rows();
+  eigen_assert(n==matA.cols());
+  eigen_assert(n==hCoeffs.size()+1 || n==1);
+
+  if(MatrixType::MaxColsAtCompileTime==Dynamic || MatrixType::MaxColsAtCompileTime>64)
+    tridiagonalization_inplace_blocked(matA, hCoeffs);
+  else
+    tridiagonalization_inplace_unblocked(matA, hCoeffs);
+}
+
 // forward declaration, implementation at the end of this file
 template<typename MatrixType,
          int Size=MatrixType::ColsAtCompileTime,
@@ -447,9 +546,22 @@ struct tridiagonalization_inplace_selector
     diag = mat.diagonal().real();
     subdiag = mat.template diagonal<-1>().real();
     if(extractQ)
-      mat = HouseholderSequenceType(mat, hCoeffs.conjugate())
-            .setLength(mat.rows() - 1)
-            .setShift(1);
+    {
+      if(MatrixType::MaxColsAtCompileTime==Dynamic || MatrixType::MaxColsAtCompileTime>64)
+      {
+        // Q = H_0 ... H_{n-2} is built by blocks of reflectors
+        MatrixType vectors = mat;
+        mat.setIdentity();
+        apply_block_householder_sequence_on_the_left(mat, vectors, hCoeffs.conjugate(), mat.rows()-1, 1, true);
+      }
+      else
+      {
+        // the blocked application uses dynamic-size temporaries
+        mat = HouseholderSequenceType(mat, hCoeffs.conjugate())
+              .setLength(mat.rows() - 1)
+              .setShift(1);
+      }
+    }
   }
 };
 
@@ -61,6 +61,38 @@ void apply_block_householder_on_the_left(MatrixType& mat, const VectorsType& vec
   mat.noalias() -= V * tmp;
 }
 
+/** \internal Applies the product H_0 H_1 ... H_{length-1} of Householder reflectors H_i = I - coeffs(i) v_i v_i^* to \a dst
+  * from the left, by blocks of \a maxBlockSize reflectors. The essential part of v_i is stored in the column i of \a vectors
+  * below the row i+shift. If \a dstIsIdentity is true, \a dst must be the identity on input, and the columns which are not
+  * modified by a block of reflectors are skipped. */
+template<typename MatrixType, typename VectorsType, typename CoeffsType>
+void apply_block_householder_sequence_on_the_left(MatrixType& dst, const VectorsType& vectors, const CoeffsType& coeffs,
+                                                  typename MatrixType::Index length, typename MatrixType::Index shift,
+                                                  bool dstIsIdentity = false, typename MatrixType::Index maxBlockSize = 48)
+{
+  typedef typename MatrixType::Index Index;
+  typedef Matrix<typename MatrixType::Scalar,Dynamic,Dynamic> BlockVectorsType;
+
+  for(Index end = length; end > 0; end -= maxBlockSize)
+  {
+    Index start = (std::max)(Index(0), end - maxBlockSize);
+    Index bs = end - start;
+    Index rs = dst.rows() - start - shift;
+    Index firstCol = dstIsIdentity ? start + shift : 0;
+    BlockVectorsType V = vectors.block(start+shift, start, rs, bs);
+    V.template triangularView<StrictlyUpper>().setZero();
+    V.diagonal().setOnes();
+    BlockVectorsType T(bs, bs);
+    make_block_householder_triangular_factor(T, V, coeffs.segment(start, bs));
+
+    // dst = (I - V T V^*) dst
+    Block<MatrixType,Dynamic,Dynamic> dstBlock(dst, start+shift, firstCol, rs, dst.cols()-firstCol);
+    BlockVectorsType tmp = V.adjoint() * dstBlock;
+    tmp = T.template triangularView<Upper>() * tmp;
+    dstBlock.noalias() -= V * tmp;
+  }
+}
+
 } // end namespace internal
 
 } // end namespace Eigen
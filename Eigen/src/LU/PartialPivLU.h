@@ -366,6 +366,115 @@ struct partial_lu_impl
     }
     return first_zero_pivot;
   }
+
+  /** \internal The tasks of a step of blocked_lu_lookahead(). Given the factorized panel \a k of width \a bs, the task 0
+    * updates the next \a nbs columns and factorizes them as the next panel, while the other tasks update \a slices
+    * vertical slices of the remaining columns. All the updated columns first get the row transpositions of panel \a k.
+    */
+  struct LookAheadJob
+  {
+    LookAheadJob(MatrixType& lu, Index luStride, PivIndex* row_transpositions, Index k, Index bs, Index nbs, Index slices,
+                 Index* panel_first_zero_pivot, PivIndex* panel_nb_transpositions)
+      : m_lu(lu), m_luStride(luStride), m_row_transpositions(row_transpositions), m_k(k), m_bs(bs), m_nbs(nbs), m_slices(slices),
+        m_panel_first_zero_pivot(panel_first_zero_pivot), m_panel_nb_transpositions(panel_nb_transpositions)
+    {}
+
+    void operator()(int i) const
+    {
+      const Index next = m_k + m_bs;
+      const Index trows = m_lu.rows() - next;
+      Index start, length;
+      if(i==0)
+      {
+        start = next;
+        length = m_nbs;
+      }
+      else
+      {
+        parallel_chunk(m_lu.cols()-next-m_nbs, m_slices, Index(4), Index(i-1), start, length);
+        start += next + m_nbs;
+      }
+      if(length==0)
+        return;
+
+      BlockType A_2(m_lu,0,start,m_lu.rows(),length);
+      for(Index r=m_k; r<next; ++r)
+        A_2.row(r).swap(A_2.row(m_row_transpositions[r]));
+
+      BlockType A11(m_lu,m_k,m_k,m_bs,m_bs);
+      BlockType A12(m_lu,m_k,start,m_bs,length);
+      A11.template triangularView<UnitLower>().solveInPlace(A12);
+      if(trows>0)
+      {
+        BlockType A21(m_lu,next,m_k,trows,m_bs);
+        BlockType A22(m_lu,next,start,trows,length);
+        A22.noalias() -= A21 * A12;
+      }
+
+      if(i==0)
+        *m_panel_first_zero_pivot = blocked_lu(trows, m_nbs, &m_lu.coeffRef(next,next), m_luStride,
+                                               m_row_transpositions+next, *m_panel_nb_transpositions, 16);
+    }
+
+    MatrixType& m_lu;
+    Index m_luStride;
+    PivIndex* m_row_transpositions;
+    Index m_k, m_bs, m_nbs, m_slices;
+    Index* m_panel_first_zero_pivot;
+    PivIndex* m_panel_nb_transpositions;
+  };
+
+  /** \internal performs the same decomposition as blocked_lu() using up to \a threads threads, with a look-ahead
+    * of one panel: the panel k+1 is factorized while the trailing columns are still being updated by the panel k,
+    * so that the factorization of the panels is not on the critical path.
+    *
+    * The row transpositions of each panel are applied to the columns on its left at the very end, since these
+    * columns are not read anymore.
+    */
+  static Index blocked_lu_lookahead(Index rows, Index cols, Scalar* lu_data, Index luStride, PivIndex* row_transpositions, PivIndex& nb_transpositions, Index threads)
+  {
+    MapLU lu1(lu_data,StorageOrder==RowMajor?rows:luStride,StorageOrder==RowMajor?luStride:cols);
+    MatrixType lu(lu1,0,0,rows,cols);
+
+    const Index size = (std::min)(rows,cols);
+
+    // smaller panels than blocked_lu() to shorten the critical path
+    Index blockSize = size/8;
+    blockSize = (blockSize/16)*16;
+    blockSize = (std::min)((std::max)(blockSize,Index(8)), Index(128));
+
+    nb_transpositions = 0;
+    Index first_zero_pivot = blocked_lu(rows, (std::min)(size,blockSize), lu_data, luStride, row_transpositions, nb_transpositions, 16);
+
+    for(Index k = 0; k < size; k+=blockSize)
+    {
+      Index bs = (std::min)(size-k,blockSize);
+      Index next = k + bs;
+      Index nbs = (std::min)(size-next,blockSize);
+      Index rest = cols - next - nbs;
+      Index slices = rest>0 ? (std::max)(Index(1), (std::min)(threads-1, rest/32)) : 0;
+      if(next==cols)
+        break;
+
+      Index ret = -1;
+      PivIndex nb_transpositions_in_panel = 0;
+      parallel_for(LookAheadJob(lu, luStride, row_transpositions, k, bs, nbs, slices, &ret, &nb_transpositions_in_panel), int(1+slices));
+
+      if(ret>=0 && first_zero_pivot==-1)
+        first_zero_pivot = next+ret;
+      nb_transpositions += nb_transpositions_in_panel;
+      for(Index i=next; i<next+nbs; ++i)
+        row_transpositions[i] += PivIndex(next);
+    }
+
+    for(Index i=blockSize; i<size; ++i)
+    {
+      BlockType A_0(lu,0,0,rows,(i/blockSize)*blockSize);
+      A_0.row(i).swap(A_0.row(row_transpositions[i]));
+    }
+
+    return first_zero_pivot;
+  }
 };
 
 /** \internal performs the LU decomposition with partial pivoting in-place.
@@ -376,9 +485,16 @@ void partial_lu_inplace(MatrixType& lu, TranspositionType& row_transpositions, t
   eigen_assert(lu.cols() == row_transpositions.size());
   eigen_assert((&row_transpositions.coeffRef(1)-&row_transpositions.coeffRef(0)) == 1);
 
-  partial_lu_impl
-    <typename MatrixType::Scalar, MatrixType::Flags&RowMajorBit?RowMajor:ColMajor, typename TranspositionType::Index>
-    ::blocked_lu(lu.rows(), lu.cols(), &lu.coeffRef(0,0), lu.outerStride(), &row_transpositions.coeffRef(0), nb_transpositions);
+  typedef partial_lu_impl
+    <typename MatrixType::Scalar, MatrixType::Flags&RowMajorBit?RowMajor:ColMajor, typename TranspositionType::Index> Impl;
+
+  typedef typename MatrixType::Index Index;
+  Index size = (std::min)(lu.rows(),lu.cols());
+  Index threads = parallel_level3_threads(double(size)*double(size)*double(size)/3, size);
+  if(threads>1)
+    Impl::blocked_lu_lookahead(lu.rows(), lu.cols(), &lu.coeffRef(0,0), lu.outerStride(), &row_transpositions.coeffRef(0), nb_transpositions, threads);
+  else
+    Impl::blocked_lu(lu.rows(), lu.cols(), &lu.coeffRef(0,0), lu.outerStride(), &row_transpositions.coeffRef(0), nb_transpositions);
 }
 
 } // end namespace internal
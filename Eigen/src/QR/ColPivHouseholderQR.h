@@ -32,6 +32,10 @@ namespace Eigen {
   * This decomposition performs column pivoting in order to be rank-revealing and improve
   * numerical stability. It is slower than HouseholderQR, and faster than FullPivHouseholderQR.
   *
+  * For large dynamic-size matrices, the updates of the trailing columns are delayed and applied by blocks
+  * of columns using matrix-matrix products, while the column norms used for the pivoting are downdated
+  * and recomputed when necessary as in LAPACK's xGEQP3.
+  *
   * \sa MatrixBase::colPivHouseholderQr()
   */
 template<typename _MatrixType> class ColPivHouseholderQR
@@ -60,6 +64,7 @@ template<typename _MatrixType> class ColPivHouseholderQR
   private:
     
     typedef typename PermutationType::Index PermIndexType;
+    typedef Matrix<Scalar, Dynamic, Dynamic> BlockUpdateType;
     
   public:
 
@@ -76,6 +81,7 @@ template<typename _MatrixType> class ColPivHouseholderQR
         m_colsTranspositions(),
         m_temp(),
         m_colSqNorms(),
+        m_colSqNormsDirect(),
         m_isInitialized(false) {}
 
     /** \brief Default Constructor with memory preallocation
@@ -91,6 +97,8 @@ template<typename _MatrixType> class ColPivHouseholderQR
         m_colsTranspositions(cols),
         m_temp(cols),
         m_colSqNorms(cols),
+        m_colSqNormsDirect(cols),
+        m_blockF(cols, panelSize(rows, cols)),
         m_isInitialized(false),
         m_usePrescribedThreshold(false) {}
 
@@ -113,6 +121,8 @@ template<typename _MatrixType> class ColPivHouseholderQR
         m_colsTranspositions(matrix.cols()),
         m_temp(matrix.cols()),
         m_colSqNorms(matrix.cols()),
+        m_colSqNormsDirect(matrix.cols()),
+        m_blockF(matrix.cols(), panelSize(matrix.rows(), matrix.cols())),
         m_isInitialized(false),
         m_usePrescribedThreshold(false)
     {
@@ -383,12 +393,26 @@ template<typename _MatrixType> class ColPivHouseholderQR
     }
 
   protected:
+
+    static Index panelSize(Index rows, Index cols)
+    {
+      // the blocked path only pays off once the trailing updates are large enough for a matrix-matrix product
+      if(MaxColsAtCompileTime!=Dynamic || (std::min)(rows,cols) < 64)
+        return 0;
+      return 32;
+    }
+
+    void computeInPlaceUnblocked(RealScalar threshold_helper, Index& number_of_transpositions);
+    void computeInPlaceBlocked(Index panel, RealScalar threshold_helper, Index& number_of_transpositions);
+
     MatrixType m_qr;
     HCoeffsType m_hCoeffs;
     PermutationType m_colsPermutation;
     IntRowVectorType m_colsTranspositions;
     RowVectorType m_temp;
     RealRowVectorType m_colSqNorms;
+    RealRowVectorType m_colSqNormsDirect;
+    BlockUpdateType m_blockF;
     bool m_isInitialized, m_usePrescribedThreshold;
     RealScalar m_prescribedThreshold, m_maxpivot;
     Index m_nonzero_pivots;
@@ -421,7 +445,6 @@ typename MatrixType::RealScalar ColPivHouseholderQR<MatrixType>::logAbsDetermina
 template<typename MatrixType>
 ColPivHouseholderQR<MatrixType>& ColPivHouseholderQR<MatrixType>::compute(const MatrixType& matrix)
 {
-  using std::abs;
   Index rows = matrix.rows();
   Index cols = matrix.cols();
   Index size = matrix.diagonalSize();
@@ -446,6 +469,30 @@ ColPivHouseholderQR<MatrixType>& ColPivHouseholderQR<MatrixType>::compute(const
   m_nonzero_pivots = size; // the generic case is that in which all pivots are nonzero (invertible case)
   m_maxpivot = RealScalar(0);
 
+  Index panel = panelSize(rows, cols);
+  if(panel > 0)
+    computeInPlaceBlocked(panel, threshold_helper, number_of_transpositions);
+  else
+    computeInPlaceUnblocked(threshold_helper, number_of_transpositions);
+
+  m_colsPermutation.setIdentity(PermIndexType(cols));
+  for(PermIndexType k = 0; k < m_nonzero_pivots; ++k)
+    m_colsPermutation.applyTranspositionOnTheRight(k, PermIndexType(m_colsTranspositions.coeff(k)));
+
+  m_det_pq = (number_of_transpositions%2) ? -1 : 1;
+  m_isInitialized = true;
+
+  return *this;
+}
+
+template<typename MatrixType>
+void ColPivHouseholderQR<MatrixType>::computeInPlaceUnblocked(RealScalar threshold_helper, Index& number_of_transpositions)
+{
+  using std::abs;
+  Index rows = m_qr.rows();
+  Index cols = m_qr.cols();
+  Index size = m_qr.diagonalSize();
+
   for(Index k = 0; k < size; ++k)
   {
     // first, we look up in our table m_colSqNorms which column has the biggest squared norm
@@ -502,15 +549,134 @@ ColPivHouseholderQR<MatrixType>& ColPivHouseholderQR<MatrixType>::compute(const
     // update our table of squared norms of the columns
     m_colSqNorms.tail(cols-k-1) -= m_qr.row(k).tail(cols-k-1).cwiseAbs2();
   }
+}
 
-  m_colsPermutation.setIdentity(PermIndexType(cols));
-  for(PermIndexType k = 0; k < m_nonzero_pivots; ++k)
-    m_colsPermutation.applyTranspositionOnTheRight(k, PermIndexType(m_colsTranspositions.coeff(k)));
+/** \internal Blocked variant of the column pivoting QR (QP3) in the spirit of LAPACK's xLAQPS.
+  *
+  * Within a panel of \a panel columns, only the pivot column and the pivot row are brought up to date.
+  * The updates of the trailing columns are accumulated into m_blockF such that the trailing matrix is
+  * A - V F^*, and are applied with a single matrix-matrix product at the end of the panel.
+  * The partial column norms are downdated from the pivot rows; once a downdate loses too many digits,
+  * the panel is terminated early and the norms of the offending columns are recomputed.
+  */
+template<typename MatrixType>
+void ColPivHouseholderQR<MatrixType>::computeInPlaceBlocked(Index panel, RealScalar threshold_helper, Index& number_of_transpositions)
+{
+  using std::abs;
+  using std::sqrt;
+  Index rows = m_qr.rows();
+  Index cols = m_qr.cols();
+  Index size = m_qr.diagonalSize();
 
-  m_det_pq = (number_of_transpositions%2) ? -1 : 1;
-  m_isInitialized = true;
+  const RealScalar norm_downdate_threshold = sqrt(NumTraits<RealScalar>::epsilon());
 
-  return *this;
+  m_colSqNormsDirect = m_colSqNorms;
+  m_blockF.resize(cols, panel);
+
+  Index k = 0;
+  while(k < size)
+  {
+    Index bs = (std::min)(size-k,panel);
+    Block<BlockUpdateType,Dynamic,Dynamic> F(m_blockF, 0, 0, cols-k, bs);
+    bool recompute_norms = false;
+    Index j = 0;
+    for(; j < bs && !recompute_norms; ++j)
+    {
+      Index c = k + j;
+      Index rc = rows - c;
+
+      Index biggest_col_index;
+      m_colSqNorms.tail(cols-c).maxCoeff(&biggest_col_index);
+      biggest_col_index += c;
+
+      m_colsTranspositions.coeffRef(c) = biggest_col_index;
+      if(c != biggest_col_index) {
+        m_qr.col(c).swap(m_qr.col(biggest_col_index));
+        F.row(j).head(j).swap(F.row(biggest_col_index-k).head(j));
+        std::swap(m_colSqNorms.coeffRef(c), m_colSqNorms.coeffRef(biggest_col_index));
+        std::swap(m_colSqNormsDirect.coeffRef(c), m_colSqNormsDirect.coeffRef(biggest_col_index));
+        ++number_of_transpositions;
+      }
+
+      // bring the pivot column up to date with the reflectors of the current panel
+      if(j > 0)
+        m_qr.col(c).tail(rc).noalias() -= m_qr.block(c, k, rc, j) * F.row(j).head(j).adjoint();
+
+      // same early termination as the unblocked path, based on the actual norm of the selected column
+      if(m_qr.col(c).tail(rc).squaredNorm() < threshold_helper * RealScalar(rc))
+      {
+        if(j > 0 && c+1 < cols)
+          m_qr.block(c, c+1, rc, cols-c-1).noalias() -= m_qr.block(c, k, rc, j) * F.block(j+1, 0, cols-c-1, j).adjoint();
+        if(c != biggest_col_index) {
+          m_qr.col(c).swap(m_qr.col(biggest_col_index));
+          --number_of_transpositions;
+        }
+        m_nonzero_pivots = c;
+        m_hCoeffs.tail(size-c).setZero();
+        m_qr.bottomRightCorner(rc,cols-c)
+            .template triangularView<StrictlyLower>()
+            .setZero();
+        return;
+      }
+
+      RealScalar beta;
+      m_qr.col(c).tail(rc).makeHouseholderInPlace(m_hCoeffs.coeffRef(c), beta);
+      if(abs(beta) > m_maxpivot) m_maxpivot = abs(beta);
+      Scalar tau = m_hCoeffs.coeff(c);
+
+      // temporarily store the full householder vector in place
+      m_qr.coeffRef(c,c) = Scalar(1);
+
+      // F(:,j) = conj(tau) * (A^* v - F(:,0:j) V^* v), restricted to the columns which are not factorized yet
+      F.col(j).head(j+1).setZero();
+      if(c+1 < cols)
+        F.col(j).tail(cols-c-1).noalias() = numext::conj(tau) * (m_qr.block(c, c+1, rc, cols-c-1).adjoint() * m_qr.col(c).tail(rc));
+      if(j > 0)
+      {
+        m_temp.head(j).noalias() = -tau * (m_qr.col(c).tail(rc).adjoint() * m_qr.block(c, k, rc, j));
+        F.col(j).noalias() += F.leftCols(j) * m_temp.head(j).adjoint();
+      }
+
+      // the pivot row is needed right away for the norm downdates
+      if(c+1 < cols)
+        m_qr.row(c).tail(cols-c-1).noalias() -= m_qr.row(c).segment(k, j+1) * F.block(j+1, 0, cols-c-1, j+1).adjoint();
+
+      m_qr.coeffRef(c,c) = beta;
+
+      // downdate the partial norms, and flag the columns whose norm cannot be trusted anymore
+      if(c+1 < rows)
+      {
+        for(Index i = c+1; i < cols; ++i)
+        {
+          if(m_colSqNorms.coeff(i) == RealScalar(0))
+            continue;
+          RealScalar ratio = (std::max)(RealScalar(0), RealScalar(1) - numext::abs2(m_qr.coeff(c,i)) / m_colSqNorms.coeff(i));
+          if(ratio * (m_colSqNorms.coeff(i) / m_colSqNormsDirect.coeff(i)) <= norm_downdate_threshold)
+          {
+            m_colSqNormsDirect.coeffRef(i) = RealScalar(-1);
+            recompute_norms = true;
+          }
+          else
+            m_colSqNorms.coeffRef(i) *= ratio;
+        }
+      }
+    }
+
+    // apply the accumulated block reflector to the trailing matrix
+    Index end = k + j;
+    if(end < rows && end < cols)
+      m_qr.bottomRightCorner(rows-end, cols-end).noalias() -= m_qr.block(end, k, rows-end, j) * F.block(j, 0, cols-end, j).adjoint();
+
+    if(recompute_norms)
+    {
+      for(Index i = end; i < cols; ++i)
+      {
+        if(m_colSqNormsDirect.coeff(i) < RealScalar(0))
+          m_colSqNormsDirect.coeffRef(i) = m_colSqNorms.coeffRef(i) = m_qr.col(i).tail(rows-end).squaredNorm();
+      }
+    }
+    k = end;
+  }
 }
 
 namespace internal {
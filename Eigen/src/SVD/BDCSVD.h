@@ -0,0 +1,719 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_BDCSVD_H
+#define EIGEN_BDCSVD_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal Orders indices by increasing values of a vector */
+template<typename VectorType>
+struct bdcsvd_index_less
+{
+  bdcsvd_index_less(const VectorType& values) : m_values(values) {}
+  template<typename Index> bool operator()(Index i, Index j) const { return m_values.coeff(i) < m_values.coeff(j); }
+  const VectorType& m_values;
+};
+
+/** \internal A plane rotation of the deflation of BDCSVD, applied to the rows \a i and \a j */
+template<typename Index, typename RealScalar>
+struct bdcsvd_rotation
+{
+  Index i, j;
+  RealScalar c, s;
+  bool bothSides; // whether the columns are rotated as well
+};
+
+} // end namespace internal
+
+/** \ingroup SVD_Module
+  *
+  *
+  * \class BDCSVD
+  *
+  * \brief Bidiagonal divide and conquer SVD decomposition of a rectangular matrix
+  *
+  * \param MatrixType the type of the matrix of which we are computing the SVD decomposition
+  *
+  * This class computes the same decomposition \f$ A = U S V^* \f$ as JacobiSVD, with the same API, but is much faster
+  * for large matrices. The matrix is first reduced to an upper bidiagonal matrix \f$ B \f$ by Householder transformations,
+  * using a blocked algorithm. The SVD of \f$ B \f$ is then computed by the divide and conquer algorithm of Gu and Eisenstat:
+  * \f$ B \f$ is split in two halves whose SVDs are computed recursively and merged by solving a secular equation.
+  * The blocks smaller than switchSize() columns are decomposed by JacobiSVD, as well as the matrices having less than
+  * switchSize() rows or columns.
+  *
+  * Singular values are always sorted in decreasing order.
+  *
+  * As with JacobiSVD, thin \a U and \a V are only available if the matrix type has a Dynamic number of columns, and
+  * solve() requires both \a U and \a V to be computed.
+  *
+  * The cost of the reduction is \f$ O(n^2 p) \f$, and the one of the divide and conquer step is \f$ O(n^3) \f$ when the singular
+  * vectors are computed, \f$ O(n^2) \f$ otherwise, where \a n is the smaller dimension and \a p the greater one.
+  * This is less accurate than JacobiSVD for the smallest singular values of badly scaled matrices, which are only accurate
+  * relatively to the largest one.
+  *
+  * \sa class JacobiSVD, MatrixBase::bdcSvd()
+  */
+template<typename _MatrixType> class BDCSVD
+{
+  public:
+
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename NumTraits<typename MatrixType::Scalar>::Real RealScalar;
+    typedef typename MatrixType::Index Index;
+    enum {
+      RowsAtCompileTime = MatrixType::RowsAtCompileTime,
+      ColsAtCompileTime = MatrixType::ColsAtCompileTime,
+      DiagSizeAtCompileTime = EIGEN_SIZE_MIN_PREFER_DYNAMIC(RowsAtCompileTime,ColsAtCompileTime),
+      MaxRowsAtCompileTime = MatrixType::MaxRowsAtCompileTime,
+      MaxColsAtCompileTime = MatrixType::MaxColsAtCompileTime,
+      MaxDiagSizeAtCompileTime = EIGEN_SIZE_MIN_PREFER_FIXED(MaxRowsAtCompileTime,MaxColsAtCompileTime),
+      MatrixOptions = MatrixType::Options
+    };
+
+    typedef Matrix<Scalar, RowsAtCompileTime, RowsAtCompileTime,
+                   MatrixOptions, MaxRowsAtCompileTime, MaxRowsAtCompileTime>
+            MatrixUType;
+    typedef Matrix<Scalar, ColsAtCompileTime, ColsAtCompileTime,
+                   MatrixOptions, MaxColsAtCompileTime, MaxColsAtCompileTime>
+            MatrixVType;
+    typedef typename internal::plain_diag_type<MatrixType, RealScalar>::type SingularValuesType;
+
+    /** \brief Default Constructor.
+      *
+      * The default constructor is useful in cases in which the user intends to
+      * perform decompositions via BDCSVD::compute(const MatrixType&).
+      */
+    BDCSVD()
+      : m_isInitialized(false),
+        m_isAllocated(false),
+        m_computationOptions(0),
+        m_rows(-1), m_cols(-1),
+        m_switchSize(16)
+    {}
+
+    /** \brief Default Constructor with memory preallocation
+      *
+      * Like the default constructor but with preallocation of the internal data
+      * according to the specified problem size.
+      * \sa BDCSVD()
+      */
+    BDCSVD(Index rows, Index cols, unsigned int computationOptions = 0)
+      : m_isInitialized(false),
+        m_isAllocated(false),
+        m_computationOptions(0),
+        m_rows(-1), m_cols(-1),
+        m_switchSize(16)
+    {
+      allocate(rows, cols, computationOptions);
+    }
+
+    /** \brief Constructor performing the decomposition of given matrix.
+     *
+     * \param matrix the matrix to decompose
+     * \param computationOptions optional parameter allowing to specify if you want full or thin U or V unitaries to be computed.
+     *                           By default, none is computed. This is a bit-field, the possible bits are #ComputeFullU, #ComputeThinU,
+     *                           #ComputeFullV, #ComputeThinV.
+     *
+     * Thin unitaries are only available if your matrix type has a Dynamic number of columns (for example MatrixXf).
+     */
+    BDCSVD(const MatrixType& matrix, unsigned int computationOptions = 0)
+      : m_isInitialized(false),
+        m_isAllocated(false),
+        m_computationOptions(0),
+        m_rows(-1), m_cols(-1),
+        m_switchSize(16)
+    {
+      compute(matrix, computationOptions);
+    }
+
+    /** \brief Method performing the decomposition of given matrix using custom options.
+     *
+     * \param matrix the matrix to decompose
+     * \param computationOptions optional parameter allowing to specify if you want full or thin U or V unitaries to be computed.
+     *                           By default, none is computed. This is a bit-field, the possible bits are #ComputeFullU, #ComputeThinU,
+     *                           #ComputeFullV, #ComputeThinV.
+     *
+     * Thin unitaries are only available if your matrix type has a Dynamic number of columns (for example MatrixXf).
+     */
+    BDCSVD& compute(const MatrixType& matrix, unsigned int computationOptions);
+
+    /** \brief Method performing the decomposition of given matrix using current options.
+     *
+     * \param matrix the matrix to decompose
+     *
+     * This method uses the current \a computationOptions, as already passed to the constructor or to compute(const MatrixType&, unsigned int).
+     */
+    BDCSVD& compute(const MatrixType& matrix)
+    {
+      return compute(matrix, m_computationOptions);
+    }
+
+    /** Sets the number of columns below which the blocks of the bidiagonal matrix are decomposed by JacobiSVD instead
+      * of being split further, and below which the whole matrix is decomposed by JacobiSVD. The default is 16. */
+    BDCSVD& setSwitchSize(Index switchSize)
+    {
+      eigen_assert(switchSize >= 3 && "BDCSVD: the switch size must be at least 3");
+      m_switchSize = switchSize;
+      return *this;
+    }
+
+    /** \returns the size below which JacobiSVD is used, see setSwitchSize() */
+    Index switchSize() const { return m_switchSize; }
+
+    /** \returns the \a U matrix.
+     *
+     * For the SVD decomposition of a n-by-p matrix, letting \a m be the minimum of \a n and \a p,
+     * the U matrix is n-by-n if you asked for #ComputeFullU, and is n-by-m if you asked for #ComputeThinU.
+     *
+     * The \a m first columns of \a U are the left singular vectors of the matrix being decomposed.
+     *
+     * This method asserts that you asked for \a U to be computed.
+     */
+    const MatrixUType& matrixU() const
+    {
+      eigen_assert(m_isInitialized && "BDCSVD is not initialized.");
+      eigen_assert(computeU() && "This BDCSVD decomposition didn't compute U. Did you ask for it?");
+      return m_matrixU;
+    }
+
+    /** \returns the \a V matrix.
+     *
+     * For the SVD decomposition of a n-by-p matrix, letting \a m be the minimum of \a n and \a p,
+     * the V matrix is p-by-p if you asked for #ComputeFullV, and is p-by-m if you asked for ComputeThinV.
+     *
+     * The \a m first columns of \a V are the right singular vectors of the matrix being decomposed.
+     *
+     * This method asserts that you asked for \a V to be computed.
+     */
+    const MatrixVType& matrixV() const
+    {
+      eigen_assert(m_isInitialized && "BDCSVD is not initialized.");
+      eigen_assert(computeV() && "This BDCSVD decomposition didn't compute V. Did you ask for it?");
+      return m_matrixV;
+    }
+
+    /** \returns the vector of singular values.
+     *
+     * For the SVD decomposition of a n-by-p matrix, letting \a m be the minimum of \a n and \a p, the
+     * returned vector has size \a m.  Singular values are always sorted in decreasing order.
+     */
+    const SingularValuesType& singularValues() const
+    {
+      eigen_assert(m_isInitialized && "BDCSVD is not initialized.");
+      return m_singularValues;
+    }
+
+    /** \returns true if \a U (full or thin) is asked for in this SVD decomposition */
+    inline bool computeU() const { return m_computeFullU || m_computeThinU; }
+    /** \returns true if \a V (full or thin) is asked for in this SVD decomposition */
+    inline bool computeV() const { return m_computeFullV || m_computeThinV; }
+
+    /** \returns a (least squares) solution of \f$ A x = b \f$ using the current SVD decomposition of A.
+      *
+      * \param b the right-hand-side of the equation to solve.
+      *
+      * \note Solving requires both U and V to be computed. Thin U and V are enough, there is no need for full U or V.
+      *
+      * \note SVD solving is implicitly least-squares. Thus, this method serves both purposes of exact solving and least-squares solving.
+      * In other words, the returned solution is guaranteed to minimize the Euclidean norm \f$ \Vert A x - b \Vert \f$.
+      */
+    template<typename Rhs>
+    inline const internal::solve_retval<BDCSVD, Rhs>
+    solve(const MatrixBase<Rhs>& b) const
+    {
+      eigen_assert(m_isInitialized && "BDCSVD is not initialized.");
+      eigen_assert(computeU() && computeV() && "BDCSVD::solve() requires both unitaries U and V to be computed (thin unitaries suffice).");
+      return internal::solve_retval<BDCSVD, Rhs>(*this, b.derived());
+    }
+
+    /** \returns the number of singular values that are not exactly 0 */
+    Index nonzeroSingularValues() const
+    {
+      eigen_assert(m_isInitialized && "BDCSVD is not initialized.");
+      return m_nonzeroSingularValues;
+    }
+
+    inline Index rows() const { return m_rows; }
+    inline Index cols() const { return m_cols; }
+
+  private:
+    typedef Matrix<RealScalar, Dynamic, Dynamic> MatrixXr;
+    typedef Matrix<RealScalar, Dynamic, 1> VectorXr;
+
+    void allocate(Index rows, Index cols, unsigned int computationOptions);
+    void divide(Index first, Index n, bool extraRow, const VectorXr& diag, const VectorXr& subDiag,
+                VectorXr& sigma, MatrixXr& U, MatrixXr& V, bool fullU, bool withV) const;
+    static void computeSVDofM(VectorXr& z, VectorXr& d, VectorXr& sigma, MatrixXr& X, MatrixXr& Y, bool withY);
+    static RealScalar secularEq(RealScalar mu, const VectorXr& d, const VectorXr& z, RealScalar shift);
+
+  protected:
+    MatrixUType m_matrixU;
+    MatrixVType m_matrixV;
+    SingularValuesType m_singularValues;
+    bool m_isInitialized, m_isAllocated;
+    bool m_computeFullU, m_computeThinU;
+    bool m_computeFullV, m_computeThinV;
+    unsigned int m_computationOptions;
+    Index m_nonzeroSingularValues, m_rows, m_cols, m_diagSize;
+    Index m_switchSize;
+};
+
+template<typename MatrixType>
+void BDCSVD<MatrixType>::allocate(Index rows, Index cols, unsigned int computationOptions)
+{
+  eigen_assert(rows >= 0 && cols >= 0);
+
+  if (m_isAllocated &&
+      rows == m_rows &&
+      cols == m_cols &&
+      computationOptions == m_computationOptions)
+  {
+    return;
+  }
+
+  m_rows = rows;
+  m_cols = cols;
+  m_isInitialized = false;
+  m_isAllocated = true;
+  m_computationOptions = computationOptions;
+  m_computeFullU = (computationOptions & ComputeFullU) != 0;
+  m_computeThinU = (computationOptions & ComputeThinU) != 0;
+  m_computeFullV = (computationOptions & ComputeFullV) != 0;
+  m_computeThinV = (computationOptions & ComputeThinV) != 0;
+  eigen_assert(!(m_computeFullU && m_computeThinU) && "BDCSVD: you can't ask for both full and thin U");
+  eigen_assert(!(m_computeFullV && m_computeThinV) && "BDCSVD: you can't ask for both full and thin V");
+  eigen_assert(EIGEN_IMPLIES(m_computeThinU || m_computeThinV, MatrixType::ColsAtCompileTime==Dynamic) &&
+              "BDCSVD: thin U and V are only available when your matrix has a dynamic number of columns.");
+  m_diagSize = (std::min)(m_rows, m_cols);
+  m_singularValues.resize(m_diagSize);
+  if(RowsAtCompileTime==Dynamic)
+    m_matrixU.resize(m_rows, m_computeFullU ? m_rows
+                            : m_computeThinU ? m_diagSize
+                            : 0);
+  if(ColsAtCompileTime==Dynamic)
+    m_matrixV.resize(m_cols, m_computeFullV ? m_cols
+                            : m_computeThinV ? m_diagSize
+                            : 0);
+}
+
+template<typename MatrixType>
+BDCSVD<MatrixType>&
+BDCSVD<MatrixType>::compute(const MatrixType& matrix, unsigned int computationOptions)
+{
+  typedef Matrix<Scalar, Dynamic, Dynamic> MatrixX;
+  typedef Matrix<Scalar, Dynamic, 1> VectorX;
+  allocate(matrix.rows(), matrix.cols(), computationOptions);
+
+  // small matrices, as well as the ones with inf or nan coefficients, are decomposed by JacobiSVD
+  RealScalar scale = matrix.cwiseAbs().maxCoeff();
+  if(m_diagSize < m_switchSize || !(numext::isfinite)(scale))
+  {
+    JacobiSVD<MatrixType> jsvd(matrix, computationOptions);
+    if(computeU()) m_matrixU = jsvd.matrixU();
+    if(computeV()) m_matrixV = jsvd.matrixV();
+    m_singularValues = jsvd.singularValues();
+    m_nonzeroSingularValues = jsvd.nonzeroSingularValues();
+    m_isInitialized = true;
+    return *this;
+  }
+  if(scale == RealScalar(0))
+    scale = RealScalar(1);
+
+  /*** step 1. Reduce the matrix, or its adjoint if it has more columns than rows, to an upper bidiagonal matrix B ***/
+
+  bool transposed = m_rows < m_cols;
+  MatrixX copy;
+  if(transposed)
+    copy = matrix.adjoint() / scale;
+  else
+    copy = matrix / scale;
+  internal::UpperBidiagonalization<MatrixX> bid(copy);
+
+  /*** step 2. SVD of the lower bidiagonal matrix B^T = U_B S V_B^T by divide and conquer ***/
+
+  // the columns of U_B are the right singular vectors of B, and the ones of V_B are its left singular vectors
+  bool computeLeft = transposed ? computeV() : computeU();
+  bool computeRight = transposed ? computeU() : computeV();
+  typename internal::UpperBidiagonalization<MatrixX>::BidiagonalType bidiagonal = bid.bidiagonal();
+  VectorXr diag = bidiagonal.template diagonal<0>().transpose();
+  VectorXr subDiag(m_diagSize);
+  subDiag.head(m_diagSize-1) = bidiagonal.template diagonal<1>().transpose();
+  subDiag(m_diagSize-1) = RealScalar(0);
+  VectorXr sigma;
+  MatrixXr UB, VB;
+  divide(0, m_diagSize, false, diag, subDiag, sigma, UB, VB, computeRight, computeLeft);
+
+  /*** step 3. Sort the singular values in decreasing order and compute the number of nonzero singular values ***/
+
+  std::vector<Index> order(m_diagSize);
+  for(Index i = 0; i < m_diagSize; ++i)
+    order[i] = i;
+  VectorXr negSigma = -sigma;
+  std::stable_sort(order.begin(), order.end(), internal::bdcsvd_index_less<VectorXr>(negSigma));
+  m_nonzeroSingularValues = m_diagSize;
+  for(Index i = 0; i < m_diagSize; ++i)
+  {
+    m_singularValues.coeffRef(i) = sigma(order[i]) * scale;
+    if(sigma(order[i]) == RealScalar(0) && m_nonzeroSingularValues == m_diagSize)
+      m_nonzeroSingularValues = i;
+  }
+
+  /*** step 4. Apply the Householder transformations of the bidiagonalization to the singular vectors of B ***/
+
+  if(computeLeft)
+  {
+    Index leftRows = transposed ? m_cols : m_rows;
+    Index leftCols = (transposed ? m_computeFullV : m_computeFullU) ? leftRows : m_diagSize;
+    MatrixX left = MatrixX::Identity(leftRows, leftCols);
+    for(Index i = 0; i < m_diagSize; ++i)
+      left.col(i).head(m_diagSize) = VB.col(order[i]).template cast<Scalar>();
+    VectorX coeffs = bid.householder().diagonal().conjugate();
+    internal::apply_block_householder_sequence_on_the_left(left, bid.householder(), coeffs, m_diagSize, 0);
+    if(transposed) m_matrixV = left;
+    else           m_matrixU = left;
+  }
+  if(computeRight)
+  {
+    MatrixX right(m_diagSize, m_diagSize);
+    for(Index i = 0; i < m_diagSize; ++i)
+      right.col(i) = UB.col(order[i]).template cast<Scalar>();
+    VectorX coeffs = bid.householder().template diagonal<1>();
+    internal::apply_block_householder_sequence_on_the_left(right, bid.householder().adjoint(), coeffs, m_diagSize-1, 1);
+    if(transposed) m_matrixU = right;
+    else           m_matrixV = right;
+  }
+
+  m_isInitialized = true;
+  return *this;
+}
+
+/** \internal
+  * Computes the SVD of the block of the lower bidiagonal matrix made of the \a n columns starting at \a first, and of
+  * the \a n rows starting at \a first, plus the next one if \a extraRow is true. The column \a j of the matrix has the
+  * coefficients \a diag(j) on the row \a j and \a subDiag(j) on the row \a j+1.
+  *
+  * On return, the block is U diag(sigma) V^T, V being only computed if \a withV is true. If \a fullU is false, U only
+  * holds the first and the last rows of the left singular vectors, which is all what the merge of the parent needs.
+  * The singular values are not sorted.
+  *
+  * The block is split in two halves around the column k, whose SVDs are computed recursively:
+  * \f[ B = \begin{bmatrix} B_1 & \alpha e_{k} & 0 \\ 0 & \beta e_0 & B_2 \end{bmatrix} \f]
+  * and which are then merged by computing the SVD of a matrix M whose only nonzeros are its first column and its diagonal.
+  */
+template<typename MatrixType>
+void BDCSVD<MatrixType>::divide(Index first, Index n, bool extraRow, const VectorXr& diag, const VectorXr& subDiag,
+                                VectorXr& sigma, MatrixXr& U, MatrixXr& V, bool fullU, bool withV) const
+{
+  using std::abs;
+  const Index rows = n + (extraRow ? 1 : 0);
+
+  if(n < m_switchSize)
+  {
+    MatrixXr block = MatrixXr::Zero(rows, n);
+    for(Index j = 0; j < n; ++j)
+    {
+      block(j,j) = diag(first+j);
+      if(j+1 < rows)
+        block(j+1,j) = subDiag(first+j);
+    }
+    JacobiSVD<MatrixXr> svd(block, ComputeFullU | (withV ? ComputeFullV : 0));
+    sigma = svd.singularValues();
+    if(fullU)
+      U = svd.matrixU();
+    else
+    {
+      U.resize(2, rows);
+      U.row(0) = svd.matrixU().row(0);
+      U.row(1) = svd.matrixU().row(rows-1);
+    }
+    if(withV)
+      V = svd.matrixV();
+    return;
+  }
+
+  const Index k = n/2;
+  const Index n2 = n - k - 1;
+  VectorXr sigma1, sigma2;
+  MatrixXr U1, U2, V1, V2;
+  divide(first, k, true, diag, subDiag, sigma1, U1, V1, fullU, withV);
+  divide(first+k+1, n2, extraRow, diag, subDiag, sigma2, U2, V2, fullU, withV);
+
+  // Up to the singular vectors of B1 and B2, B is M, after a rotation of the last row of B1 with the extra row of B2
+  const RealScalar alpha = diag(first+k);
+  const RealScalar beta = subDiag(first+k);
+  const RealScalar a = alpha * U1(U1.rows()-1, k);
+  const RealScalar b = extraRow ? beta * U2(0, n2) : RealScalar(0);
+  const RealScalar r0 = extraRow ? numext::hypot(a, b) : a;
+  const RealScalar c = r0 == RealScalar(0) ? RealScalar(1) : a / r0;
+  const RealScalar s = r0 == RealScalar(0) ? RealScalar(0) : b / r0;
+
+  VectorXr z(n), d(n);
+  z(0) = r0;
+  d(0) = RealScalar(0);
+  z.segment(1, k) = alpha * U1.row(U1.rows()-1).head(k).transpose();
+  d.segment(1, k) = sigma1;
+  z.tail(n2) = beta * U2.row(0).head(n2).transpose();
+  d.tail(n2) = sigma2;
+
+  MatrixXr X, Y;
+  computeSVDofM(z, d, sigma, X, Y, withV);
+
+  // U = [ c u1_k  U1 0 ; s u2_n2 0 U2 ] X, plus the column [ -s u1_k ; c u2_n2 ] for the extra row.
+  // Only the first row of the upper part and the last row of the lower part are needed if fullU is false.
+  const Index rows1 = fullU ? k+1 : 1;
+  const Index rows2 = fullU ? n2 + (extraRow ? 1 : 0) : 1;
+  MatrixXr XB(n2+1, n);
+  XB.row(0) = X.row(0);
+  XB.bottomRows(n2) = X.bottomRows(n2);
+  MatrixXr newU(rows1+rows2, rows);
+  newU.topLeftCorner(rows1, n).noalias() = c * U1.col(k).head(rows1) * X.row(0);
+  newU.topLeftCorner(rows1, n).noalias() += U1.topLeftCorner(rows1, k) * X.middleRows(1, k);
+  newU.bottomLeftCorner(rows2, n).noalias() = U2.bottomLeftCorner(rows2, n2) * X.bottomRows(n2);
+  if(extraRow)
+  {
+    newU.bottomLeftCorner(rows2, n).noalias() += s * U2.col(n2).tail(rows2) * X.row(0);
+    newU.col(n).head(rows1) = -s * U1.col(k).head(rows1);
+    newU.col(n).tail(rows2) = c * U2.col(n2).tail(rows2);
+  }
+  U.swap(newU);
+
+  if(withV)
+  {
+    V.resize(n, n);
+    V.topRows(k).noalias() = V1 * Y.middleRows(1, k);
+    V.row(k) = Y.row(0);
+    V.bottomRows(n2).noalias() = V2 * Y.bottomRows(n2);
+  }
+}
+
+/** \internal \returns the secular function 1 + sum_i z_i^2 / (d_i^2 - sigma^2) at sigma = \a shift + \a mu */
+template<typename MatrixType>
+typename BDCSVD<MatrixType>::RealScalar
+BDCSVD<MatrixType>::secularEq(RealScalar mu, const VectorXr& d, const VectorXr& z, RealScalar shift)
+{
+  RealScalar res = RealScalar(1);
+  for(Index i = 0; i < d.size(); ++i)
+    res += numext::abs2(z(i)) / (((d(i) - shift) - mu) * (d(i) + shift + mu));
+  return res;
+}
+
+/** \internal
+  * Computes the SVD M = X diag(sigma) Y^T of the n x n matrix M whose first column is \a z, and whose diagonal is \a d,
+  * with d(0) = 0 and d(1:) >= 0. \a Y is only computed if \a withY is true. \a z and \a d are overwritten.
+  *
+  * The singular values of M are the roots of the secular equation
+  * \f[ f(\sigma) = 1 + \sum_i \frac{z_i^2}{d_i^2 - \sigma^2} = 0 \f]
+  * after deflation of the negligible z_i and of the close values of d. Each root is computed relatively to the closest
+  * pole, so that the differences d_i - sigma_j are accurate, and the singular vectors are computed from the vector z
+  * that makes the computed roots exact (Gu and Eisenstat), so that they are orthogonal to working precision.
+  */
+template<typename MatrixType>
+void BDCSVD<MatrixType>::computeSVDofM(VectorXr& z, VectorXr& d, VectorXr& sigma, MatrixXr& X, MatrixXr& Y, bool withY)
+{
+  using std::abs;
+  using std::sqrt;
+  const Index n = z.size();
+  const RealScalar eps = NumTraits<RealScalar>::epsilon();
+
+  sigma.setZero(n);
+  X.setIdentity(n, n);
+  if(withY)
+    Y.setIdentity(n, n);
+  const RealScalar scale = (std::max)(z.cwiseAbs().maxCoeff(), d.cwiseAbs().maxCoeff());
+  if(scale == RealScalar(0))
+    return;
+  z /= scale;
+  d /= scale;
+  const RealScalar tol = RealScalar(8) * eps;
+
+  /*** deflation ***/
+
+  // the columns 1..n-1 by increasing d
+  std::vector<Index> perm(n);
+  for(Index i = 0; i < n; ++i)
+    perm[i] = i;
+  std::sort(perm.begin()+1, perm.end(), internal::bdcsvd_index_less<VectorXr>(d));
+
+  // the rotations G such that M = G^T M' are recorded to be applied to the singular vectors of the deflated matrix M'
+  typedef internal::bdcsvd_rotation<Index,RealScalar> Rotation;
+  std::vector<Rotation> rotations;
+  std::vector<Index> active;
+  active.push_back(0);
+  if(abs(z(0)) <= tol)
+    z(0) = tol;
+  for(Index p = 1; p < n; ++p)
+  {
+    Index i = perm[p];
+    Index last = active.back();
+    if(d(i) <= tol || (last != 0 && d(i) - d(last) <= tol))
+    {
+      // d(i) is (almost) equal to d(last): a rotation of the rows, and for last != 0 of the columns, cancels z(i)
+      Index j = d(i) <= tol ? 0 : last;
+      RealScalar r = numext::hypot(z(j), z(i));
+      if(r != RealScalar(0))
+      {
+        Rotation rot = { j, i, z(j) / r, z(i) / r, j != 0 };
+        rotations.push_back(rot);
+      }
+      z(j) = r;
+      z(i) = RealScalar(0);
+      if(j == 0)
+        d(i) = RealScalar(0);
+    }
+    else if(abs(z(i)) <= tol)
+      z(i) = RealScalar(0);
+    else
+      active.push_back(i);
+  }
+  for(Index i = 1; i < n; ++i)
+    sigma(i) = d(i);
+
+  /*** roots of the secular equation of the active part, by bisection relatively to the closest pole ***/
+
+  const Index na = Index(active.size());
+  VectorXr da(na), za(na), shifts(na), mus(na);
+  for(Index a = 0; a < na; ++a)
+  {
+    da(a) = d(active[a]);
+    za(a) = z(active[a]);
+  }
+  const RealScalar zNorm = za.norm();
+  for(Index a = 0; a < na; ++a)
+  {
+    RealScalar left = da(a);
+    RealScalar right = a < na-1 ? da(a+1) : da(na-1) + zNorm;
+    RealScalar shift = left, lo = 0, hi = right - left;
+    if(a < na-1)
+    {
+      RealScalar half = (right - left) / RealScalar(2);
+      if(secularEq(half, da, za, left) >= RealScalar(0))
+        hi = half;
+      else
+      {
+        shift = right;
+        lo = -half;
+        hi = RealScalar(0);
+      }
+    }
+    for(int iter = 0; iter < 400 && hi - lo > RealScalar(2) * eps * (std::max)(abs(lo), abs(hi)); ++iter)
+    {
+      RealScalar mid = lo + (hi - lo) / RealScalar(2);
+      if(mid == lo || mid == hi)
+        break;
+      RealScalar f = secularEq(mid, da, za, shift);
+      if(f > RealScalar(0))      hi = mid;
+      else if(f < RealScalar(0)) lo = mid;
+      else                       lo = hi = mid;
+    }
+    shifts(a) = shift;
+    // the pole itself is never a root
+    mus(a) = lo == RealScalar(0) ? hi : hi == RealScalar(0) ? lo : lo + (hi - lo) / RealScalar(2);
+  }
+
+  /*** the vector z for which the computed roots are exact (Loewner's theorem) ***/
+
+  VectorXr zhat(na);
+  for(Index a = 0; a < na; ++a)
+  {
+    RealScalar prod = ((shifts(na-1) - da(a)) + mus(na-1)) * (shifts(na-1) + da(a) + mus(na-1));
+    for(Index b = 0; b < na-1; ++b)
+    {
+      Index pole = b < a ? b : b+1;
+      prod *= ((shifts(b) - da(a)) + mus(b)) * (shifts(b) + da(a) + mus(b))
+            / ((da(pole) - da(a)) * (da(pole) + da(a)));
+    }
+    zhat(a) = za(a) < RealScalar(0) ? -sqrt(abs(prod)) : sqrt(abs(prod));
+  }
+
+  /*** singular vectors of the active part: u ~ (D^2 - sigma^2)^-1 z and v ~ M^T u ***/
+
+  VectorXr u(na), v(na);
+  for(Index a = 0; a < na; ++a)
+  {
+    for(Index i = 0; i < na; ++i)
+    {
+      RealScalar denom = ((da(i) - shifts(a)) - mus(a)) * (da(i) + shifts(a) + mus(a));
+      u(i) = zhat(i) / denom;
+      v(i) = da(i) * zhat(i) / denom;
+    }
+    v(0) = RealScalar(-1);
+    u.normalize();
+    v.normalize();
+    Index col = active[a];
+    sigma(col) = shifts(a) + mus(a);
+    for(Index i = 0; i < na; ++i)
+      X(active[i], col) = u(i);
+    if(withY)
+      for(Index i = 0; i < na; ++i)
+        Y(active[i], col) = v(i);
+  }
+
+  /*** undo the deflation ***/
+
+  for(Index r = Index(rotations.size())-1; r >= 0; --r)
+  {
+    const Rotation& rot = rotations[r];
+    JacobiRotation<RealScalar> G(rot.c, rot.s);
+    X.applyOnTheLeft(rot.i, rot.j, G.transpose());
+    if(withY && rot.bothSides)
+      Y.applyOnTheLeft(rot.i, rot.j, G.transpose());
+  }
+
+  sigma *= scale;
+}
+
+namespace internal {
+template<typename _MatrixType, typename Rhs>
+struct solve_retval<BDCSVD<_MatrixType>, Rhs>
+  : solve_retval_base<BDCSVD<_MatrixType>, Rhs>
+{
+  typedef BDCSVD<_MatrixType> BDCSVDType;
+  EIGEN_MAKE_SOLVE_HELPERS(BDCSVDType,Rhs)
+
+  template<typename Dest> void evalTo(Dest& dst) const
+  {
+    eigen_assert(rhs().rows() == dec().rows());
+
+    // A = U S V^*
+    // So A^{-1} = V S^{-1} U^*
+
+    Index diagSize = (std::min)(dec().rows(), dec().cols());
+    typename BDCSVDType::SingularValuesType invertedSingVals(diagSize);
+
+    Index nonzeroSingVals = dec().nonzeroSingularValues();
+    invertedSingVals.head(nonzeroSingVals) = dec().singularValues().head(nonzeroSingVals).array().inverse();
+    invertedSingVals.tail(diagSize - nonzeroSingVals).setZero();
+
+    dst = dec().matrixV().leftCols(diagSize)
+        * invertedSingVals.asDiagonal()
+        * dec().matrixU().leftCols(diagSize).adjoint()
+        * rhs();
+  }
+};
+} // end namespace internal
+
+/** \svd_module
+  *
+  * \return the singular value decomposition of \c *this computed by the divide and conquer algorithm on
+  * the bidiagonal reduction of \c *this.
+  *
+  * \sa class BDCSVD
+  */
+template<typename Derived>
+BDCSVD<typename MatrixBase<Derived>::PlainObject>
+MatrixBase<Derived>::bdcSvd(unsigned int computationOptions) const
+{
+  return BDCSVD<PlainObject>(*this, computationOptions);
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_BDCSVD_H
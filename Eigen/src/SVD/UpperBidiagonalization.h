@@ -85,6 +85,152 @@ template<typename _MatrixType> class UpperBidiagonalization
     bool m_isInitialized;
 };
 
+/** \internal
+  * Reduces the columns [\a k, cols) of \a mat to upper bidiagonal form, the previous ones being already reduced.
+  * The coefficients of the bidiagonal are stored in \a diagonal and \a upperDiagonal. */
+template<typename MatrixType, typename DiagonalType, typename UpperDiagonalType>
+void upperbidiagonalization_inplace_unblocked(MatrixType& mat, DiagonalType& diagonal, UpperDiagonalType& upperDiagonal,
+                                              typename MatrixType::Index k, typename MatrixType::Scalar* tempData)
+{
+  typedef typename MatrixType::Index Index;
+  Index rows = mat.rows();
+  Index cols = mat.cols();
+
+  for (; /* breaks at k==cols-1 below */ ; ++k)
+  {
+    Index remainingRows = rows - k;
+    Index remainingCols = cols - k - 1;
+
+    // construct left householder transform in-place in mat
+    mat.col(k).tail(remainingRows)
+       .makeHouseholderInPlace(mat.coeffRef(k,k), diagonal.coeffRef(k));
+    // apply householder transform to remaining part of mat on the left
+    mat.bottomRightCorner(remainingRows, remainingCols)
+       .applyHouseholderOnTheLeft(mat.col(k).tail(remainingRows-1), mat.coeff(k,k), tempData);
+
+    if(k == cols-1) break;
+
+    // construct right householder transform in-place in mat
+    mat.row(k).tail(remainingCols)
+       .makeHouseholderInPlace(mat.coeffRef(k,k+1), upperDiagonal.coeffRef(k));
+    // apply householder transform to remaining part of mat on the left
+    mat.bottomRightCorner(remainingRows-1, remainingCols)
+       .applyHouseholderOnTheRight(mat.row(k).tail(remainingCols-1).transpose(), mat.coeff(k,k+1), tempData);
+  }
+}
+
+/** \internal
+  * Reduces the \a bs first rows and columns of \a A, without updating the trailing part A(bs:,bs:).
+  * The transformations of the trailing part are accumulated such that it has to be updated by
+  *   A(bs:,bs:) -= V Y^* + X W^*
+  * where V and W hold the left and right Householder vectors. This is the panel factorization of the
+  * blocked algorithm of LAPACK's xGEBRD. */
+template<typename BlockType, typename DiagonalType, typename UpperDiagonalType, typename WorkMatrixType>
+void upperbidiagonalization_blocked_panel(BlockType& A, DiagonalType& diagonal, UpperDiagonalType& upperDiagonal,
+                                          typename BlockType::Index bs,
+                                          WorkMatrixType& V, WorkMatrixType& W, WorkMatrixType& X, WorkMatrixType& Y)
+{
+  typedef typename BlockType::Index Index;
+  typedef typename BlockType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> TempType;
+  Index m = A.rows();
+  Index n = A.cols();
+  TempType tmp(bs);
+
+  V.setZero(m, bs);
+  W.setZero(n, bs);
+  X.setZero(m, bs);
+  Y.setZero(n, bs);
+
+  for(Index i = 0; i < bs; ++i)
+  {
+    // update the i-th column by the previous transformations, and reduce it
+    A.col(i).tail(m-i).noalias() -= V.block(i,0,m-i,i) * Y.row(i).head(i).adjoint();
+    A.col(i).tail(m-i).noalias() -= X.block(i,0,m-i,i) * W.row(i).head(i).adjoint();
+    A.col(i).tail(m-i).makeHouseholderInPlace(A.coeffRef(i,i), diagonal.coeffRef(i));
+    Scalar tauq = A.coeff(i,i);
+    V.coeffRef(i,i) = Scalar(1);
+    V.col(i).tail(m-i-1) = A.col(i).tail(m-i-1);
+
+    // y_i = conj(tauq) * (A^* - Y V^* - W X^*) v_i
+    typename WorkMatrixType::ColXpr::SegmentReturnType y = Y.col(i).tail(n-i-1);
+    y.noalias() = A.block(i,i+1,m-i,n-i-1).adjoint() * V.col(i).tail(m-i);
+    tmp.head(i).noalias() = V.block(i,0,m-i,i).adjoint() * V.col(i).tail(m-i);
+    y.noalias() -= Y.block(i+1,0,n-i-1,i) * tmp.head(i);
+    tmp.head(i).noalias() = X.block(i,0,m-i,i).adjoint() * V.col(i).tail(m-i);
+    y.noalias() -= W.block(i+1,0,n-i-1,i) * tmp.head(i);
+    y *= numext::conj(tauq);
+
+    // update the i-th row by the previous transformations, and reduce it
+    A.row(i).tail(n-i-1).noalias() -= V.row(i).head(i+1) * Y.block(i+1,0,n-i-1,i+1).adjoint();
+    A.row(i).tail(n-i-1).noalias() -= X.row(i).head(i) * W.block(i+1,0,n-i-1,i).adjoint();
+    A.row(i).tail(n-i-1).makeHouseholderInPlace(A.coeffRef(i,i+1), upperDiagonal.coeffRef(i));
+    Scalar taup = A.coeff(i,i+1);
+    // the row is reduced by the right multiplication by I - taup w w^*, w being the conjugate of the stored vector
+    W.coeffRef(i+1,i) = Scalar(1);
+    W.col(i).tail(n-i-2) = A.row(i).tail(n-i-2).adjoint();
+
+    // x_i = taup * (A - V Y^* - X W^*) w_i
+    typename WorkMatrixType::ColXpr::SegmentReturnType x = X.col(i).tail(m-i-1);
+    x.noalias() = A.block(i+1,i+1,m-i-1,n-i-1) * W.col(i).tail(n-i-1);
+    tmp.head(i+1).noalias() = Y.block(i+1,0,n-i-1,i+1).adjoint() * W.col(i).tail(n-i-1);
+    x.noalias() -= V.block(i+1,0,m-i-1,i+1) * tmp.head(i+1);
+    tmp.head(i).noalias() = W.block(i+1,0,n-i-1,i).adjoint() * W.col(i).tail(n-i-1);
+    x.noalias() -= X.block(i+1,0,m-i-1,i) * tmp.head(i);
+    x *= taup;
+  }
+}
+
+/** \internal
+  * Reduces \a mat to upper bidiagonal form, by panels of \a maxBlockSize columns and rows whose transformations
+  * are applied to the rest of the matrix using level 3 operations. The last columns are reduced by the unblocked algorithm.
+  * The storage of the Householder vectors is the same as the one of upperbidiagonalization_inplace_unblocked(). */
+template<typename MatrixType, typename BidiagType>
+void upperbidiagonalization_inplace_blocked(MatrixType& mat, BidiagType& bidiagonal,
+                                            typename MatrixType::Index maxBlockSize = 32,
+                                            typename MatrixType::Scalar* tempData = 0)
+{
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Block<MatrixType,Dynamic,Dynamic> BlockType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> WorkMatrixType;
+  typedef Matrix<Scalar,Dynamic,1,ColMajor,MatrixType::MaxRowsAtCompileTime,1> TempType;
+
+  Index rows = mat.rows();
+  Index cols = mat.cols();
+
+  TempType tempVector;
+  if(tempData==0)
+  {
+    tempVector.resize(rows);
+    tempData = tempVector.data();
+  }
+
+  typedef typename BidiagType::template DiagonalIntReturnType<0>::Type DiagonalType;
+  typedef typename BidiagType::template DiagonalIntReturnType<1>::Type UpperDiagonalType;
+  DiagonalType diagonal = bidiagonal.template diagonal<0>();
+  UpperDiagonalType upperDiagonal = bidiagonal.template diagonal<1>();
+
+  WorkMatrixType V, W, X, Y;
+  Index k = 0;
+  // a panel has to leave at least one column for the unblocked algorithm, which does not reduce the last row
+  for(; k + maxBlockSize < cols && cols - k > 2*maxBlockSize; k += maxBlockSize)
+  {
+    Index bs = maxBlockSize;
+    BlockType A(mat, k, k, rows-k, cols-k);
+    typename DiagonalType::SegmentReturnType diagonalSegment = diagonal.segment(k, bs);
+    typename UpperDiagonalType::SegmentReturnType upperDiagonalSegment = upperDiagonal.segment(k, bs);
+    upperbidiagonalization_blocked_panel(A, diagonalSegment, upperDiagonalSegment, bs, V, W, X, Y);
+
+    // update the trailing part
+    BlockType A22(mat, k+bs, k+bs, rows-k-bs, cols-k-bs);
+    A22.noalias() -= V.bottomRows(rows-k-bs) * Y.bottomRows(cols-k-bs).adjoint();
+    A22.noalias() -= X.bottomRows(rows-k-bs) * W.bottomRows(cols-k-bs).adjoint();
+  }
+
+  upperbidiagonalization_inplace_unblocked(mat, diagonal, upperDiagonal, k, tempData);
+}
+
 template<typename _MatrixType>
 UpperBidiagonalization<_MatrixType>& UpperBidiagonalization<_MatrixType>::compute(const _MatrixType& matrix)
 {
@@ -94,36 +240,13 @@ UpperBidiagonalization<_MatrixType>& UpperBidiagonalization<_MatrixType>::comput
   eigen_assert(rows >= cols && "UpperBidiagonalization is only for matrices satisfying rows>=cols.");
   
   m_householder = matrix;
+  if(m_bidiagonal.cols() != cols)
+    m_bidiagonal = BidiagonalType(cols, cols);
 
   ColVectorType temp(rows);
 
-  for (Index k = 0; /* breaks at k==cols-1 below */ ; ++k)
-  {
-    Index remainingRows = rows - k;
-    Index remainingCols = cols - k - 1;
-
-    // construct left householder transform in-place in m_householder
-    m_householder.col(k).tail(remainingRows)
-                 .makeHouseholderInPlace(m_householder.coeffRef(k,k),
-                                         m_bidiagonal.template diagonal<0>().coeffRef(k));
-    // apply householder transform to remaining part of m_householder on the left
-    m_householder.bottomRightCorner(remainingRows, remainingCols)
-                 .applyHouseholderOnTheLeft(m_householder.col(k).tail(remainingRows-1),
-                                            m_householder.coeff(k,k),
-                                            temp.data());
+  upperbidiagonalization_inplace_blocked(m_householder, m_bidiagonal, 32, temp.data());
 
-    if(k == cols-1) break;
-    
-    // construct right householder transform in-place in m_householder
-    m_householder.row(k).tail(remainingCols)
-                 .makeHouseholderInPlace(m_householder.coeffRef(k,k+1),
-                                         m_bidiagonal.template diagonal<1>().coeffRef(k));
-    // apply householder transform to remaining part of m_householder on the left
-    m_householder.bottomRightCorner(remainingRows-1, remainingCols)
-                 .applyHouseholderOnTheRight(m_householder.row(k).tail(remainingCols-1).transpose(),
-                                             m_householder.coeff(k,k+1),
-                                             temp.data());
-  }
   m_isInitialized = true;
   return *this;
 }
@@ -0,0 +1,611 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SUPERNODAL_CHOLESKY_H
+#define EIGEN_SUPERNODAL_CHOLESKY_H
+
+namespace Eigen {
+
+#ifndef EIGEN_SUPERNODAL_RELAX_SIZE
+/** \internal Supernodes with fewer columns than this value are merged with their parent
+  * even if this introduces a few explicit zeros into the factor */
+#define EIGEN_SUPERNODAL_RELAX_SIZE 8
+#endif
+
+template<typename _MatrixType, int _UpLo = Lower> class SupernodalLLT;
+
+/** \ingroup SparseCholesky_Module
+  * \class SupernodalLLT
+  * \brief A supernodal sparse LLT Cholesky factorization
+  *
+  * This class provides a LL^T Cholesky factorization of sparse matrices that are selfadjoint and positive definite,
+  * with the same API as SimplicialLLT. The factorization allows for solving A.X = B where X and B can be either dense
+  * or sparse.
+  *
+  * Unlike SimplicialLLT which computes the factor L one row at a time, the columns of L sharing the same sparsity
+  * pattern are grouped into supernodes which are stored as dense column major blocks. Each supernode is factorized
+  * by a dense Cholesky decomposition and a triangular solve, and then updates the supernodes which depend on it
+  * through dense matrix products. Those level-3 kernels make this class much faster than SimplicialLLT on
+  * matrices with a lot of fill-in, such as the ones coming from 3D finite element discretizations.
+  *
+  * In order to reduce the fill-in, a symmetric permutation P is applied prior to the factorization
+  * such that the factorized matrix is P A P^-1. This permutation is the one of the minimum degree
+  * ordering, followed by a postordering of the elimination tree to make the supernodes contiguous.
+  *
+  * \tparam _MatrixType the type of the sparse matrix A, it must be a SparseMatrix<>
+  * \tparam _UpLo the triangular part that will be used for the computations. It can be Lower
+  *               or Upper. Default is Lower.
+  *
+  * \sa class SimplicialLLT
+  */
+template<typename _MatrixType, int _UpLo>
+class SupernodalLLT : internal::noncopyable
+{
+  public:
+    typedef _MatrixType MatrixType;
+    enum { UpLo = _UpLo };
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef typename MatrixType::Index Index;
+    typedef SparseMatrix<Scalar,ColMajor,Index> CholMatrixType;
+    typedef Matrix<Scalar,Dynamic,1> VectorType;
+    typedef Matrix<Index,Dynamic,1> IndexVector;
+    typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrixType;
+
+  public:
+
+    /** Default constructor */
+    SupernodalLLT()
+      : m_info(Success), m_isInitialized(false), m_analysisIsOk(false), m_factorizationIsOk(false),
+        m_shiftOffset(0), m_shiftScale(1)
+    {}
+
+    /** Constructs and performs the LLT factorization of \a matrix */
+    SupernodalLLT(const MatrixType& matrix)
+      : m_info(Success), m_isInitialized(false), m_analysisIsOk(false), m_factorizationIsOk(false),
+        m_shiftOffset(0), m_shiftScale(1)
+    {
+      compute(matrix);
+    }
+
+    inline Index cols() const { return m_size; }
+    inline Index rows() const { return m_size; }
+
+    /** \brief Reports whether previous computation was successful.
+      *
+      * \returns \c Success if computation was succesful,
+      *          \c NumericalIssue if the matrix.appears to be negative.
+      */
+    ComputationInfo info() const
+    {
+      eigen_assert(m_isInitialized && "Decomposition is not initialized.");
+      return m_info;
+    }
+
+    /** Computes the sparse Cholesky decomposition of \a matrix */
+    SupernodalLLT& compute(const MatrixType& matrix)
+    {
+      analyzePattern(matrix);
+      factorize(matrix);
+      return *this;
+    }
+
+    /** Performs a symbolic decomposition on the sparcity of \a matrix: computes the fill-reducing
+      * permutation, the supernodes and the sparsity pattern of the factor.
+      *
+      * This function is particularly useful when solving for several problems having the same structure.
+      *
+      * \sa factorize()
+      */
+    void analyzePattern(const MatrixType& a);
+
+    /** Performs a numeric decomposition of \a matrix
+      *
+      * The given matrix must has the same sparcity than the matrix on which the symbolic decomposition has been performed.
+      *
+      * \sa analyzePattern()
+      */
+    void factorize(const MatrixType& a);
+
+    /** \returns the solution x of \f$ A x = b \f$ using the current decomposition of A.
+      *
+      * \sa compute()
+      */
+    template<typename Rhs>
+    inline const internal::solve_retval<SupernodalLLT, Rhs>
+    solve(const MatrixBase<Rhs>& b) const
+    {
+      eigen_assert(m_isInitialized && "Supernodal LLT is not initialized.");
+      eigen_assert(rows()==b.rows()
+                && "SupernodalLLT::solve(): invalid number of rows of the right hand side matrix b");
+      return internal::solve_retval<SupernodalLLT, Rhs>(*this, b.derived());
+    }
+
+    /** \returns the solution x of \f$ A x = b \f$ using the current decomposition of A.
+      *
+      * \sa compute()
+      */
+    template<typename Rhs>
+    inline const internal::sparse_solve_retval<SupernodalLLT, Rhs>
+    solve(const SparseMatrixBase<Rhs>& b) const
+    {
+      eigen_assert(m_isInitialized && "Supernodal LLT is not initialized.");
+      eigen_assert(rows()==b.rows()
+                && "SupernodalLLT::solve(): invalid number of rows of the right hand side matrix b");
+      return internal::sparse_solve_retval<SupernodalLLT, Rhs>(*this, b.derived());
+    }
+
+    /** \returns the permutation P
+      * \sa permutationPinv() */
+    const PermutationMatrix<Dynamic,Dynamic,Index>& permutationP() const
+    { return m_P; }
+
+    /** \returns the inverse P^-1 of the permutation P
+      * \sa permutationP() */
+    const PermutationMatrix<Dynamic,Dynamic,Index>& permutationPinv() const
+    { return m_Pinv; }
+
+    /** Sets the shift parameters that will be used to adjust the diagonal coefficients during the numerical factorization.
+      *
+      * During the numerical factorization, the diagonal coefficients are transformed by the following linear model:\n
+      * \c d_ii = \a offset + \a scale * \c d_ii
+      *
+      * The default is the identity transformation with \a offset=0, and \a scale=1.
+      *
+      * \returns a reference to \c *this.
+      */
+    SupernodalLLT& setShift(const RealScalar& offset, const RealScalar& scale = 1)
+    {
+      m_shiftOffset = offset;
+      m_shiftScale = scale;
+      return *this;
+    }
+
+    /** \returns the number of supernodes of the factor */
+    Index supernodes() const
+    {
+      eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+      return m_superStart.size()-1;
+    }
+
+    /** \returns a copy of the factor L as a sparse matrix
+      *
+      * \note The factor is stored by supernodes, so this function has to convert it. */
+    CholMatrixType matrixL() const;
+
+    /** \returns the determinant of the underlying matrix from the current factorization */
+    Scalar determinant() const
+    {
+      eigen_assert(m_factorizationIsOk && "Supernodal LLT not factorized");
+      Scalar detL(1);
+      for(Index s=0; s<supernodes(); ++s)
+        detL *= supernodeBlock(s).diagonal().prod();
+      return numext::abs2(detL);
+    }
+
+#ifndef EIGEN_PARSED_BY_DOXYGEN
+    /** \internal */
+    template<typename Rhs,typename Dest>
+    void _solve(const MatrixBase<Rhs> &b, MatrixBase<Dest> &dest) const;
+#endif // EIGEN_PARSED_BY_DOXYGEN
+
+  protected:
+
+    typedef Map<DenseMatrixType> SupernodeBlock;
+    typedef Map<const DenseMatrixType> ConstSupernodeBlock;
+
+    /** \internal \returns the dense block of the supernode \a s, whose rows are given by m_rowIndices */
+    SupernodeBlock supernodeBlock(Index s)
+    {
+      return SupernodeBlock(m_values.data()+m_valuePtr[s], m_rowPtr[s+1]-m_rowPtr[s], m_superStart[s+1]-m_superStart[s]);
+    }
+    ConstSupernodeBlock supernodeBlock(Index s) const
+    {
+      return ConstSupernodeBlock(m_values.data()+m_valuePtr[s], m_rowPtr[s+1]-m_rowPtr[s], m_superStart[s+1]-m_superStart[s]);
+    }
+
+    void permute(const MatrixType& a, CholMatrixType& ap) const
+    {
+      ap.resize(m_size, m_size);
+      ap.template selfadjointView<Lower>() = a.template selfadjointView<UpLo>().twistedBy(m_P);
+    }
+
+    void computeSupernodes(const CholMatrixType& ap, const IndexVector& parent);
+
+    Index m_size;
+    mutable ComputationInfo m_info;
+    bool m_isInitialized;
+    bool m_analysisIsOk;
+    bool m_factorizationIsOk;
+
+    IndexVector m_superStart;                         // first column of each supernode, and m_size
+    IndexVector m_columnToSuper;                      // the supernode of each column
+    IndexVector m_rowPtr;                             // start of the row indices of each supernode in m_rowIndices
+    IndexVector m_rowIndices;                         // row indices of each supernode, sorted, starting by its own columns
+    IndexVector m_valuePtr;                           // start of the dense block of each supernode in m_values
+    VectorType m_values;
+    PermutationMatrix<Dynamic,Dynamic,Index> m_P;     // the permutation
+    PermutationMatrix<Dynamic,Dynamic,Index> m_Pinv;  // the inverse permutation
+
+    RealScalar m_shiftOffset;
+    RealScalar m_shiftScale;
+};
+
+namespace internal {
+
+/** \internal Computes the elimination tree of the selfadjoint matrix whose lower triangular part is \a ap
+  * using Liu's algorithm with path compression. The roots have \a n as parent, as expected by treePostorder(). */
+template<typename MatrixType, typename IndexVector>
+void selfadjoint_etree(const MatrixType& ap, IndexVector& parent)
+{
+  typedef typename MatrixType::Index Index;
+  const Index n = ap.cols();
+  // the algorithm needs the entries of the rows of the lower triangular part
+  MatrixType apt = ap.transpose();
+  IndexVector ancestor(n);
+  parent.resize(n);
+  for(Index k=0; k<n; ++k)
+  {
+    parent(k) = n;
+    ancestor(k) = n;
+    for(typename MatrixType::InnerIterator it(apt,k); it; ++it)
+    {
+      Index i = it.index();
+      while(i<k)
+      {
+        Index next = ancestor(i);
+        ancestor(i) = k;
+        if(next==n)
+        {
+          parent(i) = k;
+          break;
+        }
+        i = next;
+      }
+    }
+  }
+}
+
+} // end namespace internal
+
+template<typename MatrixType, int UpLo>
+void SupernodalLLT<MatrixType,UpLo>::analyzePattern(const MatrixType& a)
+{
+  eigen_assert(a.rows()==a.cols());
+  m_size = a.cols();
+  const Index n = m_size;
+
+  // fill-reducing ordering, as SimplicialLLT
+  {
+    CholMatrixType C;
+    C = a.template selfadjointView<UpLo>();
+    internal::minimum_degree_ordering(C, m_Pinv);
+  }
+  if(m_Pinv.size()>0)
+    m_P = m_Pinv.inverse();
+  else
+    m_P.setIdentity(n);
+
+  // followed by a postordering of the elimination tree, so that the supernodes are made of consecutive columns
+  CholMatrixType ap;
+  permute(a, ap);
+  IndexVector parent, post;
+  internal::selfadjoint_etree(ap, parent);
+  internal::treePostorder(n, parent, post);
+  for(Index i=0; i<n; ++i)
+    m_P.indices()(i) = post(m_P.indices()(i));
+  m_Pinv = m_P.inverse();
+
+  permute(a, ap);
+  internal::selfadjoint_etree(ap, parent);
+  computeSupernodes(ap, parent);
+
+  m_isInitialized     = true;
+  m_info              = Success;
+  m_analysisIsOk      = true;
+  m_factorizationIsOk = false;
+}
+
+template<typename MatrixType, int UpLo>
+void SupernodalLLT<MatrixType,UpLo>::computeSupernodes(const CholMatrixType& ap, const IndexVector& parent)
+{
+  const Index n = m_size;
+
+  // count the nonzeros of each column of L by traversing the row subtrees, see SimplicialCholeskyBase::analyzePattern_preordered
+  IndexVector colCount(IndexVector::Zero(n)), childCount(IndexVector::Zero(n+1)), tags(n);
+  {
+    CholMatrixType apt = ap.transpose();
+    for(Index k=0; k<n; ++k)
+    {
+      tags(k) = k;
+      for(typename CholMatrixType::InnerIterator it(apt,k); it; ++it)
+        for(Index i=it.index(); i<k && tags(i)!=k; i=parent(i))
+        {
+          ++colCount(i);
+          tags(i) = k;
+        }
+      ++childCount(parent(k));
+    }
+  }
+
+  // Group the chains of columns j-1, j where j-1 is the only child of j. Fundamental supernodes are the chains
+  // whose columns have the same pattern, but small supernodes are also merged with their parent at the price
+  // of a few explicit zeros, as the relaxed supernodes of SparseLU.
+  std::vector<Index> starts;
+  starts.push_back(0);
+  Index zeros = 0;
+  for(Index j=1; j<n; ++j)
+  {
+    Index width = j - starts.back();
+    bool merge = parent(j-1)==j && childCount(j)==1;
+    if(merge)
+    {
+      // the rows of the column j which are not in the column j-1 become explicit zeros of the previous columns
+      Index extra = width * (colCount(j) + 1 - colCount(j-1));
+      Index entries = (width+1) * (colCount(j) + 1 + width);
+      merge = extra==0 || width < EIGEN_SUPERNODAL_RELAX_SIZE || 10*(zeros+extra) <= entries;
+      if(merge)
+        zeros += extra;
+    }
+    if(!merge)
+    {
+      starts.push_back(j);
+      zeros = 0;
+    }
+  }
+  starts.push_back(n);
+  const Index nsuper = Index(starts.size())-1;
+  m_superStart.resize(nsuper+1);
+  m_columnToSuper.resize(n);
+  for(Index s=0; s<nsuper; ++s)
+  {
+    m_superStart(s) = starts[s];
+    for(Index j=starts[s]; j<starts[s+1]; ++j)
+      m_columnToSuper(j) = s;
+  }
+  m_superStart(nsuper) = n;
+
+  // The rows of a supernode are its own columns, plus the rows of the corresponding columns of A and the rows
+  // of its children which are below it. Since the supernodes are postordered, the children come first.
+  IndexVector firstChild(IndexVector::Constant(nsuper,-1)), nextChild(nsuper), marker(IndexVector::Constant(n,-1));
+  std::vector<Index> rows;
+  m_rowPtr.resize(nsuper+1);
+  m_valuePtr.resize(nsuper+1);
+  m_rowPtr(0) = 0;
+  m_valuePtr(0) = 0;
+  for(Index s=0; s<nsuper; ++s)
+  {
+    const Index first = m_superStart(s), last = m_superStart(s+1)-1;
+    const Index start = Index(rows.size());
+    for(Index j=first; j<=last; ++j)
+    {
+      rows.push_back(j);
+      marker(j) = s;
+    }
+    for(Index j=first; j<=last; ++j)
+      for(typename CholMatrixType::InnerIterator it(ap,j); it; ++it)
+        if(it.index()>last && marker(it.index())!=s)
+        {
+          rows.push_back(it.index());
+          marker(it.index()) = s;
+        }
+    for(Index c=firstChild(s); c>=0; c=nextChild(c))
+      for(Index p=m_rowPtr(c); p<m_rowPtr(c+1); ++p)
+      {
+        Index i = rows[p];
+        if(i>last && marker(i)!=s)
+        {
+          rows.push_back(i);
+          marker(i) = s;
+        }
+      }
+    std::sort(rows.begin()+start+(last-first+1), rows.end());
+    m_rowPtr(s+1) = Index(rows.size());
+    m_valuePtr(s+1) = m_valuePtr(s) + (m_rowPtr(s+1)-m_rowPtr(s))*(last-first+1);
+
+    // the parent of a supernode is the one holding its first off-diagonal row
+    if(m_rowPtr(s+1) > start+(last-first+1))
+    {
+      Index p = m_columnToSuper(rows[start+(last-first+1)]);
+      nextChild(s) = firstChild(p);
+      firstChild(p) = s;
+    }
+  }
+  m_rowIndices = Map<IndexVector>(rows.empty() ? 0 : &rows[0], Index(rows.size()));
+}
+
+template<typename MatrixType, int UpLo>
+void SupernodalLLT<MatrixType,UpLo>::factorize(const MatrixType& a)
+{
+  eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+  eigen_assert(a.rows()==a.cols() && a.rows()==m_size);
+  const Index nsuper = supernodes();
+
+  CholMatrixType ap;
+  permute(a, ap);
+
+  // scatter the coefficients of A into the supernodes
+  m_values.setZero(m_valuePtr(nsuper));
+  IndexVector relative(m_size);
+  for(Index s=0; s<nsuper; ++s)
+  {
+    const Index first = m_superStart(s);
+    for(Index p=m_rowPtr(s); p<m_rowPtr(s+1); ++p)
+      relative(m_rowIndices(p)) = p-m_rowPtr(s);
+    SupernodeBlock L = supernodeBlock(s);
+    for(Index j=first; j<m_superStart(s+1); ++j)
+      for(typename CholMatrixType::InnerIterator it(ap,j); it; ++it)
+      {
+        if(it.index()==j)
+          L(relative(j),j-first) += numext::real(it.value()) * m_shiftScale + m_shiftOffset;
+        else
+          L(relative(it.index()),j-first) += it.value();
+      }
+  }
+
+  // right-looking factorization: once factorized, each supernode updates the supernodes of its off-diagonal rows
+  bool ok = true;
+  DenseMatrixType update;
+  for(Index s=0; s<nsuper && ok; ++s)
+  {
+    const Index width = m_superStart(s+1)-m_superStart(s);
+    SupernodeBlock L = supernodeBlock(s);
+    const Index m = L.rows()-width;
+
+    Block<SupernodeBlock> L11(L, 0, 0, width, width);
+    if(internal::llt_inplace<Scalar,Lower>::blocked(L11)>=0)
+    {
+      ok = false;
+      break;
+    }
+    if(m==0)
+      continue;
+    Block<SupernodeBlock> L21(L, width, 0, m, width);
+    L11.adjoint().template triangularView<Upper>().template solveInPlace<OnTheRight>(L21);
+
+    // A22 -= L21 L21^*, one target supernode at a time
+    const Index* rows = m_rowIndices.data() + m_rowPtr(s) + width;
+    for(Index k=0; k<m; )
+    {
+      const Index t = m_columnToSuper(rows[k]);
+      const Index tFirst = m_superStart(t);
+      Index k2 = k+1;
+      while(k2<m && rows[k2]<m_superStart(t+1))
+        ++k2;
+
+      update.noalias() = L21.bottomRows(m-k) * L21.middleRows(k,k2-k).adjoint();
+
+      // the rows of s below rows[k] are a subset of the rows of t
+      const Index* tRows = m_rowIndices.data() + m_rowPtr(t);
+      SupernodeBlock T = supernodeBlock(t);
+      Index p = 0;
+      for(Index i=k; i<m; ++i)
+      {
+        while(tRows[p]!=rows[i])
+          ++p;
+        relative(i) = p;
+      }
+      for(Index j=k; j<k2; ++j)
+        for(Index i=j; i<m; ++i)
+          T(relative(i), rows[j]-tFirst) -= update(i-k, j-k);
+      k = k2;
+    }
+  }
+
+  m_info = ok ? Success : NumericalIssue;
+  m_factorizationIsOk = true;
+}
+
+template<typename MatrixType, int UpLo>
+template<typename Rhs,typename Dest>
+void SupernodalLLT<MatrixType,UpLo>::_solve(const MatrixBase<Rhs> &b, MatrixBase<Dest> &dest) const
+{
+  eigen_assert(m_factorizationIsOk && "The decomposition is not in a valid state for solving, you must first call either compute() or analyzePattern()/factorize()");
+  eigen_assert(m_size==b.rows());
+
+  if(m_info!=Success)
+    return;
+
+  dest = m_P * b;
+
+  typedef Matrix<typename Dest::Scalar,Dynamic,Dynamic> DenseRhs;
+  DenseRhs tmp;
+  const Index nsuper = supernodes();
+
+  // forward substitution L y = P b
+  for(Index s=0; s<nsuper; ++s)
+  {
+    const Index first = m_superStart(s), width = m_superStart(s+1)-first;
+    ConstSupernodeBlock L = supernodeBlock(s);
+    const Index m = L.rows()-width;
+    Block<Dest> xs(dest.derived(), first, 0, width, dest.cols());
+    L.topRows(width).template triangularView<Lower>().solveInPlace(xs);
+    if(m>0)
+    {
+      tmp.noalias() = L.bottomRows(m) * xs;
+      const Index* rows = m_rowIndices.data() + m_rowPtr(s) + width;
+      for(Index i=0; i<m; ++i)
+        dest.row(rows[i]) -= tmp.row(i);
+    }
+  }
+
+  // backward substitution L^* x = y
+  for(Index s=nsuper-1; s>=0; --s)
+  {
+    const Index first = m_superStart(s), width = m_superStart(s+1)-first;
+    ConstSupernodeBlock L = supernodeBlock(s);
+    const Index m = L.rows()-width;
+    Block<Dest> xs(dest.derived(), first, 0, width, dest.cols());
+    if(m>0)
+    {
+      const Index* rows = m_rowIndices.data() + m_rowPtr(s) + width;
+      tmp.resize(m, dest.cols());
+      for(Index i=0; i<m; ++i)
+        tmp.row(i) = dest.row(rows[i]);
+      xs.noalias() -= L.bottomRows(m).adjoint() * tmp;
+    }
+    L.topRows(width).template triangularView<Lower>().adjoint().solveInPlace(xs);
+  }
+
+  dest = m_Pinv * dest;
+}
+
+template<typename MatrixType, int UpLo>
+typename SupernodalLLT<MatrixType,UpLo>::CholMatrixType SupernodalLLT<MatrixType,UpLo>::matrixL() const
+{
+  eigen_assert(m_factorizationIsOk && "Supernodal LLT not factorized");
+  CholMatrixType res(m_size, m_size);
+  IndexVector nnz(m_size);
+  for(Index s=0; s<supernodes(); ++s)
+    for(Index j=m_superStart(s); j<m_superStart(s+1); ++j)
+      nnz(j) = m_rowPtr(s+1)-m_rowPtr(s) - (j-m_superStart(s));
+  res.reserve(nnz);
+  for(Index s=0; s<supernodes(); ++s)
+  {
+    ConstSupernodeBlock L = supernodeBlock(s);
+    const Index first = m_superStart(s);
+    for(Index j=first; j<m_superStart(s+1); ++j)
+      for(Index p=j-first; p<L.rows(); ++p)
+        res.insert(m_rowIndices(m_rowPtr(s)+p), j) = L(p, j-first);
+  }
+  res.makeCompressed();
+  return res;
+}
+
+namespace internal {
+
+template<typename _MatrixType, int _UpLo, typename Rhs>
+struct solve_retval<SupernodalLLT<_MatrixType,_UpLo>, Rhs>
+  : solve_retval_base<SupernodalLLT<_MatrixType,_UpLo>, Rhs>
+{
+  typedef SupernodalLLT<_MatrixType,_UpLo> Dec;
+  EIGEN_MAKE_SOLVE_HELPERS(Dec,Rhs)
+
+  template<typename Dest> void evalTo(Dest& dst) const
+  {
+    dec()._solve(rhs(),dst);
+  }
+};
+
+template<typename _MatrixType, int _UpLo, typename Rhs>
+struct sparse_solve_retval<SupernodalLLT<_MatrixType,_UpLo>, Rhs>
+  : sparse_solve_retval_base<SupernodalLLT<_MatrixType,_UpLo>, Rhs>
+{
+  typedef SupernodalLLT<_MatrixType,_UpLo> Dec;
+  EIGEN_MAKE_SPARSE_SOLVE_HELPERS(Dec,Rhs)
+
+  template<typename Dest> void evalTo(Dest& dst) const
+  {
+    this->defaultEvalTo(dst);
+  }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_SUPERNODAL_CHOLESKY_H
@@ -12,109 +12,290 @@
 
 namespace Eigen { 
 
+#ifndef EIGEN_SPARSE_PRODUCT_MIN_WORK_PER_THREAD
+/** \internal Number of multiply-adds below which it is not worth waking up one more thread for a sparse * sparse product */
+#define EIGEN_SPARSE_PRODUCT_MIN_WORK_PER_THREAD 50000
+#endif
+
+#ifndef EIGEN_SPARSE_PRODUCT_DENSE_ACCUMULATOR_RATIO
+/** \internal A column of a sparse * sparse product is accumulated into a dense vector when its number of multiply-adds
+  * is at least the number of rows divided by this ratio, and into a hash table otherwise. */
+#define EIGEN_SPARSE_PRODUCT_DENSE_ACCUMULATOR_RATIO 16
+#endif
+
 namespace internal {
 
-template<typename Lhs, typename Rhs, typename ResultType>
-static void conservative_sparse_sparse_product_impl(const Lhs& lhs, const Rhs& rhs, ResultType& res)
+/** \internal \returns the number of threads worth using for a sparse * sparse product of \a work multiply-adds
+  * whose result has \a outerSize outer vectors */
+template<typename Index> Index sparse_product_threads(double work, Index outerSize)
 {
-  typedef typename remove_all<Lhs>::type::Scalar Scalar;
-  typedef typename remove_all<Lhs>::type::Index Index;
+  Index threads = Index((std::min)(double(parallel_max_threads()), work / double(EIGEN_SPARSE_PRODUCT_MIN_WORK_PER_THREAD)));
+  return (std::max)(Index(1), (std::min)(threads, outerSize));
+}
 
-  // make sure to call innerSize/outerSize since we fake the storage order.
-  Index rows = lhs.innerSize();
-  Index cols = rhs.outerSize();
-  eigen_assert(lhs.outerSize() == rhs.innerSize());
+/** \internal The jobs of sparse_sparse_product(), computing the columns [bounds[i],bounds[i+1]) of the product of two
+  * column major matrices. The first pass (Compute) accumulates each column into a dense vector if it is expected to
+  * be dense enough according to the number of multiply-adds \a flops[j+1]-\a flops[j], and into a hash table
+  * otherwise, and appends its sorted nonzeros to the buffers of the job. Once the number of nonzeros of each column
+  * is known, the second pass (Copy) copies the buffers to the result. */
+template<typename Lhs, typename Rhs, typename Index, typename Scalar>
+struct sparse_sparse_product_job
+{
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  enum Phase { Compute, Copy };
 
-  std::vector<bool> mask(rows,false);
-  Matrix<Scalar,Dynamic,1> values(rows);
-  Matrix<Index,Dynamic,1>  indices(rows);
-
-  // estimate the number of non zero entries
-  // given a rhs column containing Y non zeros, we assume that the respective Y columns
-  // of the lhs differs in average of one non zeros, thus the number of non zeros for
-  // the product of a rhs column with the lhs is X+Y where X is the average number of non zero
-  // per column of the lhs.
-  // Therefore, we have nnz(lhs*rhs) = nnz(lhs) + nnz(rhs)
-  Index estimated_nnz_prod = lhs.nonZeros() + rhs.nonZeros();
-
-  res.setZero();
-  res.reserve(Index(estimated_nnz_prod));
-  // we compute each column of the result, one after the other
-  for (Index j=0; j<cols; ++j)
+  sparse_sparse_product_job(const Lhs& lhs, const Rhs& rhs, Index rows, const double* flops, const Index* bounds,
+                            Index* sizes, bool prune, const RealScalar& tolerance, int jobs)
+    : m_lhs(lhs), m_rhs(rhs), m_rows(rows), m_flops(flops), m_bounds(bounds), m_sizes(sizes),
+      m_prune(prune), m_tolerance(tolerance), m_indices(jobs), m_values(jobs),
+      m_outerIndex(0), m_innerIndices(0), m_resValues(0), m_phase(Compute)
+  {}
+
+  void operator()(int i) const
   {
+    std::vector<Index>& indices = m_indices[i];
+    std::vector<Scalar>& values = m_values[i];
+    if(m_phase==Copy)
+    {
+      Index start = m_outerIndex[m_bounds[i]];
+      std::copy(indices.begin(), indices.end(), m_innerIndices+start);
+      std::copy(values.begin(), values.end(), m_resValues+start);
+      return;
+    }
 
-    res.startVec(j);
-    Index nnz = 0;
-    for (typename Rhs::InnerIterator rhsIt(rhs, j); rhsIt; ++rhsIt)
+    using std::abs;
+    // dense accumulator, marker[k]==j when the row k has been met in the column j
+    std::vector<Index> marker;
+    Matrix<Scalar,Dynamic,1> dense;
+    // hash table, using linear probing in the 2^n first entries
+    std::vector<Index> keys, slots;
+    std::vector<Scalar> sums;
+    for(Index j=m_bounds[i]; j<m_bounds[i+1]; ++j)
     {
-      Scalar y = rhsIt.value();
-      Index k = rhsIt.index();
-      for (typename Lhs::InnerIterator lhsIt(lhs, k); lhsIt; ++lhsIt)
+      const double flops = m_flops[j+1]-m_flops[j];
+      const std::size_t start = indices.size();
+      if(flops*EIGEN_SPARSE_PRODUCT_DENSE_ACCUMULATOR_RATIO >= double(m_rows))
       {
-        Index i = lhsIt.index();
-        Scalar x = lhsIt.value();
-        if(!mask[i])
+        if(marker.empty())
+        {
+          marker.assign(m_rows, Index(-1));
+          dense.resize(m_rows);
+        }
+        for(typename Rhs::InnerIterator rhsIt(m_rhs, j); rhsIt; ++rhsIt)
         {
-          mask[i] = true;
-          values[i] = x * y;
-          indices[nnz] = i;
-          ++nnz;
+          const Scalar y = rhsIt.value();
+          for(typename Lhs::InnerIterator lhsIt(m_lhs, rhsIt.index()); lhsIt; ++lhsIt)
+          {
+            const Index k = Index(lhsIt.index());
+            if(marker[k]!=j)
+            {
+              marker[k] = j;
+              dense.coeffRef(k) = lhsIt.value() * y;
+              indices.push_back(k);
+            }
+            else
+              dense.coeffRef(k) += lhsIt.value() * y;
+          }
         }
+        const std::size_t nnz = indices.size()-start;
+        if(double(nnz)*std::log(double(nnz)+1) < double(m_rows))
+          std::sort(indices.begin()+start, indices.end());
         else
-          values[i] += x * y;
-      }
-    }
-
-    // unordered insertion
-    for(int k=0; k<nnz; ++k)
-    {
-      int i = indices[k];
-      res.insertBackByOuterInnerUnordered(j,i) = values[i];
-      mask[i] = false;
-    }
-
-#if 0
-    // alternative ordered insertion code:
-
-    int t200 = rows/(log2(200)*1.39);
-    int t = (rows*100)/139;
-
-    // FIXME reserve nnz non zeros
-    // FIXME implement fast sort algorithms for very small nnz
-    // if the result is sparse enough => use a quick sort
-    // otherwise => loop through the entire vector
-    // In order to avoid to perform an expensive log2 when the
-    // result is clearly very sparse we use a linear bound up to 200.
-    //if((nnz<200 && nnz<t200) || nnz * log2(nnz) < t)
-    //res.startVec(j);
-    if(true)
-    {
-      if(nnz>1) std::sort(indices.data(),indices.data()+nnz);
-      for(int k=0; k<nnz; ++k)
-      {
-        int i = indices[k];
-        res.insertBackByOuterInner(j,i) = values[i];
-        mask[i] = false;
+        {
+          // scanning the marker is cheaper than sorting
+          indices.resize(start);
+          for(Index k=0; k<m_rows; ++k)
+            if(marker[k]==j)
+              indices.push_back(k);
+        }
+        for(std::size_t p=start; p<indices.size(); ++p)
+          values.push_back(dense.coeff(indices[p]));
       }
-    }
-    else
-    {
-      // dense path
-      for(int i=0; i<rows; ++i)
+      else if(flops>0)
       {
-        if(mask[i])
+        std::size_t size = 8;
+        int bits = 3;
+        while(double(size)<2*flops)
+        {
+          size *= 2;
+          ++bits;
+        }
+        const std::size_t mask = size-1;
+        // Fibonacci hashing: the slot is made of the high bits of the product, which depend on all the bits of the row
+        const int shift = (std::max)(0, 32-bits);
+        if(keys.size()<size)
+        {
+          keys.resize(size, Index(-1));
+          sums.resize(size);
+        }
+        slots.clear();
+        for(typename Rhs::InnerIterator rhsIt(m_rhs, j); rhsIt; ++rhsIt)
+        {
+          const Scalar y = rhsIt.value();
+          for(typename Lhs::InnerIterator lhsIt(m_lhs, rhsIt.index()); lhsIt; ++lhsIt)
+          {
+            const Index k = Index(lhsIt.index());
+            std::size_t h = std::size_t(((static_cast<unsigned int>(k)*0x9E3779B1u) & 0xFFFFFFFFu) >> shift);
+            while(keys[h]!=k && keys[h]!=Index(-1))
+              h = (h+1) & mask;
+            if(keys[h]==k)
+              sums[h] += lhsIt.value() * y;
+            else
+            {
+              keys[h] = k;
+              sums[h] = lhsIt.value() * y;
+              slots.push_back(Index(h));
+            }
+          }
+        }
+        // sort the slots by row, and empty the table
+        indices.resize(start+slots.size());
+        std::sort(slots.begin(), slots.end(), hash_slot_less(keys));
+        for(std::size_t p=0; p<slots.size(); ++p)
         {
-          mask[i] = false;
-          res.insertBackByOuterInner(j,i) = values[i];
+          indices[start+p] = keys[slots[p]];
+          values.push_back(sums[slots[p]]);
+          keys[slots[p]] = Index(-1);
         }
       }
+
+      if(m_prune)
+      {
+        std::size_t nnz = start;
+        for(std::size_t p=start; p<indices.size(); ++p)
+          if(abs(values[p])>m_tolerance)
+          {
+            indices[nnz] = indices[p];
+            values[nnz] = values[p];
+            ++nnz;
+          }
+        indices.resize(nnz);
+        values.resize(nnz);
+      }
+      m_sizes[j] = Index(indices.size()-start);
     }
-#endif
+  }
 
+  struct hash_slot_less
+  {
+    hash_slot_less(const std::vector<Index>& keys) : m_keys(keys) {}
+    bool operator()(Index a, Index b) const { return m_keys[a]<m_keys[b]; }
+    const std::vector<Index>& m_keys;
+  };
+
+  const Lhs& m_lhs;
+  const Rhs& m_rhs;
+  Index m_rows;
+  const double* m_flops;
+  const Index* m_bounds;
+  Index* m_sizes;
+  bool m_prune;
+  RealScalar m_tolerance;
+  // the nonzeros computed by each job
+  mutable std::vector<std::vector<Index> > m_indices;
+  mutable std::vector<std::vector<Scalar> > m_values;
+  // Copy
+  const Index* m_outerIndex;
+  Index* m_innerIndices;
+  Scalar* m_resValues;
+  Phase m_phase;
+};
+
+/** \internal Copies the nonzeros computed by the jobs \a job to \a res, in parallel for a SparseMatrix */
+template<typename Job, typename Index, typename Scalar, int _Options>
+void sparse_product_store(Job& job, const Index* sizes, SparseMatrix<Scalar,_Options,Index>& res)
+{
+  const Index cols = res.outerSize();
+  res.resize(res.rows(), res.cols());
+  Index* outerIndex = res.outerIndexPtr();
+  Index nnz = 0;
+  for(Index j=0; j<cols; ++j)
+  {
+    outerIndex[j] = nnz;
+    nnz += sizes[j];
+  }
+  outerIndex[cols] = nnz;
+  if(nnz==0)
+    return;
+  res.resizeNonZeros(nnz);
+  job.m_outerIndex = outerIndex;
+  job.m_innerIndices = res.innerIndexPtr();
+  job.m_resValues = res.valuePtr();
+  job.m_phase = Job::Copy;
+  parallel_for(job, int(job.m_indices.size()));
+}
+
+template<typename Job, typename Index, typename ResultType>
+void sparse_product_store(Job& job, const Index* sizes, ResultType& res)
+{
+  Index nnz = 0;
+  for(Index j=0; j<Index(res.outerSize()); ++j)
+    nnz += sizes[j];
+  res.resize(res.rows(), res.cols());
+  res.reserve(nnz);
+  for(std::size_t i=0; i<job.m_indices.size(); ++i)
+  {
+    std::size_t p = 0;
+    for(Index j=job.m_bounds[i]; j<job.m_bounds[i+1]; ++j)
+    {
+      res.startVec(j);
+      for(Index end=Index(p)+sizes[j]; Index(p)<end; ++p)
+        res.insertBackByOuterInner(j,job.m_indices[i][p]) = job.m_values[i][p];
+    }
   }
   res.finalize();
 }
 
+/** \internal Computes \a res = \a lhs * \a rhs where the three matrices are seen as column major, that is the outer
+  * vectors of \a res are the products of \a lhs by the outer vectors of \a rhs. The result is sorted and compressed.
+  * If \a prune is true, the coefficients whose magnitude is not larger than \a tolerance are removed. Otherwise, the
+  * symbolic nonzeros are kept. The columns are split among threads in chunks of the same number of multiply-adds. */
+template<typename Lhs, typename Rhs, typename ResultType>
+void sparse_sparse_product(const Lhs& lhs, const Rhs& rhs, ResultType& res, bool prune, const typename ResultType::RealScalar& tolerance)
+{
+  typedef typename ResultType::Scalar Scalar;
+  typedef typename ResultType::Index Index;
+
+  // make sure to call innerSize/outerSize since we fake the storage order.
+  const Index rows = Index(lhs.innerSize());
+  const Index cols = Index(rhs.outerSize());
+  eigen_assert(lhs.outerSize() == rhs.innerSize());
+  eigen_assert(res.innerSize()==rows && res.outerSize()==cols);
+
+  // the number of multiply-adds of the columns [0,j) of the product
+  std::vector<Index> lhsSizes(lhs.outerSize());
+  for(Index k=0; k<Index(lhs.outerSize()); ++k)
+  {
+    Index n = 0;
+    for(typename Lhs::InnerIterator lhsIt(lhs, k); lhsIt; ++lhsIt)
+      ++n;
+    lhsSizes[k] = n;
+  }
+  std::vector<double> flops(cols+1);
+  flops[0] = 0;
+  for(Index j=0; j<cols; ++j)
+  {
+    double f = 0;
+    for(typename Rhs::InnerIterator rhsIt(rhs, j); rhsIt; ++rhsIt)
+      f += double(lhsSizes[rhsIt.index()]);
+    flops[j+1] = flops[j] + f;
+  }
+
+  const Index threads = sparse_product_threads(flops[cols], cols);
+  std::vector<Index> bounds, sizes(cols);
+  parallel_outer_bounds(&flops[0], cols, threads, bounds);
+  typedef sparse_sparse_product_job<Lhs,Rhs,Index,Scalar> Job;
+  Job job(lhs, rhs, rows, &flops[0], &bounds[0], cols ? &sizes[0] : 0, prune, tolerance, int(threads));
+  parallel_for(job, int(threads));
+
+  sparse_product_store(job, cols ? &sizes[0] : 0, res);
+}
+
+template<typename Lhs, typename Rhs, typename ResultType>
+static void conservative_sparse_sparse_product_impl(const Lhs& lhs, const Rhs& rhs, ResultType& res)
+{
+  sparse_sparse_product(lhs, rhs, res, false, typename ResultType::RealScalar(0));
+}
 
 } // end namespace internal
 
@@ -134,13 +315,11 @@ struct conservative_sparse_sparse_product_selector<Lhs,Rhs,ResultType,ColMajor,C
 
   static void run(const Lhs& lhs, const Rhs& rhs, ResultType& res)
   {
-    typedef SparseMatrix<typename ResultType::Scalar,RowMajor> RowMajorMatrix;
     typedef SparseMatrix<typename ResultType::Scalar,ColMajor> ColMajorMatrix;
+    // the non zeros are already sorted, the temporary only protects against aliasing
     ColMajorMatrix resCol(lhs.rows(),rhs.cols());
     internal::conservative_sparse_sparse_product_impl<Lhs,Rhs,ColMajorMatrix>(lhs, rhs, resCol);
-    // sort the non zeros:
-    RowMajorMatrix resRow(resCol);
-    res = resRow;
+    res = resCol;
   }
 };
 
@@ -229,12 +408,10 @@ struct conservative_sparse_sparse_product_selector<Lhs,Rhs,ResultType,RowMajor,R
   static void run(const Lhs& lhs, const Rhs& rhs, ResultType& res)
   {
     typedef SparseMatrix<typename ResultType::Scalar,RowMajor> RowMajorMatrix;
-    typedef SparseMatrix<typename ResultType::Scalar,ColMajor> ColMajorMatrix;
+    // the non zeros are already sorted, the temporary only protects against aliasing
     RowMajorMatrix resRow(lhs.rows(),rhs.cols());
     internal::conservative_sparse_sparse_product_impl<Rhs,Lhs,RowMajorMatrix>(rhs, lhs, resRow);
-    // sort the non zeros:
-    ColMajorMatrix resCol(resRow);
-    res = resCol;
+    res = resRow;
   }
 };
 
@@ -142,6 +142,9 @@ template<typename SparseLhsType, typename DenseRhsType, typename DenseResType,
          bool ColPerCol = ((DenseRhsType::Flags&RowMajorBit)==0) || DenseRhsType::ColsAtCompileTime==1>
 struct sparse_time_dense_product_impl;
 
+// The run() functions process the outer vectors [begin,end) of the sparse lhs only,
+// so that the product can be split among several threads, see sparse_time_dense_product().
+
 template<typename SparseLhsType, typename DenseRhsType, typename DenseResType>
 struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, RowMajor, true>
 {
@@ -150,17 +153,16 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, R
   typedef typename internal::remove_all<DenseResType>::type Res;
   typedef typename Lhs::Index Index;
   typedef typename Lhs::InnerIterator LhsInnerIterator;
-  static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha)
+  static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha, Index begin, Index end)
   {
     for(Index c=0; c<rhs.cols(); ++c)
     {
-      int n = lhs.outerSize();
-      for(Index j=0; j<n; ++j)
+      for(Index j=begin; j<end; ++j)
       {
         typename Res::Scalar tmp(0);
         for(LhsInnerIterator it(lhs,j); it ;++it)
           tmp += it.value() * rhs.coeff(it.index(),c);
-        res.coeffRef(j,c) = alpha * tmp;
+        res.coeffRef(j,c) += alpha * tmp;
       }
     }
   }
@@ -174,11 +176,11 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, C
   typedef typename internal::remove_all<DenseResType>::type Res;
   typedef typename Lhs::InnerIterator LhsInnerIterator;
   typedef typename Lhs::Index Index;
-  static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha)
+  static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha, Index begin, Index end)
   {
     for(Index c=0; c<rhs.cols(); ++c)
     {
-      for(Index j=0; j<lhs.outerSize(); ++j)
+      for(Index j=begin; j<end; ++j)
       {
         typename Res::Scalar rhs_j = alpha * rhs.coeff(j,c);
         for(LhsInnerIterator it(lhs,j); it ;++it)
@@ -196,9 +198,9 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, R
   typedef typename internal::remove_all<DenseResType>::type Res;
   typedef typename Lhs::InnerIterator LhsInnerIterator;
   typedef typename Lhs::Index Index;
-  static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha)
+  static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha, Index begin, Index end)
   {
-    for(Index j=0; j<lhs.outerSize(); ++j)
+    for(Index j=begin; j<end; ++j)
     {
       typename Res::RowXpr res_j(res.row(j));
       for(LhsInnerIterator it(lhs,j); it ;++it)
@@ -215,9 +217,9 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, C
   typedef typename internal::remove_all<DenseResType>::type Res;
   typedef typename Lhs::InnerIterator LhsInnerIterator;
   typedef typename Lhs::Index Index;
-  static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha)
+  static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha, Index begin, Index end)
   {
-    for(Index j=0; j<lhs.outerSize(); ++j)
+    for(Index j=begin; j<end; ++j)
     {
       typename Rhs::ConstRowXpr rhs_j(rhs.row(j));
       for(LhsInnerIterator it(lhs,j); it ;++it)
@@ -226,10 +228,118 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, C
   }
 };
 
+/** \internal \returns the outer index array of \a mat if it has one, which gives the number of nonzeros per outer vector,
+  * and a null pointer otherwise */
+template<typename SparseType>
+inline const typename SparseType::Index* sparse_outer_index_ptr(const SparseType&) { return 0; }
+
+template<typename Scalar, int Options, typename Index>
+inline const Index* sparse_outer_index_ptr(const SparseMatrix<Scalar,Options,Index>& mat) { return mat.outerIndexPtr(); }
+
+template<typename Scalar, int Options, typename Index>
+inline const Index* sparse_outer_index_ptr(const MappedSparseMatrix<Scalar,Options,Index>& mat) { return mat.outerIndexPtr(); }
+
+template<typename MatrixType>
+inline const typename MatrixType::Index* sparse_outer_index_ptr(const Transpose<MatrixType>& mat) { return sparse_outer_index_ptr(mat.nestedExpression()); }
+
+#ifndef EIGEN_SPARSE_DENSE_PRODUCT_MIN_WORK_PER_THREAD
+/** \internal Number of multiply-adds below which it is not worth waking up one more thread for a sparse * dense product */
+#define EIGEN_SPARSE_DENSE_PRODUCT_MIN_WORK_PER_THREAD 20000
+#endif
+
+/** \internal The jobs of a parallel sparse * dense product: job \a i processes the outer vectors [bounds[i],bounds[i+1])
+  * of the lhs into the result, or into its own zero initialized copy of the result if the lhs is column major.
+  * These copies are then summed into the result row block per row block. */
+template<typename SparseLhsType, typename DenseRhsType, typename DenseResType, int LhsStorageOrder>
+struct sparse_time_dense_product_job
+{
+  typedef typename remove_all<DenseResType>::type Res;
+  typedef typename Res::Scalar Scalar;
+  typedef typename SparseLhsType::Index Index;
+  typedef Matrix<Scalar,Dynamic,Dynamic> Accumulator;
+
+  sparse_time_dense_product_job(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const Scalar& alpha,
+                                const Index* bounds, Accumulator* accumulators, int jobs)
+    : m_lhs(lhs), m_rhs(rhs), m_res(res), m_alpha(alpha), m_bounds(bounds), m_accumulators(accumulators), m_reduce(false),
+      m_jobs(jobs)
+  {}
+
+  void operator()(int i) const
+  {
+    if(m_reduce)
+    {
+      Index r0 = (m_res.rows()*i) / m_jobs, r1 = (m_res.rows()*(i+1)) / m_jobs;
+      for(int k=0; k<m_jobs-1; ++k)
+        m_res.middleRows(r0,r1-r0) += m_accumulators[k].middleRows(r0,r1-r0);
+    }
+    else if(LhsStorageOrder==RowMajor || i==0)
+      sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType>::run(m_lhs, m_rhs, m_res, m_alpha, m_bounds[i], m_bounds[i+1]);
+    else
+      sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,Accumulator>::run(m_lhs, m_rhs, m_accumulators[i-1], m_alpha, m_bounds[i], m_bounds[i+1]);
+  }
+
+  const SparseLhsType& m_lhs;
+  const DenseRhsType& m_rhs;
+  DenseResType& m_res;
+  Scalar m_alpha;
+  const Index* m_bounds;
+  Accumulator* m_accumulators;
+  bool m_reduce;
+  int m_jobs;
+};
+
 template<typename SparseLhsType, typename DenseRhsType, typename DenseResType,typename AlphaType>
 inline void sparse_time_dense_product(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const AlphaType& alpha)
 {
-  sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType>::run(lhs, rhs, res, alpha);
+  typedef typename SparseLhsType::Index Index;
+  typedef sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType> Impl;
+  enum { LhsStorageOrder = ((SparseLhsType::Flags&RowMajorBit)==RowMajorBit) ? RowMajor : ColMajor };
+
+  const Index outerSize = lhs.outerSize();
+  const Index* outerIndex = sparse_outer_index_ptr(lhs);
+
+  // The product is split along the outer dimension of the lhs, in chunks having roughly the same number of nonzeros.
+  // Since this requires the outer index array, only the products of plain sparse matrices, or of their transpose, are parallelized.
+  Index threads = 1;
+  if(outerIndex && outerSize>1)
+  {
+    double work = double(outerIndex[outerSize]-outerIndex[0]) * double(rhs.cols());
+    threads = Index((std::min)(double(parallel_max_threads()), work / double(EIGEN_SPARSE_DENSE_PRODUCT_MIN_WORK_PER_THREAD)));
+    threads = (std::min)(threads, outerSize);
+    // with a column major lhs, each thread accumulates into its own copy of the result, which must be cheap compared to the product
+    if(int(LhsStorageOrder)==int(ColMajor))
+      threads = (std::min)(threads, Index((outerIndex[outerSize]-outerIndex[0]) / (std::max)(Index(1),Index(res.rows()))));
+  }
+
+  if(threads<=1)
+  {
+    Impl::run(lhs, rhs, res, alpha, 0, outerSize);
+    return;
+  }
+
+  std::vector<Index> bounds(threads+1);
+  bounds[0] = 0;
+  bounds[threads] = outerSize;
+  for(Index t=1; t<threads; ++t)
+  {
+    Index target = outerIndex[0] + Index((double(outerIndex[outerSize]-outerIndex[0]) * double(t)) / double(threads));
+    bounds[t] = Index(std::lower_bound(outerIndex, outerIndex+outerSize, target) - outerIndex);
+    bounds[t] = (std::max)(bounds[t], bounds[t-1]);
+  }
+
+  typedef sparse_time_dense_product_job<SparseLhsType,DenseRhsType,DenseResType,LhsStorageOrder> Job;
+  std::vector<typename Job::Accumulator> accumulators(int(LhsStorageOrder)==int(ColMajor) ? threads-1 : 0);
+  for(std::size_t k=0; k<accumulators.size(); ++k)
+    accumulators[k].setZero(res.rows(), res.cols());
+
+  Job job(lhs, rhs, res, alpha, &bounds[0], accumulators.empty() ? 0 : &accumulators[0], int(threads));
+  parallel_for(job, int(threads));
+
+  if(int(LhsStorageOrder)==int(ColMajor))
+  {
+    job.m_reduce = true;
+    parallel_for(job, int(threads));
+  }
 }
 
 } // end namespace internal
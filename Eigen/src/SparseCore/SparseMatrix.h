@@ -428,6 +428,15 @@ class SparseMatrix
     template<typename InputIterators>
     void setFromTriplets(const InputIterators& begin, const InputIterators& end);
 
+    template<typename InputIterators,typename DupFunctor>
+    void setFromTriplets(const InputIterators& begin, const InputIterators& end, DupFunctor dup_func);
+
+    template<typename InputIterators>
+    void setFromTriplets(const InputIterators& begin, const InputIterators& end, const TripletPattern<Index>& pattern);
+
+    template<typename InputIterators,typename DupFunctor>
+    void setFromTriplets(const InputIterators& begin, const InputIterators& end, const TripletPattern<Index>& pattern, DupFunctor dup_func);
+
     void sumupDuplicates();
 
     //---
@@ -912,39 +921,559 @@ class SparseMatrix<Scalar,_Options,_Index>::ReverseInnerIterator
     const Index m_start;
 };
 
+#ifndef EIGEN_SET_FROM_TRIPLETS_MIN_TRIPLETS_PER_THREAD
+/** \internal Number of triplets below which it is not worth waking up one more thread to assemble a sparse matrix */
+#define EIGEN_SET_FROM_TRIPLETS_MIN_TRIPLETS_PER_THREAD 50000
+#endif
+
 namespace internal {
 
-template<typename InputIterator, typename SparseMatrixType>
-void set_from_triplets(const InputIterator& begin, const InputIterator& end, SparseMatrixType& mat, int Options = 0)
+/** \internal A value type discarding what is assigned to it, to bucket triplets without their values */
+struct triplets_no_value
 {
-  EIGEN_UNUSED_VARIABLE(Options);
-  enum { IsRowMajor = SparseMatrixType::IsRowMajor };
-  typedef typename SparseMatrixType::Scalar Scalar;
-  SparseMatrix<Scalar,IsRowMajor?ColMajor:RowMajor> trMat(mat.rows(),mat.cols());
+  template<typename T> triplets_no_value& operator=(const T&) { return *this; }
+};
+
+/** \internal \returns the number of threads worth using to assemble a matrix from \a size triplets */
+template<typename Index> Index triplets_threads(Index size)
+{
+  Index threads = Index((std::min)(double(parallel_max_threads()), double(size) / double(EIGEN_SET_FROM_TRIPLETS_MIN_TRIPLETS_PER_THREAD)));
+  return (std::max)(Index(1), threads);
+}
+
+/** \internal The same as triplets_threads(Index) for triplets given by random access iterators, the other ones being
+  * read sequentially by a single thread */
+template<typename Index> Index triplets_threads(Index size, std::random_access_iterator_tag)
+{
+  return triplets_threads(size);
+}
+
+template<typename Index, typename IteratorCategory> Index triplets_threads(Index, IteratorCategory)
+{
+  return 1;
+}
+
+/** \internal Splits the outer vectors [0,outerSize) into \a jobs ranges [bounds[i],bounds[i+1]) holding roughly the
+  * same amount of work, where \a outerIndex[j] is the work of the outer vectors [0,j) */
+template<typename T, typename Index>
+void parallel_outer_bounds(const T* outerIndex, Index outerSize, Index jobs, std::vector<Index>& bounds)
+{
+  bounds.resize(jobs+1);
+  bounds[0] = 0;
+  bounds[jobs] = outerSize;
+  for(Index t=1; t<jobs; ++t)
+  {
+    T target = outerIndex[0] + T((double(outerIndex[outerSize]-outerIndex[0]) * double(t)) / double(jobs));
+    bounds[t] = Index(std::lower_bound(outerIndex, outerIndex+outerSize, target) - outerIndex);
+    bounds[t] = (std::max)(bounds[t], bounds[t-1]);
+  }
+}
+
+/** \internal The jobs bucketing a list of triplets per outer vector: job \a i processes the \a i-th of \a jobs chunks
+  * of the list. It first counts the entries of its chunk per outer vector into its own row of \a offsets (Count). Once
+  * these counts are turned into the positions where each job writes its entries of each outer vector, the jobs scatter
+  * their entries there (Scatter), such that the entries of each outer vector remain in the order of the list.
+  * Along with the inner indices, the optional arrays \a values and \a order receive the values of the triplets and
+  * their position in the list. */
+template<typename InputIterator, typename Index, typename Scalar>
+struct triplets_scatter_job
+{
+  enum Phase { Count, Scatter };
+
+  triplets_scatter_job(const InputIterator& begin, Index size, bool rowMajor, Index outerSize, Index jobs,
+                       Index* offsets, Index* innerIndices, Scalar* values, Index* order)
+    : m_begin(begin), m_size(size), m_rowMajor(rowMajor), m_outerSize(outerSize), m_jobs(jobs), m_offsets(offsets),
+      m_innerIndices(innerIndices), m_values(values), m_order(order), m_phase(Count)
+  {}
+
+  void operator()(int i) const
+  {
+    Index start, length;
+    parallel_chunk(m_size, m_jobs, Index(1), Index(i), start, length);
+    Index* offsets = m_offsets + Index(i)*m_outerSize;
+    InputIterator it = m_begin;
+    std::advance(it, start);
+    for(Index k=start; k<start+length; ++k, ++it)
+    {
+      const Index outer = Index(m_rowMajor ? it->row() : it->col());
+      if(m_phase==Count)
+      {
+        ++offsets[outer];
+        continue;
+      }
+      const Index p = offsets[outer]++;
+      m_innerIndices[p] = Index(m_rowMajor ? it->col() : it->row());
+      if(m_values) m_values[p] = it->value();
+      if(m_order)  m_order[p] = k;
+    }
+  }
+
+  InputIterator m_begin;
+  Index m_size;
+  bool m_rowMajor;
+  Index m_outerSize, m_jobs;
+  Index* m_offsets;
+  Index* m_innerIndices;
+  Scalar* m_values;
+  Index* m_order;
+  Phase m_phase;
+};
+
+/** \internal Buckets the \a size triplets starting at \a begin per outer vector, see triplets_scatter_job.
+  * On return, the entries of the outer vector j are stored at [outerIndex[j],outerIndex[j+1]) in the order of the list. */
+template<typename InputIterator, typename Index, typename Scalar>
+void triplets_scatter(const InputIterator& begin, Index size, bool rowMajor, Index outerSize, Index jobs,
+                      Index* outerIndex, Index* innerIndices, Scalar* values, Index* order)
+{
+  std::vector<Index> offsets(jobs*outerSize, Index(0));
+  triplets_scatter_job<InputIterator,Index,Scalar> job(begin, size, rowMajor, outerSize, jobs, &offsets[0],
+                                                       innerIndices, values, order);
+  parallel_for(job, int(jobs));
+
+  // prefix sum over the outer vectors, and over the jobs within each outer vector
+  Index count = 0;
+  for(Index j=0; j<outerSize; ++j)
+  {
+    outerIndex[j] = count;
+    for(Index t=0; t<jobs; ++t)
+    {
+      Index n = offsets[t*outerSize+j];
+      offsets[t*outerSize+j] = count;
+      count += n;
+    }
+  }
+  outerIndex[outerSize] = count;
 
-  if(begin<end)
+  job.m_phase = job.Scatter;
+  parallel_for(job, int(jobs));
+}
+
+/** \internal The jobs of set_from_triplets() processing the outer vectors [bounds[i],bounds[i+1]): the first entry
+  * of each inner index is kept and the next ones are combined into it with \a dup_func, in the order of the list.
+  * The remaining entries are then sorted by inner index, and their number is stored in \a sizes. */
+template<typename Index, typename Scalar, typename DupFunctor>
+struct triplets_collapse_job
+{
+  triplets_collapse_job(Index innerSize, const Index* outerIndex, Index* innerIndices, Scalar* values,
+                        const Index* bounds, Index* sizes, const DupFunctor& dup_func)
+    : m_innerSize(innerSize), m_outerIndex(outerIndex), m_innerIndices(innerIndices), m_values(values),
+      m_bounds(bounds), m_sizes(sizes), m_dupFunc(dup_func)
+  {}
+
+  void operator()(int i) const
   {
-    // pass 1: count the nnz per inner-vector
-    VectorXi wi(trMat.outerSize());
-    wi.setZero();
-    for(InputIterator it(begin); it!=end; ++it)
-      wi(IsRowMajor ? it->col() : it->row())++;
-
-    // pass 2: insert all the elements into trMat
-    trMat.reserve(wi);
-    for(InputIterator it(begin); it!=end; ++it)
-      trMat.insertBackUncompressed(it->row(),it->col()) = it->value();
-
-    // pass 3:
-    trMat.sumupDuplicates();
+    DupFunctor dup_func(m_dupFunc);
+    // marker[inner] holds the position of the entry of that inner index in the current outer vector, if any
+    std::vector<Index> marker(m_innerSize, Index(-1));
+    std::vector<Scalar> buffer;
+    for(Index j=m_bounds[i]; j<m_bounds[i+1]; ++j)
+    {
+      const Index start = m_outerIndex[j];
+      Index count = start;
+      bool sorted = true;
+      for(Index k=start; k<m_outerIndex[j+1]; ++k)
+      {
+        const Index inner = m_innerIndices[k];
+        const Index p = marker[inner];
+        if(p>=start)
+        {
+          m_values[p] = dup_func(m_values[p], m_values[k]);
+        }
+        else
+        {
+          sorted = sorted && (count==start || m_innerIndices[count-1]<inner);
+          m_innerIndices[count] = inner;
+          m_values[count] = m_values[k];
+          marker[inner] = count;
+          ++count;
+        }
+      }
+      if(!sorted)
+      {
+        // the inner indices are unique, so the values follow them through the marker
+        buffer.assign(m_values+start, m_values+count);
+        std::sort(m_innerIndices+start, m_innerIndices+count);
+        for(Index k=start; k<count; ++k)
+          m_values[k] = buffer[marker[m_innerIndices[k]]-start];
+      }
+      m_sizes[j] = count-start;
+    }
   }
 
-  // pass 4: transposed copy -> implicit sorting
-  mat = trMat;
+  Index m_innerSize;
+  const Index* m_outerIndex;
+  Index* m_innerIndices;
+  Scalar* m_values;
+  const Index* m_bounds;
+  Index* m_sizes;
+  DupFunctor m_dupFunc;
+};
+
+/** \internal Asserts that the triplets [begin,end) lie within a \a rows x \a cols matrix, which the bucketing relies on */
+template<typename InputIterator, typename Index>
+void triplets_check_range(const InputIterator& begin, const InputIterator& end, Index rows, Index cols)
+{
+#ifndef EIGEN_NO_DEBUG
+  for(InputIterator it(begin); it!=end; ++it)
+    eigen_assert(Index(it->row())>=0 && Index(it->row())<rows && Index(it->col())>=0 && Index(it->col())<cols);
+#else
+  EIGEN_UNUSED_VARIABLE(begin);
+  EIGEN_UNUSED_VARIABLE(end);
+  EIGEN_UNUSED_VARIABLE(rows);
+  EIGEN_UNUSED_VARIABLE(cols);
+#endif
 }
 
+/** \internal Assembles \a mat from the triplets [begin,end): the triplets are bucketed per outer vector directly into
+  * the storage of \a mat, where each outer vector is then sorted and its duplicates combined, so that the only
+  * temporaries are the per thread counters and markers. */
+template<typename InputIterator, typename SparseMatrixType, typename DupFunctor>
+void set_from_triplets(const InputIterator& begin, const InputIterator& end, SparseMatrixType& mat, DupFunctor dup_func)
+{
+  enum { IsRowMajor = SparseMatrixType::IsRowMajor };
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::Index Index;
+
+  typedef typename std::iterator_traits<InputIterator>::iterator_category IteratorCategory;
+
+  mat.resize(mat.rows(), mat.cols());
+  const Index size = Index(std::distance(begin, end)), outerSize = mat.outerSize();
+  if(size<=0)
+    return;
+  triplets_check_range(begin, end, mat.rows(), mat.cols());
+
+  // pass 1 & 2: count the entries per outer vector, and bucket them
+  mat.resizeNonZeros(size);
+  Index* outerIndex = mat.outerIndexPtr();
+  Index* innerIndices = mat.innerIndexPtr();
+  Scalar* values = mat.valuePtr();
+  const Index threads = triplets_threads(size, IteratorCategory());
+  triplets_scatter(begin, size, bool(IsRowMajor), outerSize, threads, outerIndex, innerIndices, values, (Index*)0);
+
+  // pass 3: combine the duplicates and sort each outer vector
+  std::vector<Index> bounds, sizes(outerSize);
+  parallel_outer_bounds(outerIndex, outerSize, threads, bounds);
+  parallel_for(triplets_collapse_job<Index,Scalar,DupFunctor>(mat.innerSize(), outerIndex, innerIndices, values,
+                                                              &bounds[0], &sizes[0], dup_func), int(threads));
+
+  // pass 4: remove the gaps left by the duplicates
+  Index nnz = 0;
+  for(Index j=0; j<outerSize; ++j)
+  {
+    const Index start = outerIndex[j];
+    if(start!=nnz)
+    {
+      std::copy(innerIndices+start, innerIndices+start+sizes[j], innerIndices+nnz);
+      std::copy(values+start, values+start+sizes[j], values+nnz);
+    }
+    outerIndex[j] = nnz;
+    nnz += sizes[j];
+  }
+  outerIndex[outerSize] = nnz;
+  mat.resizeNonZeros(nnz);
+  if(nnz<size)
+    mat.data().squeeze();
 }
 
+/** \internal The jobs of TripletPattern::compute() processing the outer vectors [bounds[i],bounds[i+1]) of the
+  * bucketed triplets. The first pass (Rank) sorts the distinct inner indices of each outer vector at the beginning
+  * of its bucket, and stores the rank of the inner index of each entry into \a ranks. The second one (Order) copies
+  * these inner indices to the compressed pattern, and orders the triplets of each outer vector such that the first
+  * one of each rank comes first, followed by the duplicates in the order of the list along with their destination. */
+template<typename Index>
+struct triplets_pattern_job
+{
+  enum Phase { Rank, Order };
+
+  triplets_pattern_job(Index innerSize, const Index* outerStarts, Index* bucketInner, const Index* bucketOrder,
+                       Index* ranks, const Index* bounds, Index* sizes)
+    : m_innerSize(innerSize), m_outerStarts(outerStarts), m_bucketInner(bucketInner), m_bucketOrder(bucketOrder),
+      m_ranks(ranks), m_bounds(bounds), m_sizes(sizes), m_phase(Rank)
+  {}
+
+  void operator()(int i) const
+  {
+    if(m_phase==Rank)
+    {
+      std::vector<Index> marker(m_innerSize, Index(-1));
+      std::vector<Index> keys;
+      for(Index j=m_bounds[i]; j<m_bounds[i+1]; ++j)
+      {
+        const Index start = m_outerStarts[j], end = m_outerStarts[j+1];
+        keys.clear();
+        for(Index p=start; p<end; ++p)
+          if(marker[m_bucketInner[p]]<start)
+          {
+            marker[m_bucketInner[p]] = start;
+            keys.push_back(m_bucketInner[p]);
+          }
+        std::sort(keys.begin(), keys.end());
+        for(std::size_t r=0; r<keys.size(); ++r)
+          marker[keys[r]] = start + Index(r);
+        for(Index p=start; p<end; ++p)
+          m_ranks[p] = marker[m_bucketInner[p]] - start;
+        std::copy(keys.begin(), keys.end(), m_bucketInner+start);
+        m_sizes[j] = Index(keys.size());
+      }
+    }
+    else
+    {
+      std::vector<bool> seen;
+      for(Index j=m_bounds[i]; j<m_bounds[i+1]; ++j)
+      {
+        const Index start = m_outerStarts[j], end = m_outerStarts[j+1];
+        const Index first = m_outerIndex[j], size = m_outerIndex[j+1]-first;
+        std::copy(m_bucketInner+start, m_bucketInner+start+size, m_innerIndices+first);
+        seen.assign(size, false);
+        Index d = 0;
+        for(Index p=start; p<end; ++p)
+        {
+          const Index r = m_ranks[p];
+          if(!seen[r])
+          {
+            seen[r] = true;
+            m_order[start+r] = m_bucketOrder[p];
+          }
+          else
+          {
+            m_order[start+size+d] = m_bucketOrder[p];
+            m_duplicates[start-first+d] = first+r;
+            ++d;
+          }
+        }
+      }
+    }
+  }
+
+  Index m_innerSize;
+  const Index* m_outerStarts;
+  Index* m_bucketInner;
+  const Index* m_bucketOrder;
+  Index* m_ranks;
+  const Index* m_bounds;
+  Index* m_sizes;
+  // Order
+  const Index* m_outerIndex;
+  Index* m_innerIndices;
+  Index* m_order;
+  Index* m_duplicates;
+  Phase m_phase;
+};
+
+/** \internal The jobs of SparseMatrix::setFromTriplets(begin,end,pattern,dup_func) filling the outer vectors
+  * [bounds[i],bounds[i+1]) of the matrix, see triplets_pattern_job for the layout of the pattern. The triplets given
+  * by non random access iterators are read in the order of the list by a single job filling the whole matrix. */
+template<typename InputIterator, typename Index, typename Scalar, typename DupFunctor>
+struct triplets_values_job
+{
+  triplets_values_job(const InputIterator& begin, const TripletPattern<Index>& pattern, Index* innerIndices, Scalar* values,
+                      const Index* bounds, const DupFunctor& dup_func)
+    : m_begin(begin), m_pattern(pattern), m_innerIndices(innerIndices), m_values(values), m_bounds(bounds), m_dupFunc(dup_func)
+  {}
+
+  void operator()(int i) const
+  {
+    run(i, typename std::iterator_traits<InputIterator>::iterator_category());
+  }
+
+  template<typename IteratorCategory>
+  void run(int i, IteratorCategory) const
+  {
+    const Index outerSize = Index(m_pattern.m_outerIndex.size())-1;
+    eigen_internal_assert(i==0 && m_bounds[1]==outerSize);
+    EIGEN_UNUSED_VARIABLE(i);
+    DupFunctor dup_func(m_dupFunc);
+    const Index* outerStarts = &m_pattern.m_outerStarts[0];
+    const Index* outerIndex = &m_pattern.m_outerIndex[0];
+    const Index* order = m_pattern.m_order.empty() ? 0 : &m_pattern.m_order[0];
+    const Index* duplicates = m_pattern.m_duplicates.empty() ? 0 : &m_pattern.m_duplicates[0];
+
+    // the destination of each triplet of the list, and whether it is the first one of its entry
+    std::vector<Index> dest(m_pattern.size());
+    std::vector<bool> first(m_pattern.size());
+    for(Index j=0; j<outerSize; ++j)
+    {
+      const Index start = outerStarts[j], end = outerStarts[j+1];
+      const Index firstEntry = outerIndex[j], size = outerIndex[j+1]-firstEntry;
+      for(Index r=0; r<size; ++r)
+      {
+        dest[order[start+r]] = firstEntry+r;
+        first[order[start+r]] = true;
+      }
+      for(Index p=start+size; p<end; ++p)
+        dest[order[p]] = duplicates[p-size-firstEntry];
+    }
+
+    std::copy(m_pattern.m_innerIndices.begin(), m_pattern.m_innerIndices.end(), m_innerIndices);
+    InputIterator it = m_begin;
+    for(Index k=0; k<m_pattern.size(); ++k, ++it)
+    {
+      const Index q = dest[k];
+      if(first[k])
+      {
+        eigen_assert(Index(m_pattern.isRowMajor() ? it->col() : it->row())==m_innerIndices[q]
+                     && "the triplets do not match the pattern");
+        m_values[q] = it->value();
+      }
+      else
+        m_values[q] = dup_func(m_values[q], it->value());
+    }
+  }
+
+  void run(int i, std::random_access_iterator_tag) const
+  {
+    DupFunctor dup_func(m_dupFunc);
+    const Index* outerStarts = &m_pattern.m_outerStarts[0];
+    const Index* outerIndex = &m_pattern.m_outerIndex[0];
+    const Index* order = m_pattern.m_order.empty() ? 0 : &m_pattern.m_order[0];
+    const Index* duplicates = m_pattern.m_duplicates.empty() ? 0 : &m_pattern.m_duplicates[0];
+    const Index* innerIndices = m_pattern.m_innerIndices.empty() ? 0 : &m_pattern.m_innerIndices[0];
+    for(Index j=m_bounds[i]; j<m_bounds[i+1]; ++j)
+    {
+      const Index start = outerStarts[j], end = outerStarts[j+1];
+      const Index first = outerIndex[j], size = outerIndex[j+1]-first;
+      for(Index r=0; r<size; ++r)
+      {
+        InputIterator it = m_begin + order[start+r];
+        eigen_assert(Index(m_pattern.isRowMajor() ? it->col() : it->row())==innerIndices[first+r]
+                     && "the triplets do not match the pattern");
+        m_innerIndices[first+r] = innerIndices[first+r];
+        m_values[first+r] = it->value();
+      }
+      for(Index p=start+size; p<end; ++p)
+      {
+        const Index q = duplicates[p-size-first];
+        m_values[q] = dup_func(m_values[q], (m_begin + order[p])->value());
+      }
+    }
+  }
+
+  InputIterator m_begin;
+  const TripletPattern<Index>& m_pattern;
+  Index* m_innerIndices;
+  Scalar* m_values;
+  const Index* m_bounds;
+  DupFunctor m_dupFunc;
+};
+
+} // end namespace internal
+
+/** \ingroup SparseCore_Module
+  *
+  * \class TripletPattern
+  *
+  * \brief The sparsity pattern of a list of triplets, to assemble several matrices of the same structure
+  *
+  * Most of the work of SparseMatrix::setFromTriplets() consists in sorting the triplets and locating their duplicates.
+  * When several matrices are assembled from lists holding the same (row,col) pairs in the same order, like the
+  * successive stiffness matrices of a finite element simulation, this work can be done once by compute(). Then
+  * SparseMatrix::setFromTriplets(begin,end,pattern) only scatters the values of each list into the matrix:
+  * \code
+  * TripletPattern<int> pattern(triplets.begin(), triplets.end(), n, n);
+  * SparseMatrix<double> K(n,n);
+  * for(...)
+  * {
+  *   // update the values of the triplets
+  *   K.setFromTriplets(triplets.begin(), triplets.end(), pattern);
+  * }
+  * \endcode
+  *
+  * The pattern stores two indices per triplet, and the inner indices of the assembled matrix.
+  *
+  * \tparam _Index the type of the indices of the matrices, see SparseMatrix
+  */
+template<typename _Index>
+class TripletPattern
+{
+  public:
+    typedef _Index Index;
+
+    /** Default constructor, see compute() */
+    TripletPattern() : m_rows(0), m_cols(0), m_isRowMajor(false) {}
+
+    /** Constructs the pattern of the triplets [\a begin,\a end), see compute() */
+    template<typename InputIterators>
+    TripletPattern(const InputIterators& begin, const InputIterators& end, Index rows, Index cols, int options = ColMajor)
+    {
+      compute(begin, end, rows, cols, options);
+    }
+
+    template<typename InputIterators>
+    TripletPattern& compute(const InputIterators& begin, const InputIterators& end, Index rows, Index cols, int options = ColMajor);
+
+    /** \returns the number of rows of the assembled matrices */
+    Index rows() const { return m_rows; }
+    /** \returns the number of columns of the assembled matrices */
+    Index cols() const { return m_cols; }
+    /** \returns whether the pattern is computed for row major matrices */
+    bool isRowMajor() const { return m_isRowMajor; }
+    /** \returns the number of triplets */
+    Index size() const { return Index(m_order.size()); }
+    /** \returns the number of non zeros of the assembled matrices, that is the number of distinct (row,col) pairs */
+    Index nonZeros() const { return Index(m_innerIndices.size()); }
+
+  protected:
+    template<typename, typename, typename, typename> friend struct internal::triplets_values_job;
+    template<typename, int, typename> friend class SparseMatrix;
+
+    Index m_rows, m_cols;
+    bool m_isRowMajor;
+    // the first position of each outer vector in m_order, and in the compressed matrix
+    std::vector<Index> m_outerStarts, m_outerIndex;
+    std::vector<Index> m_innerIndices;
+    // the position of the triplets in the list, outer vector per outer vector (see internal::triplets_pattern_job)
+    std::vector<Index> m_order;
+    // the destination of the duplicates
+    std::vector<Index> m_duplicates;
+};
+
+/** Computes the pattern of the triplets [\a begin,\a end) for \a rows x \a cols matrices of the storage order given
+  * by \a options (ColMajor or RowMajor). Only the row() and col() members of the triplets are read.
+  * \sa SparseMatrix::setFromTriplets(const InputIterators&, const InputIterators&, const TripletPattern<Index>&) */
+template<typename _Index>
+template<typename InputIterators>
+TripletPattern<_Index>& TripletPattern<_Index>::compute(const InputIterators& begin, const InputIterators& end, Index rows, Index cols, int options)
+{
+  m_rows = rows;
+  m_cols = cols;
+  m_isRowMajor = (options&RowMajorBit)==RowMajorBit;
+  typedef typename std::iterator_traits<InputIterators>::iterator_category IteratorCategory;
+  const Index size = Index((std::max)(Index(0),Index(std::distance(begin, end))));
+  const Index outerSize = m_isRowMajor ? rows : cols, innerSize = m_isRowMajor ? cols : rows;
+
+  std::vector<Index> bucketInner(size), bucketOrder(size), ranks(size), sizes(outerSize), bounds;
+  m_outerStarts.resize(outerSize+1);
+  m_outerIndex.resize(outerSize+1);
+  m_order.resize(size);
+  internal::triplets_check_range(begin, end, rows, cols);
+  const Index threads = internal::triplets_threads(size, IteratorCategory());
+  internal::triplets_scatter(begin, size, m_isRowMajor, outerSize, threads, &m_outerStarts[0],
+                             size ? &bucketInner[0] : 0, (internal::triplets_no_value*)0, size ? &bucketOrder[0] : 0);
+
+  internal::parallel_outer_bounds(&m_outerStarts[0], outerSize, threads, bounds);
+  internal::triplets_pattern_job<Index> job(innerSize, &m_outerStarts[0], size ? &bucketInner[0] : 0,
+                                            size ? &bucketOrder[0] : 0, size ? &ranks[0] : 0, &bounds[0],
+                                            outerSize ? &sizes[0] : 0);
+  internal::parallel_for(job, int(threads));
+
+  Index nnz = 0;
+  for(Index j=0; j<outerSize; ++j)
+  {
+    m_outerIndex[j] = nnz;
+    nnz += sizes[j];
+  }
+  m_outerIndex[outerSize] = nnz;
+  m_innerIndices.resize(nnz);
+  m_duplicates.resize(size-nnz);
+
+  job.m_outerIndex = &m_outerIndex[0];
+  job.m_innerIndices = nnz ? &m_innerIndices[0] : 0;
+  job.m_order = size ? &m_order[0] : 0;
+  job.m_duplicates = size>nnz ? &m_duplicates[0] : 0;
+  job.m_phase = job.Order;
+  internal::parallel_for(job, int(threads));
+  return *this;
+}
 
 /** Fill the matrix \c *this with the list of \em triplets defined by the iterator range \a begin - \a end.
   *
@@ -979,15 +1508,73 @@ void set_from_triplets(const InputIterator& begin, const InputIterator& end, Spa
     // m is ready to go!
   * \endcode
   *
-  * \warning The list of triplets is read multiple times (at least twice). Therefore, it is not recommended to define
-  * an abstract iterator over a complex data-structure that would be expensive to evaluate. The triplets should rather
-  * be explicitely stored into a std::vector for instance.
+  * The triplets are bucketed directly into the storage of \c *this, and large lists are processed by several threads,
+  * see Eigen::setNbThreads() and \c EIGEN_SET_FROM_TRIPLETS_MIN_TRIPLETS_PER_THREAD.
+  *
+  * \warning The list of triplets is read multiple times (at least twice), and is processed by a single thread unless
+  * it is given by random access iterators. Therefore, it is not recommended to define an abstract iterator over a
+  * complex data-structure that would be expensive to evaluate. The triplets should rather be explicitely stored into
+  * a std::vector for instance.
+  *
+  * \sa setFromTriplets(const InputIterators&, const InputIterators&, DupFunctor), TripletPattern
   */
 template<typename Scalar, int _Options, typename _Index>
 template<typename InputIterators>
 void SparseMatrix<Scalar,_Options,_Index>::setFromTriplets(const InputIterators& begin, const InputIterators& end)
 {
-  internal::set_from_triplets(begin, end, *this);
+  internal::set_from_triplets(begin, end, *this, internal::scalar_sum_op<Scalar>());
+}
+
+/** The same as setFromTriplets(const InputIterators&, const InputIterators&) but the values of the triplets having
+  * the same (row,col) pair are combined by \a dup_func instead of being summed up: the first value is kept, and each
+  * next one \c v in the order of the list replaces the current value \c x by \c dup_func(x,v).
+  * For instance, the last value of each entry is kept with:
+  * \code
+  * struct keep_last { double operator()(const double&, const double& b) const { return b; } };
+  * m.setFromTriplets(triplets.begin(), triplets.end(), keep_last());
+  * \endcode
+  */
+template<typename Scalar, int _Options, typename _Index>
+template<typename InputIterators,typename DupFunctor>
+void SparseMatrix<Scalar,_Options,_Index>::setFromTriplets(const InputIterators& begin, const InputIterators& end, DupFunctor dup_func)
+{
+  internal::set_from_triplets(begin, end, *this, dup_func);
+}
+
+/** Fills the matrix \c *this with the triplets [\a begin,\a end) whose sparsity pattern \a pattern was computed
+  * beforehand, see TripletPattern. Only the values are read from the triplets, which must hold the same (row,col)
+  * pairs in the same order as those given to TripletPattern::compute(). The matrix is resized to the size of the pattern.
+  * The duplicates are summed up.
+  */
+template<typename Scalar, int _Options, typename _Index>
+template<typename InputIterators>
+void SparseMatrix<Scalar,_Options,_Index>::setFromTriplets(const InputIterators& begin, const InputIterators& end, const TripletPattern<Index>& pattern)
+{
+  setFromTriplets(begin, end, pattern, internal::scalar_sum_op<Scalar>());
+}
+
+/** The same as setFromTriplets(const InputIterators&, const InputIterators&, const TripletPattern<Index>&) but the
+  * duplicates are combined by \a dup_func, see setFromTriplets(const InputIterators&, const InputIterators&, DupFunctor).
+  */
+template<typename Scalar, int _Options, typename _Index>
+template<typename InputIterators,typename DupFunctor>
+void SparseMatrix<Scalar,_Options,_Index>::setFromTriplets(const InputIterators& begin, const InputIterators& end,
+                                                           const TripletPattern<Index>& pattern, DupFunctor dup_func)
+{
+  eigen_assert(pattern.isRowMajor()==bool(IsRowMajor) && "the pattern was computed for the other storage order");
+  typedef typename std::iterator_traits<InputIterators>::iterator_category IteratorCategory;
+  eigen_assert(Index(std::distance(begin, end))==pattern.size() && "the triplets do not match the pattern");
+  resize(pattern.rows(), pattern.cols());
+  if(pattern.nonZeros()==0)
+    return;
+  resizeNonZeros(pattern.nonZeros());
+  std::copy(pattern.m_outerIndex.begin(), pattern.m_outerIndex.end(), m_outerIndex);
+
+  const Index threads = internal::triplets_threads(pattern.size(), IteratorCategory());
+  std::vector<Index> bounds;
+  internal::parallel_outer_bounds(&pattern.m_outerStarts[0], m_outerSize, threads, bounds);
+  internal::parallel_for(internal::triplets_values_job<InputIterators,Index,Scalar,DupFunctor>(
+                           begin, pattern, innerIndexPtr(), valuePtr(), &bounds[0], dup_func), int(threads));
 }
 
 /** \internal */
@@ -0,0 +1,319 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SPARSEPRODUCTPATTERN_H
+#define EIGEN_SPARSEPRODUCTPATTERN_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal The jobs of the symbolic phase of the product \a lhs * \a rhs of two column major matrices, processing
+  * the columns [bounds[i],bounds[i+1]) of the result. The first pass (Count) stores the number of nonzeros of each
+  * column into \a sizes, and the number of multiply-adds required to compute it into \a flops. Once the exact
+  * number of nonzeros of the result is known, the second pass (Fill) stores the sorted inner indices of each column
+  * at \a innerIndices + \a outerIndex[j]. Row major products are computed as the transposed product. */
+template<typename Lhs, typename Rhs, typename Index>
+struct sparse_product_symbolic_job
+{
+  enum Phase { Count, Fill };
+
+  sparse_product_symbolic_job(const Lhs& lhs, const Rhs& rhs, Index innerSize, const Index* bounds, Index* sizes, double* flops)
+    : m_lhs(lhs), m_rhs(rhs), m_innerSize(innerSize), m_bounds(bounds), m_sizes(sizes), m_flops(flops),
+      m_outerIndex(0), m_innerIndices(0), m_phase(Count)
+  {}
+
+  void operator()(int i) const
+  {
+    // marker[k] is j when the inner index k has been met in the column j
+    std::vector<Index> marker(m_innerSize, Index(-1));
+    for(Index j=m_bounds[i]; j<m_bounds[i+1]; ++j)
+    {
+      Index* inner = m_phase==Fill ? m_innerIndices + m_outerIndex[j] : 0;
+      Index nnz = 0;
+      double flops = 0;
+      for(typename Rhs::InnerIterator rhsIt(m_rhs, j); rhsIt; ++rhsIt)
+        for(typename Lhs::InnerIterator lhsIt(m_lhs, rhsIt.index()); lhsIt; ++lhsIt)
+        {
+          const Index k = Index(lhsIt.index());
+          ++flops;
+          if(marker[k]!=j)
+          {
+            marker[k] = j;
+            if(inner) inner[nnz] = k;
+            ++nnz;
+          }
+        }
+      if(m_phase==Count)
+      {
+        m_sizes[j] = nnz;
+        m_flops[j] = flops;
+      }
+      else
+        std::sort(inner, inner+nnz);
+    }
+  }
+
+  const Lhs& m_lhs;
+  const Rhs& m_rhs;
+  Index m_innerSize;
+  const Index* m_bounds;
+  Index* m_sizes;
+  double* m_flops;
+  // Fill
+  const Index* m_outerIndex;
+  Index* m_innerIndices;
+  Phase m_phase;
+};
+
+/** \internal The jobs of the numeric phase of the product \a lhs * \a rhs of two column major matrices, computing the
+  * columns [bounds[i],bounds[i+1]) of the result whose structure \a outerIndex, \a innerIndices is known. Each column
+  * is accumulated into a dense vector, which is gathered and reset through the structure of the column. */
+template<typename Lhs, typename Rhs, typename Index, typename Scalar>
+struct sparse_product_numeric_job
+{
+  sparse_product_numeric_job(const Lhs& lhs, const Rhs& rhs, Index innerSize, const Index* bounds,
+                             const Index* outerIndex, const Index* innerIndices, Scalar* values)
+    : m_lhs(lhs), m_rhs(rhs), m_innerSize(innerSize), m_bounds(bounds),
+      m_outerIndex(outerIndex), m_innerIndices(innerIndices), m_values(values)
+  {}
+
+  void operator()(int i) const
+  {
+    Matrix<Scalar,Dynamic,1> accumulator = Matrix<Scalar,Dynamic,1>::Zero(m_innerSize);
+#ifndef EIGEN_NO_DEBUG
+    // marker[k] is j when the inner index k belongs to the structure of the column j, since an entry of the
+    // accumulator outside of this structure would never be reset
+    std::vector<Index> marker(m_innerSize, Index(-1));
+#endif
+    for(Index j=m_bounds[i]; j<m_bounds[i+1]; ++j)
+    {
+#ifndef EIGEN_NO_DEBUG
+      for(Index p=m_outerIndex[j]; p<m_outerIndex[j+1]; ++p)
+        marker[m_innerIndices[p]] = j;
+#endif
+      for(typename Rhs::InnerIterator rhsIt(m_rhs, j); rhsIt; ++rhsIt)
+      {
+        const Scalar y = rhsIt.value();
+        for(typename Lhs::InnerIterator lhsIt(m_lhs, rhsIt.index()); lhsIt; ++lhsIt)
+        {
+#ifndef EIGEN_NO_DEBUG
+          eigen_assert(marker[lhsIt.index()]==j && "the structure of the operands is not a subset of the analyzed one");
+#endif
+          accumulator.coeffRef(lhsIt.index()) += lhsIt.value() * y;
+        }
+      }
+      for(Index p=m_outerIndex[j]; p<m_outerIndex[j+1]; ++p)
+      {
+        Scalar& x = accumulator.coeffRef(m_innerIndices[p]);
+        m_values[p] = x;
+        x = Scalar(0);
+      }
+    }
+  }
+
+  const Lhs& m_lhs;
+  const Rhs& m_rhs;
+  Index m_innerSize;
+  const Index* m_bounds;
+  const Index* m_outerIndex;
+  const Index* m_innerIndices;
+  Scalar* m_values;
+};
+
+} // end namespace internal
+
+/** \ingroup SparseCore_Module
+  *
+  * \class SparseProductPattern
+  *
+  * \brief The sparsity pattern of a product of two sparse matrices, to compute several products of the same structure
+  *
+  * The product of two sparse matrices is split into a symbolic phase, analyzePattern(), which computes the exact
+  * structure of the result, and a numeric phase, evaluate(), which only computes its values. When the same product is
+  * computed again and again with operands of the same structure, like the Galerkin products R*A*P of a multigrid
+  * method along a simulation, the symbolic phase is done once:
+  * \code
+  * SparseProductPattern<SparseMatrix<double> > AP(A,P), RAP(R,AP.structure());
+  * SparseMatrix<double> ap, rap;
+  * for(...)
+  * {
+  *   // update the values of A
+  *   AP.evaluate(A, P, ap);
+  *   RAP.evaluate(R, ap, rap);
+  * }
+  * \endcode
+  *
+  * Both phases compute the columns (or the rows) of the result in parallel, see Eigen::setNbThreads() and
+  * \c EIGEN_SPARSE_PRODUCT_MIN_WORK_PER_THREAD. The result is always sorted and compressed, and it keeps the
+  * symbolic nonzeros like the default product \c A*B.
+  *
+  * \tparam _MatrixType the type of the result, a SparseMatrix. The operands must have the same storage order.
+  */
+template<typename _MatrixType>
+class SparseProductPattern
+{
+  public:
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::Index Index;
+    enum { IsRowMajor = MatrixType::IsRowMajor };
+
+    /** Default constructor, see analyzePattern() */
+    SparseProductPattern() : m_rows(0), m_cols(0), m_isInitialized(false) {}
+
+    /** Constructs the pattern of the product \a lhs * \a rhs, see analyzePattern() */
+    template<typename Lhs, typename Rhs>
+    SparseProductPattern(const SparseMatrixBase<Lhs>& lhs, const SparseMatrixBase<Rhs>& rhs) : m_isInitialized(false)
+    {
+      analyzePattern(lhs, rhs);
+    }
+
+    /** Computes the exact structure of the product \a lhs * \a rhs, that is the union of the structures of the
+      * products of the structures of the operands. Only the structure of the operands is read. */
+    template<typename Lhs, typename Rhs>
+    SparseProductPattern& analyzePattern(const SparseMatrixBase<Lhs>& lhs, const SparseMatrixBase<Rhs>& rhs)
+    {
+      check_operands(lhs, rhs);
+      m_rows = lhs.rows();
+      m_cols = rhs.cols();
+      if(IsRowMajor)
+        analyze(rhs.derived(), lhs.derived());
+      else
+        analyze(lhs.derived(), rhs.derived());
+      m_isInitialized = true;
+      return *this;
+    }
+
+    /** Computes \a res = \a lhs * \a rhs, where the structures of \a lhs and \a rhs are the ones given to
+      * analyzePattern(), or a subset of them, which is checked in debug mode only. The structure of \a res is the one
+      * computed by analyzePattern(), even where the values vanish. */
+    template<typename Lhs, typename Rhs>
+    void evaluate(const SparseMatrixBase<Lhs>& lhs, const SparseMatrixBase<Rhs>& rhs, MatrixType& res) const
+    {
+      eigen_assert(m_isInitialized && "SparseProductPattern is not initialized.");
+      check_operands(lhs, rhs);
+      eigen_assert(lhs.rows()==m_rows && rhs.cols()==m_cols && "the operands do not match the pattern");
+      res.resize(m_rows, m_cols);
+      if(nonZeros()==0)
+        return;
+      res.resizeNonZeros(nonZeros());
+      std::copy(m_outerIndex.begin(), m_outerIndex.end(), res.outerIndexPtr());
+      std::copy(m_innerIndices.begin(), m_innerIndices.end(), res.innerIndexPtr());
+      if(IsRowMajor)
+        numeric(rhs.derived(), lhs.derived(), res);
+      else
+        numeric(lhs.derived(), rhs.derived(), res);
+    }
+
+    /** \returns the structure of the product as a sparse matrix whose values are set to one, for instance to
+      * analyze a product having this product as operand */
+    MatrixType structure() const
+    {
+      eigen_assert(m_isInitialized && "SparseProductPattern is not initialized.");
+      MatrixType res(m_rows, m_cols);
+      if(nonZeros()>0)
+      {
+        res.resizeNonZeros(nonZeros());
+        std::copy(m_outerIndex.begin(), m_outerIndex.end(), res.outerIndexPtr());
+        std::copy(m_innerIndices.begin(), m_innerIndices.end(), res.innerIndexPtr());
+        Map<Matrix<Scalar,Dynamic,1> >(res.valuePtr(), nonZeros()).setOnes();
+      }
+      return res;
+    }
+
+    /** \returns the number of rows of the product */
+    Index rows() const { return m_rows; }
+    /** \returns the number of columns of the product */
+    Index cols() const { return m_cols; }
+    /** \returns the exact number of nonzeros of the product */
+    Index nonZeros() const { return Index(m_innerIndices.size()); }
+
+  protected:
+    template<typename Lhs, typename Rhs>
+    static void check_operands(const SparseMatrixBase<Lhs>& lhs, const SparseMatrixBase<Rhs>& rhs)
+    {
+      EIGEN_STATIC_ASSERT(int(Lhs::Flags&RowMajorBit)==int(MatrixType::Flags&RowMajorBit)
+                       && int(Rhs::Flags&RowMajorBit)==int(MatrixType::Flags&RowMajorBit),
+                          BOTH_MATRICES_MUST_HAVE_THE_SAME_STORAGE_ORDER)
+      EIGEN_STATIC_ASSERT((internal::is_same<typename Lhs::Scalar,Scalar>::value && internal::is_same<typename Rhs::Scalar,Scalar>::value),
+                          YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+      eigen_assert(lhs.cols()==rhs.rows() && "invalid matrix product");
+      EIGEN_ONLY_USED_FOR_DEBUG(lhs);
+      EIGEN_ONLY_USED_FOR_DEBUG(rhs);
+    }
+
+    // computes the structure of lhs * rhs seen as column major matrices
+    template<typename Lhs, typename Rhs>
+    void analyze(const Lhs& lhs, const Rhs& rhs)
+    {
+      const Index outerSize = Index(rhs.outerSize()), innerSize = Index(lhs.innerSize());
+
+      // pass 1: count the nonzeros and the multiply-adds per outer vector, by chunks of the nonzeros of the rhs
+      std::vector<Index> bounds, sizes(outerSize);
+      m_flops.resize(outerSize+1);
+      const typename Rhs::Index* rhsOuterIndex = internal::sparse_outer_index_ptr(rhs);
+      for(Index j=0; j<=outerSize; ++j)
+        m_flops[j] = rhsOuterIndex ? double(rhsOuterIndex[j]) : double(j);
+      double work = double(rhs.nonZeros()) * double(lhs.nonZeros()) / double((std::max)(Index(1),Index(lhs.outerSize())));
+      Index threads = internal::sparse_product_threads(work, outerSize);
+      internal::parallel_outer_bounds(&m_flops[0], outerSize, threads, bounds);
+      typedef internal::sparse_product_symbolic_job<Lhs,Rhs,Index> Job;
+      Job job(lhs, rhs, innerSize, &bounds[0], outerSize ? &sizes[0] : 0, &m_flops[0]);
+      internal::parallel_for(job, int(threads));
+
+      // turn the counts into offsets
+      m_outerIndex.resize(outerSize+1);
+      Index nnz = 0;
+      double total = 0;
+      for(Index j=0; j<outerSize; ++j)
+      {
+        m_outerIndex[j] = nnz;
+        nnz += sizes[j];
+        double flops = m_flops[j];
+        m_flops[j] = total;
+        total += flops;
+      }
+      m_outerIndex[outerSize] = nnz;
+      m_flops[outerSize] = total;
+      m_innerIndices.resize(nnz);
+
+      // pass 2: fill and sort the inner indices, by chunks of the same number of multiply-adds
+      if(nnz>0)
+      {
+        threads = internal::sparse_product_threads(total, outerSize);
+        internal::parallel_outer_bounds(&m_flops[0], outerSize, threads, bounds);
+        job.m_bounds = &bounds[0];
+        job.m_outerIndex = &m_outerIndex[0];
+        job.m_innerIndices = &m_innerIndices[0];
+        job.m_phase = Job::Fill;
+        internal::parallel_for(job, int(threads));
+      }
+    }
+
+    template<typename Lhs, typename Rhs>
+    void numeric(const Lhs& lhs, const Rhs& rhs, MatrixType& res) const
+    {
+      const Index outerSize = Index(m_outerIndex.size()-1);
+      const Index threads = internal::sparse_product_threads(m_flops[outerSize], outerSize);
+      std::vector<Index> bounds;
+      internal::parallel_outer_bounds(&m_flops[0], outerSize, threads, bounds);
+      internal::parallel_for(internal::sparse_product_numeric_job<Lhs,Rhs,Index,Scalar>(
+                               lhs, rhs, Index(lhs.innerSize()), &bounds[0], res.outerIndexPtr(), res.innerIndexPtr(), res.valuePtr()),
+                             int(threads));
+    }
+
+    Index m_rows, m_cols;
+    std::vector<Index> m_outerIndex, m_innerIndices;
+    // the number of multiply-adds required to compute the outer vectors [0,j) of the product
+    std::vector<double> m_flops;
+    bool m_isInitialized;
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_SPARSEPRODUCTPATTERN_H
@@ -14,6 +14,11 @@
 
 namespace Eigen {
 
+#ifndef EIGEN_SPARSELU_MIN_NONZEROS_PER_THREAD
+/** \internal The minimal number of nonzeros of the matrix for each thread of a parallel factorization */
+#define EIGEN_SPARSELU_MIN_NONZEROS_PER_THREAD 5000
+#endif
+
 template <typename _MatrixType, typename _OrderingType> class SparseLU;
 template <typename MappedSparseMatrixType> struct SparseLUMatrixLReturnType;
 template <typename MatrixLType, typename MatrixUType> struct SparseLUMatrixUReturnType;
@@ -85,11 +90,11 @@ class SparseLU : public internal::SparseLUImpl<typename _MatrixType::Scalar, typ
     typedef internal::SparseLUImpl<Scalar, Index> Base;
     
   public:
-    SparseLU():m_isInitialized(true),m_lastError(""),m_Ustore(0,0,0,0,0,0),m_symmetricmode(false),m_diagpivotthresh(1.0),m_detPermR(1)
+    SparseLU():m_isInitialized(true),m_lastError(""),m_Ustore(0,0,0,0,0,0),m_symmetricmode(false),m_diagpivotthresh(1.0),m_detPermR(1),m_nbThreads(0)
     {
       initperfvalues(); 
     }
-    SparseLU(const MatrixType& matrix):m_isInitialized(true),m_lastError(""),m_Ustore(0,0,0,0,0,0),m_symmetricmode(false),m_diagpivotthresh(1.0),m_detPermR(1)
+    SparseLU(const MatrixType& matrix):m_isInitialized(true),m_lastError(""),m_Ustore(0,0,0,0,0,0),m_symmetricmode(false),m_diagpivotthresh(1.0),m_detPermR(1),m_nbThreads(0)
     {
       initperfvalues(); 
       compute(matrix);
@@ -166,6 +171,15 @@ class SparseLU : public internal::SparseLUImpl<typename _MatrixType::Scalar, typ
     {
       m_diagpivotthresh = thresh; 
     }
+    
+    /** Sets the maximal number of threads used by factorize() to \a nbThreads.
+      * The independent subtrees of the column elimination tree are then factorized concurrently.
+      * The default value 0 means Eigen::nbThreads(), and 1 disables the parallel factorization.
+      * Small matrices are always factorized sequentially, see \c EIGEN_SPARSELU_MIN_NONZEROS_PER_THREAD. */
+    void setNbThreads(Index nbThreads)
+    {
+      m_nbThreads = nbThreads;
+    }
 
     /** \returns the solution X of \f$ A X = B \f$ using the current decomposition of A.
       *
@@ -310,7 +324,34 @@ class SparseLU : public internal::SparseLUImpl<typename _MatrixType::Scalar, typ
      }
 
   protected:
+    typedef typename Base::GlobalLU_t GlobalLU_t;
+    typedef internal::LU_Workspace<IndexVector, ScalarVector> Workspace;
+    typedef internal::LU_SubtreeRange<Index> SubtreeRange;
+    
+    // The factorization of the independent subtrees assigned to a thread
+    struct SubtreeTask
+    {
+      SubtreeTask(SparseLU& lu, std::vector<SubtreeRange>& ranges, const IndexVector& relax_end, PermutationType& iperm_c,
+                  std::vector<GlobalLU_t>& glus, std::vector<Workspace>& workspaces, std::vector<std::string>& errors)
+        : m_lu(lu), m_ranges(ranges), m_relax_end(relax_end), m_iperm_c(iperm_c), m_glus(glus), m_workspaces(workspaces), m_errors(errors)
+      {}
+      void operator()(int t) const;
+      
+      SparseLU& m_lu;
+      std::vector<SubtreeRange>& m_ranges;
+      const IndexVector& m_relax_end;
+      PermutationType& m_iperm_c;
+      std::vector<GlobalLU_t>& m_glus;
+      std::vector<Workspace>& m_workspaces;
+      std::vector<std::string>& m_errors;
+    };
+    
     // Functions 
+    void initWorkspace(Workspace& ws);
+    bool factorizeColumns(Index first, Index end, const IndexVector& relax_end, PermutationType& iperm_c, GlobalLU_t& glu, Workspace& ws, std::string& lastError);
+    Index independentSubtrees(std::vector<SubtreeRange>& ranges);
+    bool copySubtreeRange(const SubtreeRange& range, GlobalLU_t& glu, const IndexVector& xprune, IndexVector& global_xprune);
+    
     void initperfvalues()
     {
       m_perfv.panel_size = 1;
@@ -343,6 +384,7 @@ class SparseLU : public internal::SparseLUImpl<typename _MatrixType::Scalar, typ
     RealScalar m_diagpivotthresh; // Specifies the threshold used for a diagonal entry to be an acceptable pivot
     Index m_nnzL, m_nnzU; // Nonzeros in L and U factors 
     Index m_detPermR; // Determinant of the coefficient matrix
+    Index m_nbThreads; // Maximal number of threads of the factorization, 0 for the default
   private:
     // Disable copy constructor 
     SparseLU (const SparseLU& );
@@ -409,6 +451,10 @@ void SparseLU<MatrixType, OrderingType>::analyzePattern(const MatrixType& mat)
     if(m_perm_c.size()) {
       m_perm_c = post_perm * m_perm_c;
     }
+    else {
+      // the elimination tree has been renumbered, so the columns have to follow
+      m_perm_c = post_perm;
+    }
     
   } // end postordering 
   
@@ -468,7 +514,6 @@ void SparseLU<MatrixType, OrderingType>::factorize(const MatrixType& matrix)
   Index m = m_mat.rows();
   Index n = m_mat.cols();
   Index nnz = m_mat.nonZeros();
-  Index maxpanel = m_perfv.panel_size * m;
   // Allocate working storage common to the factor routines
   Index lwork = 0;
   Index info = Base::memInit(m, n, nnz, lwork, m_perfv.fillfactor, m_perfv.panel_size, m_glu); 
@@ -479,23 +524,9 @@ void SparseLU<MatrixType, OrderingType>::factorize(const MatrixType& matrix)
     return ; 
   }
   
-  // Set up pointers for integer working arrays 
-  IndexVector segrep(m); segrep.setZero();
-  IndexVector parent(m); parent.setZero();
-  IndexVector xplore(m); xplore.setZero();
-  IndexVector repfnz(maxpanel);
-  IndexVector panel_lsub(maxpanel);
-  IndexVector xprune(n); xprune.setZero();
-  IndexVector marker(m*internal::LUNoMarker); marker.setZero();
-  
-  repfnz.setConstant(-1); 
-  panel_lsub.setConstant(-1);
-  
-  // Set up pointers for scalar working arrays 
-  ScalarVector dense; 
-  dense.setZero(maxpanel);
-  ScalarVector tempv; 
-  tempv.setZero(internal::LUnumTempV(m, m_perfv.panel_size, m_perfv.maxsuper, /*m_perfv.rowblk*/m) );
+  // Set up the working arrays
+  Workspace ws;
+  initWorkspace(ws);
   
   // Compute the inverse of perm_c
   PermutationType iperm_c(m_perm_c.inverse()); 
@@ -503,34 +534,128 @@ void SparseLU<MatrixType, OrderingType>::factorize(const MatrixType& matrix)
   // Identify initial relaxed snodes
   IndexVector relax_end(n);
   if ( m_symmetricmode == true ) 
-    Base::heap_relax_snode(n, m_etree, m_perfv.relax, marker, relax_end);
+    Base::heap_relax_snode(n, m_etree, m_perfv.relax, ws.marker, relax_end);
   else
-    Base::relax_snode(n, m_etree, m_perfv.relax, marker, relax_end);
+    Base::relax_snode(n, m_etree, m_perfv.relax, ws.marker, relax_end);
   
   
   m_perm_r.resize(m); 
   m_perm_r.indices().setConstant(-1);
-  marker.setConstant(-1);
+  ws.marker.setConstant(-1);
   m_detPermR = 1.0; // Record the determinant of the row permutation
   
   m_glu.supno(0) = emptyIdxLU; m_glu.xsup.setConstant(0);
   m_glu.xsup(0) = m_glu.xlsub(0) = m_glu.xusub(0) = m_glu.xlusup(0) = Index(0);
   
+  // The columns of independent subtrees of the column elimination tree only depend on each other, and their
+  // candidate pivot rows are disjoint. Those subtrees are first factorized in parallel, each thread using its
+  // own storage and working arrays. The remaining columns, close to the roots of the tree, are then factorized
+  // in order, while the factors of the subtrees are copied to the global storage.
+  std::vector<SubtreeRange> ranges;
+  Index threads = independentSubtrees(ranges);
+  std::vector<GlobalLU_t> glus(threads);
+  std::vector<Workspace> workspaces(threads);
+  std::vector<std::string> errors(threads);
+  if (threads > 1)
+  {
+    internal::parallel_for(SubtreeTask(*this, ranges, relax_end, iperm_c, glus, workspaces, errors), int(threads));
+    for (Index t = 0; t < threads; ++t)
+    {
+      if (!errors[t].empty())
+      {
+        m_lastError = errors[t];
+        m_info = NumericalIssue; 
+        m_factorizationIsOk = false; 
+        return; 
+      }
+      ws.marker = ws.marker.cwiseMax(workspaces[t].marker);
+      if (workspaces[t].detPermR < 0) m_detPermR *= -1;
+    }
+  }
+  
+  std::size_t r = 0;
+  for (Index jcol = 0; jcol < n; )
+  {
+    if (r < ranges.size() && ranges[r].first == jcol)
+    {
+      if (!copySubtreeRange(ranges[r], glus[ranges[r].thread], workspaces[ranges[r].thread].xprune, ws.xprune))
+      {
+        m_lastError = "UNABLE TO EXPAND MEMORY WHILE COPYING THE FACTORS OF A SUBTREE ";
+        m_info = NumericalIssue; 
+        m_factorizationIsOk = false; 
+        return; 
+      }
+      jcol = ranges[r++].last + 1;
+    }
+    else
+    {
+      Index end = r < ranges.size() ? ranges[r].first : n;
+      if (!factorizeColumns(jcol, end, relax_end, iperm_c, m_glu, ws, m_lastError))
+      {
+        m_info = NumericalIssue; 
+        m_factorizationIsOk = false; 
+        return; 
+      }
+      jcol = end;
+    }
+  }
+  if (ws.detPermR < 0) m_detPermR *= -1;
+  
+  // Count the number of nonzeros in factors 
+  Base::countnz(n, m_nnzL, m_nnzU, m_glu); 
+  // Apply permutation  to the L subscripts 
+  Base::fixupL(n, m_perm_r.indices(), m_glu); 
+  
+  // Create supernode matrix L 
+  m_Lstore.setInfos(m, n, m_glu.lusup, m_glu.xlusup, m_glu.lsub, m_glu.xlsub, m_glu.supno, m_glu.xsup); 
+  // Create the column major upper sparse matrix  U; 
+  new (&m_Ustore) MappedSparseMatrix<Scalar, ColMajor, Index> ( m, n, m_nnzU, m_glu.xusub.data(), m_glu.usub.data(), m_glu.ucol.data() ); 
+  
+  m_info = Success;
+  m_factorizationIsOk = true;
+}
+
+/** \internal Allocates the working arrays of the factorization */
+template <typename MatrixType, typename OrderingType>
+void SparseLU<MatrixType, OrderingType>::initWorkspace(Workspace& ws)
+{
+  Index m = m_mat.rows();
+  Index maxpanel = m_perfv.panel_size * m;
+  ws.segrep.setZero(m);
+  ws.parent.setZero(m);
+  ws.xplore.setZero(m);
+  ws.repfnz.setConstant(maxpanel, -1);
+  ws.panel_lsub.setConstant(maxpanel, -1);
+  ws.xprune.setZero(m_mat.cols());
+  ws.marker.setZero(m*internal::LUNoMarker);
+  ws.dense.setZero(maxpanel);
+  ws.tempv.setZero(internal::LUnumTempV(m, m_perfv.panel_size, m_perfv.maxsuper, /*m_perfv.rowblk*/m) );
+  ws.detPermR = 1;
+}
+
+/** \internal Factorizes the columns [\a first, \a end) in \a glu, where all the columns they depend on have already been factorized.
+  * \returns false on failure, with an error message in \a lastError */
+template <typename MatrixType, typename OrderingType>
+bool SparseLU<MatrixType, OrderingType>::factorizeColumns(Index first, Index end, const IndexVector& relax_end, PermutationType& iperm_c, GlobalLU_t& glu, Workspace& ws, std::string& lastError)
+{
+  using internal::emptyIdxLU;
+  Index m = m_mat.rows();
+  Index info;
+  
   // Work on one 'panel' at a time. A panel is one of the following :
   //  (a) a relaxed supernode at the bottom of the etree, or
   //  (b) panel_size contiguous columns, <panel_size> defined by the user
   Index jcol; 
-  IndexVector panel_histo(n);
   Index pivrow; // Pivotal row number in the original row matrix
   Index nseg1; // Number of segments in U-column above panel row jcol
   Index nseg; // Number of segments in each U-column 
   Index irep; 
   Index i, k, jj; 
-  for (jcol = 0; jcol < n; )
+  for (jcol = first; jcol < end; )
   {
     // Adjust panel size so that a panel won't overlap with the next relaxed snode. 
     Index panel_size = m_perfv.panel_size; // upper bound on panel width
-    for (k = jcol + 1; k < (std::min)(jcol+panel_size, n); k++)
+    for (k = jcol + 1; k < (std::min)(jcol+panel_size, end); k++)
     {
       if (relax_end(k) != emptyIdxLU) 
       {
@@ -538,14 +663,14 @@ void SparseLU<MatrixType, OrderingType>::factorize(const MatrixType& matrix)
         break; 
       }
     }
-    if (k == n) 
-      panel_size = n - jcol; 
+    if (k == end) 
+      panel_size = end - jcol; 
       
     // Symbolic outer factorization on a panel of columns 
-    Base::panel_dfs(m, panel_size, jcol, m_mat, m_perm_r.indices(), nseg1, dense, panel_lsub, segrep, repfnz, xprune, marker, parent, xplore, m_glu); 
+    Base::panel_dfs(m, panel_size, jcol, m_mat, m_perm_r.indices(), nseg1, ws.dense, ws.panel_lsub, ws.segrep, ws.repfnz, ws.xprune, ws.marker, ws.parent, ws.xplore, glu); 
     
     // Numeric sup-panel updates in topological order 
-    Base::panel_bmod(m, panel_size, jcol, nseg1, dense, tempv, segrep, repfnz, m_glu); 
+    Base::panel_bmod(m, panel_size, jcol, nseg1, ws.dense, ws.tempv, ws.segrep, ws.repfnz, glu); 
     
     // Sparse LU within the panel, and below the panel diagonal 
     for ( jj = jcol; jj< jcol + panel_size; jj++) 
@@ -554,79 +679,232 @@ void SparseLU<MatrixType, OrderingType>::factorize(const MatrixType& matrix)
       
       nseg = nseg1; // begin after all the panel segments
       //Depth-first-search for the current column
-      VectorBlock<IndexVector> panel_lsubk(panel_lsub, k, m);
-      VectorBlock<IndexVector> repfnz_k(repfnz, k, m); 
-      info = Base::column_dfs(m, jj, m_perm_r.indices(), m_perfv.maxsuper, nseg, panel_lsubk, segrep, repfnz_k, xprune, marker, parent, xplore, m_glu); 
+      VectorBlock<IndexVector> panel_lsubk(ws.panel_lsub, k, m);
+      VectorBlock<IndexVector> repfnz_k(ws.repfnz, k, m); 
+      info = Base::column_dfs(m, jj, m_perm_r.indices(), m_perfv.maxsuper, nseg, panel_lsubk, ws.segrep, repfnz_k, ws.xprune, ws.marker, ws.parent, ws.xplore, glu); 
       if ( info ) 
       {
-        m_lastError =  "UNABLE TO EXPAND MEMORY IN COLUMN_DFS() ";
-        m_info = NumericalIssue; 
-        m_factorizationIsOk = false; 
-        return; 
+        lastError =  "UNABLE TO EXPAND MEMORY IN COLUMN_DFS() ";
+        return false; 
       }
       // Numeric updates to this column 
-      VectorBlock<ScalarVector> dense_k(dense, k, m); 
-      VectorBlock<IndexVector> segrep_k(segrep, nseg1, m-nseg1); 
-      info = Base::column_bmod(jj, (nseg - nseg1), dense_k, tempv, segrep_k, repfnz_k, jcol, m_glu); 
+      VectorBlock<ScalarVector> dense_k(ws.dense, k, m); 
+      VectorBlock<IndexVector> segrep_k(ws.segrep, nseg1, m-nseg1); 
+      info = Base::column_bmod(jj, (nseg - nseg1), dense_k, ws.tempv, segrep_k, repfnz_k, jcol, glu); 
       if ( info ) 
       {
-        m_lastError = "UNABLE TO EXPAND MEMORY IN COLUMN_BMOD() ";
-        m_info = NumericalIssue; 
-        m_factorizationIsOk = false; 
-        return; 
+        lastError = "UNABLE TO EXPAND MEMORY IN COLUMN_BMOD() ";
+        return false; 
       }
       
       // Copy the U-segments to ucol(*)
-      info = Base::copy_to_ucol(jj, nseg, segrep, repfnz_k ,m_perm_r.indices(), dense_k, m_glu); 
+      info = Base::copy_to_ucol(jj, nseg, ws.segrep, repfnz_k ,m_perm_r.indices(), dense_k, glu); 
       if ( info ) 
       {
-        m_lastError = "UNABLE TO EXPAND MEMORY IN COPY_TO_UCOL() ";
-        m_info = NumericalIssue; 
-        m_factorizationIsOk = false; 
-        return; 
+        lastError = "UNABLE TO EXPAND MEMORY IN COPY_TO_UCOL() ";
+        return false; 
       }
       
       // Form the L-segment 
-      info = Base::pivotL(jj, m_diagpivotthresh, m_perm_r.indices(), iperm_c.indices(), pivrow, m_glu);
+      info = Base::pivotL(jj, m_diagpivotthresh, m_perm_r.indices(), iperm_c.indices(), pivrow, glu);
       if ( info ) 
       {
-        m_lastError = "THE MATRIX IS STRUCTURALLY SINGULAR ... ZERO COLUMN AT ";
+        lastError = "THE MATRIX IS STRUCTURALLY SINGULAR ... ZERO COLUMN AT ";
         std::ostringstream returnInfo;
         returnInfo << info; 
-        m_lastError += returnInfo.str();
-        m_info = NumericalIssue; 
-        m_factorizationIsOk = false; 
-        return; 
+        lastError += returnInfo.str();
+        return false; 
       }
       
       // Update the determinant of the row permutation matrix
-      if (pivrow != jj) m_detPermR *= -1;
+      if (pivrow != jj) ws.detPermR *= -1;
 
       // Prune columns (0:jj-1) using column jj
-      Base::pruneL(jj, m_perm_r.indices(), pivrow, nseg, segrep, repfnz_k, xprune, m_glu); 
+      Base::pruneL(jj, m_perm_r.indices(), pivrow, nseg, ws.segrep, repfnz_k, ws.xprune, glu); 
       
       // Reset repfnz for this column 
       for (i = 0; i < nseg; i++)
       {
-        irep = segrep(i); 
+        irep = ws.segrep(i); 
         repfnz_k(irep) = emptyIdxLU; 
       }
     } // end SparseLU within the panel  
     jcol += panel_size;  // Move to the next panel
   } // end for -- end elimination 
+  return true;
+}
+
+/** \internal Splits the column elimination tree into independent subtrees which can be factorized in parallel,
+  * and assigns them to the threads.
+  * \returns the number of threads, 1 if the factorization has to be sequential */
+template <typename MatrixType, typename OrderingType>
+typename SparseLU<MatrixType, OrderingType>::Index SparseLU<MatrixType, OrderingType>::independentSubtrees(std::vector<SubtreeRange>& ranges)
+{
+  Index n = m_mat.cols();
+  Index threads = m_nbThreads > 0 ? m_nbThreads : Index(internal::parallel_max_threads());
+  threads = (std::min)(threads, Index(m_mat.nonZeros() / EIGEN_SPARSELU_MIN_NONZEROS_PER_THREAD));
+  if (threads < 2 || m_etree.size() < n)
+    return 1;
   
-  // Count the number of nonzeros in factors 
-  Base::countnz(n, m_nnzL, m_nnzU, m_glu); 
-  // Apply permutation  to the L subscripts 
-  Base::fixupL(n, m_perm_r.indices(), m_glu); 
+  // The subtrees must be made of consecutive columns, that is the elimination tree must be postordered
+  IndexVector first(n), size(n), weight(n);
+  Index total = 0;
+  for (Index j = 0; j < n; ++j)
+  {
+    first(j) = j;
+    size(j) = 1;
+    weight(j) = 1 + (m_mat.isCompressed() ? m_mat.outerIndexPtr()[j+1] - m_mat.outerIndexPtr()[j] : m_mat.innerNonZeroPtr()[j]);
+    total += weight(j);
+  }
+  for (Index j = 0; j < n; ++j)
+  {
+    Index p = m_etree(j);
+    if (p < j || (p > n)) 
+      return 1;
+    if (size(j) != j - first(j) + 1)
+      return 1;
+    if (p < n)
+    {
+      size(p) += size(j);
+      weight(p) += weight(j);
+      first(p) = (std::min)(first(p), first(j));
+    }
+  }
   
-  // Create supernode matrix L 
-  m_Lstore.setInfos(m, n, m_glu.lusup, m_glu.xlusup, m_glu.lsub, m_glu.xlsub, m_glu.supno, m_glu.xsup); 
-  // Create the column major upper sparse matrix  U; 
-  new (&m_Ustore) MappedSparseMatrix<Scalar, ColMajor, Index> ( m, n, m_nnzU, m_glu.xusub.data(), m_glu.usub.data(), m_glu.ucol.data() ); 
+  // The roots of the subtrees are the nodes whose parent is too heavy to be part of a subtree.
+  // Consecutive subtrees are grouped as long as the weight of the group remains small enough.
+  Index maxWeight = total / (2*threads);
+  ranges.clear();
+  for (Index j = 0; j < n; ++j)
+  {
+    Index p = m_etree(j);
+    if (weight(j) > maxWeight || (p < n && weight(p) <= maxWeight))
+      continue;
+    if (!ranges.empty() && ranges.back().last+1 == first(j) && ranges.back().weight + weight(j) <= maxWeight)
+    {
+      ranges.back().last = j;
+      ranges.back().weight += weight(j);
+    }
+    else
+    {
+      SubtreeRange range;
+      range.first = first(j);
+      range.last = j;
+      range.weight = weight(j);
+      ranges.push_back(range);
+    }
+  }
+  if (Index(ranges.size()) < 2)
+  {
+    ranges.clear();
+    return 1;
+  }
   
-  m_info = Success;
-  m_factorizationIsOk = true;
+  // The heaviest ranges are assigned first, each one to the least loaded thread
+  threads = (std::min)(threads, Index(ranges.size()));
+  std::vector<std::pair<Index,Index> > order(ranges.size());
+  for (std::size_t r = 0; r < ranges.size(); ++r)
+    order[r] = std::make_pair(-ranges[r].weight, Index(r));
+  std::sort(order.begin(), order.end());
+  std::vector<Index> load(threads, 0);
+  for (std::size_t r = 0; r < order.size(); ++r)
+  {
+    Index t = Index(std::min_element(load.begin(), load.end()) - load.begin());
+    ranges[order[r].second].thread = t;
+    load[t] += ranges[order[r].second].weight;
+  }
+  return threads;
+}
+
+/** \internal Factorizes the ranges of independent subtrees assigned to the thread \a t */
+template <typename MatrixType, typename OrderingType>
+void SparseLU<MatrixType, OrderingType>::SubtreeTask::operator()(int t) const
+{
+  using internal::emptyIdxLU;
+  SparseLU& lu = m_lu;
+  Index n = lu.m_mat.cols();
+  GlobalLU_t& glu = m_glus[t];
+  Workspace& ws = m_workspaces[t];
+  lu.initWorkspace(ws);
+  ws.marker.setConstant(-1);
+  
+  // The storage is sized from the number of nonzeros of the columns of this thread
+  Index annz = 0;
+  for (std::size_t r = 0; r < m_ranges.size(); ++r)
+    if (m_ranges[r].thread == t)
+      annz += m_ranges[r].weight;
+  if (lu.memInit(lu.m_mat.rows(), n, annz, 0, lu.m_perfv.fillfactor, lu.m_perfv.panel_size, glu))
+  {
+    m_errors[t] = "UNABLE TO ALLOCATE WORKING MEMORY\n\n";
+    return;
+  }
+  
+  Index nextl = 0, nextlu = 0, nextu = 0;
+  for (std::size_t r = 0; r < m_ranges.size(); ++r)
+  {
+    SubtreeRange& range = m_ranges[r];
+    if (range.thread != t)
+      continue;
+    // the first column starts a new numbering of the supernodes, see column_dfs()
+    range.lsub = glu.xlsub(range.first) = nextl;
+    range.lusup = glu.xlusup(range.first) = nextlu;
+    range.usub = glu.xusub(range.first) = nextu;
+    glu.supno(range.first) = emptyIdxLU;
+    if (!lu.factorizeColumns(range.first, range.last+1, m_relax_end, m_iperm_c, glu, ws, m_errors[t]))
+      return;
+    nextl = glu.xlsub(range.last+1);
+    nextlu = glu.xlusup(range.last+1);
+    nextu = glu.xusub(range.last+1);
+  }
+}
+
+/** \internal Copies the factors of the columns of \a range from the storage \a glu of a thread to the global storage,
+  * renumbering the supernodes and shifting the pointers */
+template <typename MatrixType, typename OrderingType>
+bool SparseLU<MatrixType, OrderingType>::copySubtreeRange(const SubtreeRange& range, GlobalLU_t& glu, const IndexVector& xprune, IndexVector& global_xprune)
+{
+  using internal::emptyIdxLU;
+  const Index first = range.first, last = range.last;
+  // the number of the first supernode, and the offsets of the pointers
+  const Index super = m_glu.supno(first) == emptyIdxLU ? 0 : m_glu.supno(first) + 1;
+  const Index lastSuper = glu.supno(last);
+  const Index dl = m_glu.xlsub(first) - range.lsub;
+  const Index dlu = m_glu.xlusup(first) - range.lusup;
+  const Index du = m_glu.xusub(first) - range.usub;
+  const Index nextl = glu.xlsub(last+1), nextlu = glu.xlusup(last+1), nextu = glu.xusub(last+1);
+  
+  // make sure the global storage is large enough
+  while (nextl + dl > m_glu.nzlmax)
+    if (Base::memXpand(m_glu.lsub, m_glu.nzlmax, m_glu.xlsub(first), internal::LSUB, m_glu.num_expansions))
+      return false;
+  while (nextlu + dlu > m_glu.nzlumax)
+    if (Base::memXpand(m_glu.lusup, m_glu.nzlumax, m_glu.xlusup(first), internal::LUSUP, m_glu.num_expansions))
+      return false;
+  while (nextu + du > m_glu.nzumax)
+  {
+    if (Base::memXpand(m_glu.ucol, m_glu.nzumax, m_glu.xusub(first), internal::UCOL, m_glu.num_expansions))
+      return false;
+    if (Base::memXpand(m_glu.usub, m_glu.nzumax, m_glu.xusub(first), internal::USUB, m_glu.num_expansions))
+      return false;
+  }
+  
+  m_glu.lsub.segment(m_glu.xlsub(first), nextl - range.lsub) = glu.lsub.segment(range.lsub, nextl - range.lsub);
+  m_glu.lusup.segment(m_glu.xlusup(first), nextlu - range.lusup) = glu.lusup.segment(range.lusup, nextlu - range.lusup);
+  m_glu.usub.segment(m_glu.xusub(first), nextu - range.usub) = glu.usub.segment(range.usub, nextu - range.usub);
+  m_glu.ucol.segment(m_glu.xusub(first), nextu - range.usub) = glu.ucol.segment(range.usub, nextu - range.usub);
+  for (Index j = first; j <= last; ++j)
+  {
+    m_glu.supno(j) = glu.supno(j) - first + super;
+    m_glu.xlsub(j+1) = glu.xlsub(j+1) + dl;
+    m_glu.xlusup(j+1) = glu.xlusup(j+1) + dlu;
+    m_glu.xusub(j+1) = glu.xusub(j+1) + du;
+    global_xprune(j) = xprune(j) + dl;
+  }
+  for (Index s = first; s <= lastSuper; ++s)
+    m_glu.xsup(s - first + super) = glu.xsup(s);
+  m_glu.xsup(lastSuper - first + super + 1) = last + 1;
+  m_glu.supno(last+1) = lastSuper - first + super;
+  return true;
 }
 
 template<typename MappedSupernodalType>
@@ -140,7 +140,8 @@ Index SparseLUImpl<Scalar,Index>::memInit(Index m, Index n, Index annz, Index lw
 {
   Index& num_expansions = glu.num_expansions; //No memory expansions so far
   num_expansions = 0; 
-  glu.nzumax = glu.nzlumax = (std::max)(fillratio * annz, m*n); // estimated number of nonzeros in U 
+  // estimated number of nonzeros in U, at most dense, and at least one per column
+  glu.nzumax = glu.nzlumax = (std::max)(Index(1), (std::min)(fillratio * (annz+1) / n, m)) * n;
   glu.nzlmax  = (std::max)(1., fillratio/4.) * annz; // estimated  nnz in L factor
 
   // Return the estimated size to the user if necessary
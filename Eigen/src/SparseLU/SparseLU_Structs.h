@@ -92,6 +92,32 @@ struct LU_GlobalLU_t {
   Index   num_expansions; 
 };
 
+// Working arrays of the factorization of a range of columns. A parallel factorization uses one set per thread.
+template <typename IndexVector, typename ScalarVector>
+struct LU_Workspace {
+  typedef typename IndexVector::Scalar Index;
+  IndexVector segrep; // Segment representatives of the current column
+  IndexVector parent; // Stack of the depth-first searches
+  IndexVector xplore; // Stack of the depth-first searches
+  IndexVector repfnz; // First nonzero location of each segment of the panel
+  IndexVector panel_lsub; // Row indices of the panel
+  IndexVector xprune; // Pointers to the pruned structure of the columns of L
+  IndexVector marker; // Markers of the depth-first searches
+  ScalarVector dense; // Numerical values of the panel
+  ScalarVector tempv; // Temporary for the dense updates
+  Index detPermR; // Sign of the row interchanges
+};
+
+// A range of consecutive columns made of independent subtrees of the column elimination tree.
+// They are factorized by a single thread in the storage of that thread, and then copied to the global one.
+template <typename Index>
+struct LU_SubtreeRange {
+  Index first, last; // the columns [first, last]
+  Index weight; // estimation of the cost of the factorization
+  Index thread;
+  Index lsub, lusup, usub; // where the range starts in the storage of the thread
+};
+
 // Values to set for performance
 template <typename Index>
 struct perfvalues {
@@ -120,9 +120,11 @@ Index SparseLUImpl<Scalar,Index>::column_dfs(const Index m, const Index jcol, In
   Index jcolm1 = jcol - 1;
   
   // check to see if j belongs in the same supernode as j-1
-  if ( jcol == 0 )
-  { // Do nothing for column 0 
-    nsuper = glu.supno(0) = 0 ;
+  if ( nsuper == emptyIdxLU )
+  { // Do nothing for column 0, or for the first column of an independent subtree:
+    // its supernodes are numbered from jcol in the private storage of the thread
+    nsuper = glu.supno(jcol) = jcol;
+    glu.xsup(nsuper) = jcol;
   }
   else 
   {
@@ -131,8 +131,67 @@ tan() const
   return derived();
 }
 
+/** \returns an expression of the coefficient-wise arc tangent of *this.
+  *
+  * Example: \include Cwise_atan.cpp
+  * Output: \verbinclude Cwise_atan.out
+  *
+  * \sa tan(), atan2()
+  */
+inline const CwiseUnaryOp<internal::scalar_atan_op<Scalar>, const Derived>
+atan() const
+{
+  return derived();
+}
+
+/** \returns an expression of the coefficient-wise hyperbolic tangent of *this.
+  *
+  * Example: \include Cwise_tanh.cpp
+  * Output: \verbinclude Cwise_tanh.out
+  *
+  * \sa logistic(), exp()
+  */
+inline const CwiseUnaryOp<internal::scalar_tanh_op<Scalar>, const Derived>
+tanh() const
+{
+  return derived();
+}
+
+/** \returns an expression of the coefficient-wise logistic function 1/(1+exp(-x)) of *this,
+  * also known as the sigmoid function.
+  *
+  * Example: \include Cwise_logistic.cpp
+  * Output: \verbinclude Cwise_logistic.out
+  *
+  * \sa tanh(), exp()
+  */
+inline const CwiseUnaryOp<internal::scalar_logistic_op<Scalar>, const Derived>
+logistic() const
+{
+  return derived();
+}
+
+/** \returns an expression of the coefficient-wise error function of *this.
+  *
+  * This function is only available for real scalar types.
+  *
+  * Example: \include Cwise_erf.cpp
+  * Output: \verbinclude Cwise_erf.out
+  *
+  * \sa exp()
+  */
+inline const CwiseUnaryOp<internal::scalar_erf_op<Scalar>, const Derived>
+erf() const
+{
+  return derived();
+}
+
 
 /** \returns an expression of the coefficient-wise power of *this to the given exponent.
+  *
+  * When the exponent is a small integer, the powers are vectorized by repeated multiplications.
+  * Otherwise, they are vectorized as exp(exponent*log(x)) when EIGEN_FAST_MATH is enabled, in
+  * which case the relative error grows like |exponent*log(x)| times the machine epsilon.
   *
   * Example: \include Cwise_pow.cpp
   * Output: \verbinclude Cwise_pow.out
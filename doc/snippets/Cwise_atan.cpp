@@ -0,0 +1,2 @@
+Array3d v(-1, 0.5, 2);
+cout << v.atan() << endl;
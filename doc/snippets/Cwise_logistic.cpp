@@ -0,0 +1,2 @@
+Array3d v(-1, 0, 2);
+cout << v.logistic() << endl;
@@ -176,6 +176,17 @@ template<typename ArrayType> void array_real(const ArrayType& m)
   VERIFY_IS_APPROX(m1.acos(), acos(m1));
 //   VERIFY_IS_APPROX(m1.tan(), std::tan(m1));
   VERIFY_IS_APPROX(m1.tan(), tan(m1));
+  VERIFY_IS_APPROX(m1.atan(), atan(m1));
+  VERIFY_IS_APPROX(m1.tan().atan(), m1);
+  VERIFY_IS_APPROX(atan2(m1.sin(), m1.cos()), m1);
+  VERIFY_IS_APPROX(atan2(m1, m2.abs() + RealScalar(1)), (m1 / (m2.abs() + RealScalar(1))).atan());
+  VERIFY_IS_APPROX(m1.tanh(), tanh(m1));
+  VERIFY_IS_APPROX(m1.tanh(), (m1.exp() - (-m1).exp()) / (m1.exp() + (-m1).exp()));
+  VERIFY_IS_APPROX(m1.logistic(), logistic(m1));
+  VERIFY_IS_APPROX(m1.logistic(), (m1 * RealScalar(0.5)).tanh() * RealScalar(0.5) + RealScalar(0.5));
+  VERIFY_IS_APPROX(m1.erf(), erf(m1));
+  VERIFY_IS_APPROX(m1.erf(), -(-m1).erf());
+  VERIFY_IS_APPROX(ArrayType::Constant(rows, cols, RealScalar(0.5)).erf(), ArrayType::Constant(rows, cols, RealScalar(0.520499877813046537682)));
   
   VERIFY_IS_APPROX(cos(m1+RealScalar(3)*m2), cos((m1+RealScalar(3)*m2).eval()));
 //   VERIFY_IS_APPROX(std::cos(m1+RealScalar(3)*m2), std::cos((m1+RealScalar(3)*m2).eval()));
@@ -0,0 +1,223 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+#include <Eigen/SVD>
+
+template<typename MatrixType>
+void bdcsvd_check_full(const MatrixType& m, const BDCSVD<MatrixType>& svd)
+{
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::Scalar Scalar;
+  Index rows = m.rows();
+  Index cols = m.cols();
+  typedef Matrix<Scalar, MatrixType::RowsAtCompileTime, MatrixType::RowsAtCompileTime> MatrixUType;
+  typedef Matrix<Scalar, MatrixType::ColsAtCompileTime, MatrixType::ColsAtCompileTime> MatrixVType;
+
+  MatrixType sigma = MatrixType::Zero(rows,cols);
+  sigma.diagonal() = svd.singularValues().template cast<Scalar>();
+  MatrixUType u = svd.matrixU();
+  MatrixVType v = svd.matrixV();
+
+  VERIFY_IS_APPROX(m, u * sigma * v.adjoint());
+  VERIFY_IS_UNITARY(u);
+  VERIFY_IS_UNITARY(v);
+}
+
+template<typename MatrixType>
+void bdcsvd_compare_to_full(const MatrixType& m, unsigned int computationOptions, const BDCSVD<MatrixType>& referenceSvd, typename MatrixType::Index switchSize)
+{
+  typedef typename MatrixType::Index Index;
+  Index diagSize = (std::min)(m.rows(), m.cols());
+
+  BDCSVD<MatrixType> svd;
+  svd.setSwitchSize(switchSize).compute(m, computationOptions);
+
+  VERIFY_IS_APPROX(svd.singularValues(), referenceSvd.singularValues());
+  // the singular vectors are unique up to a sign, or a unitary scaling for complex matrices
+  if(computationOptions & (ComputeFullU|ComputeThinU))
+    VERIFY_IS_APPROX((svd.matrixU().leftCols(diagSize).adjoint() * referenceSvd.matrixU().leftCols(diagSize)).cwiseAbs(),
+                     MatrixType::Identity(diagSize, diagSize).cwiseAbs());
+  if(computationOptions & (ComputeFullV|ComputeThinV))
+    VERIFY_IS_APPROX((svd.matrixV().leftCols(diagSize).adjoint() * referenceSvd.matrixV().leftCols(diagSize)).cwiseAbs(),
+                     MatrixType::Identity(diagSize, diagSize).cwiseAbs());
+  if(computationOptions & ComputeFullU)
+    VERIFY_IS_UNITARY(svd.matrixU());
+  if(computationOptions & ComputeFullV)
+    VERIFY_IS_UNITARY(svd.matrixV());
+}
+
+template<typename MatrixType>
+void bdcsvd_solve(const MatrixType& m, unsigned int computationOptions, typename MatrixType::Index switchSize)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::Index Index;
+  typedef Matrix<Scalar, MatrixType::RowsAtCompileTime, Dynamic> RhsType;
+  typedef Matrix<Scalar, MatrixType::ColsAtCompileTime, Dynamic> SolutionType;
+
+  RhsType rhs = RhsType::Random(m.rows(), internal::random<Index>(1, m.cols()));
+  BDCSVD<MatrixType> svd;
+  svd.setSwitchSize(switchSize).compute(m, computationOptions);
+  SolutionType x = svd.solve(rhs);
+  // evaluate normal equation which works also for least-squares solutions
+  VERIFY_IS_APPROX(m.adjoint()*m*x, m.adjoint()*rhs);
+}
+
+template<typename MatrixType>
+void bdcsvd_test_all_computation_options(const MatrixType& m)
+{
+  typedef typename MatrixType::Index Index;
+  // small switch sizes exercise the divide and conquer algorithm on small matrices
+  Index switchSize = internal::random<Index>(3, 20);
+  BDCSVD<MatrixType> fullSvd;
+  fullSvd.setSwitchSize(switchSize).compute(m, ComputeFullU|ComputeFullV);
+
+  bdcsvd_check_full(m, fullSvd);
+  bdcsvd_solve(m, ComputeFullU|ComputeFullV, switchSize);
+
+  // the singular values match the ones of JacobiSVD
+  JacobiSVD<MatrixType> jacobiSvd(m);
+  VERIFY_IS_APPROX(fullSvd.singularValues(), jacobiSvd.singularValues());
+
+  bdcsvd_compare_to_full(m, ComputeFullU, fullSvd, switchSize);
+  bdcsvd_compare_to_full(m, ComputeFullV, fullSvd, switchSize);
+  bdcsvd_compare_to_full(m, 0, fullSvd, switchSize);
+
+  if (MatrixType::ColsAtCompileTime == Dynamic) {
+    bdcsvd_compare_to_full(m, ComputeFullU|ComputeThinV, fullSvd, switchSize);
+    bdcsvd_compare_to_full(m,              ComputeThinV, fullSvd, switchSize);
+    bdcsvd_compare_to_full(m, ComputeThinU|ComputeFullV, fullSvd, switchSize);
+    bdcsvd_compare_to_full(m, ComputeThinU             , fullSvd, switchSize);
+    bdcsvd_compare_to_full(m, ComputeThinU|ComputeThinV, fullSvd, switchSize);
+    bdcsvd_solve(m, ComputeThinU|ComputeThinV, switchSize);
+
+    // test reconstruction
+    Index diagSize = (std::min)(m.rows(), m.cols());
+    BDCSVD<MatrixType> svd(m, ComputeThinU | ComputeThinV);
+    VERIFY_IS_APPROX(m, svd.matrixU().leftCols(diagSize) * svd.singularValues().asDiagonal() * svd.matrixV().leftCols(diagSize).adjoint());
+  }
+}
+
+template<typename MatrixType>
+void bdcsvd(const MatrixType& a = MatrixType(), bool pickrandom = true)
+{
+  MatrixType m = pickrandom ? MatrixType::Random(a.rows(), a.cols()) : a;
+  bdcsvd_test_all_computation_options(m);
+}
+
+// matrices with a known spectrum, with repeated and zero singular values which have to be deflated
+template<typename MatrixType>
+void bdcsvd_spectrum(typename MatrixType::Index rows, typename MatrixType::Index cols)
+{
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::RealScalar RealScalar;
+  typedef Matrix<RealScalar, Dynamic, 1> RealVectorType;
+  Index diagSize = (std::min)(rows, cols);
+  Index rank = internal::random<Index>(1, diagSize);
+  RealVectorType sv(diagSize);
+  for(Index i = 0; i < diagSize; ++i)
+    sv(i) = i < rank ? RealScalar(3 - i%3) : RealScalar(0);
+  MatrixType u = MatrixType::Random(rows, rows).householderQr().householderQ();
+  MatrixType v = MatrixType::Random(cols, cols).householderQr().householderQ();
+  MatrixType m = u.leftCols(diagSize) * sv.template cast<typename MatrixType::Scalar>().asDiagonal() * v.leftCols(diagSize).adjoint();
+
+  BDCSVD<MatrixType> svd;
+  svd.setSwitchSize(internal::random<Index>(3, 8)).compute(m, ComputeThinU|ComputeThinV);
+  std::sort(sv.data(), sv.data()+diagSize, std::greater<RealScalar>());
+  VERIFY_IS_APPROX(svd.singularValues(), sv);
+  VERIFY_IS_APPROX(m, svd.matrixU() * svd.singularValues().asDiagonal() * svd.matrixV().adjoint());
+  VERIFY_IS_UNITARY(svd.matrixU());
+  VERIFY_IS_UNITARY(svd.matrixV());
+  bdcsvd_check_full(m, BDCSVD<MatrixType>(m, ComputeFullU|ComputeFullV));
+}
+
+template<typename MatrixType> void bdcsvd_verify_assert(const MatrixType& m)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, MatrixType::RowsAtCompileTime, 1> RhsType;
+  RhsType rhs(m.rows());
+
+  BDCSVD<MatrixType> svd;
+  VERIFY_RAISES_ASSERT(svd.matrixU())
+  VERIFY_RAISES_ASSERT(svd.singularValues())
+  VERIFY_RAISES_ASSERT(svd.matrixV())
+  VERIFY_RAISES_ASSERT(svd.solve(rhs))
+  VERIFY_RAISES_ASSERT(svd.setSwitchSize(2))
+
+  MatrixType a = MatrixType::Zero(m.rows(), m.cols());
+  svd.compute(a, 0);
+  VERIFY_RAISES_ASSERT(svd.matrixU())
+  VERIFY_RAISES_ASSERT(svd.matrixV())
+  svd.singularValues();
+  VERIFY_RAISES_ASSERT(svd.solve(rhs))
+  VERIFY_RAISES_ASSERT(svd.compute(a, ComputeFullU|ComputeThinU))
+
+  svd.compute(a, ComputeThinU);
+  svd.matrixU();
+  VERIFY_RAISES_ASSERT(svd.matrixV())
+  VERIFY_RAISES_ASSERT(svd.solve(rhs))
+}
+
+template<typename MatrixType>
+void bdcsvd_method()
+{
+  enum { Size = MatrixType::RowsAtCompileTime };
+  typedef typename MatrixType::RealScalar RealScalar;
+  typedef Matrix<RealScalar, Size, 1> RealVecType;
+  MatrixType m = MatrixType::Identity();
+  VERIFY_IS_APPROX(m.bdcSvd().singularValues(), RealVecType::Ones());
+  VERIFY_RAISES_ASSERT(m.bdcSvd().matrixU());
+  VERIFY_RAISES_ASSERT(m.bdcSvd().matrixV());
+  VERIFY_IS_APPROX(m.bdcSvd(ComputeFullU|ComputeFullV).solve(m), m);
+}
+
+template<typename MatrixType>
+void bdcsvd_inf_nan()
+{
+  // all this function does is verify we don't iterate infinitely on nan/inf values
+  BDCSVD<MatrixType> svd;
+  typedef typename MatrixType::Scalar Scalar;
+  Scalar some_inf = Scalar(1) / Scalar(0);
+  svd.compute(MatrixType::Constant(20,20,some_inf), ComputeFullU | ComputeFullV);
+  Scalar some_nan = Scalar(0) / Scalar(0);
+  svd.compute(MatrixType::Constant(20,20,some_nan), ComputeFullU | ComputeFullV);
+  MatrixType m = MatrixType::Zero(20,20);
+  m(internal::random<int>(0,19), internal::random<int>(0,19)) = some_nan;
+  svd.compute(m, ComputeFullU | ComputeFullV);
+}
+
+void test_bdcsvd()
+{
+  CALL_SUBTEST_1(( bdcsvd_verify_assert(MatrixXf(10,12)) ));
+  CALL_SUBTEST_2(( bdcsvd_verify_assert(MatrixXcd(7,5)) ));
+
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_3(( bdcsvd<Matrix3f>() ));
+    CALL_SUBTEST_4(( bdcsvd<Matrix<double,Dynamic,2> >(Matrix<double,Dynamic,2>(10,2)) ));
+
+    int r = internal::random<int>(1, 40),
+        c = internal::random<int>(1, 40);
+    CALL_SUBTEST_1(( bdcsvd<MatrixXf>(MatrixXf(r,c)) ));
+    CALL_SUBTEST_5(( bdcsvd<MatrixXd>(MatrixXd(r,c)) ));
+    CALL_SUBTEST_2(( bdcsvd<MatrixXcd>(MatrixXcd(r,c)) ));
+    (void) r;
+    (void) c;
+
+    CALL_SUBTEST_5(( bdcsvd_spectrum<MatrixXd>(internal::random<int>(10,60), internal::random<int>(10,60)) ));
+    CALL_SUBTEST_2(( bdcsvd_spectrum<MatrixXcd>(internal::random<int>(10,40), internal::random<int>(10,40)) ));
+
+    // Test on inf/nan matrix
+    CALL_SUBTEST_1( bdcsvd_inf_nan<MatrixXf>() );
+  }
+
+  CALL_SUBTEST_1(( bdcsvd<MatrixXf>(MatrixXf(internal::random<int>(EIGEN_TEST_MAX_SIZE/4, EIGEN_TEST_MAX_SIZE/2), internal::random<int>(EIGEN_TEST_MAX_SIZE/4, EIGEN_TEST_MAX_SIZE/2))) ));
+  CALL_SUBTEST_2(( bdcsvd<MatrixXcd>(MatrixXcd(internal::random<int>(EIGEN_TEST_MAX_SIZE/4, EIGEN_TEST_MAX_SIZE/3), internal::random<int>(EIGEN_TEST_MAX_SIZE/4, EIGEN_TEST_MAX_SIZE/3))) ));
+
+  // test matrixbase method
+  CALL_SUBTEST_3(( bdcsvd_method<Matrix3f>() ));
+  CALL_SUBTEST_4(( bdcsvd_method<Matrix2cd>() ));
+}
@@ -282,6 +282,41 @@ template<typename MatrixType> void cholesky_indefinite(const MatrixType& m)
   }
 }
 
+// Large indefinite matrices are factorized by panels, with pivots chosen on the diagonal of the Schur complement.
+template<typename MatrixType> void cholesky_indefinite_blocked(const MatrixType& m)
+{
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  Index size = m.rows();
+
+  MatrixType a = MatrixType::Random(size,size);
+  MatrixType symm = a * a.adjoint();
+  symm.diagonal().array() -= RealScalar(size) / RealScalar(3);
+  MatrixType symmLo = symm.template triangularView<Lower>();
+  MatrixType symmUp = symm.template triangularView<Upper>();
+  MatrixType matB = MatrixType::Random(size,size);
+
+  LDLT<MatrixType,Lower> ldltlo(symmLo);
+  VERIFY(!ldltlo.isPositive());
+  VERIFY(!ldltlo.isNegative());
+  VERIFY_IS_APPROX(symm, ldltlo.reconstructedMatrix());
+  VERIFY_IS_APPROX(symm * ldltlo.solve(matB), matB);
+
+  LDLT<MatrixType,Upper> ldltup(symmUp);
+  VERIFY_IS_APPROX(symm, ldltup.reconstructedMatrix());
+  VERIFY_IS_APPROX(symm * ldltup.solve(matB), matB);
+
+  // the blocked and unblocked algorithms choose the same pivots
+  MatrixType mat = symmLo;
+  typename LDLT<MatrixType>::TranspositionType transpositions(size);
+  Matrix<Scalar,Dynamic,1> temp(size);
+  internal::ldlt_inplace<Lower>::unblocked(mat, transpositions, temp);
+  for(Index i = 0; i < size; ++i)
+    VERIFY_IS_EQUAL(transpositions.coeff(i), ldltlo.transpositionsP().coeff(i));
+  VERIFY_IS_APPROX(MatrixType(mat.template triangularView<Lower>()), MatrixType(ldltlo.matrixLDLT().template triangularView<Lower>()));
+}
+
 template<typename MatrixType> void cholesky_verify_assert()
 {
   MatrixType tmp;
@@ -326,6 +361,12 @@ void test_cholesky()
   // Test problem size constructors
   CALL_SUBTEST_9( LLT<MatrixXf>(10) );
   CALL_SUBTEST_9( LDLT<MatrixXf>(10) );
+
+  s = internal::random<int>(32,EIGEN_TEST_MAX_SIZE);
+  CALL_SUBTEST_10( cholesky_indefinite_blocked(MatrixXd(s,s)) );
+  CALL_SUBTEST_10( cholesky_indefinite_blocked(Matrix<double,Dynamic,Dynamic,RowMajor>(s,s)) );
+  s = internal::random<int>(32,EIGEN_TEST_MAX_SIZE/2);
+  CALL_SUBTEST_11( cholesky_indefinite_blocked(MatrixXcd(s,s)) );
   
   EIGEN_UNUSED_VARIABLE(s)
 }
@@ -10,7 +10,7 @@
 #include "main.h"
 
 #if EIGEN_ALIGN
-#define ALIGNMENT 16
+#define ALIGNMENT EIGEN_ALIGN_BYTES
 #else
 #define ALIGNMENT 1
 #endif
@@ -63,12 +63,14 @@ void check_aligned_stack_alloc()
 }
 
 
+typedef Matrix<float,16,1> Vector16f;
+
 // test compilation with both a struct and a class...
 struct MyStruct
 {
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
   char dummychar;
-  Vector4f avec;
+  Vector16f avec;
 };
 
 class MyClassA
@@ -76,15 +78,20 @@ class MyClassA
   public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
     char dummychar;
-    Vector4f avec;
+    Vector16f avec;
 };
 
 template<typename T> void check_dynaligned()
 {
-  T* obj = new T;
-  VERIFY(T::NeedsToAlign==1);
-  VERIFY(size_t(obj)%ALIGNMENT==0);
-  delete obj;
+  // fixed size objects whose size is not a multiple of the packet alignment (e.g., Vector4f with AVX)
+  // are not required to be aligned
+  if(sizeof(T)%ALIGNMENT==0)
+  {
+    T* obj = new T;
+    VERIFY(T::NeedsToAlign==1);
+    VERIFY(size_t(obj)%ALIGNMENT==0);
+    delete obj;
+  }
 }
 
 void test_dynalloc()
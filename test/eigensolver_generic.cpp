@@ -110,6 +110,10 @@ void test_eigensolver_generic()
   // Test problem size constructors
   CALL_SUBTEST_5(EigenSolver<MatrixXf>(s));
 
+  // Large matrices go through the blocked Hessenberg reduction and the multishift QR algorithm
+  s = internal::random<int>(75,EIGEN_TEST_MAX_SIZE/2);
+  CALL_SUBTEST_6( eigensolver(MatrixXd(s,s)) );
+
   // regression test for bug 410
   CALL_SUBTEST_2(
   {
@@ -52,6 +52,12 @@ template<typename MatrixType> void selfadjointeigensolver(const MatrixType& m)
           eiDirect.eigenvectors() * eiDirect.eigenvalues().asDiagonal(), largerEps));
   VERIFY_IS_APPROX(symmA.template selfadjointView<Lower>().eigenvalues(), eiDirect.eigenvalues());
 
+  SelfAdjointEigenSolver<MatrixType> eiSymmDC(symmA, ComputeEigenvectors|DivideAndConquer);
+  VERIFY_IS_EQUAL(eiSymmDC.info(), Success);
+  VERIFY((symmA.template selfadjointView<Lower>() * eiSymmDC.eigenvectors()).isApprox(
+          eiSymmDC.eigenvectors() * eiSymmDC.eigenvalues().asDiagonal(), largerEps));
+  VERIFY_IS_APPROX(eiSymm.eigenvalues(), eiSymmDC.eigenvalues());
+
   SelfAdjointEigenSolver<MatrixType> eiSymmNoEivecs(symmA, false);
   VERIFY_IS_EQUAL(eiSymmNoEivecs.info(), Success);
   VERIFY_IS_APPROX(eiSymm.eigenvalues(), eiSymmNoEivecs.eigenvalues());
@@ -62,6 +68,11 @@ template<typename MatrixType> void selfadjointeigensolver(const MatrixType& m)
   VERIFY((symmA.template selfadjointView<Lower>() * eiSymmGen.eigenvectors()).isApprox(
           symmB.template selfadjointView<Lower>() * (eiSymmGen.eigenvectors() * eiSymmGen.eigenvalues().asDiagonal()), largerEps));
 
+  eiSymmGen.compute(symmA, symmB,Ax_lBx|DivideAndConquer);
+  VERIFY_IS_EQUAL(eiSymmGen.info(), Success);
+  VERIFY((symmA.template selfadjointView<Lower>() * eiSymmGen.eigenvectors()).isApprox(
+          symmB.template selfadjointView<Lower>() * (eiSymmGen.eigenvectors() * eiSymmGen.eigenvalues().asDiagonal()), largerEps));
+
   // generalized eigen problem BAx = lx
   eiSymmGen.compute(symmA, symmB,BAx_lx);
   VERIFY_IS_EQUAL(eiSymmGen.info(), Success);
@@ -108,6 +119,53 @@ template<typename MatrixType> void selfadjointeigensolver(const MatrixType& m)
   }
 }
 
+template<typename MatrixType> void selfadjointeigensolver_divide_and_conquer(const MatrixType& m)
+{
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<RealScalar,Dynamic,1> RealVectorType;
+  Index n = m.rows();
+
+  // a spectrum with multiple and close eigenvalues, which are deflated when merging the halves
+  RealVectorType spectrum(n);
+  for(Index i = 0; i < n; ++i)
+  {
+    switch(internal::random<int>(0,3))
+    {
+      case 0:  spectrum(i) = RealScalar(1); break;
+      case 1:  spectrum(i) = RealScalar(-2) + RealScalar(i) * NumTraits<RealScalar>::epsilon(); break;
+      case 2:  spectrum(i) = RealScalar(0); break;
+      default: spectrum(i) = internal::random<RealScalar>(-10,10);
+    }
+  }
+  MatrixType q = MatrixType::Random(n,n).householderQr().householderQ();
+  MatrixType symmA = q * spectrum.asDiagonal() * q.adjoint();
+
+  SelfAdjointEigenSolver<MatrixType> eiSymm(symmA, EigenvaluesOnly);
+  SelfAdjointEigenSolver<MatrixType> eiSymmDC(symmA, ComputeEigenvectors|DivideAndConquer);
+  VERIFY_IS_EQUAL(eiSymmDC.info(), Success);
+  std::sort(spectrum.data(), spectrum.data()+n);
+  VERIFY_IS_APPROX(eiSymmDC.eigenvalues(), spectrum);
+  VERIFY_IS_APPROX(eiSymmDC.eigenvalues(), eiSymm.eigenvalues());
+  VERIFY_IS_APPROX(symmA * eiSymmDC.eigenvectors(), eiSymmDC.eigenvectors() * eiSymmDC.eigenvalues().asDiagonal());
+  VERIFY_IS_UNITARY(eiSymmDC.eigenvectors());
+
+  // a tridiagonal matrix whose off-diagonal coefficients are all equal to the one between the halves
+  MatrixType t = MatrixType::Zero(n,n);
+  t.diagonal().setRandom();
+  t.template diagonal<-1>().setConstant(Scalar(1));
+  eiSymmDC.compute(t, ComputeEigenvectors|DivideAndConquer);
+  VERIFY_IS_EQUAL(eiSymmDC.info(), Success);
+  VERIFY_IS_APPROX(t.template selfadjointView<Lower>() * eiSymmDC.eigenvectors(), eiSymmDC.eigenvectors() * eiSymmDC.eigenvalues().asDiagonal());
+  VERIFY_IS_UNITARY(eiSymmDC.eigenvectors());
+
+  // the identity is fully deflated
+  eiSymmDC.compute(MatrixType::Identity(n,n), ComputeEigenvectors|DivideAndConquer);
+  VERIFY_IS_APPROX(eiSymmDC.eigenvalues(), RealVectorType::Ones(n));
+  VERIFY_IS_UNITARY(eiSymmDC.eigenvectors());
+}
+
 void test_eigensolver_selfadjoint()
 {
   int s;
@@ -131,6 +189,12 @@ void test_eigensolver_selfadjoint()
     CALL_SUBTEST_4( selfadjointeigensolver(MatrixXd(2,2)) );
     CALL_SUBTEST_6( selfadjointeigensolver(Matrix<double,1,1>()) );
     CALL_SUBTEST_7( selfadjointeigensolver(Matrix<double,2,2>()) );
+
+    // large enough for the blocked tridiagonalization and the divide and conquer algorithm
+    s = internal::random<int>(30,200);
+    CALL_SUBTEST_10( selfadjointeigensolver_divide_and_conquer(MatrixXd(s,s)) );
+    s = internal::random<int>(30,100);
+    CALL_SUBTEST_11( selfadjointeigensolver_divide_and_conquer(MatrixXcf(s,s)) );
   }
 
   // Test problem size constructors
@@ -49,6 +49,22 @@ template<typename Scalar,int Size> void hessenberg(int size = Size)
   // TODO: Add tests for packedMatrix() and householderCoefficients()
 }
 
+template<typename MatrixType> void hessenberg_blocked(int size)
+{
+  // Large matrices are reduced by panels, check both storage orders
+  MatrixType m = MatrixType::Random(size,size);
+  HessenbergDecomposition<MatrixType> hess(m);
+  MatrixType Q = hess.matrixQ();
+  MatrixType H = hess.matrixH();
+  VERIFY_IS_APPROX(m, Q * H * Q.adjoint());
+  VERIFY_IS_UNITARY(Q);
+  for(int row = 2; row < size; ++row) {
+    for(int col = 0; col < row-1; ++col) {
+      VERIFY(H(row,col) == (typename MatrixType::Scalar)0);
+    }
+  }
+}
+
 void test_hessenberg()
 {
   CALL_SUBTEST_1(( hessenberg<std::complex<double>,1>() ));
@@ -59,4 +75,8 @@ void test_hessenberg()
 
   // Test problem size constructors
   CALL_SUBTEST_6(HessenbergDecomposition<MatrixXf>(10));
+
+  CALL_SUBTEST_7(( hessenberg_blocked<MatrixXd>(internal::random<int>(65,EIGEN_TEST_MAX_SIZE)) ));
+  CALL_SUBTEST_7(( hessenberg_blocked<Matrix<double,Dynamic,Dynamic,RowMajor> >(internal::random<int>(65,EIGEN_TEST_MAX_SIZE)) ));
+  CALL_SUBTEST_8(( hessenberg_blocked<Matrix<std::complex<float>,Dynamic,Dynamic,RowMajor> >(internal::random<int>(65,EIGEN_TEST_MAX_SIZE)) ));
 }
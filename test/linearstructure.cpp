@@ -68,6 +68,43 @@ template<typename MatrixType> void linearStructure(const MatrixType& m)
   VERIFY_IS_APPROX(m1.block(0,0,rows,cols) * s1, m1 * s1);
 }
 
+template<typename Scalar> void packetTails()
+{
+  /* check the scalar or masked prologues and epilogues of the vectorized assignments
+     for all the sizes around the packet size, including the in-place variants */
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  const int PacketSize = internal::packet_traits<Scalar>::size;
+
+  for(int n=0; n<=3*PacketSize+1; ++n)
+  {
+    VectorType v1 = VectorType::Random(n+2), v2 = VectorType::Random(n+2), v3 = v1, v4 = v2;
+    v3.segment(1,n) = v1.segment(1,n) + v2.segment(1,n);
+    v4.segment(1,n) += v1.segment(1,n);
+    for(int i=0; i<n+2; ++i)
+    {
+      VERIFY_IS_EQUAL(v3(i), i>=1 && i<=n ? Scalar(v1(i)+v2(i)) : v1(i));
+      VERIFY_IS_EQUAL(v4(i), i>=1 && i<=n ? Scalar(v2(i)+v1(i)) : v2(i));
+    }
+    VectorType v5 = v3, v6 = v4;
+    v3.head(n).swap(v4.tail(n));
+    VERIFY_IS_EQUAL(v3.head(n), v6.tail(n));
+    VERIFY_IS_EQUAL(v4.tail(n), v5.head(n));
+    VERIFY_IS_EQUAL(v3.tail(2), v5.tail(2));
+    VERIFY_IS_EQUAL(v4.head(2), v6.head(2));
+
+    MatrixType m1 = MatrixType::Random(n+3,3), m2 = m1;
+    m2.block(1,0,n,3) = 2*m1.block(2,0,n,3);
+    for(int j=0; j<3; ++j)
+      for(int i=0; i<n+3; ++i)
+        VERIFY_IS_EQUAL(m2(i,j), i>=1 && i<=n ? Scalar(2)*m1(i+1,j) : m1(i,j));
+  }
+
+  Matrix<Scalar,3*PacketSize+1,1> f1 = Matrix<Scalar,3*PacketSize+1,1>::Random(), f2;
+  f2 = f1 + f1;
+  VERIFY_IS_APPROX(f2, Scalar(2)*f1);
+}
+
 void test_linearstructure()
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -80,5 +117,7 @@ void test_linearstructure()
     CALL_SUBTEST_7( linearStructure(MatrixXi (internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE))) );
     CALL_SUBTEST_8( linearStructure(MatrixXcd(internal::random<int>(1,EIGEN_TEST_MAX_SIZE/2), internal::random<int>(1,EIGEN_TEST_MAX_SIZE/2))) );
     CALL_SUBTEST_9( linearStructure(ArrayXXf (internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE))) );
+    CALL_SUBTEST_10( packetTails<float>() );
+    CALL_SUBTEST_11( packetTails<double>() );
   }
 }
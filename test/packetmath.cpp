@@ -92,6 +92,27 @@ struct packet_helper<false,Packet>
   VERIFY(areApprox(ref, data2, PacketSize) && #POP); \
 }
 
+#define CHECK_CWISE2_IF(COND, REFOP, POP) if(COND) { \
+  packet_helper<COND,Packet> h; \
+  for (int i=0; i<PacketSize; ++i) \
+    ref[i] = REFOP(data1[i], data1[i+PacketSize]); \
+  h.store(data2, POP(h.load(data1), h.load(data1+PacketSize))); \
+  VERIFY(areApprox(ref, data2, PacketSize) && #POP); \
+}
+
+// as CHECK_CWISE1_IF, but the NaN coefficients of the reference must be NaN in the result
+#define CHECK_CWISE1_NAN_IF(COND, REFOP, POP) if(COND) { \
+  packet_helper<COND,Packet> h; \
+  for (int i=0; i<PacketSize; ++i) \
+    ref[i] = REFOP(data1[i]); \
+  h.store(data2, POP(h.load(data1))); \
+  for (int i=0; i<PacketSize; ++i) \
+    VERIFY((ref[i]!=ref[i] ? data2[i]!=data2[i] : internal::isApprox(ref[i], data2[i])) && #POP); \
+}
+
+template<typename Scalar> Scalar ref_logistic(const Scalar& x) { return Scalar(1)/(Scalar(1)+std::exp(-x)); }
+template<typename Scalar> Scalar ref_erf(const Scalar& x) { return Scalar(::erf(double(x))); }
+
 #define REF_ADD(a,b) ((a)+(b))
 #define REF_SUB(a,b) ((a)-(b))
 #define REF_MUL(a,b) ((a)*(b))
@@ -104,11 +125,12 @@ template<typename Scalar> void packetmath()
   const int PacketSize = internal::packet_traits<Scalar>::size;
   typedef typename NumTraits<Scalar>::Real RealScalar;
 
-  const int size = PacketSize*4;
-  EIGEN_ALIGN16 Scalar data1[internal::packet_traits<Scalar>::size*4];
-  EIGEN_ALIGN16 Scalar data2[internal::packet_traits<Scalar>::size*4];
-  EIGEN_ALIGN16 Packet packets[PacketSize*2];
-  EIGEN_ALIGN16 Scalar ref[internal::packet_traits<Scalar>::size*4];
+  // preduxp needs PacketSize full packets
+  const int size = PacketSize*(PacketSize>4 ? PacketSize : 4);
+  EIGEN_ALIGN_DEFAULT Scalar data1[size];
+  EIGEN_ALIGN_DEFAULT Scalar data2[size];
+  EIGEN_ALIGN_DEFAULT Packet packets[PacketSize*2];
+  EIGEN_ALIGN_DEFAULT Scalar ref[size];
   RealScalar refvalue = 0;
   for (int i=0; i<size; ++i)
   {
@@ -140,6 +162,18 @@ template<typename Scalar> void packetmath()
     else if (offset==1) internal::palign<1>(packets[0], packets[1]);
     else if (offset==2) internal::palign<2>(packets[0], packets[1]);
     else if (offset==3) internal::palign<3>(packets[0], packets[1]);
+    else if (offset==4) internal::palign<4>(packets[0], packets[1]);
+    else if (offset==5) internal::palign<5>(packets[0], packets[1]);
+    else if (offset==6) internal::palign<6>(packets[0], packets[1]);
+    else if (offset==7) internal::palign<7>(packets[0], packets[1]);
+    else if (offset==8) internal::palign<8>(packets[0], packets[1]);
+    else if (offset==9) internal::palign<9>(packets[0], packets[1]);
+    else if (offset==10) internal::palign<10>(packets[0], packets[1]);
+    else if (offset==11) internal::palign<11>(packets[0], packets[1]);
+    else if (offset==12) internal::palign<12>(packets[0], packets[1]);
+    else if (offset==13) internal::palign<13>(packets[0], packets[1]);
+    else if (offset==14) internal::palign<14>(packets[0], packets[1]);
+    else if (offset==15) internal::palign<15>(packets[0], packets[1]);
     internal::pstore(data2, packets[0]);
 
     for (int i=0; i<PacketSize; ++i)
@@ -148,6 +182,22 @@ template<typename Scalar> void packetmath()
     VERIFY(areApprox(ref, data2, PacketSize) && "internal::palign");
   }
 
+  for (int n=0; n<=PacketSize; ++n)
+  {
+    for (int i=0; i<PacketSize; ++i)
+      ref[i] = i<n ? data1[i+1] : Scalar(0);
+    internal::pstoreu(data2, internal::ploadu_partial<Packet>(data1+1, n));
+    VERIFY(areApprox(ref, data2, PacketSize) && "internal::ploadu_partial");
+
+    for (int i=0; i<PacketSize+1; ++i)
+    {
+      ref[i] = i<n ? data1[i] : data1[i+PacketSize];
+      data2[i] = data1[i+PacketSize];
+    }
+    internal::pstoreu_partial(data2, internal::ploadu<Packet>(data1), n);
+    VERIFY(areApprox(ref, data2, PacketSize+1) && "internal::pstoreu_partial");
+  }
+
   CHECK_CWISE2(REF_ADD,  internal::padd);
   CHECK_CWISE2(REF_SUB,  internal::psub);
   CHECK_CWISE2(REF_MUL,  internal::pmul);
@@ -212,9 +262,9 @@ template<typename Scalar> void packetmath_real()
   const int PacketSize = internal::packet_traits<Scalar>::size;
 
   const int size = PacketSize*4;
-  EIGEN_ALIGN16 Scalar data1[internal::packet_traits<Scalar>::size*4];
-  EIGEN_ALIGN16 Scalar data2[internal::packet_traits<Scalar>::size*4];
-  EIGEN_ALIGN16 Scalar ref[internal::packet_traits<Scalar>::size*4];
+  EIGEN_ALIGN_DEFAULT Scalar data1[internal::packet_traits<Scalar>::size*4];
+  EIGEN_ALIGN_DEFAULT Scalar data2[internal::packet_traits<Scalar>::size*4];
+  EIGEN_ALIGN_DEFAULT Scalar ref[internal::packet_traits<Scalar>::size*4];
 
   for (int i=0; i<size; ++i)
   {
@@ -233,6 +283,34 @@ template<typename Scalar> void packetmath_real()
   CHECK_CWISE1_IF(internal::packet_traits<Scalar>::HasASin, std::asin, internal::pasin);
   CHECK_CWISE1_IF(internal::packet_traits<Scalar>::HasACos, std::acos, internal::pacos);
 
+  for (int i=0; i<size; ++i)
+  {
+    data1[i] = internal::random<Scalar>(-1,1) * std::pow(Scalar(10), internal::random<Scalar>(-2,1));
+    data2[i] = internal::random<Scalar>(-1,1) * std::pow(Scalar(10), internal::random<Scalar>(-2,1));
+  }
+  CHECK_CWISE1_IF(internal::packet_traits<Scalar>::HasATan, std::atan, internal::patan);
+  CHECK_CWISE2_IF(internal::packet_traits<Scalar>::HasATan, std::atan2, internal::patan2);
+  CHECK_CWISE1_IF(internal::packet_traits<Scalar>::HasTanh, std::tanh, internal::ptanh);
+  CHECK_CWISE1_IF(internal::packet_traits<Scalar>::HasLogistic, ref_logistic, internal::plogistic);
+  CHECK_CWISE1_IF(internal::packet_traits<Scalar>::HasErf, ref_erf, internal::perf);
+  // atan2 on the axes and in the four quadrants
+  data1[0] = Scalar(0);  data1[PacketSize] = Scalar(-1);
+  data1[1] = Scalar(-2); data1[PacketSize+1] = Scalar(0);
+  CHECK_CWISE2_IF(internal::packet_traits<Scalar>::HasATan, std::atan2, internal::patan2);
+  data1[0] = Scalar(-1); data1[PacketSize] = Scalar(-3);
+  data1[1] = Scalar(1);  data1[PacketSize+1] = Scalar(-3);
+  CHECK_CWISE2_IF(internal::packet_traits<Scalar>::HasATan, std::atan2, internal::patan2);
+  // the NaN arguments are not lost in the clamping
+  for (int i=0; i<PacketSize; i+=2)
+    data1[i] = std::numeric_limits<Scalar>::quiet_NaN();
+  CHECK_CWISE1_NAN_IF(internal::packet_traits<Scalar>::HasATan, std::atan, internal::patan);
+  CHECK_CWISE1_NAN_IF(internal::packet_traits<Scalar>::HasTanh, std::tanh, internal::ptanh);
+  CHECK_CWISE1_NAN_IF(internal::packet_traits<Scalar>::HasLogistic, ref_logistic, internal::plogistic);
+  CHECK_CWISE1_NAN_IF(internal::packet_traits<Scalar>::HasErf, ref_erf, internal::perf);
+  // and the arguments out of [-1,1] return NaN
+  CHECK_CWISE1_NAN_IF(internal::packet_traits<Scalar>::HasASin, std::asin, internal::pasin);
+  CHECK_CWISE1_NAN_IF(internal::packet_traits<Scalar>::HasACos, std::acos, internal::pacos);
+
   for (int i=0; i<size; ++i)
   {
     data1[i] = internal::random<Scalar>(-87,88);
@@ -249,6 +327,142 @@ template<typename Scalar> void packetmath_real()
     data1[internal::random<int>(0, PacketSize)] = 0;
   CHECK_CWISE1_IF(internal::packet_traits<Scalar>::HasLog, std::log, internal::plog);
   CHECK_CWISE1_IF(internal::packet_traits<Scalar>::HasSqrt, std::sqrt, internal::psqrt);
+
+  for (int i=0; i<PacketSize; ++i)
+  {
+    data1[i] = internal::random<Scalar>(-10,10);
+    // integer exponents for negative numbers, fractional ones otherwise
+    data1[i+PacketSize] = internal::random<Scalar>(-4,4);
+    if(i%2==0)
+      data1[i+PacketSize] = Scalar(int(data1[i+PacketSize]));
+    else
+      data1[i] = abs(data1[i]);
+  }
+  CHECK_CWISE2_IF(internal::packet_traits<Scalar>::HasPow, std::pow, internal::ppow);
+
+  // the packet path of the pow functor, which does not depend on HasPow
+  VERIFY((internal::functor_traits<internal::scalar_pow_op<Scalar> >::PacketAccess));
+  const Scalar exponents[] = { Scalar(0), Scalar(1), Scalar(2), Scalar(-3), Scalar(7), Scalar(-16), Scalar(64), Scalar(1.5) };
+  for (int k=0; k<int(sizeof(exponents)/sizeof(Scalar)); ++k)
+  {
+    internal::scalar_pow_op<Scalar> op(exponents[k]);
+    for (int i=0; i<PacketSize; ++i)
+    {
+      data1[i] = internal::random<Scalar>(Scalar(0.5),Scalar(1.5));
+      if(i%2==0 && exponents[k]==Scalar(int(exponents[k])))
+        data1[i] = -data1[i];
+      ref[i] = std::pow(data1[i], exponents[k]);
+    }
+    internal::pstore(data2, op.packetOp(internal::pload<Packet>(data1)));
+    VERIFY(areApprox(ref, data2, PacketSize));
+    // without a vectorized pow, the packets are computed exactly as the scalars of the tail of an array
+    if(!internal::packet_traits<Scalar>::HasPow)
+      for (int i=0; i<PacketSize; ++i)
+        VERIFY(data2[i]==op(data1[i]));
+  }
+}
+
+#define CHECK_CWISE1_ULP_IF(COND, REFOP, POP, MAXULP) if(COND) { \
+  for (int i=0; i<size; ++i) \
+    ref[i] = REFOP(data1[i]); \
+  for (int i=0; i<size; i+=PacketSize) \
+    internal::pstore(data2+i, POP(internal::pload<Packet>(data1+i))); \
+  for (int i=0; i<size; ++i) \
+    VERIFY(abs(data2[i]-ref[i]) <= Scalar(MAXULP)*NumTraits<Scalar>::epsilon()*abs(ref[i]) && #POP); \
+}
+
+// The double precision versions are expected to stay within a few ULP of the standard library
+// on the full range where they are vectorized, and to handle the special values of log like std::log.
+template<typename Scalar> void packetmath_real_ulp()
+{
+  using std::abs;
+  typedef typename internal::packet_traits<Scalar>::type Packet;
+  const int PacketSize = internal::packet_traits<Scalar>::size;
+
+  const int size = PacketSize*64;
+  EIGEN_ALIGN_DEFAULT Scalar data1[internal::packet_traits<Scalar>::size*64];
+  EIGEN_ALIGN_DEFAULT Scalar data2[internal::packet_traits<Scalar>::size*64];
+  EIGEN_ALIGN_DEFAULT Scalar ref[internal::packet_traits<Scalar>::size*64];
+
+  for (int i=0; i<size; ++i)
+    data1[i] = internal::random<Scalar>(-1,1) * std::pow(Scalar(10), internal::random<Scalar>(-3,8));
+  CHECK_CWISE1_ULP_IF(internal::packet_traits<Scalar>::HasSin, std::sin, internal::psin, 4);
+  CHECK_CWISE1_ULP_IF(internal::packet_traits<Scalar>::HasCos, std::cos, internal::pcos, 4);
+  CHECK_CWISE1_ULP_IF(internal::packet_traits<Scalar>::HasTan, std::tan, internal::ptan, 8);
+
+  for (int i=0; i<size; ++i)
+    data1[i] = internal::random<Scalar>(-1,1);
+  data1[0] = Scalar(1);
+  data1[1] = Scalar(-1);
+  CHECK_CWISE1_ULP_IF(internal::packet_traits<Scalar>::HasASin, std::asin, internal::pasin, 4);
+  CHECK_CWISE1_ULP_IF(internal::packet_traits<Scalar>::HasACos, std::acos, internal::pacos, 4);
+
+  // the arguments too large for the reduction, and the non finite ones, are mixed with the others in the packets
+  for (int i=0; i<size; ++i)
+    data1[i] = internal::random<Scalar>(-1,1) * std::pow(Scalar(10), i%3==0 ? internal::random<Scalar>(9,300) : internal::random<Scalar>(-3,8));
+  CHECK_CWISE1_ULP_IF(internal::packet_traits<Scalar>::HasSin, std::sin, internal::psin, 4);
+  CHECK_CWISE1_ULP_IF(internal::packet_traits<Scalar>::HasCos, std::cos, internal::pcos, 4);
+  if(internal::packet_traits<Scalar>::HasSin && internal::packet_traits<Scalar>::HasCos)
+  {
+    const Scalar specials[] = { std::numeric_limits<Scalar>::infinity(), -std::numeric_limits<Scalar>::infinity(),
+                                std::numeric_limits<Scalar>::quiet_NaN() };
+    for (int i=0; i<size; i+=2)
+      data1[i] = specials[(i/2)%3];
+    for (int i=0; i<size; i+=PacketSize)
+    {
+      internal::pstore(data2+i, internal::psin(internal::pload<Packet>(data1+i)));
+      internal::pstore(ref+i, internal::pcos(internal::pload<Packet>(data1+i)));
+    }
+    for (int i=0; i<size; ++i)
+    {
+      if(i%2==0)
+        VERIFY(data2[i]!=data2[i] && ref[i]!=ref[i]);
+      else
+        VERIFY(abs(data2[i]-std::sin(data1[i])) <= Scalar(4)*NumTraits<Scalar>::epsilon()*abs(std::sin(data1[i]))
+            && abs(ref[i]-std::cos(data1[i])) <= Scalar(4)*NumTraits<Scalar>::epsilon()*abs(std::cos(data1[i])));
+    }
+  }
+
+  for (int i=0; i<size; ++i)
+    data1[i] = internal::random<Scalar>(-700,700);
+  CHECK_CWISE1_ULP_IF(internal::packet_traits<Scalar>::HasExp, std::exp, internal::pexp, 4);
+
+  for (int i=0; i<size; ++i)
+    data1[i] = internal::random<Scalar>(-1,1) * std::pow(Scalar(10), internal::random<Scalar>(-3,2));
+  CHECK_CWISE1_ULP_IF(internal::packet_traits<Scalar>::HasATan, std::atan, internal::patan, 4);
+  CHECK_CWISE1_ULP_IF(internal::packet_traits<Scalar>::HasTanh, std::tanh, internal::ptanh, 4);
+  CHECK_CWISE1_ULP_IF(internal::packet_traits<Scalar>::HasLogistic, ref_logistic, internal::plogistic, 4);
+  CHECK_CWISE1_ULP_IF(internal::packet_traits<Scalar>::HasErf, ref_erf, internal::perf, 4);
+
+  for (int i=0; i<size; ++i)
+    data1[i] = std::pow(Scalar(10), internal::random<Scalar>(-300,300));
+  CHECK_CWISE1_ULP_IF(internal::packet_traits<Scalar>::HasLog, std::log, internal::plog, 4);
+  CHECK_CWISE1_ULP_IF(internal::packet_traits<Scalar>::HasSqrt, std::sqrt, internal::psqrt, 1);
+
+  if(internal::packet_traits<Scalar>::HasLog)
+  {
+    const Scalar specials[] = { Scalar(0), Scalar(-1), Scalar(1),
+                                std::numeric_limits<Scalar>::infinity(),
+                                std::numeric_limits<Scalar>::quiet_NaN(),
+                                std::numeric_limits<Scalar>::denorm_min(),
+                                (std::numeric_limits<Scalar>::min)()/Scalar(3),
+                                (std::numeric_limits<Scalar>::max)() };
+    const int nb_specials = sizeof(specials)/sizeof(specials[0]);
+    for (int i=0; i<size; ++i)
+      data1[i] = specials[i%nb_specials];
+    for (int i=0; i<size; i+=PacketSize)
+      internal::pstore(data2+i, internal::plog(internal::pload<Packet>(data1+i)));
+    for (int i=0; i<size; ++i)
+    {
+      Scalar expected = std::log(data1[i]);
+      if(expected!=expected)
+        VERIFY(data2[i]!=data2[i] && "internal::plog");
+      else if(abs(expected)==std::numeric_limits<Scalar>::infinity())
+        VERIFY(data2[i]==expected && "internal::plog");
+      else
+        VERIFY(abs(data2[i]-expected) <= Scalar(4)*NumTraits<Scalar>::epsilon()*abs(expected) && "internal::plog");
+    }
+  }
 }
 
 template<typename Scalar> void packetmath_notcomplex()
@@ -257,9 +471,9 @@ template<typename Scalar> void packetmath_notcomplex()
   typedef typename internal::packet_traits<Scalar>::type Packet;
   const int PacketSize = internal::packet_traits<Scalar>::size;
 
-  EIGEN_ALIGN16 Scalar data1[internal::packet_traits<Scalar>::size*4];
-  EIGEN_ALIGN16 Scalar data2[internal::packet_traits<Scalar>::size*4];
-  EIGEN_ALIGN16 Scalar ref[internal::packet_traits<Scalar>::size*4];
+  EIGEN_ALIGN_DEFAULT Scalar data1[internal::packet_traits<Scalar>::size*4];
+  EIGEN_ALIGN_DEFAULT Scalar data2[internal::packet_traits<Scalar>::size*4];
+  EIGEN_ALIGN_DEFAULT Scalar ref[internal::packet_traits<Scalar>::size*4];
   
   Array<Scalar,Dynamic,1>::Map(data1, internal::packet_traits<Scalar>::size*4).setRandom();
 
@@ -317,10 +531,10 @@ template<typename Scalar> void packetmath_complex()
   const int PacketSize = internal::packet_traits<Scalar>::size;
 
   const int size = PacketSize*4;
-  EIGEN_ALIGN16 Scalar data1[PacketSize*4];
-  EIGEN_ALIGN16 Scalar data2[PacketSize*4];
-  EIGEN_ALIGN16 Scalar ref[PacketSize*4];
-  EIGEN_ALIGN16 Scalar pval[PacketSize*4];
+  EIGEN_ALIGN_DEFAULT Scalar data1[PacketSize*4];
+  EIGEN_ALIGN_DEFAULT Scalar data2[PacketSize*4];
+  EIGEN_ALIGN_DEFAULT Scalar ref[PacketSize*4];
+  EIGEN_ALIGN_DEFAULT Scalar pval[PacketSize*4];
 
   for (int i=0; i<size; ++i)
   {
@@ -358,6 +572,7 @@ void test_packetmath()
     
     CALL_SUBTEST_1( packetmath_real<float>() );
     CALL_SUBTEST_2( packetmath_real<double>() );
+    CALL_SUBTEST_2( packetmath_real_ulp<double>() );
 
     CALL_SUBTEST_1( packetmath_complex<std::complex<float> >() );
     CALL_SUBTEST_2( packetmath_complex<std::complex<double> >() );
@@ -9,6 +9,26 @@
 
 #include "product.h"
 
+// products by a few vectors, which read the matrix once for all the vectors
+template<typename Scalar, int LhsOrder, int RhsOrder, int ResOrder> void product_few_columns()
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> RefType;
+  int rows = internal::random<int>(200,400), depth = internal::random<int>(1000,2000), cols = internal::random<int>(2,4);
+  Matrix<Scalar,Dynamic,Dynamic,LhsOrder> a = Matrix<Scalar,Dynamic,Dynamic,LhsOrder>::Random(rows,depth);
+  Matrix<Scalar,Dynamic,Dynamic,RhsOrder> b = Matrix<Scalar,Dynamic,Dynamic,RhsOrder>::Random(depth,cols);
+  Matrix<Scalar,Dynamic,Dynamic,ResOrder> c = Matrix<Scalar,Dynamic,Dynamic,ResOrder>::Random(rows,cols), c0 = c;
+  Scalar s = internal::random<Scalar>();
+
+  RefType ref = RefType(a).lazyProduct(RefType(b));
+  c.noalias() = a * b;
+  VERIFY_IS_APPROX(RefType(c), ref);
+  c = c0;
+  c.noalias() -= s * a.conjugate() * b;
+  VERIFY_IS_APPROX(RefType(c), RefType(RefType(c0) - s * RefType(a.conjugate()).lazyProduct(RefType(b))));
+  c.noalias() = a * b.conjugate();
+  VERIFY_IS_APPROX(RefType(c), RefType(RefType(a).lazyProduct(RefType(b.conjugate()))));
+}
+
 void test_product_large()
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -17,6 +37,14 @@ void test_product_large()
     CALL_SUBTEST_3( product(MatrixXi(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE))) );
     CALL_SUBTEST_4( product(MatrixXcf(internal::random<int>(1,EIGEN_TEST_MAX_SIZE/2), internal::random<int>(1,EIGEN_TEST_MAX_SIZE/2))) );
     CALL_SUBTEST_5( product(Matrix<float,Dynamic,Dynamic,RowMajor>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE))) );
+    CALL_SUBTEST_7(( product_few_columns<float,ColMajor,ColMajor,ColMajor>() ));
+    CALL_SUBTEST_7(( product_few_columns<float,ColMajor,RowMajor,ColMajor>() ));
+    CALL_SUBTEST_7(( product_few_columns<float,ColMajor,ColMajor,RowMajor>() ));
+    CALL_SUBTEST_7(( product_few_columns<double,RowMajor,ColMajor,ColMajor>() ));
+    CALL_SUBTEST_7(( product_few_columns<double,RowMajor,ColMajor,RowMajor>() ));
+    CALL_SUBTEST_7(( product_few_columns<double,RowMajor,RowMajor,RowMajor>() ));
+    CALL_SUBTEST_7(( product_few_columns<std::complex<float>,ColMajor,ColMajor,ColMajor>() ));
+    CALL_SUBTEST_7(( product_few_columns<std::complex<double>,RowMajor,ColMajor,RowMajor>() ));
   }
 
 #if defined EIGEN_TEST_PART_6
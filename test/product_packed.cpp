@@ -0,0 +1,91 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+
+template<typename Scalar, int LhsOrder, int RhsOrder, int ResOrder>
+void product_packed(int rows, int depth, int cols)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic,LhsOrder> LhsType;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RhsOrder> RhsType;
+  typedef Matrix<Scalar,Dynamic,Dynamic,ResOrder> ResType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> RefType;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+
+  LhsType a = LhsType::Random(rows,depth);
+  RhsType b = RhsType::Random(depth,cols), bt = RhsType::Random(cols,depth);
+  VectorType v = VectorType::Random(depth);
+  Scalar s = internal::random<Scalar>();
+  ResType c = ResType::Random(rows,cols), c0 = c;
+
+  PackedMatrix<LhsType> pa = pack(a);
+  VERIFY_IS_EQUAL(pa.rows(), a.rows());
+  VERIFY_IS_EQUAL(pa.cols(), a.cols());
+
+  RefType ref = RefType(a).lazyProduct(RefType(b));
+
+  // the same packed matrix is reused for several products
+  c.noalias() = pa * b;
+  VERIFY_IS_APPROX(c, ResType(ref));
+  c = c0;
+  c.noalias() += pa * b;
+  VERIFY_IS_APPROX(c, ResType(c0 + ref));
+  c = c0;
+  c.noalias() -= s * (pa * b);
+  VERIFY_IS_APPROX(c, ResType(c0 - s * ref));
+  c = pa * b;
+  VERIFY_IS_APPROX(c, ResType(ref));
+  c.noalias() = pa * (s * b);
+  VERIFY_IS_APPROX(c, ResType(s * ref));
+  c.noalias() = pa * bt.adjoint();
+  VERIFY_IS_APPROX(c, ResType(RefType(a).lazyProduct(RefType(bt.adjoint()))));
+  c = c0;
+  c.rightCols(cols/2).noalias() = pa * b.rightCols(cols/2);
+  VERIFY_IS_APPROX(c.rightCols(cols/2), ResType(ref.rightCols(cols/2)));
+  VERIFY_IS_EQUAL(c.leftCols(cols-cols/2), c0.leftCols(cols-cols/2));
+
+  VectorType r = pa * v;
+  VERIFY_IS_APPROX(r, VectorType(RefType(a).lazyProduct(v)));
+  r.noalias() = pa * bt.row(0).transpose();
+  VERIFY_IS_APPROX(r, VectorType(RefType(a).lazyProduct(RefType(bt).row(0).transpose())));
+
+  // scaled, conjugated and transposed matrices are packed as such
+  PackedMatrix<LhsType> pas(s * a.conjugate());
+  c.noalias() = pas * b;
+  VERIFY_IS_APPROX(c, ResType(s * RefType(a.conjugate()).lazyProduct(RefType(b))));
+  PackedMatrix<LhsType> pat;
+  pat.compute(a.adjoint());
+  c.resize(depth,depth);
+  c.noalias() = pat * a;
+  VERIFY_IS_APPROX(c, ResType(RefType(a.adjoint()).lazyProduct(RefType(a))));
+  pat.compute(a.block(1,0,rows-1,depth));
+  VERIFY_IS_APPROX(VectorType(pat * v), VectorType(RefType(a.block(1,0,rows-1,depth)).lazyProduct(v)));
+}
+
+template<typename Scalar> void product_packed_all_orders()
+{
+  int rows = internal::random<int>(2,EIGEN_TEST_MAX_SIZE), depth = internal::random<int>(1,EIGEN_TEST_MAX_SIZE),
+      cols = internal::random<int>(1,EIGEN_TEST_MAX_SIZE);
+  product_packed<Scalar,ColMajor,ColMajor,ColMajor>(rows, depth, cols);
+  product_packed<Scalar,ColMajor,RowMajor,ColMajor>(rows, depth, cols);
+  product_packed<Scalar,RowMajor,ColMajor,ColMajor>(rows, depth, cols);
+  product_packed<Scalar,RowMajor,RowMajor,RowMajor>(rows, depth, cols);
+}
+
+void test_product_packed()
+{
+  for(int i = 0; i < g_repeat ; i++)
+  {
+    CALL_SUBTEST_1( product_packed_all_orders<float>() );
+    CALL_SUBTEST_2( product_packed_all_orders<double>() );
+    CALL_SUBTEST_3( product_packed_all_orders<std::complex<float> >() );
+    CALL_SUBTEST_4( product_packed_all_orders<std::complex<double> >() );
+    // sizes larger than the cache blocks
+    CALL_SUBTEST_5( (product_packed<float,ColMajor,ColMajor,ColMajor>(internal::random<int>(300,700), internal::random<int>(300,700), internal::random<int>(2,80))) );
+    CALL_SUBTEST_6( (product_packed<double,RowMajor,ColMajor,ColMajor>(internal::random<int>(300,700), internal::random<int>(300,700), internal::random<int>(2,80))) );
+  }
+}
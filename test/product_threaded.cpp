@@ -0,0 +1,412 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Copyright (C) 2010 Gael Guennebaud <gael.guennebaud@inria.fr>
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+#include <Eigen/SparseCore>
+#include <Eigen/Cholesky>
+#include <Eigen/LU>
+#include <Eigen/SparseLU>
+
+// an executor forwarding to a ThreadPool while recording how it is used
+class CountingExecutor : public ParallelExecutor
+{
+  public:
+    CountingExecutor(ParallelExecutor& pool, int maxTasks = -1) : m_pool(pool), m_maxTasks(maxTasks), m_calls(0) {}
+    int numThreads() const { return m_pool.numThreads(); }
+    void run(Task task, void* data, int maxTasks)
+    {
+      ++m_calls;
+      m_pool.run(task, data, m_maxTasks>0 ? (std::min)(m_maxTasks,maxTasks) : maxTasks);
+    }
+    int calls() const { return m_calls; }
+  protected:
+    ParallelExecutor& m_pool;
+    int m_maxTasks;
+    int m_calls;
+};
+
+template<typename MatrixType> void check_products(int rows, int depth, int cols)
+{
+  typedef Matrix<typename MatrixType::Scalar, Dynamic, Dynamic, ColMajor> RefMatrixType;
+  MatrixType a = MatrixType::Random(rows,depth), b = MatrixType::Random(depth,cols), c(rows,cols), ct(cols,rows);
+
+  setNbThreads(1);
+  RefMatrixType ref = RefMatrixType(a) * RefMatrixType(b);
+  setNbThreads(0); // back to the default number of threads
+
+  c.noalias() = a * b;
+  VERIFY_IS_APPROX(c, MatrixType(ref));
+  ct.noalias() = b.transpose() * a.transpose();
+  VERIFY_IS_APPROX(ct, MatrixType(ref.transpose()));
+  c.noalias() += a * b;
+  VERIFY_IS_APPROX(c, MatrixType(2*ref));
+  PackedMatrix<MatrixType> pa = pack(a);
+  c.noalias() = pa * b;
+  VERIFY_IS_APPROX(c, MatrixType(ref));
+}
+
+template<typename MatrixType> void check_gemv(int rows, int cols)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, Dynamic, Dynamic, ColMajor> RefMatrixType;
+  typedef Matrix<Scalar, Dynamic, 1> VectorType;
+  MatrixType a = MatrixType::Random(rows,cols);
+  VectorType v = VectorType::Random(cols), w = VectorType::Random(rows), r(rows), rt = VectorType::Random(cols), rt0 = rt;
+  RefMatrixType b = RefMatrixType::Random(cols,3), c(rows,3);
+
+  r.noalias() = a * v;
+  VERIFY_IS_APPROX(r, VectorType(RefMatrixType(a).lazyProduct(v)));
+  rt.noalias() += a.adjoint() * w;
+  VERIFY_IS_APPROX(rt, VectorType(rt0 + RefMatrixType(a.adjoint()).lazyProduct(w)));
+  c.noalias() = a * b;
+  VERIFY_IS_APPROX(c, RefMatrixType(RefMatrixType(a).lazyProduct(b)));
+}
+
+template<typename SparseMatrixType> void check_sparse_dense_products(int rows, int cols, int rhsCols)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+
+  // a few dense outer vectors among sparse ones, to check the balancing of the nonzeros
+  std::vector<Triplet<Scalar> > triplets;
+  for(int j=0; j<cols; ++j)
+    for(int i=0; i<rows; ++i)
+      if(internal::random<int>(0,99)<3 || i%97==0 || j%89==0)
+        triplets.push_back(Triplet<Scalar>(i,j,internal::random<Scalar>()));
+  SparseMatrixType m(rows,cols);
+  m.setFromTriplets(triplets.begin(), triplets.end());
+
+  DenseVector v = DenseVector::Random(cols), vt = DenseVector::Random(rows);
+  DenseMatrix b = DenseMatrix::Random(cols,rhsCols), bt = DenseMatrix::Random(rows,rhsCols);
+  Matrix<Scalar,Dynamic,Dynamic,RowMajor> brm = b;
+
+  setNbThreads(1);
+  DenseVector refv = m*v, refvt = m.transpose()*vt;
+  DenseMatrix refb = m*b, refbt = m.transpose()*bt;
+  setNbThreads(0);
+
+  DenseVector rv = m*v;
+  VERIFY_IS_APPROX(rv, refv);
+  rv += m*v;
+  VERIFY_IS_APPROX(rv, 2*refv);
+  DenseVector rvt = m.transpose()*vt;
+  VERIFY_IS_APPROX(rvt, refvt);
+  DenseMatrix rb = m*b;
+  VERIFY_IS_APPROX(rb, refb);
+  rb += m*brm;
+  VERIFY_IS_APPROX(rb, 2*refb);
+  DenseMatrix rbt = m.transpose()*bt;
+  VERIFY_IS_APPROX(rbt, refbt);
+  VERIFY_IS_APPROX(DenseVector(vt.transpose()*m), DenseVector(refvt));
+}
+
+template<typename SparseMatrixType> void check_triplets(int size, int ntriplets)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::Index Index;
+
+  // overlapping dense blocks, like the assembly of finite elements
+  std::vector<Triplet<Scalar,Index> > triplets;
+  while(int(triplets.size())<ntriplets)
+  {
+    int i0 = internal::random<int>(0,size-4), j0 = internal::random<int>(0,size-4);
+    for(int j=j0; j<j0+4; ++j)
+      for(int i=i0; i<i0+4; ++i)
+        triplets.push_back(Triplet<Scalar,Index>(i,j,internal::random<Scalar>()));
+  }
+
+  setNbThreads(1);
+  SparseMatrixType ref(size,size);
+  ref.setFromTriplets(triplets.begin(), triplets.end());
+  TripletPattern<Index> refPattern(triplets.begin(), triplets.end(), size, size, SparseMatrixType::IsRowMajor ? RowMajor : ColMajor);
+  setNbThreads(0);
+
+  // the duplicates are combined in the same order whatever the number of threads
+  SparseMatrixType m(size,size);
+  m.setFromTriplets(triplets.begin(), triplets.end());
+  VERIFY_IS_EQUAL(m.nonZeros(), ref.nonZeros());
+  VERIFY(m.isApprox(ref));
+  TripletPattern<Index> pattern(triplets.begin(), triplets.end(), size, size, SparseMatrixType::IsRowMajor ? RowMajor : ColMajor);
+  VERIFY_IS_EQUAL(pattern.nonZeros(), ref.nonZeros());
+  SparseMatrixType m2;
+  m2.setFromTriplets(triplets.begin(), triplets.end(), pattern);
+  VERIFY(m2.isApprox(ref));
+  m2.setFromTriplets(triplets.begin(), triplets.end(), refPattern);
+  VERIFY(m2.isApprox(ref));
+}
+
+template<typename SparseMatrixType> void check_sparse_products(int size)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  std::vector<Triplet<Scalar> > triplets;
+  for(int j=0; j<size; ++j)
+    for(int k=0; k<8; ++k)
+      triplets.push_back(Triplet<Scalar>(internal::random<int>(0,size-1), j, internal::random<Scalar>()));
+  SparseMatrixType a(size,size), b(size,size);
+  a.setFromTriplets(triplets.begin(), triplets.end());
+  b = a.transpose();
+
+  setNbThreads(1);
+  SparseMatrixType ref = a*b, refPruned = (a*b).pruned(1e-2);
+  setNbThreads(0);
+
+  // the columns of a sparse * sparse product are split among the threads
+  SparseMatrixType c = a*b;
+  VERIFY_IS_EQUAL(c.nonZeros(), ref.nonZeros());
+  VERIFY(c.isApprox(ref));
+  c = (a*b).pruned(1e-2);
+  VERIFY_IS_EQUAL(c.nonZeros(), refPruned.nonZeros());
+  VERIFY(c.isApprox(refPruned));
+
+  SparseProductPattern<SparseMatrixType> pattern(a, b);
+  VERIFY_IS_EQUAL(pattern.nonZeros(), ref.nonZeros());
+  pattern.evaluate(a, b, c);
+  VERIFY(c.isApprox(ref));
+}
+
+template<typename MatrixType> void check_level3_kernels(int size, int cols)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, Dynamic, Dynamic, ColMajor> RefMatrixType;
+  MatrixType a = MatrixType::Random(size,size), b = MatrixType::Random(size,cols), bt = MatrixType::Random(cols,size);
+  a.diagonal().array() += Scalar(size);
+
+  // triangular solves, triangular and selfadjoint products, and rank updates, with the results of a single thread as reference
+  setNbThreads(1);
+  RefMatrixType trsmL = a.template triangularView<Lower>().solve(b);
+  RefMatrixType trsmR = a.template triangularView<Upper>().template solve<OnTheRight>(bt);
+  RefMatrixType trmmL = a.template triangularView<Upper>() * b;
+  RefMatrixType trmmR = bt * a.template triangularView<UnitLower>();
+  RefMatrixType symmL = a.template selfadjointView<Lower>() * b;
+  RefMatrixType symmR = bt * a.template selfadjointView<Upper>();
+  MatrixType syrkL = a, syrkU = a;
+  syrkL.template selfadjointView<Lower>().rankUpdate(b, Scalar(2));
+  syrkU.template triangularView<Upper>() -= b * b.adjoint();
+  setNbThreads(0);
+
+  VERIFY_IS_APPROX(MatrixType(a.template triangularView<Lower>().solve(b)), MatrixType(trsmL));
+  VERIFY_IS_APPROX(MatrixType(a.template triangularView<Upper>().template solve<OnTheRight>(bt)), MatrixType(trsmR));
+  VERIFY_IS_APPROX(MatrixType(a.template triangularView<Upper>() * b), MatrixType(trmmL));
+  VERIFY_IS_APPROX(MatrixType(bt * a.template triangularView<UnitLower>()), MatrixType(trmmR));
+  VERIFY_IS_APPROX(MatrixType(a.template selfadjointView<Lower>() * b), MatrixType(symmL));
+  VERIFY_IS_APPROX(MatrixType(bt * a.template selfadjointView<Upper>()), MatrixType(symmR));
+  MatrixType c = a;
+  c.template selfadjointView<Lower>().rankUpdate(b, Scalar(2));
+  VERIFY_IS_APPROX(c, syrkL);
+  c = a;
+  c.template triangularView<Upper>() -= b * b.adjoint();
+  VERIFY_IS_APPROX(c, syrkU);
+}
+
+template<typename MatrixType> void check_lookahead_factorizations(int size)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  MatrixType a = MatrixType::Random(size,size), b = MatrixType::Random(size,3);
+  MatrixType spd = a * a.adjoint();
+  spd.diagonal().array() += RealScalar(1);
+
+  PartialPivLU<MatrixType> lu(a);
+  VERIFY_IS_APPROX(lu.reconstructedMatrix(), a);
+  VERIFY_IS_APPROX(a * lu.solve(b), b);
+
+  // the panels are factorized ahead of the trailing updates, but the pivots must be the ones of the sequential
+  // algorithm, at least in double precision where ties are unlikely
+  if(internal::is_same<RealScalar,double>::value)
+  {
+    setNbThreads(1);
+    PartialPivLU<MatrixType> luRef(a);
+    setNbThreads(0);
+    VERIFY(lu.permutationP().indices() == luRef.permutationP().indices());
+    VERIFY_IS_APPROX(lu.matrixLU(), luRef.matrixLU());
+  }
+
+  LLT<MatrixType,Lower> llt(spd);
+  VERIFY(llt.info()==Success);
+  VERIFY_IS_APPROX(llt.reconstructedMatrix(), spd);
+  VERIFY_IS_APPROX(spd * llt.solve(b), b);
+  LLT<MatrixType,Upper> lltUp(spd);
+  VERIFY(lltUp.info()==Success);
+  VERIFY_IS_APPROX(lltUp.reconstructedMatrix(), spd);
+
+  // a matrix which is not positive definite in the middle of a panel factorized ahead
+  int k = internal::random<int>(size/3, size-1);
+  spd.row(k).setZero();
+  spd.col(k).setZero();
+  VERIFY(llt.compute(spd).info()==NumericalIssue);
+  VERIFY(lltUp.compute(spd).info()==NumericalIssue);
+}
+
+template<typename Scalar> void check_sparselu_subtrees(const CountingExecutor& executor, int blocks, int n)
+{
+  typedef SparseMatrix<Scalar> MatrixType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+
+  // independent n x n grids, whose column elimination trees are disjoint subtrees,
+  // coupled by a few border columns and rows factorized after them
+  const int border = 8, size = blocks*n*n + border;
+  std::vector<Triplet<Scalar> > triplets;
+  for(int k=0; k<blocks; ++k)
+    for(int j=0; j<n; ++j)
+      for(int i=0; i<n; ++i)
+      {
+        const int id = k*n*n + i + n*j;
+        triplets.push_back(Triplet<Scalar>(id, id, Scalar(4) + internal::random<Scalar>()));
+        if(i>0)   triplets.push_back(Triplet<Scalar>(id, id-1, internal::random<Scalar>()));
+        if(i<n-1) triplets.push_back(Triplet<Scalar>(id, id+1, internal::random<Scalar>()));
+        if(j>0)   triplets.push_back(Triplet<Scalar>(id, id-n, internal::random<Scalar>()));
+        if(j<n-1) triplets.push_back(Triplet<Scalar>(id, id+n, internal::random<Scalar>()));
+      }
+  for(int b=0; b<border; ++b)
+  {
+    const int id = size-border+b;
+    triplets.push_back(Triplet<Scalar>(id, id, Scalar(4)));
+    for(int k=0; k<blocks; ++k)
+    {
+      const int other = k*n*n + internal::random<int>(0,n*n-1);
+      triplets.push_back(Triplet<Scalar>(id, other, internal::random<Scalar>()));
+      triplets.push_back(Triplet<Scalar>(other, id, internal::random<Scalar>()));
+    }
+  }
+  MatrixType A(size,size);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  DenseMatrix B = DenseMatrix::Random(size,3);
+
+  SparseLU<MatrixType, COLAMDOrdering<int> > seq, par;
+  int calls = executor.calls();
+  seq.setNbThreads(1);
+  seq.compute(A);
+  VERIFY_IS_EQUAL(seq.info(), Success);
+  const int seqCalls = executor.calls() - calls;
+  calls = executor.calls();
+  par.setNbThreads(4);
+  par.compute(A);
+  VERIFY_IS_EQUAL(par.info(), Success);
+  // the subtrees are dispatched to the executor, which the sequential factorization does not need
+  VERIFY(executor.calls()-calls > seqCalls);
+
+  // the subtrees factorized concurrently give the factors of the sequential factorization
+  VERIFY(par.rowsPermutation().indices() == seq.rowsPermutation().indices());
+  VERIFY(par.colsPermutation().indices() == seq.colsPermutation().indices());
+  DenseMatrix L = B, Lref = B, U = B, Uref = B;
+  par.matrixL().solveInPlace(L);
+  seq.matrixL().solveInPlace(Lref);
+  VERIFY_IS_APPROX(L, Lref);
+  par.matrixU().solveInPlace(U);
+  seq.matrixU().solveInPlace(Uref);
+  VERIFY_IS_APPROX(U, Uref);
+
+  DenseMatrix X = par.solve(B);
+  VERIFY_IS_APPROX(A*X, B);
+  VERIFY_IS_APPROX(X, DenseMatrix(seq.solve(B)));
+}
+
+struct nested_products
+{
+  static void run(void* data, int /*id*/, int /*count*/)
+  {
+    bool& ok = *static_cast<bool*>(data);
+    MatrixXf a = MatrixXf::Ones(200,50), b = MatrixXf::Ones(50,150);
+    MatrixXf c = a * b;
+    if(!c.isApprox(MatrixXf::Constant(200,150,50)))
+      ok = false;
+  }
+};
+
+void check_partitions()
+{
+  typedef internal::gemm_partition<DenseIndex> Partition;
+
+  // small products are not worth waking up threads
+  Partition p = internal::compute_gemm_partition<DenseIndex>(40, 40, 40, 40, 8);
+  VERIFY_IS_EQUAL(p.threads(), 1);
+
+  // large square products use all the threads, sharing the rhs if possible
+  p = internal::compute_gemm_partition<DenseIndex>(2000, 2000, 2000, 256, 8);
+  VERIFY_IS_EQUAL(p.threads(), 8);
+  VERIFY_IS_EQUAL(p.pk, 1);
+
+  // tall-skinny products are split along the rows, short-wide ones along the columns
+  p = internal::compute_gemm_partition<DenseIndex>(5000, 40, 300, 256, 8);
+  VERIFY(p.pm==8 && p.pn==1 && p.pk==1);
+  p = internal::compute_gemm_partition<DenseIndex>(40, 5000, 300, 256, 8);
+  VERIFY(p.pm==1 && p.pn==8 && p.pk==1);
+
+  // deep products with a small result are split along the depth
+  p = internal::compute_gemm_partition<DenseIndex>(20, 20, 100000, 256, 8);
+  VERIFY(p.pm==1 && p.pn==1 && p.pk==8);
+}
+
+void test_product_threaded()
+{
+  CALL_SUBTEST( check_partitions() );
+
+  ThreadPool pool(3);
+  VERIFY_IS_EQUAL(pool.numThreads(), 3);
+  VERIFY(ThreadPool::hardwareConcurrency()>=1);
+
+  // default executor: the internal pool, or OpenMP
+  CALL_SUBTEST( check_products<MatrixXf>(internal::random<int>(100,300), internal::random<int>(1,200), internal::random<int>(100,300)) );
+
+  // user executors
+  CountingExecutor executor(pool);
+  setParallelExecutor(&executor);
+  VERIFY(parallelExecutor()==&executor);
+  VERIFY_IS_EQUAL(nbThreads(), 3);
+  CALL_SUBTEST( check_products<MatrixXf>(internal::random<int>(100,300), internal::random<int>(1,200), internal::random<int>(100,300)) );
+  CALL_SUBTEST( check_products<MatrixXd>(internal::random<int>(100,300), internal::random<int>(1,200), internal::random<int>(100,300)) );
+  CALL_SUBTEST( check_products<MatrixXcf>(internal::random<int>(100,200), internal::random<int>(1,100), internal::random<int>(100,200)) );
+  CALL_SUBTEST(( check_products<Matrix<float,Dynamic,Dynamic,RowMajor> >(internal::random<int>(100,300), internal::random<int>(1,200), internal::random<int>(100,300)) ));
+  // tall-skinny, short-wide, and deep products
+  CALL_SUBTEST( check_products<MatrixXd>(internal::random<int>(500,1000), internal::random<int>(50,100), internal::random<int>(16,40)) );
+  CALL_SUBTEST( check_products<MatrixXd>(internal::random<int>(8,40), internal::random<int>(50,100), internal::random<int>(500,1000)) );
+  CALL_SUBTEST( check_products<MatrixXd>(internal::random<int>(1,30), internal::random<int>(4000,6000), internal::random<int>(1,30)) );
+  CALL_SUBTEST(( check_products<Matrix<double,Dynamic,Dynamic,RowMajor> >(internal::random<int>(1,30), internal::random<int>(4000,6000), internal::random<int>(1,30)) ));
+  VERIFY(executor.calls()>0);
+  int denseCalls = executor.calls();
+  CALL_SUBTEST( check_sparse_dense_products<SparseMatrix<double> >(internal::random<int>(300,600), internal::random<int>(300,600), internal::random<int>(2,8)) );
+  CALL_SUBTEST(( check_sparse_dense_products<SparseMatrix<double,RowMajor> >(internal::random<int>(300,600), internal::random<int>(300,600), internal::random<int>(2,8)) ));
+  CALL_SUBTEST( check_sparse_dense_products<SparseMatrix<std::complex<float> > >(internal::random<int>(300,600), internal::random<int>(300,600), internal::random<int>(2,8)) );
+  CALL_SUBTEST( check_triplets<SparseMatrix<double> >(internal::random<int>(1000,3000), internal::random<int>(200000,300000)) );
+  CALL_SUBTEST(( check_triplets<SparseMatrix<std::complex<float>,RowMajor> >(internal::random<int>(1000,3000), internal::random<int>(200000,300000)) ));
+  CALL_SUBTEST( check_sparse_products<SparseMatrix<double> >(internal::random<int>(2000,4000)) );
+  CALL_SUBTEST(( check_sparse_products<SparseMatrix<std::complex<float>,RowMajor> >(internal::random<int>(2000,4000)) ));
+  VERIFY(executor.calls()>denseCalls);
+  int sparseCalls = executor.calls();
+  CALL_SUBTEST( check_level3_kernels<MatrixXd>(internal::random<int>(150,300), internal::random<int>(100,200)) );
+  CALL_SUBTEST(( check_level3_kernels<Matrix<double,Dynamic,Dynamic,RowMajor> >(internal::random<int>(150,300), internal::random<int>(100,200)) ));
+  CALL_SUBTEST( check_level3_kernels<MatrixXcf>(internal::random<int>(100,200), internal::random<int>(64,100)) );
+  VERIFY(executor.calls()>sparseCalls);
+  int level3Calls = executor.calls();
+  CALL_SUBTEST( check_gemv<MatrixXf>(internal::random<int>(500,1000), internal::random<int>(500,1000)) );
+  CALL_SUBTEST(( check_gemv<Matrix<double,Dynamic,Dynamic,RowMajor> >(internal::random<int>(500,1000), internal::random<int>(500,1000)) ));
+  CALL_SUBTEST( check_gemv<MatrixXcf>(internal::random<int>(500,1000), internal::random<int>(500,1000)) );
+  VERIFY(executor.calls()>level3Calls);
+  CALL_SUBTEST( check_lookahead_factorizations<MatrixXd>(internal::random<int>(300,500)) );
+  CALL_SUBTEST(( check_lookahead_factorizations<Matrix<double,Dynamic,Dynamic,RowMajor> >(internal::random<int>(300,500)) ));
+  CALL_SUBTEST( check_lookahead_factorizations<MatrixXcf>(internal::random<int>(200,300)) );
+  CALL_SUBTEST( check_sparselu_subtrees<double>(executor, internal::random<int>(6,10), internal::random<int>(30,40)) );
+  CALL_SUBTEST( check_sparselu_subtrees<std::complex<double> >(executor, internal::random<int>(6,10), internal::random<int>(30,40)) );
+
+  // an executor granting a single task at a time
+  CountingExecutor single(pool, 1);
+  setParallelExecutor(&single);
+  CALL_SUBTEST( check_products<MatrixXf>(internal::random<int>(100,300), internal::random<int>(100,200), internal::random<int>(100,300)) );
+  VERIFY(single.calls()>0);
+
+  // products issued from the tasks of the pool itself only get the idle threads
+  setParallelExecutor(&pool);
+  bool ok = true;
+  pool.run(&nested_products::run, &ok, pool.numThreads());
+  VERIFY(ok);
+
+  setParallelExecutor(0);
+  VERIFY(parallelExecutor()==0);
+}
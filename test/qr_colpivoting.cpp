@@ -68,6 +68,44 @@ template<typename MatrixType, int Cols2> void qr_fixedsize()
   VERIFY_IS_APPROX(m3, m1*m2);
 }
 
+template<typename MatrixType> void qr_blocked()
+{
+  using std::abs;
+  using std::sqrt;
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+
+  // large enough to go through the blocked path, with tall, wide and rank deficient shapes
+  Index rows = internal::random<Index>(64,EIGEN_TEST_MAX_SIZE), cols = internal::random<Index>(64,EIGEN_TEST_MAX_SIZE);
+  if(internal::random<bool>()) rows = (std::max)(rows, 4*cols);
+  Index size = (std::min)(rows,cols);
+  Index rank = internal::random<bool>() ? size : internal::random<Index>(1, size-1);
+
+  MatrixType m1;
+  createRandomPIMatrixOfRank(rank,rows,cols,m1);
+  // columns of very different scales make the norm downdates lose digits quickly
+  for(Index j = 0; j < cols; j += 3)
+    m1.col(j) *= RealScalar(1e-3);
+
+  ColPivHouseholderQR<MatrixType> qr(m1);
+  VERIFY(rank == qr.rank());
+
+  MatrixType r = qr.matrixQR().template triangularView<Upper>();
+  MatrixType c = qr.householderQ() * r * qr.colsPermutation().inverse();
+  VERIFY_IS_APPROX(m1, c);
+
+  // the diagonal of R must be non increasing up to the accuracy of the partial norms
+  RealScalar tol = RealScalar(1) + RealScalar(100) * sqrt(NumTraits<RealScalar>::epsilon());
+  for(Index i = 1; i < qr.rank(); ++i)
+    VERIFY(abs(qr.matrixQR().coeff(i,i)) <= tol * abs(qr.matrixQR().coeff(i-1,i-1)));
+
+  MatrixType m2 = MatrixType::Random(cols,4);
+  MatrixType m3 = m1*m2;
+  m2 = qr.solve(m3);
+  VERIFY_IS_APPROX(m3, m1*m2);
+}
+
 template<typename MatrixType> void qr_invertible()
 {
   using std::log;
@@ -131,6 +169,12 @@ void test_qr_colpivoting()
     CALL_SUBTEST_5(( qr_fixedsize<Matrix<double,1,1>, 1 >() ));
   }
 
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_10( qr_blocked<MatrixXd>() );
+    CALL_SUBTEST_10(( qr_blocked<Matrix<double,Dynamic,Dynamic,RowMajor> >() ));
+    CALL_SUBTEST_11( qr_blocked<MatrixXcf>() );
+  }
+
   for(int i = 0; i < g_repeat; i++) {
     CALL_SUBTEST_1( qr_invertible<MatrixXf>() );
     CALL_SUBTEST_2( qr_invertible<MatrixXd>() );
@@ -0,0 +1,137 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_RUNTIME_DISPATCH
+#include "main.h"
+
+// The kernels are taken from static libraries, so make sure they are linked in.
+void register_kernels()
+{
+#ifdef EIGEN_TEST_RUNTIME_DISPATCH_SSE4_2
+  eigen_runtime_dispatch::register_kernels_sse4_2();
+#endif
+#ifdef EIGEN_TEST_RUNTIME_DISPATCH_AVX2
+  eigen_runtime_dispatch::register_kernels_avx2();
+#endif
+#ifdef EIGEN_TEST_RUNTIME_DISPATCH_AVX512
+  eigen_runtime_dispatch::register_kernels_avx512();
+#endif
+}
+
+void runtime_dispatch_selection(int maxLevel)
+{
+  int expected = -1;
+  for(int level = (std::min)(maxLevel, internal::querySimdLevel()); level>=0 && expected<0; --level)
+    if(eigen_runtime_dispatch::registered_table(level))
+      expected = level;
+
+  const eigen_runtime_dispatch::table* table = internal::runtime_dispatch_table();
+  if(expected<0)
+    VERIFY(table==0);
+  else
+  {
+    VERIFY(table!=0);
+    VERIFY_IS_EQUAL(table->level, expected);
+  }
+}
+
+template<typename MatrixType> void runtime_dispatch_products(const MatrixType& m)
+{
+  typedef typename MatrixType::Index Index;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMajorMatrix;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+
+  Index rows = m.rows(), cols = m.cols(), depth = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+  MatrixType a = MatrixType::Random(rows,depth), b = MatrixType::Random(depth,cols), c = MatrixType::Random(rows,cols), r;
+  RowMajorMatrix aT = a, bT = b;
+  Scalar s = internal::random<Scalar>();
+
+  // the references are computed with coefficient-based products, which are never dispatched
+  MatrixType ref = c + s * a.lazyProduct(b);
+  r = c; r.noalias() += s * a * b;       VERIFY_IS_APPROX(r, ref);
+  r = c; r.noalias() += s * aT * b;      VERIFY_IS_APPROX(r, ref);
+  r = c; r.noalias() += s * a * bT;      VERIFY_IS_APPROX(r, ref);
+  r = c; r.noalias() += s * aT * bT;     VERIFY_IS_APPROX(r, ref);
+  RowMajorMatrix rT = c; rT.noalias() += s * a * b;
+  VERIFY_IS_APPROX(rT, ref);
+
+  VectorType v = VectorType::Random(depth), w = VectorType::Random(rows), u;
+  VectorType refv = w + s * a.lazyProduct(v);
+  u = w; u.noalias() += s * a * v;       VERIFY_IS_APPROX(u, refv);
+  u = w; u.noalias() += s * aT * v;      VERIFY_IS_APPROX(u, refv);
+
+  MatrixType sq = MatrixType::Random(rows,rows) + MatrixType::Identity(rows,rows) * Scalar(rows);
+  MatrixType lower = sq.template triangularView<Lower>(), unitUpper = sq.template triangularView<UnitUpper>();
+  MatrixType rhs = MatrixType::Random(rows,cols), lhs = MatrixType::Random(cols,rows);
+
+  VERIFY_IS_APPROX(r = sq.template triangularView<Lower>() * rhs, lower.lazyProduct(rhs));
+  VERIFY_IS_APPROX(r = lhs * sq.template triangularView<UnitUpper>(), lhs.lazyProduct(unitUpper));
+  VERIFY_IS_APPROX(rT = RowMajorMatrix(sq).template triangularView<StrictlyUpper>() * rhs,
+                   MatrixType(sq.template triangularView<StrictlyUpper>()).lazyProduct(rhs));
+
+  r = sq.template triangularView<Lower>().solve(rhs);
+  VERIFY_IS_APPROX(lower.lazyProduct(r), rhs);
+  r = sq.template triangularView<Upper>().template solve<OnTheRight>(lhs);
+  VERIFY_IS_APPROX(r.lazyProduct(MatrixType(sq.template triangularView<Upper>())), lhs);
+  // random unit triangular matrices are ill-conditioned unless their off-diagonal part is small
+  MatrixType small = MatrixType::Random(rows,rows) / Scalar(rows);
+  r = small.template triangularView<UnitLower>().solve(rhs);
+  VERIFY_IS_APPROX(MatrixType(small.template triangularView<UnitLower>()).lazyProduct(r), rhs);
+  rT = RowMajorMatrix(sq).template triangularView<Lower>().solve(rhs);
+  VERIFY_IS_APPROX(lower.lazyProduct(rT), rhs);
+}
+
+template<typename Scalar> void runtime_dispatch_math(int size)
+{
+  typedef Array<Scalar,Dynamic,1> ArrayType;
+  ArrayType x = ArrayType::Random(size), px = x.abs() + Scalar(0.5), y(size), ref(size);
+
+  for(int i=0; i<size; ++i) ref(i) = std::exp(x(i));
+  VERIFY_IS_APPROX(y = x.exp(), ref);
+  for(int i=0; i<size; ++i) ref(i) = std::log(px(i));
+  VERIFY_IS_APPROX(y = px.log(), ref);
+  for(int i=0; i<size; ++i) ref(i) = std::sqrt(px(i));
+  VERIFY_IS_APPROX(y = px.sqrt(), ref);
+  for(int i=0; i<size; ++i) ref(i) = std::sin(x(i));
+  VERIFY_IS_APPROX(y = x.sin(), ref);
+  for(int i=0; i<size; ++i) ref(i) = std::cos(x(i));
+  VERIFY_IS_APPROX(y = x.cos(), ref);
+  for(int i=0; i<size; ++i) ref(i) = std::tanh(x(i));
+  VERIFY_IS_APPROX(y = x.tanh(), ref);
+  for(int i=0; i<size; ++i) ref(i) = std::atan(x(i));
+  VERIFY_IS_APPROX(y = x.atan(), ref);
+  for(int i=0; i<size; ++i) ref(i) = internal::scalar_logistic_op<Scalar>()(x(i));
+  VERIFY_IS_APPROX(y = x.logistic(), ref);
+  for(int i=0; i<size; ++i) ref(i) = internal::scalar_erf_op<Scalar>()(x(i));
+  VERIFY_IS_APPROX(y = x.erf(), ref);
+
+  // inner vectorized traversal of a block
+  Matrix<Scalar,Dynamic,Dynamic> m = Matrix<Scalar,Dynamic,Dynamic>::Random(size,5), e(size-1,3);
+  e = m.block(1,1,size-1,3).array().exp().matrix();
+  for(int j=0; j<3; ++j)
+    for(int i=0; i<size-1; ++i)
+      VERIFY_IS_APPROX(e(i,j), std::exp(m(i+1,j+1)));
+}
+
+void test_runtime_dispatch()
+{
+  register_kernels();
+
+  for(int level = internal::SimdLevelSSE2; level <= internal::SimdLevelAVX512; ++level)
+  {
+    internal::runtime_dispatch_max_level() = level;
+    CALL_SUBTEST_1( runtime_dispatch_selection(level) );
+    for(int i = 0; i < g_repeat; i++) {
+      CALL_SUBTEST_2( runtime_dispatch_products(MatrixXf(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE))) );
+      CALL_SUBTEST_3( runtime_dispatch_products(MatrixXd(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE))) );
+      CALL_SUBTEST_4( runtime_dispatch_math<float>(internal::random<int>(EIGEN_RUNTIME_DISPATCH_MATH_THRESHOLD,1000)) );
+      CALL_SUBTEST_4( runtime_dispatch_math<double>(internal::random<int>(EIGEN_RUNTIME_DISPATCH_MATH_THRESHOLD,1000)) );
+    }
+  }
+  internal::runtime_dispatch_max_level() = internal::SimdLevelAVX512;
+}
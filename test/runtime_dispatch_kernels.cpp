@@ -0,0 +1,10 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// The kernels of the runtime_dispatch test, this file is compiled once per instruction set.
+#define EIGEN_RUNTIME_DISPATCH_KERNELS
+#include <Eigen/Core>
@@ -88,4 +88,7 @@ void test_schur_complex()
 
   // Test problem size constructors
   CALL_SUBTEST_5(ComplexSchur<MatrixXf>(10));
+
+  // Large matrices are reduced to Hessenberg form by blocks
+  CALL_SUBTEST_6(( schur<MatrixXd>(internal::random<int>(65,EIGEN_TEST_MAX_SIZE/2)) ));
 }
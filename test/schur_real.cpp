@@ -100,6 +100,36 @@ template<typename MatrixType> void schur(int size = MatrixType::ColsAtCompileTim
   }
 }
 
+template<typename MatrixType> void schur_multishift(int size)
+{
+  typedef typename MatrixType::Scalar Scalar;
+
+  // matrices on which the multishift QR iterations and the aggressive early deflation are likely to stagnate
+  MatrixType cyclic = MatrixType::Zero(size, size);
+  for(int i = 0; i < size; ++i)
+    cyclic((i+1) % size, i) = Scalar(1);
+  Matrix<Scalar,Dynamic,1> eigenvalues = Matrix<Scalar,Dynamic,1>::Ones(size);
+  eigenvalues.head(size/2) *= Scalar(2);
+  MatrixType Q = MatrixType::Random(size, size).householderQr().householderQ();
+  MatrixType clustered = Q * eigenvalues.asDiagonal() * Q.transpose();
+  MatrixType frank(size, size);
+  for(int i = 0; i < size; ++i)
+    for(int j = 0; j < size; ++j)
+      frank(i,j) = j >= i-1 ? Scalar(size - (std::max)(i,j)) : Scalar(0);
+
+  MatrixType tests[3] = { cyclic, clustered, frank };
+  for(int k = 0; k < 3; ++k)
+  {
+    RealSchur<MatrixType> schurOfA(tests[k]);
+    VERIFY_IS_EQUAL(schurOfA.info(), Success);
+    MatrixType U = schurOfA.matrixU();
+    MatrixType T = schurOfA.matrixT();
+    verifyIsQuasiTriangular(T);
+    VERIFY_IS_UNITARY(U);
+    VERIFY_IS_APPROX(tests[k], U * T * U.transpose());
+  }
+}
+
 void test_schur_real()
 {
   CALL_SUBTEST_1(( schur<Matrix4f>() ));
@@ -109,4 +139,9 @@ void test_schur_real()
 
   // Test problem size constructors
   CALL_SUBTEST_5(RealSchur<MatrixXf>(10));
+
+  // Large matrices go through the multishift QR algorithm
+  CALL_SUBTEST_6(( schur<MatrixXd>(internal::random<int>(75,EIGEN_TEST_MAX_SIZE/2)) ));
+  CALL_SUBTEST_7(( schur<Matrix<double,Dynamic,Dynamic,RowMajor> >(internal::random<int>(75,EIGEN_TEST_MAX_SIZE/2)) ));
+  CALL_SUBTEST_7(( schur_multishift<MatrixXd>(internal::random<int>(75,EIGEN_TEST_MAX_SIZE/2)) ));
 }
@@ -9,8 +9,14 @@
 // Public License v. 2.0. If a copy of the MPL was not distributed
 // with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <list>
 #include "sparse.h"
 
+template<typename Scalar> struct keep_last_value
+{
+  Scalar operator()(const Scalar&, const Scalar& b) const { return b; }
+};
+
 template<typename SparseMatrixType> void sparse_basic(const SparseMatrixType& ref)
 {
   typedef typename SparseMatrixType::Index Index;
@@ -381,6 +387,54 @@ template<typename SparseMatrixType> void sparse_basic(const SparseMatrixType& re
     SparseMatrixType m(rows,cols);
     m.setFromTriplets(triplets.begin(), triplets.end());
     VERIFY_IS_APPROX(m, refMat);
+
+    // user defined combination of the duplicates
+    DenseMatrix refLast(rows,cols);
+    refLast.setZero();
+    for(int i=0;i<ntriplets;++i)
+      refLast(triplets[i].row(),triplets[i].col()) = triplets[i].value();
+    m.setFromTriplets(triplets.begin(), triplets.end(), keep_last_value<Scalar>());
+    VERIFY_IS_APPROX(m, refLast);
+
+    // reuse of the pattern with other values
+    TripletPattern<Index> pattern(triplets.begin(), triplets.end(), rows, cols, Flags&RowMajorBit ? RowMajor : ColMajor);
+    VERIFY_IS_EQUAL(pattern.size(), Index(ntriplets));
+    VERIFY_IS_EQUAL(pattern.nonZeros(), m.nonZeros());
+    for(int i=0;i<ntriplets;++i)
+      triplets[i] = TripletType(triplets[i].row(), triplets[i].col(), internal::random<Scalar>());
+    refMat.setZero();
+    refLast.setZero();
+    for(int i=0;i<ntriplets;++i)
+    {
+      refMat(triplets[i].row(),triplets[i].col()) += triplets[i].value();
+      refLast(triplets[i].row(),triplets[i].col()) = triplets[i].value();
+    }
+    SparseMatrixType m2;
+    m2.setFromTriplets(triplets.begin(), triplets.end(), pattern);
+    VERIFY_IS_APPROX(m2, refMat);
+    VERIFY(m2.isCompressed());
+    m2.setFromTriplets(triplets.begin(), triplets.end(), pattern, keep_last_value<Scalar>());
+    VERIFY_IS_APPROX(m2, refLast);
+
+    // triplets given by non random access iterators
+    std::list<TripletType> tripletList(triplets.begin(), triplets.end());
+    m.setFromTriplets(tripletList.begin(), tripletList.end());
+    VERIFY_IS_APPROX(m, refMat);
+    m.setFromTriplets(tripletList.begin(), tripletList.end(), keep_last_value<Scalar>());
+    VERIFY_IS_APPROX(m, refLast);
+    TripletPattern<Index> listPattern(tripletList.begin(), tripletList.end(), rows, cols, Flags&RowMajorBit ? RowMajor : ColMajor);
+    VERIFY_IS_EQUAL(listPattern.nonZeros(), pattern.nonZeros());
+    m2.setFromTriplets(tripletList.begin(), tripletList.end(), listPattern);
+    VERIFY_IS_APPROX(m2, refMat);
+    m2.setFromTriplets(tripletList.begin(), tripletList.end(), pattern, keep_last_value<Scalar>());
+    VERIFY_IS_APPROX(m2, refLast);
+
+    // out of range triplets
+    triplets.push_back(TripletType(rows,0,Scalar(1)));
+    VERIFY_RAISES_ASSERT(m.setFromTriplets(triplets.begin(), triplets.end()));
+    VERIFY_RAISES_ASSERT(pattern.compute(triplets.begin(), triplets.end(), rows, cols));
+    triplets.back() = TripletType(0,-1,Scalar(1));
+    VERIFY_RAISES_ASSERT(m.setFromTriplets(triplets.begin(), triplets.end()));
   }
 
   // test triangularView
@@ -196,6 +196,77 @@ template<typename SparseMatrixType> void sparse_product()
   }
 }
 
+// SparseMatrix only features of the sparse * sparse products
+template<typename SparseMatrixType> void sparse_product_phases()
+{
+  typedef typename SparseMatrixType::Index Index;
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  const Index rows  = internal::random<int>(1,100);
+  const Index cols  = internal::random<int>(1,100);
+  const Index depth = internal::random<int>(1,100);
+  double density = (std::max)(8./(rows*cols), 0.1);
+  Scalar s1 = internal::random<Scalar>();
+  Scalar s2 = internal::random<Scalar>();
+
+  DenseMatrix refMat2  = DenseMatrix::Zero(rows, depth);
+  DenseMatrix refMat2t = DenseMatrix::Zero(depth, rows);
+  DenseMatrix refMat3  = DenseMatrix::Zero(depth, cols);
+  DenseMatrix refMat4  = DenseMatrix::Zero(rows, cols);
+  SparseMatrixType m2 (rows, depth);
+  SparseMatrixType m2t(depth, rows);
+  SparseMatrixType m3 (depth, cols);
+  SparseMatrixType m4 (rows, cols);
+  initSparse(density, refMat2,  m2);
+  initSparse(density, refMat2t, m2t);
+  initSparse(density, refMat3,  m3);
+
+  // symbolic and numeric phases
+  {
+    SparseProductPattern<SparseMatrixType> pattern(m2, m3);
+    SparseMatrixType m5;
+    m5 = m2*m3;
+    VERIFY_IS_EQUAL(pattern.nonZeros(), m5.nonZeros());
+    pattern.evaluate(m2, m3, m4);
+    VERIFY(m4.isCompressed());
+    VERIFY_IS_APPROX(m4, refMat4=refMat2*refMat3);
+    // new values with the same structure
+    SparseMatrixType m2s = m2*s1, m3s = m3;
+    Map<Matrix<Scalar,Dynamic,1> >(m3s.valuePtr(), m3s.nonZeros()) *= s2;
+    refMat4 = DenseMatrix(m2s)*DenseMatrix(m3s);
+    pattern.evaluate(m2s, m3s, m4);
+    VERIFY_IS_APPROX(m4, refMat4);
+    // chained products analyzed from the structure of the intermediate result
+    SparseMatrixType m7;
+    SparseProductPattern<SparseMatrixType> pattern2(m2t, pattern.structure());
+    pattern2.evaluate(m2t, m4, m7);
+    VERIFY_IS_APPROX(m7, DenseMatrix(refMat2t*refMat4));
+  }
+
+  // operands whose structure is not covered by the pattern
+  {
+    SparseMatrixType a(3,3), b(3,3), c;
+    a.insert(0,0) = Scalar(1);
+    b.insert(0,0) = Scalar(1);
+    SparseProductPattern<SparseMatrixType> pattern(a, b);
+    a.insert(1,0) = Scalar(1);
+    VERIFY_RAISES_ASSERT(pattern.evaluate(a, b, c));
+  }
+
+  // hypersparse products, whose columns are accumulated into hash tables
+  {
+    Index m = internal::random<Index>(500,1000);
+    DenseMatrix refA = DenseMatrix::Zero(m, m), refB = DenseMatrix::Zero(m, m);
+    SparseMatrixType a(m, m), b(m, m);
+    initSparse<Scalar>(2./double(m), refA, a);
+    initSparse<Scalar>(2./double(m), refB, b);
+    SparseMatrixType c = a*b;
+    VERIFY(c.isCompressed());
+    VERIFY_IS_APPROX(c, refA*refB);
+    VERIFY_IS_APPROX(c=(a*b).pruned(), refA*refB);
+  }
+}
+
 // New test for Bug in SparseTimeDenseProduct
 template<typename SparseMatrixType, typename DenseMatrixType> void sparse_product_regression_test()
 {
@@ -225,6 +296,9 @@ void test_sparse_product()
     CALL_SUBTEST_1( (sparse_product<SparseMatrix<double,RowMajor> >()) );
     CALL_SUBTEST_2( (sparse_product<SparseMatrix<std::complex<double>, ColMajor > >()) );
     CALL_SUBTEST_2( (sparse_product<SparseMatrix<std::complex<double>, RowMajor > >()) );
+    CALL_SUBTEST_1( (sparse_product_phases<SparseMatrix<double,ColMajor> >()) );
+    CALL_SUBTEST_1( (sparse_product_phases<SparseMatrix<double,RowMajor> >()) );
+    CALL_SUBTEST_2( (sparse_product_phases<SparseMatrix<std::complex<double>, ColMajor > >()) );
     CALL_SUBTEST_4( (sparse_product_regression_test<SparseMatrix<double,RowMajor>, Matrix<double, Dynamic, Dynamic, RowMajor> >()) );
   }
 }
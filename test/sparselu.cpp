@@ -46,10 +46,55 @@ template<typename T> void test_sparselu_T()
   check_sparse_square_solving(sparselu_natural);
 }
 
+// the 5 points stencil of a grid, with unsymmetric coefficients requiring some pivoting,
+// whose column elimination tree has many independent subtrees
+template<typename T> void test_sparselu_subtrees()
+{
+  typedef SparseMatrix<T, ColMajor> MatrixType;
+  typedef Matrix<T,Dynamic,1> DenseVector;
+  int n = internal::random<int>(60,100), size = n*n;
+  std::vector<Triplet<T> > triplets;
+  for(int j=0; j<n; ++j)
+    for(int i=0; i<n; ++i)
+    {
+      int id = i + n*j;
+      triplets.push_back(Triplet<T>(id, id, internal::random<T>()));
+      if(i>0)   triplets.push_back(Triplet<T>(id, id-1, internal::random<T>()));
+      if(i<n-1) triplets.push_back(Triplet<T>(id, id+1, internal::random<T>()));
+      if(j>0)   triplets.push_back(Triplet<T>(id, id-n, internal::random<T>()));
+      if(j<n-1) triplets.push_back(Triplet<T>(id, id+n, internal::random<T>()));
+    }
+  MatrixType A(size,size);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  DenseVector b = DenseVector::Random(size);
+
+  SparseLU<MatrixType, COLAMDOrdering<int> > seq, par;
+  seq.setNbThreads(1);
+  seq.compute(A);
+  VERIFY_IS_EQUAL(seq.info(), Success);
+  par.setNbThreads(4);
+  par.compute(A);
+  VERIFY_IS_EQUAL(par.info(), Success);
+
+  DenseVector x = par.solve(b);
+  VERIFY_IS_APPROX(A*x, b);
+  VERIFY_IS_APPROX(x, DenseVector(seq.solve(b)));
+  VERIFY_IS_APPROX(par.logAbsDeterminant(), seq.logAbsDeterminant());
+  VERIFY_IS_EQUAL(par.signDeterminant(), seq.signDeterminant());
+
+  // a new factorization with the same pattern
+  A = A * T(2);
+  par.factorize(A);
+  VERIFY_IS_EQUAL(par.info(), Success);
+  VERIFY_IS_APPROX(A*DenseVector(par.solve(b)), b);
+}
+
 void test_sparselu()
 {
   CALL_SUBTEST_1(test_sparselu_T<float>()); 
   CALL_SUBTEST_2(test_sparselu_T<double>());
   CALL_SUBTEST_3(test_sparselu_T<std::complex<float> >()); 
   CALL_SUBTEST_4(test_sparselu_T<std::complex<double> >());
+  CALL_SUBTEST_5(test_sparselu_subtrees<double>());
+  CALL_SUBTEST_6(test_sparselu_subtrees<std::complex<double> >());
 }
@@ -0,0 +1,81 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse_solver.h"
+
+// the 7 points Laplacian of a n^3 grid, whose factors have large supernodes
+template<typename T> void test_supernodal_cholesky_grid()
+{
+  typedef SparseMatrix<T> MatrixType;
+  typedef Matrix<T,Dynamic,Dynamic> DenseMatrix;
+  int n = internal::random<int>(4,12);
+  int size = n*n*n;
+  std::vector<Triplet<T> > triplets;
+  for(int k=0; k<n; ++k)
+    for(int j=0; j<n; ++j)
+      for(int i=0; i<n; ++i)
+      {
+        int id = i + n*(j + n*k);
+        triplets.push_back(Triplet<T>(id, id, T(6.1)));
+        if(i>0) triplets.push_back(Triplet<T>(id, id-1, T(-1)));
+        if(j>0) triplets.push_back(Triplet<T>(id, id-n, T(-1)));
+        if(k>0) triplets.push_back(Triplet<T>(id, id-n*n, T(-1)));
+      }
+  MatrixType A(size,size);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+
+  SupernodalLLT<MatrixType, Lower> llt(A);
+  VERIFY_IS_EQUAL(llt.info(), Success);
+  VERIFY(llt.supernodes() < size);
+
+  DenseMatrix b = DenseMatrix::Random(size, 3);
+  DenseMatrix x = llt.solve(b);
+  MatrixType Afull;
+  Afull = A.template selfadjointView<Lower>();
+  VERIFY_IS_APPROX(Afull*x, b);
+
+  SimplicialLLT<MatrixType, Lower> ref(A);
+  VERIFY_IS_APPROX(x, ref.solve(b));
+
+  // P A P^-1 = L L^*
+  MatrixType L = llt.matrixL();
+  MatrixType PAP, LLt;
+  PAP.template selfadjointView<Upper>() = A.template selfadjointView<Lower>().twistedBy(llt.permutationP());
+  LLt = L * MatrixType(L.adjoint());
+  VERIFY_IS_APPROX(DenseMatrix(LLt.template triangularView<Upper>()), DenseMatrix(PAP));
+
+  // a new factorization with the same pattern and a shift
+  llt.setShift(1).factorize(A);
+  VERIFY_IS_EQUAL(llt.info(), Success);
+  for(int i=0; i<size; ++i)
+    Afull.coeffRef(i,i) += T(1);
+  VERIFY_IS_APPROX(Afull*llt.solve(b), b);
+
+  // not positive definite
+  llt.setShift(-10).factorize(A);
+  VERIFY_IS_EQUAL(llt.info(), NumericalIssue);
+}
+
+template<typename T> void test_supernodal_cholesky_T()
+{
+  SupernodalLLT<SparseMatrix<T>, Lower> llt_colmajor_lower;
+  SupernodalLLT<SparseMatrix<T>, Upper> llt_colmajor_upper;
+
+  check_sparse_spd_solving(llt_colmajor_lower);
+  check_sparse_spd_solving(llt_colmajor_upper);
+
+  check_sparse_spd_determinant(llt_colmajor_lower);
+  check_sparse_spd_determinant(llt_colmajor_upper);
+
+  test_supernodal_cholesky_grid<T>();
+}
+
+void test_supernodal_cholesky()
+{
+  CALL_SUBTEST_1(test_supernodal_cholesky_T<double>());
+  CALL_SUBTEST_2(test_supernodal_cholesky_T<std::complex<double> >());
+}
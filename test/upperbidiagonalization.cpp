@@ -40,4 +40,8 @@ void test_upperbidiagonalization()
    CALL_SUBTEST_6( upperbidiag(Matrix<float,5,5>()) );
    CALL_SUBTEST_7( upperbidiag(Matrix<double,4,3>()) );
   }
+
+  // large enough for the blocked reduction
+  CALL_SUBTEST_8( upperbidiag(MatrixXd(internal::random<int>(100,150),100)) );
+  CALL_SUBTEST_9( upperbidiag(MatrixXcf(internal::random<int>(70,100),70)) );
 }
@@ -75,7 +75,11 @@ bool test_redux(const Xpr&, int traversal, int unrolling)
   return res;
 }
 
-template<typename Scalar, bool Enable = internal::packet_traits<Scalar>::Vectorizable> struct vectorization_logic
+// the fixed size cases below assume that a packet spans the whole static alignment,
+// which is not the case of the 256 bits complex packets when compiling for AVX512
+template<typename Scalar, bool Enable = internal::packet_traits<Scalar>::Vectorizable
+                                     && int(internal::packet_traits<Scalar>::size)*sizeof(Scalar)==EIGEN_ALIGN_BYTES>
+struct vectorization_logic
 {
   enum {
     PacketSize = internal::packet_traits<Scalar>::size
@@ -91,22 +95,22 @@ template<typename Scalar, bool Enable = internal::packet_traits<Scalar>::Vectori
     typedef Matrix<Scalar,(Matrix11::Flags&RowMajorBit)?16:4*PacketSize,(Matrix11::Flags&RowMajorBit)?4*PacketSize:16> Matrix44;
     typedef Matrix<Scalar,(Matrix11::Flags&RowMajorBit)?16:4*PacketSize,(Matrix11::Flags&RowMajorBit)?4*PacketSize:16,DontAlign|EIGEN_DEFAULT_MATRIX_STORAGE_ORDER_OPTION> Matrix44u;
     typedef Matrix<Scalar,4*PacketSize,16,ColMajor> Matrix44c;
-    typedef Matrix<Scalar,4*PacketSize,16,RowMajor> Matrix44r;
+    typedef Matrix<Scalar,16,4*PacketSize,RowMajor> Matrix44r;
 
     typedef Matrix<Scalar,
-        (PacketSize==8 ? 4 : PacketSize==4 ? 2 : PacketSize==2 ? 1 : /*PacketSize==1 ?*/ 1),
-        (PacketSize==8 ? 2 : PacketSize==4 ? 2 : PacketSize==2 ? 2 : /*PacketSize==1 ?*/ 1)
+        (PacketSize==16 ? 4 : PacketSize==8 ? 4 : PacketSize==4 ? 2 : PacketSize==2 ? 1 : /*PacketSize==1 ?*/ 1),
+        (PacketSize==16 ? 4 : PacketSize==8 ? 2 : PacketSize==4 ? 2 : PacketSize==2 ? 2 : /*PacketSize==1 ?*/ 1)
       > Matrix1;
 
     typedef Matrix<Scalar,
-        (PacketSize==8 ? 4 : PacketSize==4 ? 2 : PacketSize==2 ? 1 : /*PacketSize==1 ?*/ 1),
-        (PacketSize==8 ? 2 : PacketSize==4 ? 2 : PacketSize==2 ? 2 : /*PacketSize==1 ?*/ 1),
+        (PacketSize==16 ? 4 : PacketSize==8 ? 4 : PacketSize==4 ? 2 : PacketSize==2 ? 1 : /*PacketSize==1 ?*/ 1),
+        (PacketSize==16 ? 4 : PacketSize==8 ? 2 : PacketSize==4 ? 2 : PacketSize==2 ? 2 : /*PacketSize==1 ?*/ 1),
       DontAlign|((Matrix1::Flags&RowMajorBit)?RowMajor:ColMajor)> Matrix1u;
 
     // this type is made such that it can only be vectorized when viewed as a linear 1D vector
     typedef Matrix<Scalar,
-        (PacketSize==8 ? 4 : PacketSize==4 ? 6 : PacketSize==2 ? ((Matrix11::Flags&RowMajorBit)?2:3) : /*PacketSize==1 ?*/ 1),
-        (PacketSize==8 ? 6 : PacketSize==4 ? 2 : PacketSize==2 ? ((Matrix11::Flags&RowMajorBit)?3:2) : /*PacketSize==1 ?*/ 3)
+        (PacketSize==16 ? 4 : PacketSize==8 ? 4 : PacketSize==4 ? 6 : PacketSize==2 ? ((Matrix11::Flags&RowMajorBit)?2:3) : /*PacketSize==1 ?*/ 1),
+        (PacketSize==16 ? 12 : PacketSize==8 ? 6 : PacketSize==4 ? 2 : PacketSize==2 ? ((Matrix11::Flags&RowMajorBit)?3:2) : /*PacketSize==1 ?*/ 3)
       > Matrix3;
     
     #if !EIGEN_GCC_AND_ARCH_DOESNT_WANT_STACK_ALIGNMENT
@@ -156,8 +160,10 @@ template<typename Scalar, bool Enable = internal::packet_traits<Scalar>::Vectori
       VERIFY(test_assign(Matrix<Scalar,17,17>(),Matrix<Scalar,17,17>()+Matrix<Scalar,17,17>(),
         LinearTraversal,NoUnrolling));
 
-      VERIFY(test_assign(Matrix11(),Matrix<Scalar,17,17>().template block<PacketSize,PacketSize>(2,3)+Matrix<Scalar,17,17>().template block<PacketSize,PacketSize>(10,4),
-      DefaultTraversal,CompleteUnrolling));
+      // odd sized so that the blocks cannot be aligned, and large enough to hold them
+      typedef Matrix<Scalar,PacketSize<=8?17:2*PacketSize+9,PacketSize<=8?17:2*PacketSize+9> MatrixOdd;
+      VERIFY(test_assign(Matrix11(),MatrixOdd().template block<PacketSize,PacketSize>(2,3)+MatrixOdd().template block<PacketSize,PacketSize>(8,4),
+      DefaultTraversal,PacketSize>4?InnerUnrolling:CompleteUnrolling));
     }
     
     VERIFY(test_redux(Matrix3(),
@@ -167,7 +173,7 @@ template<typename Scalar, bool Enable = internal::packet_traits<Scalar>::Vectori
       LinearVectorizedTraversal,NoUnrolling));
 
     VERIFY(test_redux(Matrix44().template block<(Matrix1::Flags&RowMajorBit)?4:PacketSize,(Matrix1::Flags&RowMajorBit)?PacketSize:4>(1,2),
-      DefaultTraversal,CompleteUnrolling));
+      DefaultTraversal,(4*PacketSize*int(NumTraits<Scalar>::ReadCost)+(4*PacketSize-1)*int(NumTraits<Scalar>::AddCost))>EIGEN_UNROLLING_LIMIT ? NoUnrolling : CompleteUnrolling));
 
     VERIFY(test_redux(Matrix44c().template block<2*PacketSize,1>(1,2),
       LinearVectorizedTraversal,CompleteUnrolling));
@@ -183,9 +189,13 @@ template<typename Scalar, bool Enable = internal::packet_traits<Scalar>::Vectori
     VERIFY((test_assign<
             Map<Matrix22, Aligned, InnerStride<3*PacketSize> >,
             Matrix22
-            >(DefaultTraversal,CompleteUnrolling)));
+            >(DefaultTraversal,
+              // with wide packets (AVX) Matrix22 becomes too large to be completely unrolled
+              Matrix22::SizeAtCompileTime*int(NumTraits<Scalar>::ReadCost)>EIGEN_UNROLLING_LIMIT ? InnerUnrolling : CompleteUnrolling)));
 
-    VERIFY((test_assign(Matrix11(), Matrix11()*Matrix11(), InnerVectorizedTraversal, CompleteUnrolling)));
+    // with wide packets (AVX) Matrix11*Matrix11 is too large to be a completely unrolled lazy product
+    if(PacketSize*int(NumTraits<Scalar>::ReadCost)<=4)
+      VERIFY((test_assign(Matrix11(), Matrix11()*Matrix11(), InnerVectorizedTraversal, CompleteUnrolling)));
     #endif
 
     VERIFY(test_assign(MatrixXX(10,10),MatrixXX(20,20).block(10,10,2,3),
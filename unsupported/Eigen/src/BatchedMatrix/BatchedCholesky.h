@@ -0,0 +1,375 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_BATCHED_CHOLESKY_H
+#define EIGEN_BATCHED_CHOLESKY_H
+
+namespace Eigen {
+
+/** \ingroup BatchedMatrix_Module
+  *
+  * \class BatchedLLT
+  *
+  * \brief Cholesky decompositions of a batch of small selfadjoint positive definite matrices
+  *
+  * \tparam _Scalar the type of the coefficients
+  * \tparam _Size the size of the matrices
+  *
+  * This class computes the same decompositions \f$ A = LL^* \f$ as LLT for all the matrices of a BatchedMatrix,
+  * fully vectorized across the matrices of each group. Only the lower triangular parts of the matrices are read.
+  *
+  * \sa LLT, BatchedLDLT
+  */
+template<typename _Scalar, int _Size>
+class BatchedLLT
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef DenseIndex Index;
+    typedef BatchedMatrix<Scalar,_Size,_Size> MatrixType;
+    typedef typename MatrixType::Packet Packet;
+    enum {
+      Size = _Size,
+      PacketSize = MatrixType::PacketSize
+    };
+
+    BatchedLLT() : m_isInitialized(false) {}
+
+    /** Computes the Cholesky decompositions of all the matrices of \a matrices */
+    explicit BatchedLLT(const MatrixType& matrices) : m_isInitialized(false)
+    {
+      compute(matrices);
+    }
+
+    BatchedLLT& compute(const MatrixType& matrices);
+
+    /** \returns the factors L in the lower triangular parts, the strictly upper parts are unspecified */
+    const MatrixType& matrixL() const
+    {
+      eigen_assert(m_isInitialized && "BatchedLLT is not initialized.");
+      return m_matrix;
+    }
+
+    /** \returns the number of matrices */
+    Index count() const { return m_matrix.count(); }
+
+    /** \returns \c Success if all the matrices are positive definite, and \c NumericalIssue otherwise,
+      * in which case the factors of the matrices which are not are filled with NaN or infinite values. */
+    ComputationInfo info() const
+    {
+      eigen_assert(m_isInitialized && "BatchedLLT is not initialized.");
+      return m_info;
+    }
+
+    /** \returns the solutions \a x[k] of \a A[k] \a x[k] = \a b[k] */
+    template<int RhsCols>
+    BatchedMatrix<Scalar,Size,RhsCols> solve(const BatchedMatrix<Scalar,Size,RhsCols>& b) const
+    {
+      BatchedMatrix<Scalar,Size,RhsCols> res(b);
+      solveInPlace(res);
+      return res;
+    }
+
+    /** Overwrites \a b[k] by the solution of \a A[k] \a x[k] = \a b[k] */
+    template<int RhsCols>
+    void solveInPlace(BatchedMatrix<Scalar,Size,RhsCols>& b) const;
+
+  protected:
+    MatrixType m_matrix;
+    ComputationInfo m_info;
+    bool m_isInitialized;
+};
+
+template<typename Scalar, int Size>
+BatchedLLT<Scalar,Size>& BatchedLLT<Scalar,Size>::compute(const MatrixType& matrices)
+{
+  using namespace internal;
+  m_matrix = matrices;
+
+  for(Index g=0; g<m_matrix.groups(); ++g)
+  {
+    Scalar* data = m_matrix.groupData(g);
+    Packet a[Size*Size];
+    for(Index j=0; j<Size; ++j)
+      for(Index i=j; i<Size; ++i)
+        a[i+j*Size] = pload<Packet>(data+(i+j*Size)*PacketSize);
+
+    for(Index j=0; j<Size; ++j)
+    {
+      Packet d = a[j+j*Size];
+      for(Index k=0; k<j; ++k)
+        d = psub(d, pmul(a[j+k*Size], a[j+k*Size]));
+      a[j+j*Size] = batched_sqrt(d);
+      Packet inv = pdiv(pset1<Packet>(Scalar(1)), a[j+j*Size]);
+      for(Index i=j+1; i<Size; ++i)
+      {
+        Packet s = a[i+j*Size];
+        for(Index k=0; k<j; ++k)
+          s = psub(s, pmul(a[i+k*Size], a[j+k*Size]));
+        a[i+j*Size] = pmul(s, inv);
+      }
+    }
+
+    for(Index j=0; j<Size; ++j)
+      for(Index i=j; i<Size; ++i)
+        pstore(data+(i+j*Size)*PacketSize, a[i+j*Size]);
+  }
+
+  m_info = Success;
+  for(Index k=0; k<m_matrix.count(); ++k)
+    for(Index i=0; i<Size; ++i)
+      if(!(m_matrix.coeff(k,i,i)>Scalar(0)))
+        m_info = NumericalIssue;
+  m_isInitialized = true;
+  return *this;
+}
+
+template<typename Scalar, int Size>
+template<int RhsCols>
+void BatchedLLT<Scalar,Size>::solveInPlace(BatchedMatrix<Scalar,Size,RhsCols>& b) const
+{
+  using namespace internal;
+  eigen_assert(m_isInitialized && "BatchedLLT is not initialized.");
+  eigen_assert(b.count()==count() && "BatchedLLT::solve(): invalid number of right hand sides");
+
+  for(Index g=0; g<m_matrix.groups(); ++g)
+  {
+    const Scalar* l = m_matrix.groupData(g);
+    Scalar* x = b.groupData(g);
+    for(Index j=0; j<RhsCols; ++j)
+    {
+      Packet xj[Size];
+      for(Index i=0; i<Size; ++i)
+        xj[i] = pload<Packet>(x+(i+j*Size)*PacketSize);
+      // solve L y = b
+      for(Index k=0; k<Size; ++k)
+      {
+        xj[k] = pdiv(xj[k], pload<Packet>(l+(k+k*Size)*PacketSize));
+        for(Index i=k+1; i<Size; ++i)
+          xj[i] = psub(xj[i], pmul(pload<Packet>(l+(i+k*Size)*PacketSize), xj[k]));
+      }
+      // solve L^T x = y
+      for(Index k=Size-1; k>=0; --k)
+      {
+        xj[k] = pdiv(xj[k], pload<Packet>(l+(k+k*Size)*PacketSize));
+        for(Index i=0; i<k; ++i)
+          xj[i] = psub(xj[i], pmul(pload<Packet>(l+(k+i*Size)*PacketSize), xj[k]));
+      }
+      for(Index i=0; i<Size; ++i)
+        pstore(x+(i+j*Size)*PacketSize, xj[i]);
+    }
+  }
+}
+
+/** \ingroup BatchedMatrix_Module
+  *
+  * \class BatchedLDLT
+  *
+  * \brief Robust Cholesky decompositions with pivoting of a batch of small selfadjoint matrices
+  *
+  * \tparam _Scalar the type of the coefficients
+  * \tparam _Size the size of the matrices
+  *
+  * This class computes the same decompositions \f$ A = P^TLDL^*P \f$ as LDLT for all the matrices of a BatchedMatrix,
+  * the largest remaining diagonal coefficient being chosen as the pivot at each step. The updates are vectorized
+  * across the matrices of each group, while the symmetric permutations are carried out matrix per matrix.
+  * Only the lower triangular parts of the matrices are read.
+  *
+  * \sa LDLT, BatchedLLT
+  */
+template<typename _Scalar, int _Size>
+class BatchedLDLT
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef DenseIndex Index;
+    typedef BatchedMatrix<Scalar,_Size,_Size> MatrixType;
+    typedef typename MatrixType::Packet Packet;
+    enum {
+      Size = _Size,
+      PacketSize = MatrixType::PacketSize
+    };
+
+    BatchedLDLT() : m_isInitialized(false) {}
+
+    /** Computes the LDLT decompositions of all the matrices of \a matrices */
+    explicit BatchedLDLT(const MatrixType& matrices) : m_isInitialized(false)
+    {
+      compute(matrices);
+    }
+
+    BatchedLDLT& compute(const MatrixType& matrices);
+
+    /** \returns the factors in the lower triangular parts: the diagonals store the matrices D, and the strictly
+      * lower parts the unit lower triangular factors L. The strictly upper parts are unspecified. */
+    const MatrixType& matrixLDLT() const
+    {
+      eigen_assert(m_isInitialized && "BatchedLDLT is not initialized.");
+      return m_matrix;
+    }
+
+    /** \returns the index of the row and column which have been swapped with the row and column \a i while
+      * decomposing the \a k -th matrix */
+    Index transposition(Index k, Index i) const
+    {
+      eigen_assert(m_isInitialized && "BatchedLDLT is not initialized.");
+      return m_transpositions[((k/PacketSize)*Size + i)*PacketSize + k%PacketSize];
+    }
+
+    /** \returns the number of matrices */
+    Index count() const { return m_matrix.count(); }
+
+    /** \returns \c Success if all the matrices are invertible, and \c NumericalIssue otherwise */
+    ComputationInfo info() const
+    {
+      eigen_assert(m_isInitialized && "BatchedLDLT is not initialized.");
+      return m_info;
+    }
+
+    /** \returns the solutions \a x[k] of \a A[k] \a x[k] = \a b[k] */
+    template<int RhsCols>
+    BatchedMatrix<Scalar,Size,RhsCols> solve(const BatchedMatrix<Scalar,Size,RhsCols>& b) const
+    {
+      BatchedMatrix<Scalar,Size,RhsCols> res(b);
+      solveInPlace(res);
+      return res;
+    }
+
+    /** Overwrites \a b[k] by the solution of \a A[k] \a x[k] = \a b[k] */
+    template<int RhsCols>
+    void solveInPlace(BatchedMatrix<Scalar,Size,RhsCols>& b) const;
+
+  protected:
+    MatrixType m_matrix;
+    std::vector<Index> m_transpositions;
+    ComputationInfo m_info;
+    bool m_isInitialized;
+};
+
+template<typename Scalar, int Size>
+BatchedLDLT<Scalar,Size>& BatchedLDLT<Scalar,Size>::compute(const MatrixType& matrices)
+{
+  using namespace internal;
+  using std::abs;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+
+  m_matrix = matrices;
+  m_transpositions.resize(m_matrix.groups()*Size*PacketSize);
+
+  for(Index g=0; g<m_matrix.groups(); ++g)
+  {
+    Scalar* a = m_matrix.groupData(g);
+    Index* transpositions = &m_transpositions[g*Size*PacketSize];
+    for(Index k=0; k<Size; ++k)
+    {
+      // choose the pivot and apply the symmetric permutation to the lower part of each matrix separately
+      for(Index l=0; l<PacketSize; ++l)
+      {
+        #define EIGEN_BATCHED_LDLT_COEFF(I,J) a[((I)+(J)*Size)*PacketSize+l]
+        Index p = k;
+        RealScalar biggest = abs(EIGEN_BATCHED_LDLT_COEFF(k,k));
+        for(Index i=k+1; i<Size; ++i)
+          if(abs(EIGEN_BATCHED_LDLT_COEFF(i,i))>biggest)
+          {
+            biggest = abs(EIGEN_BATCHED_LDLT_COEFF(i,i));
+            p = i;
+          }
+        transpositions[k*PacketSize+l] = p;
+        if(p!=k)
+        {
+          std::swap(EIGEN_BATCHED_LDLT_COEFF(k,k), EIGEN_BATCHED_LDLT_COEFF(p,p));
+          for(Index j=0; j<k; ++j)
+            std::swap(EIGEN_BATCHED_LDLT_COEFF(k,j), EIGEN_BATCHED_LDLT_COEFF(p,j));
+          for(Index i=p+1; i<Size; ++i)
+            std::swap(EIGEN_BATCHED_LDLT_COEFF(i,k), EIGEN_BATCHED_LDLT_COEFF(i,p));
+          for(Index i=k+1; i<p; ++i)
+            std::swap(EIGEN_BATCHED_LDLT_COEFF(i,k), EIGEN_BATCHED_LDLT_COEFF(p,i));
+        }
+        #undef EIGEN_BATCHED_LDLT_COEFF
+      }
+
+      // then update the trailing lower parts of the whole group at once
+      Packet dinv = pdiv(pset1<Packet>(Scalar(1)), pload<Packet>(a+(k+k*Size)*PacketSize));
+      for(Index j=k+1; j<Size; ++j)
+      {
+        Packet ljk = pmul(pload<Packet>(a+(j+k*Size)*PacketSize), dinv);
+        for(Index i=j; i<Size; ++i)
+          pstore(a+(i+j*Size)*PacketSize, psub(pload<Packet>(a+(i+j*Size)*PacketSize), pmul(pload<Packet>(a+(i+k*Size)*PacketSize), ljk)));
+      }
+      for(Index i=k+1; i<Size; ++i)
+        pstore(a+(i+k*Size)*PacketSize, pmul(pload<Packet>(a+(i+k*Size)*PacketSize), dinv));
+    }
+  }
+
+  m_info = Success;
+  for(Index k=0; k<m_matrix.count(); ++k)
+    for(Index i=0; i<Size; ++i)
+      if(m_matrix.coeff(k,i,i)==Scalar(0))
+        m_info = NumericalIssue;
+  m_isInitialized = true;
+  return *this;
+}
+
+template<typename Scalar, int Size>
+template<int RhsCols>
+void BatchedLDLT<Scalar,Size>::solveInPlace(BatchedMatrix<Scalar,Size,RhsCols>& b) const
+{
+  using namespace internal;
+  eigen_assert(m_isInitialized && "BatchedLDLT is not initialized.");
+  eigen_assert(b.count()==count() && "BatchedLDLT::solve(): invalid number of right hand sides");
+
+  for(Index g=0; g<m_matrix.groups(); ++g)
+  {
+    const Scalar* a = m_matrix.groupData(g);
+    const Index* transpositions = &m_transpositions[g*Size*PacketSize];
+    Scalar* x = b.groupData(g);
+
+    // x = P b
+    for(Index l=0; l<PacketSize; ++l)
+      for(Index k=0; k<Size; ++k)
+      {
+        Index p = transpositions[k*PacketSize+l];
+        if(p!=k)
+          for(Index j=0; j<RhsCols; ++j)
+            std::swap(x[(k+j*Size)*PacketSize+l], x[(p+j*Size)*PacketSize+l]);
+      }
+
+    for(Index j=0; j<RhsCols; ++j)
+    {
+      Packet xj[Size];
+      for(Index i=0; i<Size; ++i)
+        xj[i] = pload<Packet>(x+(i+j*Size)*PacketSize);
+      // solve L y = x
+      for(Index k=0; k<Size; ++k)
+        for(Index i=k+1; i<Size; ++i)
+          xj[i] = psub(xj[i], pmul(pload<Packet>(a+(i+k*Size)*PacketSize), xj[k]));
+      // then D z = y
+      for(Index k=0; k<Size; ++k)
+        xj[k] = pdiv(xj[k], pload<Packet>(a+(k+k*Size)*PacketSize));
+      // and L^T w = z
+      for(Index k=Size-1; k>=0; --k)
+        for(Index i=0; i<k; ++i)
+          xj[i] = psub(xj[i], pmul(pload<Packet>(a+(k+i*Size)*PacketSize), xj[k]));
+      for(Index i=0; i<Size; ++i)
+        pstore(x+(i+j*Size)*PacketSize, xj[i]);
+    }
+
+    // x = P^T w
+    for(Index l=0; l<PacketSize; ++l)
+      for(Index k=Size-1; k>=0; --k)
+      {
+        Index p = transpositions[k*PacketSize+l];
+        if(p!=k)
+          for(Index j=0; j<RhsCols; ++j)
+            std::swap(x[(k+j*Size)*PacketSize+l], x[(p+j*Size)*PacketSize+l]);
+      }
+  }
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_BATCHED_CHOLESKY_H
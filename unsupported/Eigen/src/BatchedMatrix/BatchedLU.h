@@ -0,0 +1,338 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_BATCHED_LU_H
+#define EIGEN_BATCHED_LU_H
+
+namespace Eigen {
+
+/** \ingroup BatchedMatrix_Module
+  *
+  * \class BatchedPartialPivLU
+  *
+  * \brief LU decompositions with partial pivoting of a batch of small square matrices
+  *
+  * \tparam _Scalar the type of the coefficients
+  * \tparam _Size the size of the matrices
+  *
+  * This class computes the same decompositions as PartialPivLU for all the matrices of a BatchedMatrix.
+  * The eliminations are vectorized across the matrices of each group, while the choice of the pivots
+  * and the row swaps are carried out matrix per matrix.
+  *
+  * \sa PartialPivLU, batchedInverse(), batchedDeterminant()
+  */
+template<typename _Scalar, int _Size>
+class BatchedPartialPivLU
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef DenseIndex Index;
+    typedef BatchedMatrix<Scalar,_Size,_Size> MatrixType;
+    typedef typename MatrixType::Packet Packet;
+    enum {
+      Size = _Size,
+      PacketSize = MatrixType::PacketSize
+    };
+
+    BatchedPartialPivLU() : m_isInitialized(false) {}
+
+    /** Computes the LU decompositions of all the matrices of \a matrices */
+    explicit BatchedPartialPivLU(const MatrixType& matrices) : m_isInitialized(false)
+    {
+      compute(matrices);
+    }
+
+    BatchedPartialPivLU& compute(const MatrixType& matrices);
+
+    /** \returns the LU decompositions, with the strictly lower part of the unit lower triangular factors L
+      * and the upper triangular factors U */
+    const MatrixType& matrixLU() const
+    {
+      eigen_assert(m_isInitialized && "BatchedPartialPivLU is not initialized.");
+      return m_lu;
+    }
+
+    /** \returns the index of the row which has been swapped with the row \a i while decomposing the \a k -th matrix */
+    Index transposition(Index k, Index i) const
+    {
+      eigen_assert(m_isInitialized && "BatchedPartialPivLU is not initialized.");
+      return m_transpositions[((k/PacketSize)*Size + i)*PacketSize + k%PacketSize];
+    }
+
+    /** \returns the number of matrices */
+    Index count() const { return m_lu.count(); }
+
+    /** \returns the determinants of the matrices */
+    BatchedMatrix<Scalar,1,1> determinant() const;
+
+    /** \returns the inverses of the matrices */
+    MatrixType inverse() const
+    {
+      MatrixType res(count());
+      res.setIdentity();
+      solveInPlace(res);
+      return res;
+    }
+
+    /** \returns the solutions \a x[k] of \a A[k] \a x[k] = \a b[k] */
+    template<int RhsCols>
+    BatchedMatrix<Scalar,Size,RhsCols> solve(const BatchedMatrix<Scalar,Size,RhsCols>& b) const
+    {
+      BatchedMatrix<Scalar,Size,RhsCols> res(b);
+      solveInPlace(res);
+      return res;
+    }
+
+    /** Overwrites \a b[k] by the solution of \a A[k] \a x[k] = \a b[k] */
+    template<int RhsCols>
+    void solveInPlace(BatchedMatrix<Scalar,Size,RhsCols>& b) const;
+
+  protected:
+    MatrixType m_lu;
+    std::vector<Index> m_transpositions;
+    bool m_isInitialized;
+};
+
+template<typename Scalar, int Size>
+BatchedPartialPivLU<Scalar,Size>& BatchedPartialPivLU<Scalar,Size>::compute(const MatrixType& matrices)
+{
+  using namespace internal;
+  using std::abs;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+
+  m_lu = matrices;
+  m_transpositions.resize(m_lu.groups()*Size*PacketSize);
+
+  for(Index g=0; g<m_lu.groups(); ++g)
+  {
+    Scalar* lu = m_lu.groupData(g);
+    Index* transpositions = &m_transpositions[g*Size*PacketSize];
+    for(Index k=0; k<Size; ++k)
+    {
+      // choose the pivot and swap the rows of each matrix separately
+      for(Index l=0; l<PacketSize; ++l)
+      {
+        Index p = k;
+        RealScalar biggest = abs(lu[(k+k*Size)*PacketSize+l]);
+        for(Index i=k+1; i<Size; ++i)
+        {
+          RealScalar a = abs(lu[(i+k*Size)*PacketSize+l]);
+          if(a>biggest)
+          {
+            biggest = a;
+            p = i;
+          }
+        }
+        transpositions[k*PacketSize+l] = p;
+        if(p!=k)
+          for(Index j=0; j<Size; ++j)
+            std::swap(lu[(k+j*Size)*PacketSize+l], lu[(p+j*Size)*PacketSize+l]);
+      }
+
+      // then eliminate the whole group at once
+      Packet pivotInverse = pdiv(pset1<Packet>(Scalar(1)), pload<Packet>(lu+(k+k*Size)*PacketSize));
+      for(Index i=k+1; i<Size; ++i)
+        pstore(lu+(i+k*Size)*PacketSize, pmul(pload<Packet>(lu+(i+k*Size)*PacketSize), pivotInverse));
+      for(Index j=k+1; j<Size; ++j)
+      {
+        Packet ukj = pload<Packet>(lu+(k+j*Size)*PacketSize);
+        for(Index i=k+1; i<Size; ++i)
+          pstore(lu+(i+j*Size)*PacketSize, psub(pload<Packet>(lu+(i+j*Size)*PacketSize), pmul(pload<Packet>(lu+(i+k*Size)*PacketSize), ukj)));
+      }
+    }
+  }
+  m_isInitialized = true;
+  return *this;
+}
+
+template<typename Scalar, int Size>
+BatchedMatrix<Scalar,1,1> BatchedPartialPivLU<Scalar,Size>::determinant() const
+{
+  using namespace internal;
+  eigen_assert(m_isInitialized && "BatchedPartialPivLU is not initialized.");
+  BatchedMatrix<Scalar,1,1> res(count());
+  for(Index g=0; g<m_lu.groups(); ++g)
+  {
+    const Scalar* lu = m_lu.groupData(g);
+    const Index* transpositions = &m_transpositions[g*Size*PacketSize];
+    EIGEN_ALIGN_DEFAULT Scalar signs[PacketSize];
+    for(Index l=0; l<PacketSize; ++l)
+    {
+      signs[l] = Scalar(1);
+      for(Index k=0; k<Size; ++k)
+        if(transpositions[k*PacketSize+l]!=k)
+          signs[l] = -signs[l];
+    }
+    Packet det = pload<Packet>(signs);
+    for(Index k=0; k<Size; ++k)
+      det = pmul(det, pload<Packet>(lu+(k+k*Size)*PacketSize));
+    pstore(res.groupData(g), det);
+  }
+  return res;
+}
+
+template<typename Scalar, int Size>
+template<int RhsCols>
+void BatchedPartialPivLU<Scalar,Size>::solveInPlace(BatchedMatrix<Scalar,Size,RhsCols>& b) const
+{
+  using namespace internal;
+  eigen_assert(m_isInitialized && "BatchedPartialPivLU is not initialized.");
+  eigen_assert(b.count()==count() && "BatchedPartialPivLU::solve(): invalid number of right hand sides");
+
+  for(Index g=0; g<m_lu.groups(); ++g)
+  {
+    const Scalar* lu = m_lu.groupData(g);
+    const Index* transpositions = &m_transpositions[g*Size*PacketSize];
+    Scalar* x = b.groupData(g);
+
+    // apply the row permutation P of each matrix
+    for(Index l=0; l<PacketSize; ++l)
+      for(Index k=0; k<Size; ++k)
+      {
+        Index p = transpositions[k*PacketSize+l];
+        if(p!=k)
+          for(Index j=0; j<RhsCols; ++j)
+            std::swap(x[(k+j*Size)*PacketSize+l], x[(p+j*Size)*PacketSize+l]);
+      }
+
+    for(Index j=0; j<RhsCols; ++j)
+    {
+      Packet xj[Size];
+      for(Index i=0; i<Size; ++i)
+        xj[i] = pload<Packet>(x+(i+j*Size)*PacketSize);
+      // solve L y = P b
+      for(Index k=0; k<Size; ++k)
+        for(Index i=k+1; i<Size; ++i)
+          xj[i] = psub(xj[i], pmul(pload<Packet>(lu+(i+k*Size)*PacketSize), xj[k]));
+      // solve U x = y
+      for(Index k=Size-1; k>=0; --k)
+      {
+        xj[k] = pdiv(xj[k], pload<Packet>(lu+(k+k*Size)*PacketSize));
+        for(Index i=0; i<k; ++i)
+          xj[i] = psub(xj[i], pmul(pload<Packet>(lu+(i+k*Size)*PacketSize), xj[k]));
+      }
+      for(Index i=0; i<Size; ++i)
+        pstore(x+(i+j*Size)*PacketSize, xj[i]);
+    }
+  }
+}
+
+namespace internal {
+
+/** \internal Closed form inverses and determinants of the matrices of size 1, 2 and 3, and LU decompositions for the larger ones */
+template<typename Scalar, int Size>
+struct batched_inverse_impl
+{
+  static void determinant(const BatchedMatrix<Scalar,Size,Size>& matrices, BatchedMatrix<Scalar,1,1>& dst)
+  {
+    BatchedMatrix<Scalar,1,1> res = BatchedPartialPivLU<Scalar,Size>(matrices).determinant();
+    dst.swap(res);
+  }
+  static void inverse(const BatchedMatrix<Scalar,Size,Size>& matrices, BatchedMatrix<Scalar,Size,Size>& dst)
+  {
+    BatchedMatrix<Scalar,Size,Size> res = BatchedPartialPivLU<Scalar,Size>(matrices).inverse();
+    dst.swap(res);
+  }
+};
+
+template<typename Scalar, int Size>
+struct batched_inverse_small
+{
+  typedef typename packet_traits<Scalar>::type Packet;
+  typedef DenseIndex Index;
+  enum { PacketSize = packet_traits<Scalar>::size };
+
+  static void determinant(const BatchedMatrix<Scalar,Size,Size>& matrices, BatchedMatrix<Scalar,1,1>& dst)
+  {
+    dst.resize(matrices.count());
+    for(Index g=0; g<matrices.groups(); ++g)
+    {
+      Packet a[Size*Size], cofactors[Size];
+      load(matrices.groupData(g), a);
+      pstore(dst.groupData(g), determinant(a, cofactors));
+    }
+  }
+
+  static void inverse(const BatchedMatrix<Scalar,Size,Size>& matrices, BatchedMatrix<Scalar,Size,Size>& dst)
+  {
+    dst.resize(matrices.count());
+    for(Index g=0; g<matrices.groups(); ++g)
+    {
+      Packet a[Size*Size], cofactors[Size];
+      load(matrices.groupData(g), a);
+      Packet invdet = pdiv(pset1<Packet>(Scalar(1)), determinant(a, cofactors));
+      Scalar* res = dst.groupData(g);
+      for(Index i=0; i<Size; ++i)
+        for(Index j=0; j<Size; ++j)
+          pstore(res+(j+i*Size)*PacketSize, pmul(cofactor(a,i,j), invdet));
+    }
+  }
+
+  static void load(const Scalar* data, Packet* a)
+  {
+    for(Index i=0; i<Size*Size; ++i)
+      a[i] = pload<Packet>(data+i*PacketSize);
+  }
+
+  // the cofactor of the coefficient (i,j)
+  static Packet cofactor(const Packet* a, Index i, Index j)
+  {
+    if(Size==1)
+      return pset1<Packet>(Scalar(1));
+    if(Size==2)
+    {
+      Packet c = a[(1-i)+(1-j)*2];
+      return i==j ? c : pnegate(c);
+    }
+    // for 3x3 matrices, the cyclic ordering of the remaining rows and columns takes care of the signs
+    Index i1 = (i+1)%3, i2 = (i+2)%3, j1 = (j+1)%3, j2 = (j+2)%3;
+    return psub(pmul(a[i1+j1*3], a[i2+j2*3]), pmul(a[i1+j2*3], a[i2+j1*3]));
+  }
+
+  static Packet determinant(const Packet* a, Packet* cofactors)
+  {
+    Packet det = pmul(a[0], cofactors[0] = cofactor(a,0,0));
+    for(Index j=1; j<Size; ++j)
+      det = pmadd(a[j*Size], cofactors[j] = cofactor(a,0,j), det);
+    return det;
+  }
+};
+
+template<typename Scalar> struct batched_inverse_impl<Scalar,1> : batched_inverse_small<Scalar,1> {};
+template<typename Scalar> struct batched_inverse_impl<Scalar,2> : batched_inverse_small<Scalar,2> {};
+template<typename Scalar> struct batched_inverse_impl<Scalar,3> : batched_inverse_small<Scalar,3> {};
+
+} // end namespace internal
+
+/** \ingroup BatchedMatrix_Module
+  *
+  * Computes the inverses of the matrices of \a matrices into \a dst. The matrices of size up to 3 are inverted
+  * using their cofactors, and the larger ones using a BatchedPartialPivLU decomposition.
+  *
+  * \sa MatrixBase::inverse(), BatchedPartialPivLU::inverse()
+  */
+template<typename Scalar, int Size>
+void batchedInverse(const BatchedMatrix<Scalar,Size,Size>& matrices, BatchedMatrix<Scalar,Size,Size>& dst)
+{
+  internal::batched_inverse_impl<Scalar,Size>::inverse(matrices, dst);
+}
+
+/** \ingroup BatchedMatrix_Module
+  *
+  * Computes the determinants of the matrices of \a matrices into \a dst.
+  *
+  * \sa MatrixBase::determinant(), BatchedPartialPivLU::determinant()
+  */
+template<typename Scalar, int Size>
+void batchedDeterminant(const BatchedMatrix<Scalar,Size,Size>& matrices, BatchedMatrix<Scalar,1,1>& dst)
+{
+  internal::batched_inverse_impl<Scalar,Size>::determinant(matrices, dst);
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_BATCHED_LU_H
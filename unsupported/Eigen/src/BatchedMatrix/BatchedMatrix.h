@@ -0,0 +1,232 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_BATCHED_MATRIX_H
+#define EIGEN_BATCHED_MATRIX_H
+
+namespace Eigen {
+
+/** \ingroup BatchedMatrix_Module
+  *
+  * \class BatchedMatrix
+  *
+  * \brief A contiguous array of small fixed-size matrices stored in an interleaved layout
+  *
+  * \tparam _Scalar the type of the coefficients, a real floating point type
+  * \tparam _Rows the number of rows of each matrix
+  * \tparam _Cols the number of columns of each matrix
+  *
+  * The matrices are stored by groups of \c PacketSize matrices, \c PacketSize being the number of scalars
+  * held by a SIMD packet. Within a group, the coefficients (i,j) of the \c PacketSize matrices are contiguous,
+  * so that a single packet operation processes the same coefficient of all the matrices of the group.
+  * The groups store their coefficients in column major order, and the last group is padded if the number
+  * of matrices is not a multiple of \c PacketSize. The coefficients of the padding matrices are unspecified.
+  *
+  * The batched algorithms of this module, such as batchedProduct(), BatchedPartialPivLU, BatchedLLT, BatchedLDLT
+  * and BatchedJacobiSVD, perform the same operation on all the matrices of a BatchedMatrix at once.
+  *
+  * Example:
+  * \code
+  * BatchedMatrix<float,3,3> a(n), b(n), c;
+  * for(int k=0; k<n; ++k)
+  *   a.setMatrix(k, rotations[k]);
+  * ...
+  * batchedProduct(a, b, c);
+  * Matrix3f c0 = c.matrix(0);
+  * \endcode
+  */
+template<typename _Scalar, int _Rows, int _Cols>
+class BatchedMatrix
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef DenseIndex Index;
+    typedef typename internal::packet_traits<Scalar>::type Packet;
+    typedef Matrix<Scalar,_Rows,_Cols> MatrixType;
+    enum {
+      Rows = _Rows,
+      Cols = _Cols,
+      Coeffs = _Rows*_Cols,
+      PacketSize = internal::packet_traits<Scalar>::size
+    };
+
+    /** Default constructor, creating an empty batch */
+    BatchedMatrix() : m_data(0), m_count(0)
+    {
+      check_template_parameters();
+    }
+
+    /** Creates a batch of \a count matrices, all set to zero */
+    explicit BatchedMatrix(Index count) : m_data(0), m_count(0)
+    {
+      check_template_parameters();
+      resize(count);
+    }
+
+    BatchedMatrix(const BatchedMatrix& other) : m_data(0), m_count(0)
+    {
+      *this = other;
+    }
+
+    ~BatchedMatrix()
+    {
+      internal::aligned_delete(m_data, allocatedSize());
+    }
+
+    BatchedMatrix& operator=(const BatchedMatrix& other)
+    {
+      if(this!=&other)
+      {
+        resize(other.count());
+        internal::smart_copy(other.m_data, other.m_data+allocatedSize(), m_data);
+      }
+      return *this;
+    }
+
+    /** Resizes the batch to \a count matrices. If the number of matrices changes, the previous
+      * matrices are discarded and all the coefficients are set to zero. */
+    void resize(Index count)
+    {
+      eigen_assert(count>=0);
+      if(count==m_count)
+        return;
+      internal::aligned_delete(m_data, allocatedSize());
+      m_data = 0;
+      m_count = count;
+      if(count>0)
+      {
+        m_data = internal::aligned_new<Scalar>(allocatedSize());
+        setZero();
+      }
+    }
+
+    /** \returns the number of matrices */
+    inline Index count() const { return m_count; }
+
+    /** \returns the number of groups of \c PacketSize interleaved matrices, including the padded one */
+    inline Index groups() const { return (m_count+PacketSize-1)/PacketSize; }
+
+    /** \returns a pointer to the coefficients of the \a g -th group of matrices: the coefficient (i,j)
+      * of the matrix \a g*PacketSize+l is stored at the offset (i+j*Rows)*PacketSize+l. */
+    inline Scalar* groupData(Index g) { return m_data + g*Coeffs*PacketSize; }
+    inline const Scalar* groupData(Index g) const { return m_data + g*Coeffs*PacketSize; }
+
+    inline Scalar* data() { return m_data; }
+    inline const Scalar* data() const { return m_data; }
+
+    /** \returns a reference to the coefficient (\a i, \a j) of the \a k -th matrix */
+    inline Scalar& coeffRef(Index k, Index i, Index j)
+    {
+      eigen_assert(k>=0 && k<m_count && i>=0 && i<Rows && j>=0 && j<Cols);
+      return groupData(k/PacketSize)[(i+j*Rows)*PacketSize + k%PacketSize];
+    }
+
+    inline const Scalar& coeff(Index k, Index i, Index j) const
+    {
+      eigen_assert(k>=0 && k<m_count && i>=0 && i<Rows && j>=0 && j<Cols);
+      return groupData(k/PacketSize)[(i+j*Rows)*PacketSize + k%PacketSize];
+    }
+
+    inline Scalar& operator()(Index k, Index i, Index j) { return coeffRef(k,i,j); }
+    inline const Scalar& operator()(Index k, Index i, Index j) const { return coeff(k,i,j); }
+
+    /** \returns a copy of the \a k -th matrix */
+    MatrixType matrix(Index k) const
+    {
+      MatrixType res;
+      for(Index j=0; j<Cols; ++j)
+        for(Index i=0; i<Rows; ++i)
+          res.coeffRef(i,j) = coeff(k,i,j);
+      return res;
+    }
+
+    /** Sets the \a k -th matrix to \a other */
+    template<typename OtherDerived>
+    void setMatrix(Index k, const MatrixBase<OtherDerived>& other)
+    {
+      eigen_assert(other.rows()==Rows && other.cols()==Cols);
+      for(Index j=0; j<Cols; ++j)
+        for(Index i=0; i<Rows; ++i)
+          coeffRef(k,i,j) = other.coeff(i,j);
+    }
+
+    /** Sets all the matrices to zero */
+    void setZero()
+    {
+      std::fill(m_data, m_data+allocatedSize(), Scalar(0));
+    }
+
+    /** Sets all the matrices to the identity */
+    void setIdentity()
+    {
+      setZero();
+      for(Index g=0; g<groups(); ++g)
+        for(Index i=0; i<(std::min)(Index(Rows),Index(Cols)); ++i)
+          internal::pstore(groupData(g)+(i+i*Rows)*PacketSize, internal::pset1<Packet>(Scalar(1)));
+    }
+
+    void swap(BatchedMatrix& other)
+    {
+      std::swap(m_data, other.m_data);
+      std::swap(m_count, other.m_count);
+    }
+
+    /** \returns the products of the matrices of \c *this by the ones of \a other
+      * \sa batchedProduct() */
+    template<int OtherCols>
+    BatchedMatrix<Scalar,Rows,OtherCols> operator*(const BatchedMatrix<Scalar,Cols,OtherCols>& other) const
+    {
+      BatchedMatrix<Scalar,Rows,OtherCols> res;
+      batchedProduct(*this, other, res);
+      return res;
+    }
+
+  protected:
+    std::size_t allocatedSize() const { return std::size_t(groups()*Coeffs*PacketSize); }
+
+    static void check_template_parameters()
+    {
+      EIGEN_STATIC_ASSERT(_Rows!=Dynamic && _Cols!=Dynamic, THIS_METHOD_IS_ONLY_FOR_FIXED_SIZE);
+      EIGEN_STATIC_ASSERT(!NumTraits<Scalar>::IsComplex, NUMERIC_TYPE_MUST_BE_REAL);
+    }
+
+    Scalar* m_data;
+    Index m_count;
+};
+
+namespace internal {
+
+/** \internal \returns the square roots of the entries of \a a, falling back to std::sqrt if the packet type has no psqrt */
+template<typename Packet, bool HasSqrt = packet_traits<typename unpacket_traits<Packet>::type>::HasSqrt>
+struct batched_sqrt_impl
+{
+  static inline Packet run(const Packet& a) { return psqrt(a); }
+};
+
+template<typename Packet>
+struct batched_sqrt_impl<Packet,false>
+{
+  typedef typename unpacket_traits<Packet>::type Scalar;
+  enum { Size = unpacket_traits<Packet>::size };
+  static inline Packet run(const Packet& a)
+  {
+    using std::sqrt;
+    EIGEN_ALIGN_DEFAULT Scalar tmp[Size];
+    pstore(tmp, a);
+    for(int l=0; l<Size; ++l)
+      tmp[l] = sqrt(tmp[l]);
+    return pload<Packet>(tmp);
+  }
+};
+
+template<typename Packet> inline Packet batched_sqrt(const Packet& a) { return batched_sqrt_impl<Packet>::run(a); }
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_BATCHED_MATRIX_H
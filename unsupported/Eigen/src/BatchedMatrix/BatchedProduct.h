@@ -0,0 +1,54 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_BATCHED_PRODUCT_H
+#define EIGEN_BATCHED_PRODUCT_H
+
+namespace Eigen {
+
+/** \ingroup BatchedMatrix_Module
+  *
+  * Computes the products \a lhs[k] * \a rhs[k] of the matrices of two batches of the same size, and stores them into \a dst,
+  * which is resized if needed. \a dst may be one of the operands.
+  *
+  * \sa BatchedMatrix::operator*()
+  */
+template<typename Scalar, int Rows, int Depth, int Cols>
+void batchedProduct(const BatchedMatrix<Scalar,Rows,Depth>& lhs, const BatchedMatrix<Scalar,Depth,Cols>& rhs,
+                    BatchedMatrix<Scalar,Rows,Cols>& dst)
+{
+  using namespace internal;
+  typedef typename BatchedMatrix<Scalar,Rows,Cols>::Packet Packet;
+  typedef DenseIndex Index;
+  enum { PacketSize = BatchedMatrix<Scalar,Rows,Cols>::PacketSize };
+  eigen_assert(lhs.count()==rhs.count() && "batchedProduct(): the batches must have the same number of matrices");
+
+  if(dst.count()!=lhs.count())
+    dst.resize(lhs.count());
+
+  for(Index g=0; g<lhs.groups(); ++g)
+  {
+    const Scalar* a = lhs.groupData(g);
+    const Scalar* b = rhs.groupData(g);
+    Packet res[Rows*Cols];
+    for(Index j=0; j<Cols; ++j)
+      for(Index i=0; i<Rows; ++i)
+      {
+        Packet acc = pmul(pload<Packet>(a+i*PacketSize), pload<Packet>(b+j*Depth*PacketSize));
+        for(Index k=1; k<Depth; ++k)
+          acc = pmadd(pload<Packet>(a+(i+k*Rows)*PacketSize), pload<Packet>(b+(k+j*Depth)*PacketSize), acc);
+        res[i+j*Rows] = acc;
+      }
+    Scalar* c = dst.groupData(g);
+    for(Index i=0; i<Rows*Cols; ++i)
+      pstore(c+i*PacketSize, res[i]);
+  }
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_BATCHED_PRODUCT_H
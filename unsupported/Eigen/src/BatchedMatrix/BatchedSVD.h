@@ -0,0 +1,252 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_BATCHED_SVD_H
+#define EIGEN_BATCHED_SVD_H
+
+namespace Eigen {
+
+/** \ingroup BatchedMatrix_Module
+  *
+  * \class BatchedJacobiSVD
+  *
+  * \brief Singular value decompositions of a batch of small matrices
+  *
+  * \tparam _Scalar the type of the coefficients
+  * \tparam _Rows the number of rows of the matrices
+  * \tparam _Cols the number of columns of the matrices, which must not exceed \a _Rows
+  *
+  * This class computes the thin singular value decompositions \f$ A = U S V^T \f$ of all the matrices of a BatchedMatrix
+  * with the one-sided Jacobi algorithm: the columns of the matrices are orthogonalized by plane rotations, which are
+  * applied to the whole group of matrices at once, until no rotation is needed anymore. As with JacobiSVD, the singular
+  * values are sorted in decreasing order and are accurate to the order of the machine precision.
+  *
+  * The computation of the singular vectors is driven by the \c ComputeThinU and \c ComputeThinV options, which are
+  * equivalent to \c ComputeFullU and \c ComputeFullV for square matrices.
+  *
+  * \sa JacobiSVD
+  */
+template<typename _Scalar, int _Rows, int _Cols>
+class BatchedJacobiSVD
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef DenseIndex Index;
+    typedef BatchedMatrix<Scalar,_Rows,_Cols> MatrixType;
+    typedef typename MatrixType::Packet Packet;
+    typedef BatchedMatrix<Scalar,_Cols,1> SingularValuesType;
+    typedef BatchedMatrix<Scalar,_Rows,_Cols> MatrixUType;
+    typedef BatchedMatrix<Scalar,_Cols,_Cols> MatrixVType;
+    enum {
+      Rows = _Rows,
+      Cols = _Cols,
+      PacketSize = MatrixType::PacketSize
+    };
+
+    BatchedJacobiSVD() : m_isInitialized(false), m_computeU(false), m_computeV(false)
+    {
+      check_template_parameters();
+    }
+
+    /** Computes the singular value decompositions of all the matrices of \a matrices
+      * \sa compute() */
+    explicit BatchedJacobiSVD(const MatrixType& matrices, unsigned int computationOptions = 0)
+      : m_isInitialized(false), m_computeU(false), m_computeV(false)
+    {
+      check_template_parameters();
+      compute(matrices, computationOptions);
+    }
+
+    /** Computes the singular value decompositions of all the matrices of \a matrices.
+      * \param computationOptions a combination of \c ComputeThinU and \c ComputeThinV, or of their full variants for square matrices */
+    BatchedJacobiSVD& compute(const MatrixType& matrices, unsigned int computationOptions = 0);
+
+    /** \returns the singular values, sorted in decreasing order */
+    const SingularValuesType& singularValues() const
+    {
+      eigen_assert(m_isInitialized && "BatchedJacobiSVD is not initialized.");
+      return m_singularValues;
+    }
+
+    /** \returns the left singular vectors, if they have been computed */
+    const MatrixUType& matrixU() const
+    {
+      eigen_assert(m_isInitialized && "BatchedJacobiSVD is not initialized.");
+      eigen_assert(m_computeU && "This BatchedJacobiSVD decomposition didn't compute U. Did you ask for it?");
+      return m_matrixU;
+    }
+
+    /** \returns the right singular vectors, if they have been computed */
+    const MatrixVType& matrixV() const
+    {
+      eigen_assert(m_isInitialized && "BatchedJacobiSVD is not initialized.");
+      eigen_assert(m_computeV && "This BatchedJacobiSVD decomposition didn't compute V. Did you ask for it?");
+      return m_matrixV;
+    }
+
+    /** \returns the number of matrices */
+    Index count() const { return m_singularValues.count(); }
+
+  protected:
+    static void check_template_parameters()
+    {
+      EIGEN_STATIC_ASSERT(_Cols<=_Rows, YOU_MADE_A_PROGRAMMING_MISTAKE);
+    }
+
+    SingularValuesType m_singularValues;
+    MatrixUType m_matrixU;
+    MatrixVType m_matrixV;
+    bool m_isInitialized, m_computeU, m_computeV;
+};
+
+template<typename Scalar, int Rows, int Cols>
+BatchedJacobiSVD<Scalar,Rows,Cols>& BatchedJacobiSVD<Scalar,Rows,Cols>::compute(const MatrixType& matrices, unsigned int computationOptions)
+{
+  using namespace internal;
+  using std::abs;
+  using std::sqrt;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+
+  eigen_assert((Rows==Cols || !(computationOptions & (ComputeFullU|ComputeFullV)))
+               && "BatchedJacobiSVD: full U and V are only available for square matrices, use thin U and V instead");
+  m_computeU = (computationOptions & (ComputeThinU|ComputeFullU)) != 0;
+  m_computeV = (computationOptions & (ComputeThinV|ComputeFullV)) != 0;
+
+  // unlike the two-sided JacobiSVD, the inner products of the columns are recomputed at each step,
+  // so the threshold has to account for their rounding errors
+  const RealScalar precision = RealScalar(2*Rows) * NumTraits<Scalar>::epsilon();
+  const RealScalar considerAsZero = (std::numeric_limits<RealScalar>::min)();
+  const int maxSweeps = 64;
+
+  // the columns of W converge to U S, and V accumulates the rotations
+  MatrixUType w(matrices);
+  MatrixVType v(matrices.count());
+  v.setIdentity();
+  m_singularValues.resize(matrices.count());
+
+  for(Index g=0; g<w.groups(); ++g)
+  {
+    Scalar* wg = w.groupData(g);
+    Scalar* vg = v.groupData(g);
+    bool finished = false;
+    for(int sweep=0; sweep<maxSweeps && !finished; ++sweep)
+    {
+      finished = true;
+      for(Index p=1; p<Cols; ++p)
+        for(Index q=0; q<p; ++q)
+        {
+          Packet alpha = pset1<Packet>(Scalar(0)), beta = alpha, gamma = alpha;
+          for(Index i=0; i<Rows; ++i)
+          {
+            Packet wp = pload<Packet>(wg+(i+p*Rows)*PacketSize), wq = pload<Packet>(wg+(i+q*Rows)*PacketSize);
+            alpha = pmadd(wp, wp, alpha);
+            beta  = pmadd(wq, wq, beta);
+            gamma = pmadd(wp, wq, gamma);
+          }
+
+          // the rotation annihilating the off-diagonal coefficient of W^T W is computed matrix per matrix
+          EIGEN_ALIGN_DEFAULT Scalar a[PacketSize], b[PacketSize], c[PacketSize], s[PacketSize];
+          pstore(a, alpha);
+          pstore(b, beta);
+          pstore(c, gamma);
+          bool rotate = false;
+          for(Index l=0; l<PacketSize; ++l)
+          {
+            Scalar gam = c[l];
+            c[l] = Scalar(1);
+            s[l] = Scalar(0);
+            if(abs(gam) > (std::max)(considerAsZero, precision * sqrt(a[l]*b[l])))
+            {
+              Scalar zeta = (b[l]-a[l]) / (Scalar(2)*gam);
+              Scalar t = Scalar(1) / (abs(zeta) + sqrt(Scalar(1)+zeta*zeta));
+              if(zeta<Scalar(0))
+                t = -t;
+              c[l] = Scalar(1) / sqrt(Scalar(1)+t*t);
+              s[l] = c[l]*t;
+              rotate = true;
+            }
+          }
+          if(!rotate)
+            continue;
+          finished = false;
+
+          Packet cp = pload<Packet>(c), sp = pload<Packet>(s);
+          for(Index i=0; i<Rows; ++i)
+          {
+            Packet wp = pload<Packet>(wg+(i+p*Rows)*PacketSize), wq = pload<Packet>(wg+(i+q*Rows)*PacketSize);
+            pstore(wg+(i+p*Rows)*PacketSize, psub(pmul(cp,wp), pmul(sp,wq)));
+            pstore(wg+(i+q*Rows)*PacketSize, padd(pmul(sp,wp), pmul(cp,wq)));
+          }
+          if(m_computeV)
+            for(Index i=0; i<Cols; ++i)
+            {
+              Packet vp = pload<Packet>(vg+(i+p*Cols)*PacketSize), vq = pload<Packet>(vg+(i+q*Cols)*PacketSize);
+              pstore(vg+(i+p*Cols)*PacketSize, psub(pmul(cp,vp), pmul(sp,vq)));
+              pstore(vg+(i+q*Cols)*PacketSize, padd(pmul(sp,vp), pmul(cp,vq)));
+            }
+        }
+    }
+
+    // the singular values are the norms of the columns of W, and the columns of U are the normalized ones
+    Scalar* sg = m_singularValues.groupData(g);
+    for(Index j=0; j<Cols; ++j)
+    {
+      Packet n2 = pset1<Packet>(Scalar(0));
+      for(Index i=0; i<Rows; ++i)
+      {
+        Packet wij = pload<Packet>(wg+(i+j*Rows)*PacketSize);
+        n2 = pmadd(wij, wij, n2);
+      }
+      Packet sigma = batched_sqrt(n2);
+      pstore(sg+j*PacketSize, sigma);
+      if(m_computeU)
+      {
+        EIGEN_ALIGN_DEFAULT Scalar inv[PacketSize];
+        pstore(inv, sigma);
+        for(Index l=0; l<PacketSize; ++l)
+          inv[l] = inv[l]==Scalar(0) ? Scalar(0) : Scalar(1)/inv[l];
+        Packet invp = pload<Packet>(inv);
+        for(Index i=0; i<Rows; ++i)
+          pstore(wg+(i+j*Rows)*PacketSize, pmul(pload<Packet>(wg+(i+j*Rows)*PacketSize), invp));
+      }
+    }
+
+    // sort the singular values and the singular vectors of each matrix
+    for(Index l=0; l<PacketSize; ++l)
+      for(Index j=0; j<Cols-1; ++j)
+      {
+        Index maxIndex = j;
+        for(Index k=j+1; k<Cols; ++k)
+          if(sg[k*PacketSize+l]>sg[maxIndex*PacketSize+l])
+            maxIndex = k;
+        if(maxIndex==j)
+          continue;
+        std::swap(sg[j*PacketSize+l], sg[maxIndex*PacketSize+l]);
+        if(m_computeU)
+          for(Index i=0; i<Rows; ++i)
+            std::swap(wg[(i+j*Rows)*PacketSize+l], wg[(i+maxIndex*Rows)*PacketSize+l]);
+        if(m_computeV)
+          for(Index i=0; i<Cols; ++i)
+            std::swap(vg[(i+j*Cols)*PacketSize+l], vg[(i+maxIndex*Cols)*PacketSize+l]);
+      }
+  }
+
+  if(m_computeU)
+    m_matrixU.swap(w);
+  else
+    m_matrixU.resize(0);
+  if(m_computeV)
+    m_matrixV.swap(v);
+  else
+    m_matrixV.resize(0);
+  m_isInitialized = true;
+  return *this;
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_BATCHED_SVD_H
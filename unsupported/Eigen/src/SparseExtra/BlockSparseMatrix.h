@@ -0,0 +1,287 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_BLOCK_SPARSE_MATRIX_H
+#define EIGEN_BLOCK_SPARSE_MATRIX_H
+
+namespace Eigen {
+
+template<typename _Scalar, int _BlockRows, int _BlockCols = _BlockRows, typename _Index = int> class BlockSparseMatrix;
+
+namespace internal {
+
+template<typename _Scalar, int _BlockRows, int _BlockCols, typename _Index>
+struct traits<BlockSparseMatrix<_Scalar,_BlockRows,_BlockCols,_Index> >
+{
+  typedef _Scalar Scalar;
+  typedef _Index Index;
+  typedef Sparse StorageKind;
+  typedef MatrixXpr XprKind;
+  enum {
+    RowsAtCompileTime = Dynamic,
+    ColsAtCompileTime = Dynamic,
+    MaxRowsAtCompileTime = Dynamic,
+    MaxColsAtCompileTime = Dynamic,
+    Flags = RowMajorBit | NestByRefBit,
+    CoeffReadCost = NumTraits<Scalar>::ReadCost
+  };
+};
+
+/** \internal The products of a BlockSparseMatrix by a dense matrix, processing the rows block row per block row, and
+  * accumulating the fixed-size products of their blocks by the matching segments of the rhs. */
+template<typename _Scalar, int _BlockRows, int _BlockCols, typename _Index>
+struct sparse_operator_product_impl<BlockSparseMatrix<_Scalar,_BlockRows,_BlockCols,_Index> >
+{
+  typedef BlockSparseMatrix<_Scalar,_BlockRows,_BlockCols,_Index> MatrixType;
+  typedef _Scalar Scalar;
+  typedef _Index Index;
+  typedef typename MatrixType::BlockType BlockType;
+  enum {
+    BlockRows = _BlockRows,
+    BlockCols = _BlockCols
+  };
+
+  static Index groups(const MatrixType& mat) { return mat.rowBlocks(); }
+  static const Index* groupStarts(const MatrixType& mat) { return mat.blockOuterIndexPtr(); }
+
+  template<typename Rhs, typename Dest>
+  static void run(const MatrixType& mat, const Rhs& rhs, Dest& dst, const Scalar& alpha, Index begin, Index end)
+  {
+    const Index* outerIndex = mat.blockOuterIndexPtr();
+    const Index* innerIndices = mat.blockInnerIndexPtr();
+    for(Index j=0; j<rhs.cols(); ++j)
+      for(Index r=begin; r<end; ++r)
+      {
+        Matrix<Scalar,BlockRows,1> acc = Matrix<Scalar,BlockRows,1>::Zero();
+        for(Index k=outerIndex[r]; k<outerIndex[r+1]; ++k)
+          acc.noalias() += Map<const BlockType>(mat.valuePtr() + k*BlockType::SizeAtCompileTime)
+                         * rhs.col(j).template segment<BlockCols>(innerIndices[k]*BlockCols);
+        dst.col(j).template segment<BlockRows>(r*BlockRows) += alpha * acc;
+      }
+  }
+};
+
+} // end namespace internal
+
+/** \ingroup SparseExtra_Module
+  *
+  * \class BlockSparseMatrix
+  *
+  * \brief A read-only sparse matrix made of dense fixed-size blocks, in the block compressed sparse row (BSR) format
+  *
+  * \param _Scalar the scalar type, i.e. the type of the coefficients
+  * \param _BlockRows the number of rows of the blocks
+  * \param _BlockCols the number of columns of the blocks, equal to \a _BlockRows by default
+  * \param _Index the type of the indices
+  *
+  * The matrix is split into a grid of \a _BlockRows x \a _BlockCols blocks, and only the blocks having at least one
+  * nonzero are stored, block row per block row. A single column index is stored per block instead of one per
+  * coefficient, and the coefficients of each block are stored contiguously in column major order. The product of a
+  * block row by a dense vector is then a sum of fixed-size matrix * vector products, which Eigen unrolls and
+  * vectorizes, while the block rows are split among threads by chunks of the same number of blocks.
+  *
+  * The zeros of the stored blocks are stored and multiplied too, so that this format only pays off when the nonzeros
+  * come in dense blocks, as in the matrices of structural or multibody problems, where each node carries 3 or 6
+  * degrees of freedom coupled with all those of its neighbours:
+  * \code
+  * SparseMatrix<double> A;
+  * // fill A, whose sizes are multiples of 3
+  * BlockSparseMatrix<double,3> B(A);
+  * ConjugateGradient<BlockSparseMatrix<double,3> > cg(B);
+  * x = cg.solve(b);
+  * \endcode
+  * Unlike a SlicedEllMatrix, the structure is kept in the order of the rows, and the coefficients of the stored
+  * blocks can be updated in place through block(k), so that the matrices of successive linearizations are refilled
+  * without rebuilding the structure. toSparse() converts the matrix back, with the zeros of its blocks.
+  *
+  * \sa SparseMatrix, SlicedEllMatrix, SparseOperatorBase
+  */
+template<typename _Scalar, int _BlockRows, int _BlockCols, typename _Index>
+class BlockSparseMatrix : public SparseOperatorBase<BlockSparseMatrix<_Scalar,_BlockRows,_BlockCols,_Index> >
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef _Index Index;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    enum {
+      BlockRows = _BlockRows,
+      BlockCols = _BlockCols
+    };
+    /** The type of the blocks, column major unless they are row vectors */
+    typedef Matrix<Scalar,BlockRows,BlockCols,(BlockRows==1 && BlockCols!=1) ? RowMajor : ColMajor> BlockType;
+    typedef Matrix<Scalar,Dynamic,1> ValueVector;
+    typedef Matrix<Index,Dynamic,1> IndexVector;
+
+    class InnerIterator;
+
+    /** Default constructor yielding an empty 0 x 0 matrix */
+    BlockSparseMatrix() : m_rows(0), m_cols(0), m_outerIndex(IndexVector::Zero(1)) {}
+
+    /** Constructs a BlockSparseMatrix from the sparse expression \a other, whose sizes must be multiples of the
+      * block sizes. */
+    template<typename OtherDerived>
+    explicit BlockSparseMatrix(const SparseMatrixBase<OtherDerived>& other)
+    {
+      *this = other;
+    }
+
+    /** Sets \a *this from the sparse expression \a other, whose sizes must be multiples of the block sizes.
+      * Every block holding at least one stored coefficient of \a other is stored. */
+    template<typename OtherDerived>
+    BlockSparseMatrix& operator=(const SparseMatrixBase<OtherDerived>& other)
+    {
+      const SparseMatrix<Scalar,RowMajor,Index> mat(other.derived());
+      eigen_assert(mat.rows()%BlockRows==0 && mat.cols()%BlockCols==0
+                && "BlockSparseMatrix: the sizes of the matrix must be multiples of the block sizes");
+      m_rows = mat.rows();
+      m_cols = mat.cols();
+      this->checkSelfAdjoint(mat);
+      const Index rowBlocks = m_rows/BlockRows, colBlocks = m_cols/BlockCols;
+
+      // pass 1: find the nonzero blocks of each block row, in increasing order,
+      // where position[c] is the position of the block c of the current block row
+      std::vector<Index> position(colBlocks, Index(-1));
+      std::vector<Index> blocks;
+      m_outerIndex.resize(rowBlocks+1);
+      m_outerIndex[0] = 0;
+      for(Index r=0; r<rowBlocks; ++r)
+      {
+        const std::size_t start = blocks.size();
+        for(Index i=r*BlockRows; i<(r+1)*BlockRows; ++i)
+          for(typename SparseMatrix<Scalar,RowMajor,Index>::InnerIterator it(mat,i); it; ++it)
+          {
+            const Index c = it.index()/BlockCols;
+            if(position[c]<0)
+            {
+              position[c] = 0;
+              blocks.push_back(c);
+            }
+          }
+        std::sort(blocks.begin()+start, blocks.end());
+        for(std::size_t k=start; k<blocks.size(); ++k)
+          position[blocks[k]] = Index(-1);
+        m_outerIndex[r+1] = Index(blocks.size());
+      }
+      m_innerIndices.resize(Index(blocks.size()));
+      std::copy(blocks.begin(), blocks.end(), m_innerIndices.data());
+
+      // pass 2: copy the coefficients
+      m_values.setZero(Index(blocks.size())*BlockType::SizeAtCompileTime);
+      for(Index r=0; r<rowBlocks; ++r)
+      {
+        for(Index k=m_outerIndex[r]; k<m_outerIndex[r+1]; ++k)
+          position[m_innerIndices[k]] = k;
+        for(Index i=r*BlockRows; i<(r+1)*BlockRows; ++i)
+          for(typename SparseMatrix<Scalar,RowMajor,Index>::InnerIterator it(mat,i); it; ++it)
+          {
+            const Index c = it.index()/BlockCols;
+            block(position[c]).coeffRef(i%BlockRows, it.index()%BlockCols) = it.value();
+          }
+      }
+      return *this;
+    }
+
+    /** \returns a SparseMatrix storing all the coefficients of the nonzero blocks, including their zeros */
+    SparseMatrix<Scalar,ColMajor,Index> toSparse() const
+    {
+      typedef Triplet<Scalar,Index> T;
+      std::vector<T> triplets;
+      triplets.reserve(m_values.size());
+      for(Index r=0; r<rowBlocks(); ++r)
+        for(Index k=m_outerIndex[r]; k<m_outerIndex[r+1]; ++k)
+          for(Index j=0; j<BlockCols; ++j)
+            for(Index i=0; i<BlockRows; ++i)
+              triplets.push_back(T(r*BlockRows+i, m_innerIndices[k]*BlockCols+j, block(k).coeff(i,j)));
+      SparseMatrix<Scalar,ColMajor,Index> res(m_rows, m_cols);
+      res.setFromTriplets(triplets.begin(), triplets.end());
+      return res;
+    }
+
+    inline Index rows() const { return m_rows; }
+    inline Index cols() const { return m_cols; }
+    inline Index outerSize() const { return m_rows; }
+    inline Index innerSize() const { return m_cols; }
+    /** \returns the number of block rows */
+    inline Index rowBlocks() const { return m_rows/BlockRows; }
+    /** \returns the number of block columns */
+    inline Index colBlocks() const { return m_cols/BlockCols; }
+    /** \returns the number of stored blocks */
+    inline Index nonZeroBlocks() const { return Index(m_innerIndices.size()); }
+    /** \returns the number of stored coefficients, that is the number of stored blocks times the size of a block */
+    inline Index nonZeros() const { return Index(m_values.size()); }
+    /** \returns the number of stored coefficients, like nonZeros() */
+    inline Index storedSize() const { return Index(m_values.size()); }
+
+    /** \returns the \a k -th stored block */
+    inline Map<const BlockType> block(Index k) const
+    {
+      return Map<const BlockType>(m_values.data() + k*BlockType::SizeAtCompileTime);
+    }
+    /** \returns a writable reference to the \a k -th stored block, such that the values can be updated without
+      * changing the structure */
+    inline Map<BlockType> block(Index k)
+    {
+      return Map<BlockType>(m_values.data() + k*BlockType::SizeAtCompileTime);
+    }
+
+    /** \internal \returns the offsets of the block rows in the stored blocks */
+    inline const Index* blockOuterIndexPtr() const { return m_outerIndex.data(); }
+    /** \internal \returns the block column indices of the stored blocks */
+    inline const Index* blockInnerIndexPtr() const { return m_innerIndices.data(); }
+    /** \internal \returns the coefficients of the stored blocks */
+    inline const Scalar* valuePtr() const { return m_values.data(); }
+
+  protected:
+    Index m_rows;
+    Index m_cols;
+    IndexVector m_outerIndex;
+    IndexVector m_innerIndices;
+    ValueVector m_values;
+};
+
+/** \ingroup SparseExtra_Module
+  * \brief Iterates over the stored coefficients of a row of a BlockSparseMatrix, in increasing column order */
+template<typename Scalar, int BlockRows, int BlockCols, typename Index>
+class BlockSparseMatrix<Scalar,BlockRows,BlockCols,Index>::InnerIterator
+{
+  public:
+    InnerIterator(const BlockSparseMatrix& mat, Index outer)
+      : m_mat(mat), m_outer(outer), m_id(mat.m_outerIndex[outer/BlockRows]), m_end(mat.m_outerIndex[outer/BlockRows+1]), m_j(0)
+    {}
+
+    inline InnerIterator& operator++()
+    {
+      if(++m_j==BlockCols)
+      {
+        m_j = 0;
+        ++m_id;
+      }
+      return *this;
+    }
+
+    inline const Scalar& value() const
+    {
+      return m_mat.m_values.coeff(m_id*BlockRows*BlockCols + m_j*BlockRows + m_outer%BlockRows);
+    }
+    inline Index index() const { return m_mat.m_innerIndices.coeff(m_id)*BlockCols + m_j; }
+    inline Index outer() const { return m_outer; }
+    inline Index row() const { return m_outer; }
+    inline Index col() const { return index(); }
+
+    inline operator bool() const { return m_id < m_end; }
+
+  protected:
+    const BlockSparseMatrix& m_mat;
+    const Index m_outer;
+    Index m_id;
+    const Index m_end;
+    Index m_j;
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_BLOCK_SPARSE_MATRIX_H
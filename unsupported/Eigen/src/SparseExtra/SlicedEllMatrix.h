@@ -0,0 +1,295 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SLICED_ELL_MATRIX_H
+#define EIGEN_SLICED_ELL_MATRIX_H
+
+namespace Eigen {
+
+template<typename _Scalar, typename _Index = int> class SlicedEllMatrix;
+
+namespace internal {
+
+template<typename _Scalar, typename _Index>
+struct traits<SlicedEllMatrix<_Scalar,_Index> >
+{
+  typedef _Scalar Scalar;
+  typedef _Index Index;
+  typedef Sparse StorageKind;
+  typedef MatrixXpr XprKind;
+  enum {
+    RowsAtCompileTime = Dynamic,
+    ColsAtCompileTime = Dynamic,
+    MaxRowsAtCompileTime = Dynamic,
+    MaxColsAtCompileTime = Dynamic,
+    Flags = RowMajorBit | NestByRefBit,
+    CoeffReadCost = NumTraits<Scalar>::ReadCost
+  };
+};
+
+/** \internal The products of a SlicedEllMatrix by a dense matrix, processing the rows slice per slice. Each slice is
+  * processed as a single packet of rows, going through its columns of values from left to right, and gathering the
+  * matching coefficients of the rhs into a packet. The padding of the empty rows is not written to the result, such
+  * that they stay zero whatever the rhs. */
+template<typename _Scalar, typename _Index>
+struct sparse_operator_product_impl<SlicedEllMatrix<_Scalar,_Index> >
+{
+  typedef SlicedEllMatrix<_Scalar,_Index> MatrixType;
+  typedef _Scalar Scalar;
+  typedef _Index Index;
+  typedef typename packet_traits<Scalar>::type Packet;
+  enum { SliceHeight = MatrixType::SliceHeight };
+
+  static Index groups(const MatrixType& mat) { return mat.slices(); }
+  static const Index* groupStarts(const MatrixType& mat) { return mat.sliceStartPtr(); }
+
+  template<typename Rhs, typename Dest>
+  static void run(const MatrixType& mat, const Rhs& rhs, Dest& dst, const Scalar& alpha, Index begin, Index end)
+  {
+    const Index* sliceStarts = mat.sliceStartPtr();
+    const Index* permutation = mat.permutationPtr();
+    const Index* rowLengths = mat.rowLengthPtr();
+    const Index rows = mat.rows();
+    // two columns of the slice are processed at once, with their own gathering buffers and accumulators,
+    // so that the gathering of the next column is not stalled by the load of the previous one
+    EIGEN_ALIGN_DEFAULT Scalar x[2*SliceHeight];
+    for(Index j=0; j<rhs.cols(); ++j)
+      for(Index s=begin; s<end; ++s)
+      {
+        const Scalar* values = mat.valuePtr() + sliceStarts[s];
+        const Index* indices = mat.innerIndexPtr() + sliceStarts[s];
+        const Index width = (sliceStarts[s+1]-sliceStarts[s]) / SliceHeight;
+        Packet acc0 = pset1<Packet>(Scalar(0)), acc1 = pset1<Packet>(Scalar(0));
+        Index k = 0;
+        for(; k+1<width; k+=2, values+=2*SliceHeight, indices+=2*SliceHeight)
+        {
+          for(int l=0; l<2*SliceHeight; ++l)
+            x[l] = rhs.coeff(indices[l], j);
+          acc0 = pmadd(pload<Packet>(values), pload<Packet>(x), acc0);
+          acc1 = pmadd(pload<Packet>(values+SliceHeight), pload<Packet>(x+SliceHeight), acc1);
+        }
+        if(k<width)
+        {
+          for(int l=0; l<SliceHeight; ++l)
+            x[l] = rhs.coeff(indices[l], j);
+          acc0 = pmadd(pload<Packet>(values), pload<Packet>(x), acc0);
+        }
+        pstore(x, padd(acc0, acc1));
+        const Index height = (std::min)(Index(SliceHeight), rows-s*SliceHeight);
+        for(Index l=0; l<height; ++l)
+        {
+          const Index row = permutation[s*SliceHeight+l];
+          if(rowLengths[row]>0)
+            dst.coeffRef(row, j) += alpha * x[l];
+        }
+      }
+  }
+};
+
+} // end namespace internal
+
+/** \ingroup SparseExtra_Module
+  *
+  * \class SlicedEllMatrix
+  *
+  * \brief A read-only sparse matrix in the SELL-C-sigma format, designed for fast products with dense vectors
+  *
+  * \param _Scalar the scalar type, i.e. the type of the coefficients
+  * \param _Index the type of the indices
+  *
+  * The rows are grouped into slices of C = \c SliceHeight consecutive rows, C being the number of scalars in a
+  * SIMD packet. The nonzeros of a slice are stored column by column, padded to the length of its longest row, such
+  * that a product with a dense vector processes the C rows of a slice at once, one packet of values after the other.
+  * To reduce the padding, the rows are first sorted by decreasing number of nonzeros within windows of \c sigma
+  * rows, the sorting scope. A larger scope gives less padding, while a smaller scope better preserves the locality
+  * of the accesses to the dense vector.
+  *
+  * A SlicedEllMatrix is built once from any sparse expression, typically to speed up the many products of an
+  * iterative solver, and cannot be modified afterwards:
+  * \code
+  * SparseMatrix<double> A;
+  * // fill A
+  * SlicedEllMatrix<double> B(A);
+  * ConjugateGradient<SlicedEllMatrix<double> > cg(B);
+  * x = cg.solve(b);
+  * \endcode
+  * The products are multithreaded like the other sparse * dense products, the slices being split among threads by
+  * chunks of the same number of stored coefficients. The padding of a row refers to its last column, so that it does
+  * not bring new coefficients of the dense vector into the cache. Like any SparseOperatorBase, the matrix can only be
+  * multiplied by dense matrices, for instance by ConjugateGradient or BiCGSTAB with a DiagonalPreconditioner or an
+  * IdentityPreconditioner.
+  *
+  * \sa SparseMatrix, SparseOperatorBase
+  */
+template<typename _Scalar, typename _Index>
+class SlicedEllMatrix : public SparseOperatorBase<SlicedEllMatrix<_Scalar,_Index> >
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef _Index Index;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    enum {
+      SliceHeight = internal::packet_traits<Scalar>::size
+    };
+    typedef Matrix<Scalar,Dynamic,1> ValueVector;
+    typedef Matrix<Index,Dynamic,1> IndexVector;
+
+    class InnerIterator;
+
+    /** Default constructor yielding an empty 0 x 0 matrix */
+    SlicedEllMatrix() : m_rows(0), m_cols(0), m_nonZeros(0), m_sortingScope(1), m_sliceStarts(IndexVector::Zero(1)) {}
+
+    /** Constructs a SlicedEllMatrix from the sparse expression \a other, sorting the rows within windows
+      * of \a sortingScope rows. */
+    template<typename OtherDerived>
+    explicit SlicedEllMatrix(const SparseMatrixBase<OtherDerived>& other, Index sortingScope = 8*SliceHeight)
+    {
+      compute(other, sortingScope);
+    }
+
+    /** Sets \a *this from the sparse expression \a other, sorting the rows within windows of \a sortingScope rows. */
+    template<typename OtherDerived>
+    SlicedEllMatrix& compute(const SparseMatrixBase<OtherDerived>& other, Index sortingScope = 8*SliceHeight)
+    {
+      eigen_assert(sortingScope>0);
+      const SparseMatrix<Scalar,RowMajor,Index> mat(other.derived());
+      m_rows = mat.rows();
+      m_cols = mat.cols();
+      m_nonZeros = mat.nonZeros();
+      m_sortingScope = sortingScope;
+      this->checkSelfAdjoint(mat);
+
+      // sort the rows by decreasing number of nonzeros within each window
+      m_rowLengths.resize(m_rows);
+      for(Index i=0; i<m_rows; ++i)
+        m_rowLengths[i] = mat.outerIndexPtr()[i+1] - mat.outerIndexPtr()[i];
+      m_permutation.resize(m_rows);
+      for(Index i=0; i<m_rows; ++i)
+        m_permutation[i] = i;
+      for(Index i=0; i<m_rows; i+=sortingScope)
+        std::stable_sort(m_permutation.data()+i, m_permutation.data()+(std::min)(m_rows,i+sortingScope),
+                         longer_row(m_rowLengths.data()));
+      m_positions.resize(m_rows);
+      for(Index p=0; p<m_rows; ++p)
+        m_positions[m_permutation[p]] = p;
+
+      // each slice is as wide as its longest row
+      const Index slices = (m_rows+SliceHeight-1) / SliceHeight;
+      m_sliceStarts.resize(slices+1);
+      m_sliceStarts[0] = 0;
+      for(Index s=0; s<slices; ++s)
+      {
+        Index width = 0;
+        for(Index p=s*SliceHeight; p<(std::min)(m_rows,(s+1)*SliceHeight); ++p)
+          width = (std::max)(width, m_rowLengths[m_permutation[p]]);
+        m_sliceStarts[s+1] = m_sliceStarts[s] + width*SliceHeight;
+      }
+
+      // copy the rows, the padding refers to the last column of the row to keep the accesses to the rhs local,
+      // while the products skip the empty rows
+      m_values.setZero(m_sliceStarts[slices]);
+      m_indices.setZero(m_sliceStarts[slices]);
+      for(Index p=0; p<m_rows; ++p)
+      {
+        const Index row = m_permutation[p];
+        const Index s = p / SliceHeight, width = (m_sliceStarts[s+1]-m_sliceStarts[s]) / SliceHeight;
+        const Index start = mat.outerIndexPtr()[row], length = m_rowLengths[row];
+        Index dst = m_sliceStarts[s] + p%SliceHeight;
+        for(Index k=0; k<width; ++k, dst+=SliceHeight)
+        {
+          if(k<length)
+          {
+            m_values[dst] = mat.valuePtr()[start+k];
+            m_indices[dst] = mat.innerIndexPtr()[start+k];
+          }
+          else if(length>0)
+            m_indices[dst] = mat.innerIndexPtr()[start+length-1];
+        }
+      }
+      return *this;
+    }
+
+    inline Index rows() const { return m_rows; }
+    inline Index cols() const { return m_cols; }
+    inline Index outerSize() const { return m_rows; }
+    inline Index innerSize() const { return m_cols; }
+    /** \returns the number of nonzeros, not counting the padding */
+    inline Index nonZeros() const { return m_nonZeros; }
+    /** \returns the number of stored coefficients, including the padding */
+    inline Index storedSize() const { return Index(m_values.size()); }
+    /** \returns the number of rows within which the rows are sorted by decreasing number of nonzeros */
+    inline Index sortingScope() const { return m_sortingScope; }
+    /** \returns the number of slices */
+    inline Index slices() const { return Index(m_sliceStarts.size()) - 1; }
+
+    /** \internal \returns the offsets of the slices in the value and index arrays */
+    inline const Index* sliceStartPtr() const { return m_sliceStarts.data(); }
+    /** \internal \returns the stored values, slice per slice and column per column */
+    inline const Scalar* valuePtr() const { return m_values.data(); }
+    /** \internal \returns the column indices of the stored values */
+    inline const Index* innerIndexPtr() const { return m_indices.data(); }
+    /** \internal \returns the rows in their storage order */
+    inline const Index* permutationPtr() const { return m_permutation.data(); }
+    /** \internal \returns the number of nonzeros of each row, in the original order */
+    inline const Index* rowLengthPtr() const { return m_rowLengths.data(); }
+
+  protected:
+    struct longer_row
+    {
+      longer_row(const Index* lengths) : m_lengths(lengths) {}
+      bool operator()(Index a, Index b) const { return m_lengths[a]>m_lengths[b]; }
+      const Index* m_lengths;
+    };
+
+    Index m_rows;
+    Index m_cols;
+    Index m_nonZeros;
+    Index m_sortingScope;
+    IndexVector m_sliceStarts;
+    ValueVector m_values;
+    IndexVector m_indices;
+    // m_permutation[p] is the row stored at the position p, m_positions is its inverse
+    IndexVector m_permutation;
+    IndexVector m_positions;
+    IndexVector m_rowLengths;
+};
+
+/** \ingroup SparseExtra_Module
+  * \brief Iterates over the nonzeros of a row of a SlicedEllMatrix, in increasing column order */
+template<typename Scalar, typename Index>
+class SlicedEllMatrix<Scalar,Index>::InnerIterator
+{
+  public:
+    InnerIterator(const SlicedEllMatrix& mat, Index outer)
+      : m_values(mat.valuePtr()), m_indices(mat.innerIndexPtr()), m_outer(outer)
+    {
+      const Index p = mat.m_positions[outer];
+      m_id = mat.m_sliceStarts[p/SliceHeight] + p%SliceHeight;
+      m_end = m_id + mat.m_rowLengths[outer]*SliceHeight;
+    }
+
+    inline InnerIterator& operator++() { m_id += SliceHeight; return *this; }
+
+    inline const Scalar& value() const { return m_values[m_id]; }
+    inline Index index() const { return m_indices[m_id]; }
+    inline Index outer() const { return m_outer; }
+    inline Index row() const { return m_outer; }
+    inline Index col() const { return index(); }
+
+    inline operator bool() const { return m_id < m_end; }
+
+  protected:
+    const Scalar* m_values;
+    const Index* m_indices;
+    const Index m_outer;
+    Index m_id;
+    Index m_end;
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_SLICED_ELL_MATRIX_H
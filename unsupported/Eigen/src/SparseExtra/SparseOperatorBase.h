@@ -0,0 +1,185 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SPARSE_OPERATOR_BASE_H
+#define EIGEN_SPARSE_OPERATOR_BASE_H
+
+namespace Eigen {
+
+template<typename Derived> class SparseOperatorBase;
+template<typename Lhs, typename Rhs> class SparseOperatorTimeDenseProduct;
+
+namespace internal {
+
+template<typename Lhs, typename Rhs>
+struct traits<SparseOperatorTimeDenseProduct<Lhs,Rhs> >
+ : traits<ProductBase<SparseOperatorTimeDenseProduct<Lhs,Rhs>, Lhs, Rhs> >
+{
+  typedef Dense StorageKind;
+  typedef MatrixXpr XprKind;
+};
+
+/** \internal Implements the products of a matrix deriving from SparseOperatorBase, and must be specialized for each
+  * of them. The rows of the matrix are processed by groups, such as the slices of a SlicedEllMatrix:
+  *  - groups(mat) returns the number of groups,
+  *  - groupStarts(mat) returns the offsets of the groups in the storage, which measure the cost of their products,
+  *  - run(mat, rhs, res, alpha, begin, end) adds \a alpha times the product of the rows of the groups [begin,end)
+  *    by \a rhs to the matching rows of \a res, without touching the other rows. */
+template<typename MatrixType> struct sparse_operator_product_impl;
+
+/** \internal The jobs of a parallel product of a SparseOperatorBase by a dense matrix: job \a i processes the groups of
+  * rows [bounds[i],bounds[i+1]). */
+template<typename MatrixType, typename Rhs, typename Dest>
+struct sparse_operator_product_job
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::Index Index;
+
+  sparse_operator_product_job(const MatrixType& mat, const Rhs& rhs, Dest& dst, const Scalar& alpha, const Index* bounds)
+    : m_mat(mat), m_rhs(rhs), m_dst(dst), m_alpha(alpha), m_bounds(bounds)
+  {}
+
+  void operator()(int i) const
+  {
+    sparse_operator_product_impl<MatrixType>::run(m_mat, m_rhs, m_dst, m_alpha, m_bounds[i], m_bounds[i+1]);
+  }
+
+  const MatrixType& m_mat;
+  const Rhs& m_rhs;
+  Dest& m_dst;
+  Scalar m_alpha;
+  const Index* m_bounds;
+};
+
+template<typename MatrixType, typename Rhs, typename Dest>
+void sparse_operator_product(const MatrixType& mat, const Rhs& rhs, Dest& dst, const typename MatrixType::Scalar& alpha)
+{
+  typedef typename MatrixType::Index Index;
+  typedef sparse_operator_product_impl<MatrixType> Impl;
+  const Index groups = Impl::groups(mat);
+  const Index* groupStarts = Impl::groupStarts(mat);
+
+  // the groups are split among threads in chunks having roughly the same number of stored coefficients
+  const double work = double(mat.storedSize()) * double(rhs.cols());
+  Index threads = Index((std::min)(double(parallel_max_threads()), work / double(EIGEN_SPARSE_DENSE_PRODUCT_MIN_WORK_PER_THREAD)));
+  threads = (std::min)(threads, groups);
+  if(threads<=1)
+  {
+    Impl::run(mat, rhs, dst, alpha, 0, groups);
+    return;
+  }
+
+  std::vector<Index> bounds;
+  parallel_outer_bounds(groupStarts, groups, threads, bounds);
+  sparse_operator_product_job<MatrixType,Rhs,Dest> job(mat, rhs, dst, alpha, &bounds[0]);
+  parallel_for(job, int(threads));
+}
+
+} // end namespace internal
+
+/** \ingroup SparseExtra_Module
+  *
+  * \class SparseOperatorBase
+  *
+  * \brief Base class of the read-only sparse matrices which are only meant to be multiplied by dense matrices
+  *
+  * \param Derived the type of the matrix, for which internal::sparse_operator_product_impl must be specialized
+  *
+  * This class implements what the iterative solvers need from their MatrixType: the multithreaded products by dense
+  * vectors, which are evaluated like the other products (into a temporary, unless noalias() is used), and
+  * selfadjointView(). Such matrices store all their nonzeros, so that the selfadjoint view of ConjugateGradient is
+  * the matrix itself, which must then be selfadjoint whatever the triangular part passed to the solver.
+  */
+template<typename Derived>
+class SparseOperatorBase
+{
+  public:
+    typedef typename internal::traits<Derived>::Scalar Scalar;
+    typedef typename internal::traits<Derived>::Index Index;
+    enum {
+      RowsAtCompileTime = Dynamic,
+      ColsAtCompileTime = Dynamic,
+      MaxRowsAtCompileTime = Dynamic,
+      MaxColsAtCompileTime = Dynamic,
+      IsVectorAtCompileTime = 0,
+      IsRowMajor = 1,
+      Flags = internal::traits<Derived>::Flags
+    };
+    // nested by reference in the product expressions, which never need to copy it
+    typedef const Derived& Nested;
+    typedef Derived PlainObject;
+
+    inline const Derived& derived() const { return *static_cast<const Derived*>(this); }
+
+    /** \returns an expression of the product of \a *this by the dense matrix or vector \a other */
+    template<typename OtherDerived>
+    inline const SparseOperatorTimeDenseProduct<Derived,OtherDerived> operator*(const MatrixBase<OtherDerived>& other) const
+    {
+      return SparseOperatorTimeDenseProduct<Derived,OtherDerived>(derived(), other.derived());
+    }
+
+    /** \returns whether the matrix is square and equal to its adjoint, up to the default precision */
+    inline bool isSelfAdjoint() const { return m_isSelfAdjoint; }
+
+    /** \returns \a *this, which must be selfadjoint with both of its triangular parts stored, whatever \a UpLo.
+      * This allows the matrix to be used by ConjugateGradient.
+      * \sa isSelfAdjoint() */
+    template<unsigned int UpLo> inline const Derived& selfadjointView() const
+    {
+      eigen_assert(m_isSelfAdjoint && "the selfadjoint view of this matrix requires both triangular parts to be stored");
+      return derived();
+    }
+
+  protected:
+    SparseOperatorBase() : m_isSelfAdjoint(true) {}
+
+    /** \internal Records whether the sparse matrix \a mat, from which \a *this is built, is selfadjoint */
+    template<typename MatrixType> void checkSelfAdjoint(const MatrixType& mat)
+    {
+      typedef typename NumTraits<Scalar>::Real RealScalar;
+      m_isSelfAdjoint = mat.rows()==mat.cols();
+      if(m_isSelfAdjoint)
+      {
+        const MatrixType diff = mat - MatrixType(mat.adjoint());
+        const RealScalar prec = NumTraits<RealScalar>::dummy_precision();
+        m_isSelfAdjoint = diff.squaredNorm() <= prec * prec * mat.squaredNorm();
+      }
+    }
+
+    bool m_isSelfAdjoint;
+};
+
+/** \ingroup SparseExtra_Module
+  * \brief Expression of the product of a SparseOperatorBase by a dense matrix or vector
+  *
+  * \sa SparseOperatorBase::operator*()
+  */
+template<typename Lhs, typename Rhs>
+class SparseOperatorTimeDenseProduct
+  : public ProductBase<SparseOperatorTimeDenseProduct<Lhs,Rhs>, Lhs, Rhs>
+{
+  public:
+    EIGEN_PRODUCT_PUBLIC_INTERFACE(SparseOperatorTimeDenseProduct)
+
+    SparseOperatorTimeDenseProduct(const Lhs& lhs, const Rhs& rhs) : Base(lhs,rhs)
+    {
+      EIGEN_STATIC_ASSERT((internal::is_same<typename Lhs::Scalar, typename Rhs::Scalar>::value),
+        YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+    }
+
+    template<typename Dest> void scaleAndAddTo(Dest& dest, const Scalar& alpha) const
+    {
+      internal::sparse_operator_product(m_lhs, m_rhs, dest, alpha);
+    }
+
+  private:
+    SparseOperatorTimeDenseProduct& operator=(const SparseOperatorTimeDenseProduct&);
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_SPARSE_OPERATOR_BASE_H
@@ -0,0 +1,201 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+#include <Eigen/Dense>
+#include <unsupported/Eigen/BatchedMatrix>
+
+template<typename Scalar, int Rows, int Cols>
+void fill_random(BatchedMatrix<Scalar,Rows,Cols>& batch)
+{
+  for(DenseIndex k=0; k<batch.count(); ++k)
+    batch.setMatrix(k, Matrix<Scalar,Rows,Cols>::Random());
+}
+
+template<typename Scalar, int Rows, int Cols> void batched_storage()
+{
+  typedef BatchedMatrix<Scalar,Rows,Cols> Batch;
+  DenseIndex n = internal::random<int>(1,50);
+  Batch a(n);
+  VERIFY_IS_EQUAL(a.count(), n);
+  VERIFY_IS_EQUAL(a.groups(), (n+Batch::PacketSize-1)/Batch::PacketSize);
+  VERIFY(a.matrix(n-1).isZero());
+
+  std::vector<Matrix<Scalar,Rows,Cols>, aligned_allocator<Matrix<Scalar,Rows,Cols> > > ref(n);
+  for(DenseIndex k=0; k<n; ++k)
+  {
+    ref[k].setRandom();
+    a.setMatrix(k, ref[k]);
+  }
+  Batch b(a);
+  for(DenseIndex k=0; k<n; ++k)
+  {
+    VERIFY_IS_EQUAL(b.matrix(k), ref[k]);
+    VERIFY_IS_EQUAL(a(k,Rows-1,0), ref[k](Rows-1,0));
+  }
+  // the same coefficient of consecutive matrices is contiguous
+  if(n>1)
+    VERIFY_IS_EQUAL(&a.coeffRef(1,0,0)-&a.coeffRef(0,0,0), DenseIndex(Batch::PacketSize>1 ? 1 : Rows*Cols));
+
+  b.setIdentity();
+  VERIFY_IS_EQUAL(b.matrix(n-1), (Matrix<Scalar,Rows,Cols>::Identity()));
+}
+
+template<typename Scalar, int Size> void batched_products()
+{
+  typedef Matrix<Scalar,Size,Size> MatrixType;
+  DenseIndex n = internal::random<int>(1,100);
+  BatchedMatrix<Scalar,Size,Size> a(n), b(n), c;
+  BatchedMatrix<Scalar,Size,2> v(n), w;
+  fill_random(a);
+  fill_random(b);
+  fill_random(v);
+
+  batchedProduct(a, b, c);
+  w = a * v;
+  for(DenseIndex k=0; k<n; ++k)
+  {
+    VERIFY_IS_APPROX(c.matrix(k), MatrixType(a.matrix(k)*b.matrix(k)));
+    VERIFY_IS_APPROX(w.matrix(k), (Matrix<Scalar,Size,2>(a.matrix(k)*v.matrix(k))));
+  }
+
+  // in place
+  BatchedMatrix<Scalar,Size,Size> a0(a);
+  batchedProduct(a, b, a);
+  for(DenseIndex k=0; k<n; ++k)
+    VERIFY_IS_APPROX(a.matrix(k), MatrixType(a0.matrix(k)*b.matrix(k)));
+}
+
+template<typename Scalar, int Size> void batched_lu()
+{
+  typedef Matrix<Scalar,Size,Size> MatrixType;
+  DenseIndex n = internal::random<int>(1,100);
+  BatchedMatrix<Scalar,Size,Size> a(n), inv, inv2;
+  BatchedMatrix<Scalar,Size,3> b(n);
+  BatchedMatrix<Scalar,1,1> det, det2;
+  for(DenseIndex k=0; k<n; ++k)
+  {
+    // invertible matrices, whose largest coefficients are not on the diagonal
+    MatrixType m = MatrixType::Random();
+    m.col(0).swap(m.col(Size-1));
+    m += MatrixType::Identity().reverse() * Scalar(Size);
+    a.setMatrix(k, m);
+  }
+  fill_random(b);
+
+  BatchedPartialPivLU<Scalar,Size> lu(a);
+  BatchedMatrix<Scalar,Size,3> x = lu.solve(b);
+  batchedInverse(a, inv);
+  batchedDeterminant(a, det);
+  inv2 = lu.inverse();
+  det2 = lu.determinant();
+  for(DenseIndex k=0; k<n; ++k)
+  {
+    MatrixType m = a.matrix(k);
+    PartialPivLU<MatrixType> ref(m);
+    VERIFY_IS_APPROX(x.matrix(k), (Matrix<Scalar,Size,3>(ref.solve(b.matrix(k)))));
+    VERIFY_IS_APPROX(inv.matrix(k), ref.inverse());
+    VERIFY_IS_APPROX(inv2.matrix(k), ref.inverse());
+    VERIFY_IS_APPROX(det(k,0,0), ref.determinant());
+    VERIFY_IS_APPROX(det2(k,0,0), ref.determinant());
+  }
+}
+
+template<typename Scalar, int Size> void batched_cholesky()
+{
+  typedef Matrix<Scalar,Size,Size> MatrixType;
+  DenseIndex n = internal::random<int>(1,100);
+  BatchedMatrix<Scalar,Size,Size> spd(n), indefinite(n);
+  BatchedMatrix<Scalar,Size,2> b(n);
+  for(DenseIndex k=0; k<n; ++k)
+  {
+    MatrixType m = MatrixType::Random();
+    spd.setMatrix(k, m*m.adjoint() + MatrixType::Identity());
+    MatrixType d = MatrixType::Zero();
+    for(int i=0; i<Size; ++i)
+      d(i,i) = (i%2==0 ? Scalar(1) : Scalar(-1)) * internal::random<Scalar>(Scalar(1),Scalar(2));
+    MatrixType q = m.householderQr().householderQ();
+    indefinite.setMatrix(k, q*d*q.adjoint());
+  }
+  fill_random(b);
+
+  BatchedLLT<Scalar,Size> llt(spd);
+  VERIFY_IS_EQUAL(llt.info(), Success);
+  BatchedMatrix<Scalar,Size,2> x = llt.solve(b);
+  BatchedLDLT<Scalar,Size> ldlt(spd);
+  VERIFY_IS_EQUAL(ldlt.info(), Success);
+  BatchedMatrix<Scalar,Size,2> y = ldlt.solve(b);
+  ldlt.compute(indefinite);
+  VERIFY_IS_EQUAL(ldlt.info(), Success);
+  BatchedMatrix<Scalar,Size,2> z = ldlt.solve(b);
+  for(DenseIndex k=0; k<n; ++k)
+  {
+    VERIFY_IS_APPROX(x.matrix(k), (Matrix<Scalar,Size,2>(spd.matrix(k).llt().solve(b.matrix(k)))));
+    VERIFY_IS_APPROX(MatrixType(llt.matrixL().matrix(k).template triangularView<Lower>()), MatrixType(spd.matrix(k).llt().matrixL()));
+    VERIFY_IS_APPROX(y.matrix(k), (Matrix<Scalar,Size,2>(spd.matrix(k).ldlt().solve(b.matrix(k)))));
+    // diagonal pivoting is not backward stable for indefinite matrices, so only check the residual of these well conditioned ones
+    VERIFY_IS_APPROX((Matrix<Scalar,Size,2>(indefinite.matrix(k)*z.matrix(k))), b.matrix(k));
+  }
+
+  // not positive definite
+  spd.setMatrix(n-1, -MatrixType::Identity());
+  llt.compute(spd);
+  VERIFY_IS_EQUAL(llt.info(), NumericalIssue);
+}
+
+template<typename Scalar, int Rows, int Cols> void batched_svd()
+{
+  typedef Matrix<Scalar,Rows,Cols> MatrixType;
+  DenseIndex n = internal::random<int>(1,100);
+  BatchedMatrix<Scalar,Rows,Cols> a(n);
+  fill_random(a);
+  // a rank deficient matrix
+  MatrixType m = MatrixType::Random();
+  m.col(Cols-1) = m.col(0);
+  a.setMatrix(0, m);
+
+  BatchedJacobiSVD<Scalar,Rows,Cols> svd(a, ComputeThinU|ComputeThinV);
+  BatchedJacobiSVD<Scalar,Rows,Cols> svdValuesOnly(a);
+  for(DenseIndex k=0; k<n; ++k)
+  {
+    JacobiSVD<MatrixType> ref(a.matrix(k));
+    Matrix<Scalar,Cols,1> sigma = svd.singularValues().matrix(k);
+    VERIFY_IS_APPROX(sigma, ref.singularValues());
+    VERIFY_IS_APPROX((Matrix<Scalar,Cols,1>(svdValuesOnly.singularValues().matrix(k))), ref.singularValues());
+    Matrix<Scalar,Rows,Cols> u = svd.matrixU().matrix(k);
+    Matrix<Scalar,Cols,Cols> v = svd.matrixV().matrix(k);
+    VERIFY_IS_APPROX(MatrixType(u * sigma.asDiagonal() * v.transpose()), a.matrix(k));
+    VERIFY_IS_APPROX(v.transpose()*v, (Matrix<Scalar,Cols,Cols>::Identity()));
+  }
+}
+
+void test_batched_matrix()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( batched_storage<float,3,3>() ));
+    CALL_SUBTEST_1(( batched_storage<double,6,2>() ));
+    CALL_SUBTEST_1(( batched_storage<long double,2,2>() ));
+
+    CALL_SUBTEST_2(( batched_products<float,3>() ));
+    CALL_SUBTEST_2(( batched_products<double,4>() ));
+    CALL_SUBTEST_2(( batched_products<double,6>() ));
+
+    CALL_SUBTEST_3(( batched_lu<float,1>() ));
+    CALL_SUBTEST_3(( batched_lu<float,2>() ));
+    CALL_SUBTEST_3(( batched_lu<double,3>() ));
+    CALL_SUBTEST_3(( batched_lu<double,4>() ));
+    CALL_SUBTEST_3(( batched_lu<float,6>() ));
+
+    CALL_SUBTEST_4(( batched_cholesky<float,3>() ));
+    CALL_SUBTEST_4(( batched_cholesky<double,4>() ));
+    CALL_SUBTEST_4(( batched_cholesky<double,6>() ));
+
+    CALL_SUBTEST_5(( batched_svd<float,3,3>() ));
+    CALL_SUBTEST_5(( batched_svd<double,4,4>() ));
+    CALL_SUBTEST_5(( batched_svd<double,6,3>() ));
+  }
+}
@@ -0,0 +1,169 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <set>
+#include "sparse.h"
+#include <Eigen/IterativeLinearSolvers>
+#include <unsupported/Eigen/SparseExtra>
+
+// Fills \a mat with random dense blocks, about \a blocksPerRow per block row, plus the transposed blocks if
+// \a selfadjoint is true, and returns the number of distinct blocks.
+template<int BlockRows, int BlockCols, typename Scalar>
+int fill_random_blocks(SparseMatrix<Scalar>& mat, int blocksPerRow, bool selfadjoint)
+{
+  typedef Matrix<Scalar,BlockRows,BlockCols> Block;
+  const int rowBlocks = mat.rows()/BlockRows, colBlocks = mat.cols()/BlockCols;
+  std::vector<Triplet<Scalar> > triplets;
+  std::set<std::pair<int,int> > blocks;
+  for(int r=0; r<rowBlocks; ++r)
+    for(int k=0; k<blocksPerRow; ++k)
+    {
+      const int c = internal::random<int>(0,colBlocks-1);
+      if(!blocks.insert(std::make_pair(r,c)).second || (selfadjoint && !blocks.insert(std::make_pair(c,r)).second))
+        continue;
+      const Block a = Block::Random();
+      for(int j=0; j<BlockCols; ++j)
+        for(int i=0; i<BlockRows; ++i)
+        {
+          triplets.push_back(Triplet<Scalar>(r*BlockRows+i, c*BlockCols+j, a(i,j)));
+          if(selfadjoint)
+            triplets.push_back(Triplet<Scalar>(c*BlockCols+j, r*BlockRows+i, numext::conj(a(i,j))));
+        }
+    }
+  mat.setFromTriplets(triplets.begin(), triplets.end());
+  return int(blocks.size());
+}
+
+template<typename Scalar, int BlockRows, int BlockCols> void block_sparse_structure()
+{
+  typedef BlockSparseMatrix<Scalar,BlockRows,BlockCols> BsrMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  const int rowBlocks = internal::random<int>(1,40), colBlocks = internal::random<int>(1,40);
+
+  // a matrix made of dense blocks is stored exactly
+  SparseMatrix<Scalar> m(rowBlocks*BlockRows, colBlocks*BlockCols);
+  const int blocks = fill_random_blocks<BlockRows,BlockCols>(m, internal::random<int>(1,4), false);
+  BsrMatrix bsr(m);
+  VERIFY_IS_EQUAL(bsr.rowBlocks(), rowBlocks);
+  VERIFY_IS_EQUAL(bsr.colBlocks(), colBlocks);
+  VERIFY_IS_EQUAL(bsr.nonZeroBlocks(), blocks);
+  VERIFY_IS_EQUAL(bsr.nonZeros(), m.nonZeros());
+  VERIFY_IS_APPROX(bsr.toSparse(), m);
+
+  // the blocks of each block row are sorted by column, and a row is iterated with the zeros of its blocks
+  const DenseMatrix refMat(m);
+  for(int r=0; r<rowBlocks; ++r)
+    for(int k=bsr.blockOuterIndexPtr()[r]; k<bsr.blockOuterIndexPtr()[r+1]; ++k)
+    {
+      if(k>bsr.blockOuterIndexPtr()[r])
+        VERIFY(bsr.blockInnerIndexPtr()[k-1]<bsr.blockInnerIndexPtr()[k]);
+      VERIFY_IS_APPROX(DenseMatrix(bsr.block(k)), refMat.block(r*BlockRows, bsr.blockInnerIndexPtr()[k]*BlockCols, BlockRows, BlockCols));
+    }
+  for(int i=0; i<m.rows(); ++i)
+  {
+    int count = 0;
+    for(typename BsrMatrix::InnerIterator it(bsr,i); it; ++it, ++count)
+      VERIFY_IS_EQUAL(it.value(), refMat(i,it.index()));
+    VERIFY_IS_EQUAL(count, int(bsr.blockOuterIndexPtr()[i/BlockRows+1]-bsr.blockOuterIndexPtr()[i/BlockRows])*BlockCols);
+  }
+
+  // a scattered nonzero brings in a whole block of zeros
+  SparseMatrix<Scalar> scattered = m;
+  const int i = internal::random<int>(0,int(m.rows())-1), j = internal::random<int>(0,int(m.cols())-1);
+  scattered.coeffRef(i,j) += Scalar(1);
+  BsrMatrix bsr2(scattered);
+  VERIFY(bsr2.nonZeroBlocks()==blocks || bsr2.nonZeroBlocks()==blocks+1);
+  VERIFY_IS_EQUAL(bsr2.nonZeros(), bsr2.nonZeroBlocks()*BlockRows*BlockCols);
+  VERIFY_IS_APPROX(bsr2.toSparse(), scattered);
+
+  // the values are updated in place
+  for(int k=0; k<bsr.nonZeroBlocks(); ++k)
+    bsr.block(k) *= Scalar(2);
+  VERIFY_IS_APPROX(bsr.toSparse(), SparseMatrix<Scalar>(Scalar(2)*m));
+
+  BsrMatrix empty(SparseMatrix<Scalar>(rowBlocks*BlockRows, colBlocks*BlockCols));
+  VERIFY_IS_EQUAL(empty.nonZeroBlocks(), 0);
+  VERIFY_IS_EQUAL(empty.toSparse().nonZeros(), 0);
+}
+
+template<typename Scalar, int BlockRows, int BlockCols> void block_sparse_products()
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  const int rows = BlockRows*internal::random<int>(1,60);
+  const int cols = BlockCols*internal::random<int>(1,60);
+
+  // random nonzeros, such that the blocks are partially filled
+  DenseMatrix refMat = DenseMatrix::Zero(rows, cols);
+  SparseMatrix<Scalar> m(rows, cols);
+  initSparse<Scalar>(internal::random<double>(0.01,0.2), refMat, m);
+  BlockSparseMatrix<Scalar,BlockRows,BlockCols> bsr(m);
+
+  DenseVector v = DenseVector::Random(cols), res(rows);
+  DenseMatrix b = DenseMatrix::Random(cols, internal::random<int>(1,5));
+  VERIFY_IS_APPROX(res = bsr*v, refMat*v);
+  VERIFY_IS_APPROX(res.noalias() = bsr*b.col(0), refMat*b.col(0));
+  VERIFY_IS_APPROX(DenseMatrix(bsr*b), refMat*b);
+  VERIFY_IS_APPROX(DenseVector(bsr*(v+v)), refMat*(v+v));
+  DenseVector res2 = res;
+  VERIFY_IS_APPROX(res2 += bsr*v, res + refMat*v);
+  VERIFY_IS_APPROX(res2.noalias() -= Scalar(2)*(bsr*v), res - refMat*v);
+}
+
+template<typename Scalar, int BlockSize> void block_sparse_solvers()
+{
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  typedef BlockSparseMatrix<Scalar,BlockSize> BsrMatrix;
+  const int n = BlockSize*internal::random<int>(20,100);
+
+  // selfadjoint positive definite, with both triangular parts stored
+  SparseMatrix<Scalar> spd(n, n);
+  fill_random_blocks<BlockSize,BlockSize>(spd, 3, true);
+  for(int i=0; i<n; ++i)
+    spd.coeffRef(i,i) += Scalar(12*BlockSize);
+  DenseVector b = DenseVector::Random(n);
+
+  BsrMatrix bsr(spd);
+  VERIFY(bsr.isSelfAdjoint());
+  ConjugateGradient<BsrMatrix, Upper> cg(bsr);
+  DenseVector x = cg.solve(b);
+  VERIFY_IS_EQUAL(cg.info(), Success);
+  VERIFY_IS_APPROX(spd*x, b);
+
+  // the products are evaluated into a temporary when the result aliases the rhs
+  DenseVector y = x;
+  VERIFY_IS_APPROX(y = bsr*y, b);
+
+  // general
+  SparseMatrix<Scalar> general = spd;
+  for(int i=0; i<n; ++i)
+    general.coeffRef(i,internal::random<int>(0,n-1)) += internal::random<Scalar>();
+  BsrMatrix bsrGeneral(general);
+  VERIFY(!bsrGeneral.isSelfAdjoint());
+  BiCGSTAB<BsrMatrix> bicg(bsrGeneral);
+  x = bicg.solve(b);
+  VERIFY_IS_EQUAL(bicg.info(), Success);
+  VERIFY_IS_APPROX(general*x, b);
+}
+
+void test_block_sparse_matrix()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( block_sparse_structure<double,3,3>() ));
+    CALL_SUBTEST_1(( block_sparse_structure<float,2,4>() ));
+    CALL_SUBTEST_1(( block_sparse_structure<double,1,4>() ));
+    CALL_SUBTEST_1(( block_sparse_structure<std::complex<double>,6,6>() ));
+    CALL_SUBTEST_2(( block_sparse_products<double,3,3>() ));
+    CALL_SUBTEST_2(( block_sparse_products<float,4,2>() ));
+    CALL_SUBTEST_2(( block_sparse_products<double,1,1>() ));
+    CALL_SUBTEST_2(( block_sparse_products<float,1,8>() ));
+    CALL_SUBTEST_2(( block_sparse_products<std::complex<double>,6,6>() ));
+    CALL_SUBTEST_3(( block_sparse_solvers<double,3>() ));
+    CALL_SUBTEST_3(( block_sparse_solvers<double,6>() ));
+    CALL_SUBTEST_3(( block_sparse_solvers<std::complex<float>,2>() ));
+  }
+}
@@ -0,0 +1,138 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse.h"
+#include <Eigen/IterativeLinearSolvers>
+#include <unsupported/Eigen/SparseExtra>
+
+template<typename Scalar> void sliced_ell_storage_and_products()
+{
+  typedef SlicedEllMatrix<Scalar> EllMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  const int rows = internal::random<int>(1,300);
+  const int cols = internal::random<int>(1,300);
+
+  DenseMatrix refMat = DenseMatrix::Zero(rows, cols);
+  SparseMatrix<Scalar> m(rows, cols);
+  initSparse<Scalar>(internal::random<double>(0.01,0.2), refMat, m);
+  // a few long rows make the sorting matter
+  for(int k=0; k<3; ++k)
+  {
+    int i = internal::random<int>(0,rows-1);
+    for(int j=0; j<cols; j+=2)
+      m.coeffRef(i,j) = refMat(i,j) = internal::random<Scalar>();
+  }
+
+  int sortingScopes[] = { 1, internal::random<int>(2,64), rows };
+  for(int k=0; k<3; ++k)
+  {
+    EllMatrix ell(m, sortingScopes[k]);
+    VERIFY_IS_EQUAL(ell.rows(), rows);
+    VERIFY_IS_EQUAL(ell.cols(), cols);
+    VERIFY_IS_EQUAL(ell.nonZeros(), m.nonZeros());
+    VERIFY(ell.storedSize()>=ell.nonZeros());
+    VERIFY_IS_EQUAL(ell.storedSize()%EllMatrix::SliceHeight, 0);
+
+    // the rows are iterated in increasing column order
+    SparseMatrix<Scalar,RowMajor> mr(m);
+    for(int i=0; i<rows; ++i)
+    {
+      typename SparseMatrix<Scalar,RowMajor>::InnerIterator it(mr,i);
+      typename EllMatrix::InnerIterator ellIt(ell,i);
+      for(; it && ellIt; ++it, ++ellIt)
+      {
+        VERIFY_IS_EQUAL(ellIt.index(), it.index());
+        VERIFY_IS_EQUAL(ellIt.value(), it.value());
+      }
+      VERIFY(!it && !ellIt);
+    }
+
+    DenseVector v = DenseVector::Random(cols), res(rows);
+    DenseMatrix b = DenseMatrix::Random(cols, internal::random<int>(1,5));
+    VERIFY_IS_APPROX(res = ell*v, refMat*v);
+    VERIFY_IS_APPROX(res.noalias() = ell*b.col(0), refMat*b.col(0));
+    VERIFY_IS_APPROX(DenseMatrix(ell*b), refMat*b);
+    VERIFY_IS_APPROX(DenseVector(v.head(rows%cols) + (ell*v).head(rows%cols)), DenseVector(v.head(rows%cols) + (refMat*v).head(rows%cols)));
+    DenseVector res2 = res;
+    VERIFY_IS_APPROX(res2 += ell*v, res + refMat*v);
+    VERIFY_IS_APPROX(res2.noalias() -= Scalar(2)*(ell*v), res - refMat*v);
+
+    // the padding of the empty rows does not read the rhs
+    DenseVector nan = DenseVector::Constant(cols, Scalar(std::numeric_limits<RealScalar>::quiet_NaN()));
+    res = ell*nan;
+    for(int i=0; i<rows; ++i)
+      if(refMat.row(i).isZero(0))
+        VERIFY_IS_EQUAL(res(i), Scalar(0));
+  }
+
+  EllMatrix empty(SparseMatrix<Scalar>(rows,cols));
+  VERIFY_IS_EQUAL(empty.storedSize(), 0);
+  VERIFY(DenseVector(empty*DenseVector::Random(cols)).isZero());
+}
+
+template<typename Scalar> void sliced_ell_solvers()
+{
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  const int n = internal::random<int>(50,400);
+
+  // selfadjoint positive definite, with both triangular parts stored
+  std::vector<Triplet<Scalar> > triplets;
+  for(int i=0; i<n; ++i)
+  {
+    triplets.push_back(Triplet<Scalar>(i,i,Scalar(16)));
+    for(int k=0; k<3; ++k)
+    {
+      int j = internal::random<int>(0,n-1);
+      if(j==i) continue;
+      Scalar x = internal::random<Scalar>();
+      triplets.push_back(Triplet<Scalar>(i,j,x));
+      triplets.push_back(Triplet<Scalar>(j,i,numext::conj(x)));
+    }
+  }
+  SparseMatrix<Scalar> spd(n,n);
+  spd.setFromTriplets(triplets.begin(), triplets.end());
+  DenseVector b = DenseVector::Random(n);
+
+  SlicedEllMatrix<Scalar> ell(spd);
+  VERIFY(ell.isSelfAdjoint());
+  ConjugateGradient<SlicedEllMatrix<Scalar> > cg(ell);
+  DenseVector x = cg.solve(b);
+  VERIFY_IS_EQUAL(cg.info(), Success);
+  VERIFY_IS_APPROX(spd*x, b);
+
+  // the products are evaluated into a temporary when the result aliases the rhs
+  DenseVector y = x;
+  VERIFY_IS_APPROX(y = ell*y, b);
+
+  ConjugateGradient<SlicedEllMatrix<Scalar>, Lower, IdentityPreconditioner> cgId(ell);
+  VERIFY_IS_APPROX(spd*DenseVector(cgId.solve(b)), b);
+
+  // general
+  SparseMatrix<Scalar> general = spd;
+  for(int i=0; i<n; ++i)
+    general.coeffRef(i,internal::random<int>(0,n-1)) += internal::random<Scalar>();
+  SlicedEllMatrix<Scalar> ellGeneral(general);
+  VERIFY(!ellGeneral.isSelfAdjoint());
+  BiCGSTAB<SlicedEllMatrix<Scalar> > bicg(ellGeneral);
+  x = bicg.solve(b);
+  VERIFY_IS_EQUAL(bicg.info(), Success);
+  VERIFY_IS_APPROX(general*x, b);
+}
+
+void test_sliced_ell_matrix()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1( sliced_ell_storage_and_products<float>() );
+    CALL_SUBTEST_1( sliced_ell_storage_and_products<double>() );
+    CALL_SUBTEST_2( sliced_ell_storage_and_products<std::complex<double> >() );
+    CALL_SUBTEST_2( sliced_ell_storage_and_products<std::complex<float> >() );
+    CALL_SUBTEST_3( sliced_ell_solvers<double>() );
+    CALL_SUBTEST_3( sliced_ell_solvers<std::complex<double> >() );
+  }
+}